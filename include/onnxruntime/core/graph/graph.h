@@ -397,7 +397,11 @@ class Node {
   bool ClearAttribute(const std::string& attr_name);
 
   /** Gets the Node's mutable attributes. */
-  NodeAttributes& GetMutableAttributes() noexcept { return attributes_; }
+  NodeAttributes& GetMutableAttributes() noexcept {
+    // someone fetching these is going to change something
+    ++attributes_version_;
+    return attributes_;
+  }
 
 #endif  // !defined(ORT_MINIMAL_BUILD) || defined(ORT_EXTENDED_MINIMAL_BUILD)
 
@@ -642,8 +646,15 @@ class Node {
   // Node::ToProto when running onnx::check_node in the first Graph::Resolve. At that point we know all the nodes are
   // unchanged from the original model.
   const ONNX_NAMESPACE::NodeProto* original_node_proto_ = nullptr;
+
+  // Everything the type/shape inferencing of this node depended on when it last ran in Graph::Resolve.
+  // Inferencing is skipped while this is unchanged. See Graph::GetInferenceSignature.
+  std::string inference_signature_;
 #endif
 
+  // Incremented whenever attributes_ may have been modified.
+  uint32_t attributes_version_ = 0;
+
   // Execution priority, lower value for higher priority
   int priority_ = 0;
 
@@ -750,6 +761,13 @@ class Graph {  // NOLINT(clang-analyzer-optin.performance.Padding): preserve exi
   /** Remove the initializer tensor with the provided name from the Graph. */
   void RemoveInitializedTensor(const std::string& tensor_name);
 
+#if !defined(ORT_MINIMAL_BUILD)
+  /** Check if the initializer with the given name was removed or replaced since the Graph was loaded.
+  An initializer that an optimizer removed and added again under the same name is reported as replaced.
+  */
+  bool IsInitializerReplaced(const std::string& name) const { return replaced_initializer_names_.count(name) > 0; }
+#endif
+
   /** Check if a given name is an initializer tensor's name in this graph. */
   bool IsInitializedTensor(const std::string& name) const;
 
@@ -1123,6 +1141,21 @@ class Graph {  // NOLINT(clang-analyzer-optin.performance.Padding): preserve exi
   void KahnsTopologicalSort(const std::function<void(const Node*)>& enter,
                             const std::function<bool(const Node*, const Node*)>& comp) const;
 
+  /** Performs topological sort with Kahn's algorithm, always visiting the ready node that adds the fewest bytes
+  of node outputs that are alive. Ties go to the node that continues the most recently visited branch.
+  Sizes are estimated from the inferred output shapes, treating unknown and symbolic dimensions as 1.
+  @param comp Comparison function to break the remaining ties deterministically.
+  @param node_orders The output node orders.
+  @returns The estimated peak bytes of node outputs alive when running the nodes in node_orders.
+  */
+  size_t MemoryAwareTopologicalSort(const std::function<bool(const Node*, const Node*)>& comp,
+                                    std::vector<NodeIndex>& node_orders) const;
+
+  /** Estimates the peak bytes of node outputs alive when running the nodes in node_orders.
+  Uses the same size estimate as MemoryAwareTopologicalSort so the results of different orders can be compared.
+  */
+  size_t EstimatePeakActivationBytes(gsl::span<const NodeIndex> node_orders) const;
+
 #endif
 
 #ifdef ENABLE_TRAINING
@@ -1621,6 +1654,10 @@ class Graph {  // NOLINT(clang-analyzer-optin.performance.Padding): preserve exi
 
   common::Status InferAndVerifyTypeMatch(Node& node, const ONNX_NAMESPACE::OpSchema& op, const ResolveOptions& options);
 
+  // Serializes the state that type/shape inferencing of `node` reads: the op, the attributes, the input and output
+  // NodeArgs and their types, and the constant initializers consumed by the node.
+  std::string GetInferenceSignature(const Node& node) const;
+
   // perform type and shape inferencing on the subgraph and Resolve to validate
   static common::Status InferAndVerifySubgraphTypes(const Node& node, Graph& subgraph,
                                                     const std::vector<const ONNX_NAMESPACE::TypeProto*>& input_types,
@@ -1729,6 +1766,11 @@ class Graph {  // NOLINT(clang-analyzer-optin.performance.Padding): preserve exi
 
   InitializedTensorSet name_to_initial_tensor_;
 
+#if !defined(ORT_MINIMAL_BUILD)
+  // Names of the initializers removed or replaced since the Graph was loaded. see IsInitializerReplaced.
+  InlinedHashSet<std::string> replaced_initializer_names_;
+#endif
+
   // Initializers that are external to the Graph.
   // e.g. created from existing memory using CreateTensorWithDataAndDeleterAsOrtValue in the ORT API.
   // As we need to convert to TensorProto for the optimizers to work and keep the deleter information we store them
@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 #pragma once
+#include <mutex>
 #include <unordered_set>
 #include <filesystem>
 
@@ -113,6 +114,8 @@ class GraphViewer {
 
   /** Gets the NodeIndex values for the Graph nodes, sorted into topological order.
   @remarks Filtered using filter_info_ if set.
+  @remarks ExecutionOrder::MEMORY_EFFICIENT orders the nodes to reduce the peak memory of the node outputs alive.
+  It is computed on first use.
   */
   const std::vector<NodeIndex>& GetNodesInTopologicalOrder(ExecutionOrder order = ExecutionOrder::DEFAULT) const;
 
@@ -214,9 +217,11 @@ class GraphViewer {
   std::vector<NodeIndex> nodes_in_topological_order_with_priority_;
 #endif
 
-#ifdef ENABLE_TRAINING
+#if !defined(ORT_MINIMAL_BUILD)
   // The NodeIndex values of the graph nodes sorted in memory efficient topological order.
-  std::vector<NodeIndex> nodes_in_mem_efficient_topological_order_;
+  // Computed on first use unless the training specific order is set by the constructor.
+  mutable std::vector<NodeIndex> nodes_in_mem_efficient_topological_order_;
+  mutable std::once_flag mem_efficient_topological_order_once_;
 #endif
 
   // Graph root nodes.
@@ -20,6 +20,47 @@
 // If the config value is set to "1" then the prepacking is disabled, otherwise prepacking is enabled (default value)
 static const char* const kOrtSessionOptionsConfigDisablePrepacking = "session.disable_prepacking";
 
+// Key for parallel session finalization.
+// If the config value is set to "1", kernels assigned to the CPU execution provider are created and constant
+// initializers are pre-packed concurrently on the intra-op thread pool during session initialization.
+// Kernel constructors and PrePack implementations, including those of custom ops, must not share mutable state
+// across kernel instances. The default value is "0".
+static const char* const kOrtSessionOptionsConfigParallelFinalization = "session.parallel_finalization";
+
+// Key for lazy pre-packing.
+// If the config value is set to "1", constant initializers are pre-packed by each kernel the first time it runs
+// instead of during session initialization. This reduces the initialization time and the memory usage of models in
+// which some nodes rarely run (e.g. a branch of an If node). The original initializers are kept, so nodes that do run
+// hold both the original and the pre-packed weights. Ignored when the optimized model is saved.
+// The default value is "0".
+static const char* const kOrtSessionOptionsConfigLazyPrepacking = "session.lazy_prepacking";
+
+// Key for the directory that backs the weights cached in a shared pre-packed weights container with files.
+// Only used if the session is added to a PrepackedWeightsContainer with shared initializers.
+// If the directory is on a shared memory file system (e.g. "/dev/shm/ort_prepacked") processes on the same host
+// that pre-pack identical weights map a single physical copy instead of each holding its own copy.
+// Files are named after the hash of the pre-packed data and also store it. The data of an existing file is checked
+// against the hash before it is mapped and a stale or damaged file is replaced. Files are not removed by ORT.
+// All sessions using the same container must use the same directory.
+static const char* const kOrtSessionOptionsConfigPrepackedWeightsSharedMemoryDir =
+    "session.prepacked_weights_shared_memory_dir";
+
+// Key for re-optimizing a model with dynamic input shapes for the shapes observed at runtime.
+// If the config value is set to N > 0 and the input shapes of N consecutive successful runs are identical,
+// the session creates a second session for the model with the symbolic input dimensions fixed to the observed
+// values (see SessionOptions::free_dimension_overrides) so that the optimizers can use the concrete shapes.
+// The specialized session is initialized on a background thread so that no run waits for it. Once it is ready,
+// runs with exactly those input shapes use it. Other runs, and all runs until then, use the original session.
+// The specialized session lives as long as the session. It runs on the thread pools of the session and shares the
+// initializers that neither session's optimizers replaced, but it holds its own optimized graph, kernels,
+// pre-packed weights (unless a pre-packed weights container is used) and the remaining initializers, which can
+// roughly double the memory used for the model. Its runs are counted and profiled as runs of the session; the node
+// level profiling events of those runs are written to a second file with the prefix "<prefix>shape_specialized_".
+// Only supported for sessions that load an ONNX model from a file, run on the CPU EP only and have no custom ops.
+// The default value is "0" (disabled).
+static const char* const kOrtSessionOptionsConfigShapeSpecializationAfterRuns =
+    "session.shape_specialization_after_runs";
+
 // A value of "1" means allocators registered in the env will be used. "0" means the allocators created in the session
 // will be used. Use this to override the usage of env allocators on a per session level.
 static const char* const kOrtSessionOptionsConfigUseEnvAllocators = "session.use_env_allocators";
@@ -32,6 +73,16 @@ static const char* const kOrtSessionOptionsConfigLoadModelFormat = "session.load
 // If unset, format will default to ONNX unless optimized_model_filepath ends in '.ort'.
 static const char* const kOrtSessionOptionsConfigSaveModelFormat = "session.save_model_format";
 
+// Directory used to cache optimized models in ORT format, so that subsequent sessions created for the same ONNX model
+// file skip graph resolution and optimization. The first session saves a snapshot once it is initialized, later
+// sessions load it instead of the ONNX model. Snapshots are keyed by the model file bytes, the session configuration
+// and the CPU instruction set. External data files and the registered execution providers are not part of the key,
+// so use a separate directory for each execution provider configuration.
+// Only applies when loading a model from a file path and SessionOptions.optimized_model_path is not set.
+// The cache is not used when initializers are added to the session options (AddInitializer, external initializers)
+// or custom ops are registered, and no snapshot is written when a pre-packed weights container is used.
+static const char* const kOrtSessionOptionsConfigOptimizedModelCacheDir = "session.optimized_model_cache_dir";
+
 // If a value is "1", flush-to-zero and denormal-as-zero are applied. The default is "0".
 // When multiple sessions are created, a main thread doesn't override changes from succeeding session options,
 // but threads in session thread pools follow option changes.
@@ -67,6 +118,10 @@ static const char* const kOrtSessionOptionsEnableQuantQDQCleanup = "session.enab
 // GeluApproximation has side effects which may change the inference results. It is disabled by default due to this.
 static const char* const kOrtSessionOptionsEnableGeluApproximation = "optimization.enable_gelu_approximation";
 
+// Enable or disable fusing chains of float element-wise operators (Add, Mul, Sigmoid, Relu, ...) on the CPU EP into a
+// single FusedElementwise node that makes one pass over memory. "0": disable; "1": enable. The default is "0".
+static const char* const kOrtSessionOptionsEnableElementwiseChainFusion = "optimization.enable_elementwise_chain_fusion";
+
 // Enable or disable Cast chain elimination in graph optimization. "0": disable; "1": enable. The default is "0".
 // CastElimination with chain elimination has side effects which may change the inference results. It is disabled by default due to this.
 static const char* const kOrtSessionOptionsEnableCastChainElimination = "optimization.enable_cast_chain_elimination";
@@ -372,6 +427,22 @@ static const char* const kOrtSessionOptionsEpContextModelExternalInitializersFil
 // - "1": Gemm FastMath mode is enabled.
 static const char* const kOrtSessionOptionsMlasGemmFastMathArm64Bfloat16 = "mlas.enable_gemm_fastmath_arm64_bfloat16";
 
+// Quantize the constant W and R weights of float LSTM nodes on the CPU EP to int8 with one scale per output column
+// when they are pre-packed, and run the input and recurrent GEMMs with dynamically quantized activations.
+// This trades accuracy for speed in the same way as the DynamicQuantizeLSTM contrib op, without changing the model.
+// Option values:
+// - "0": LSTM weights are kept in float. [DEFAULT]
+// - "1": LSTM weights are quantized to int8.
+static const char* const kOrtSessionOptionsQuantizeLstmWeights = "session.quantize_lstm_weights";
+
+// Quantize the W and R weights of float GRU nodes on the CPU EP to int8 in the same way as
+// "session.quantize_lstm_weights" does for LSTM. The recurrent weights are quantized separately for the update and
+// reset gates and for the hidden gate, as they are applied by separate GEMMs.
+// Option values:
+// - "0": GRU weights are kept in float. [DEFAULT]
+// - "1": GRU weights are quantized to int8.
+static const char* const kOrtSessionOptionsQuantizeGruWeights = "session.quantize_gru_weights";
+
 // When converting DQ + MatMul -> MatMulNBits, the accuracy level of the MatMulNBits is controlled by this option.
 // Refer to MatMulNBits op schema for more details.
 // If not provided, default is 4.
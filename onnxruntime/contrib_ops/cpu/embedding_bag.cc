@@ -0,0 +1,195 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <algorithm>
+#include <atomic>
+#include <type_traits>
+
+#include "core/common/inlined_containers.h"
+#include "core/common/narrow.h"
+#include "core/framework/op_kernel.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/platform/threadpool.h"
+#include "core/util/math_cpuonly.h"
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <xmmintrin.h>
+#endif
+
+namespace onnxruntime {
+namespace contrib {
+
+namespace {
+
+// Brings a table row into cache while the previous row of the bag is being accumulated.
+inline void PrefetchRow(const void* row, size_t row_bytes) {
+  constexpr size_t kCacheLineSize = 64;
+  const char* p = static_cast<const char*>(row);
+  for (size_t offset = 0; offset < row_bytes; offset += kCacheLineSize) {
+#if defined(__GNUC__)
+    __builtin_prefetch(p + offset);
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    _mm_prefetch(p + offset, _MM_HINT_T0);
+#else
+    ORT_UNUSED_PARAMETER(p);
+#endif
+  }
+}
+
+// y += weight * row for the supported table types. buffer holds dim floats for the types that are converted first.
+inline void AccumulateRow(const float* row, float weight, size_t dim, float* y, float* /*buffer*/) {
+  EigenVectorArrayMap<float> ym(y, narrow<Eigen::Index>(dim));
+  ym += ConstEigenVectorArrayMap<float>(row, narrow<Eigen::Index>(dim)) * weight;
+}
+
+inline void AccumulateRow(const int8_t* row, float weight, size_t dim, float* y, float* /*buffer*/) {
+  EigenVectorArrayMap<float> ym(y, narrow<Eigen::Index>(dim));
+  ym += ConstEigenVectorArrayMap<int8_t>(row, narrow<Eigen::Index>(dim)).cast<float>() * weight;
+}
+
+inline void AccumulateRow(const MLFloat16* row, float weight, size_t dim, float* y, float* buffer) {
+  MlasConvertHalfToFloatBuffer(row, buffer, dim);
+  AccumulateRow(buffer, weight, dim, y, nullptr);
+}
+
+}  // namespace
+
+// Sums (or averages) the rows of an embedding table selected by each bag of indices, optionally weighting each
+// row by a per-sample weight and, for int8 tables, by a per-row scale. This is Gather followed by ReduceSum or
+// ReduceMean over the bag axis, without materializing the gathered [..., bag, dim] tensor.
+class EmbeddingBag final : public OpKernel {
+ public:
+  explicit EmbeddingBag(const OpKernelInfo& info) : OpKernel(info) {
+    const auto mode = info.GetAttrOrDefault<std::string>("mode", "sum");
+    ORT_ENFORCE(mode == "sum" || mode == "mean", "EmbeddingBag mode must be 'sum' or 'mean' but is ", mode);
+    mean_ = mode == "mean";
+  }
+
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  template <typename TTable, typename TIndex>
+  Status ComputeImpl(OpKernelContext* context, const Tensor& table, const Tensor& indices, const float* weights,
+                     const float* scales, Tensor& output) const;
+
+  bool mean_;
+};
+
+template <typename TTable, typename TIndex>
+Status EmbeddingBag::ComputeImpl(OpKernelContext* context, const Tensor& table, const Tensor& indices,
+                                 const float* weights, const float* scales, Tensor& output) const {
+  const int64_t num_rows = table.Shape()[0];
+  const auto dim = narrow<size_t>(table.Shape()[1]);
+  const auto bag_size = narrow<size_t>(indices.Shape()[indices.Shape().NumDimensions() - 1]);
+  const auto num_bags = narrow<size_t>(output.Shape().Size() / std::max<int64_t>(1, table.Shape()[1]));
+
+  const TTable* table_data = table.Data<TTable>();
+  const TIndex* indices_data = indices.Data<TIndex>();
+  float* output_data = output.MutableData<float>();
+  const float bag_scale = mean_ && bag_size > 0 ? 1.0f / static_cast<float>(bag_size) : 1.0f;
+
+  std::atomic<bool> index_error{false};
+  const double row_bytes = static_cast<double>(dim * sizeof(TTable));
+  concurrency::ThreadPool::TryParallelFor(
+      context->GetOperatorThreadPool(), static_cast<std::ptrdiff_t>(num_bags),
+      TensorOpCost{row_bytes * bag_size, static_cast<double>(dim * sizeof(float)),
+                   static_cast<double>(dim * bag_size) * 2.0},
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        InlinedVector<float> buffer(std::is_same_v<TTable, MLFloat16> ? dim : 0);
+        for (auto bag = static_cast<size_t>(first); bag < static_cast<size_t>(last); ++bag) {
+          float* y = output_data + bag * dim;
+          std::fill_n(y, dim, 0.0f);
+
+          const TIndex* bag_indices = indices_data + bag * bag_size;
+          for (size_t j = 0; j < bag_size; ++j) {
+            int64_t row = static_cast<int64_t>(bag_indices[j]);
+            if (row < 0) row += num_rows;
+            if (row < 0 || row >= num_rows) {
+              index_error = true;
+              return;
+            }
+
+            if (j + 1 < bag_size) {
+              int64_t next_row = static_cast<int64_t>(bag_indices[j + 1]);
+              if (next_row < 0) next_row += num_rows;
+              if (next_row >= 0 && next_row < num_rows) {
+                PrefetchRow(table_data + next_row * dim, dim * sizeof(TTable));
+              }
+            }
+
+            float weight = weights ? weights[bag * bag_size + j] : 1.0f;
+            if (scales) weight *= scales[row];
+            AccumulateRow(table_data + row * dim, weight, dim, y, buffer.data());
+          }
+
+          if (mean_) {
+            EigenVectorArrayMap<float>(y, narrow<Eigen::Index>(dim)) *= bag_scale;
+          }
+        }
+      });
+
+  ORT_RETURN_IF(index_error, "EmbeddingBag: indices must be within [", -num_rows, ", ", num_rows - 1, "]");
+  return Status::OK();
+}
+
+Status EmbeddingBag::Compute(OpKernelContext* context) const {
+  const Tensor* table = context->Input<Tensor>(0);
+  const Tensor* indices = context->Input<Tensor>(1);
+  const Tensor* weights = context->Input<Tensor>(2);
+  const Tensor* scales = context->Input<Tensor>(3);
+
+  const auto& table_shape = table->Shape();
+  const auto& indices_shape = indices->Shape();
+  ORT_RETURN_IF_NOT(table_shape.NumDimensions() == 2, "EmbeddingBag: table must be 2-D, got ", table_shape);
+  ORT_RETURN_IF_NOT(indices_shape.NumDimensions() >= 1, "EmbeddingBag: indices must have at least one dimension");
+  ORT_RETURN_IF_NOT(weights == nullptr || weights->Shape().Size() == indices_shape.Size(),
+                    "EmbeddingBag: per_sample_weights must have one value per index. Got ", weights->Shape(),
+                    " for indices of shape ", indices_shape);
+
+  const bool is_quantized = table->IsDataType<int8_t>();
+  ORT_RETURN_IF_NOT(!is_quantized || scales != nullptr, "EmbeddingBag: an int8 table requires scales");
+  ORT_RETURN_IF_NOT(scales == nullptr || scales->Shape().Size() == table_shape[0],
+                    "EmbeddingBag: scales must have one value per table row. Got ", scales->Shape(),
+                    " for table of shape ", table_shape);
+
+  // the bag axis is replaced by the embedding dimension
+  TensorShapeVector output_dims(indices_shape.GetDims().begin(), indices_shape.GetDims().end());
+  output_dims.back() = table_shape[1];
+  Tensor* output = context->Output(0, output_dims);
+  if (output->Shape().Size() == 0) {
+    return Status::OK();
+  }
+
+  const float* weights_data = weights ? weights->Data<float>() : nullptr;
+  const float* scales_data = scales ? scales->Data<float>() : nullptr;
+  const bool int32_indices = indices->IsDataType<int32_t>();
+  if (table->IsDataType<float>()) {
+    return int32_indices
+               ? ComputeImpl<float, int32_t>(context, *table, *indices, weights_data, scales_data, *output)
+               : ComputeImpl<float, int64_t>(context, *table, *indices, weights_data, scales_data, *output);
+  }
+
+  if (table->IsDataType<MLFloat16>()) {
+    return int32_indices
+               ? ComputeImpl<MLFloat16, int32_t>(context, *table, *indices, weights_data, scales_data, *output)
+               : ComputeImpl<MLFloat16, int64_t>(context, *table, *indices, weights_data, scales_data, *output);
+  }
+
+  return int32_indices
+             ? ComputeImpl<int8_t, int32_t>(context, *table, *indices, weights_data, scales_data, *output)
+             : ComputeImpl<int8_t, int64_t>(context, *table, *indices, weights_data, scales_data, *output);
+}
+
+ONNX_OPERATOR_KERNEL_EX(
+    EmbeddingBag,
+    kMSDomain,
+    1,
+    kCpuExecutionProvider,
+    KernelDefBuilder()
+        .TypeConstraint("T1", BuildKernelDefConstraints<float, MLFloat16, int8_t>())
+        .TypeConstraint("T2", DataTypeImpl::GetTensorType<float>())
+        .TypeConstraint("Tind", BuildKernelDefConstraints<int32_t, int64_t>()),
+    EmbeddingBag);
+
+}  // namespace contrib
+}  // namespace onnxruntime
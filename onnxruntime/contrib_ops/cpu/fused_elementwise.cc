@@ -0,0 +1,234 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <algorithm>
+#include <cstring>
+
+#include "core/common/inlined_containers.h"
+#include "core/common/narrow.h"
+#include "core/framework/op_kernel.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/platform/threadpool.h"
+#include "core/util/math_cpuonly.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+// Runs the chain of element-wise operators produced by ElementwiseChainFusion.
+// The attributes are decoded once into a small program which is interpreted for each tile of the output,
+// so the whole chain makes a single pass over memory while the tile stays in cache.
+class FusedElementwise final : public OpKernel {
+ public:
+  explicit FusedElementwise(const OpKernelInfo& info);
+
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  enum class OpCode : uint8_t {
+    kAdd,
+    kSub,
+    kSubFrom,  // operand - value
+    kMul,
+    kDiv,
+    kDivInto,  // operand / value
+    kRelu,
+    kSigmoid,
+    kTanh,
+    kExp,
+    kLog,
+    kSqrt,
+    kNeg,
+    kAbs,
+    kReciprocal,
+  };
+
+  struct Instruction {
+    OpCode op;
+    int operand;  // input index of the other operand of a binary op, -1 to use the immediate
+    float immediate;
+  };
+
+  static bool IsBinary(OpCode op) { return op <= OpCode::kDivInto; }
+
+  // Applies the program to count elements starting at offset. The running value lives in y.
+  void RunProgram(gsl::span<const float* const> inputs, float* y, size_t offset, size_t count) const;
+
+  InlinedVector<Instruction> program_;
+};
+
+FusedElementwise::FusedElementwise(const OpKernelInfo& info) : OpKernel(info) {
+  const auto ops = info.GetAttrsOrDefault<std::string>("ops");
+  const auto operands = info.GetAttrsOrDefault<int64_t>("operands");
+  const auto immediates = info.GetAttrsOrDefault<float>("immediates");
+  const auto chain_is_rhs = info.GetAttrsOrDefault<int64_t>("chain_is_rhs");
+  ORT_ENFORCE(!ops.empty() && operands.size() == ops.size() && immediates.size() == ops.size() &&
+                  chain_is_rhs.size() == ops.size(),
+              "FusedElementwise requires 'ops', 'operands', 'immediates' and 'chain_is_rhs' of the same length.");
+
+  const int num_inputs = static_cast<int>(info.GetInputCount());
+  program_.reserve(ops.size());
+  for (size_t i = 0; i < ops.size(); ++i) {
+    const std::string& op_type = ops[i];
+    const bool rhs = chain_is_rhs[i] != 0;
+    OpCode op;
+    if (op_type == "Add") {
+      op = OpCode::kAdd;
+    } else if (op_type == "Sub") {
+      op = rhs ? OpCode::kSubFrom : OpCode::kSub;
+    } else if (op_type == "Mul") {
+      op = OpCode::kMul;
+    } else if (op_type == "Div") {
+      op = rhs ? OpCode::kDivInto : OpCode::kDiv;
+    } else if (op_type == "Relu") {
+      op = OpCode::kRelu;
+    } else if (op_type == "Sigmoid") {
+      op = OpCode::kSigmoid;
+    } else if (op_type == "Tanh") {
+      op = OpCode::kTanh;
+    } else if (op_type == "Exp") {
+      op = OpCode::kExp;
+    } else if (op_type == "Log") {
+      op = OpCode::kLog;
+    } else if (op_type == "Sqrt") {
+      op = OpCode::kSqrt;
+    } else if (op_type == "Neg") {
+      op = OpCode::kNeg;
+    } else if (op_type == "Abs") {
+      op = OpCode::kAbs;
+    } else if (op_type == "Reciprocal") {
+      op = OpCode::kReciprocal;
+    } else {
+      ORT_THROW("FusedElementwise does not support the operator ", op_type);
+    }
+
+    const int operand = narrow<int>(operands[i]);
+    ORT_ENFORCE(!IsBinary(op) || (operand >= -1 && operand < num_inputs),
+                "Invalid operand index ", operand, " for step ", i, " of FusedElementwise.");
+    program_.push_back({op, IsBinary(op) ? operand : -1, immediates[i]});
+  }
+}
+
+void FusedElementwise::RunProgram(gsl::span<const float* const> inputs, float* y, size_t offset,
+                                  size_t count) const {
+  EigenVectorArrayMap<float> ym(y, narrow<Eigen::Index>(count));
+  for (const auto& instruction : program_) {
+    if (IsBinary(instruction.op) && instruction.operand >= 0) {
+      ConstEigenVectorArrayMap<float> bm(inputs[instruction.operand] + offset, narrow<Eigen::Index>(count));
+      switch (instruction.op) {
+        case OpCode::kAdd:
+          ym += bm;
+          break;
+        case OpCode::kSub:
+          ym -= bm;
+          break;
+        case OpCode::kSubFrom:
+          ym = bm - ym;
+          break;
+        case OpCode::kMul:
+          ym *= bm;
+          break;
+        case OpCode::kDiv:
+          ym /= bm;
+          break;
+        default:  // kDivInto
+          ym = bm / ym;
+          break;
+      }
+      continue;
+    }
+
+    const float b = instruction.immediate;
+    switch (instruction.op) {
+      case OpCode::kAdd:
+        ym += b;
+        break;
+      case OpCode::kSub:
+        ym -= b;
+        break;
+      case OpCode::kSubFrom:
+        ym = b - ym;
+        break;
+      case OpCode::kMul:
+        ym *= b;
+        break;
+      case OpCode::kDiv:
+        ym /= b;
+        break;
+      case OpCode::kDivInto:
+        ym = b / ym;
+        break;
+      case OpCode::kRelu:
+        ym = ym.cwiseMax(0.0f);
+        break;
+      case OpCode::kSigmoid:
+        MlasComputeLogistic(y, y, count);
+        break;
+      case OpCode::kTanh:
+        MlasComputeTanh(y, y, count);
+        break;
+      case OpCode::kExp:
+        MlasComputeExp(y, y, count);
+        break;
+      case OpCode::kLog:
+        ym = ym.log();
+        break;
+      case OpCode::kSqrt:
+        ym = ym.sqrt();
+        break;
+      case OpCode::kNeg:
+        ym = -ym;
+        break;
+      case OpCode::kAbs:
+        ym = ym.abs();
+        break;
+      case OpCode::kReciprocal:
+        ym = ym.inverse();
+        break;
+    }
+  }
+}
+
+Status FusedElementwise::Compute(OpKernelContext* context) const {
+  const Tensor* X = context->Input<Tensor>(0);
+  const TensorShape& shape = X->Shape();
+  const int64_t elem_count = shape.Size();
+
+  const int num_inputs = context->InputCount();
+  InlinedVector<const float*> inputs(num_inputs);
+  for (int i = 0; i < num_inputs; ++i) {
+    const Tensor* input = context->Input<Tensor>(i);
+    ORT_RETURN_IF_NOT(input->Shape().Size() == elem_count, "Input ", i, " of FusedElementwise has ",
+                      input->Shape().Size(), " elements but input 0 has ", elem_count);
+    inputs[i] = input->Data<float>();
+  }
+
+  Tensor* Y = context->Output(0, shape);
+  float* y_data = Y->MutableData<float>();
+
+  // small enough to stay in L1 between the steps of the program
+  constexpr int64_t length_per_task = 4096;
+  const int64_t task_count = (elem_count + length_per_task - 1) / length_per_task;
+  concurrency::ThreadPool::TryBatchParallelFor(
+      context->GetOperatorThreadPool(), narrow<ptrdiff_t>(task_count),
+      [&](ptrdiff_t task_idx) {
+        const size_t start = narrow<size_t>(task_idx * length_per_task);
+        const size_t count = narrow<size_t>(std::min(length_per_task, elem_count - static_cast<int64_t>(start)));
+        float* y = y_data + start;
+        std::memcpy(y, inputs[0] + start, count * sizeof(float));
+        RunProgram(inputs, y, start, count);
+      },
+      0);
+
+  return Status::OK();
+}
+
+ONNX_OPERATOR_KERNEL_EX(
+    FusedElementwise,
+    kMSDomain,
+    1,
+    kCpuExecutionProvider,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    FusedElementwise);
+
+}  // namespace contrib
+}  // namespace onnxruntime
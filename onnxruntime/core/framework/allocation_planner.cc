@@ -4,11 +4,14 @@
 #include "core/framework/allocation_planner.h"
 #include <list>
 #include <algorithm>
+#include <cctype>
 #include <deque>
 #include <sstream>
 #include <ctime>
 #include <iomanip>
 #include <iterator>
+#include <limits>
+#include <string_view>
 #include "core/common/exceptions.h"
 #include "core/common/inlined_containers.h"
 #include "core/common/safeint.h"
@@ -405,7 +408,7 @@ class PlannerImpl {
 #endif
 
               if (!need_skip) {
-                if (SameSize(*p_input_arg, *p_output_arg)) {
+                if (SameSize(*p_input_arg, *p_output_arg, /*allow_different_shape*/ false)) {
                   // we can reuse this input since it is its last use and permitted for in-place update
                   *reusable_input = input_arg_index;  // or original; both should be okay
                   return true;
@@ -496,6 +499,85 @@ class PlannerImpl {
     return true;
   }
 
+  // The number of elements of a shape as a product of a constant and named symbolic dimensions.
+  // A symbolic dimension may itself be a product (e.g.) "batch*seq" as produced by symbolic shape inference.
+  struct SymbolicNumElements {
+    int64_t constant = 1;
+    InlinedVector<std::string_view> symbols;  // sorted
+
+    bool operator==(const SymbolicNumElements& other) const {
+      return constant == other.constant && (constant == 0 || symbols == other.symbols);
+    }
+  };
+
+  static bool MultiplyConstant(SymbolicNumElements& num_elements, int64_t value) {
+    if (value < 0 ||
+        (value != 0 && num_elements.constant > std::numeric_limits<int64_t>::max() / value)) {
+      return false;
+    }
+
+    num_elements.constant *= value;
+    return true;
+  }
+
+  // Returns false if a dimension is unknown or cannot be interpreted as a product.
+  static bool GetSymbolicNumElements(const TensorShapeProto& shape, SymbolicNumElements& num_elements) {
+    for (const auto& dim : shape.dim()) {
+      if (utils::HasDimValue(dim)) {
+        if (!MultiplyConstant(num_elements, dim.dim_value())) return false;
+        continue;
+      }
+
+      if (!utils::HasDimParam(dim)) return false;
+
+      std::string_view param = dim.dim_param();
+      const bool is_product = std::all_of(param.begin(), param.end(), [](char c) {
+        return c == '*' || c == '_' || c == ' ' || std::isalnum(static_cast<unsigned char>(c));
+      });
+      if (!is_product) {
+        // an arbitrary expression is only equal to itself
+        num_elements.symbols.push_back(param);
+        continue;
+      }
+
+      while (!param.empty()) {
+        const size_t end = std::min(param.find('*'), param.size());
+        std::string_view factor = param.substr(0, end);
+        param.remove_prefix(std::min(end + 1, param.size()));
+
+        while (!factor.empty() && factor.front() == ' ') factor.remove_prefix(1);
+        while (!factor.empty() && factor.back() == ' ') factor.remove_suffix(1);
+        if (factor.empty()) return false;
+
+        if (std::all_of(factor.begin(), factor.end(), [](char c) { return c >= '0' && c <= '9'; })) {
+          int64_t value = 0;
+          for (char c : factor) {
+            if (value > (std::numeric_limits<int64_t>::max() - (c - '0')) / 10) return false;
+            value = value * 10 + (c - '0');
+          }
+
+          if (!MultiplyConstant(num_elements, value)) return false;
+        } else {
+          num_elements.symbols.push_back(factor);
+        }
+      }
+    }
+
+    std::sort(num_elements.symbols.begin(), num_elements.symbols.end());
+    return true;
+  }
+
+  // Returns true if the shapes have the same number of elements for all values of their symbolic dimensions.
+  // e.g. {batch, seq, 768}, {batch, 12, seq, 64} and {batch*seq, 768}
+  static bool SameNumElements(const TensorShapeProto& shape1, const TensorShapeProto& shape2) {
+    if (SameShape(shape1, shape2)) return true;
+
+    SymbolicNumElements num_elements1;
+    SymbolicNumElements num_elements2;
+    return GetSymbolicNumElements(shape1, num_elements1) && GetSymbolicNumElements(shape2, num_elements2) &&
+           num_elements1 == num_elements2;
+  }
+
   /*! \brief Given a tensor-type, return the size of an element of the tensor.
    */
   static size_t GetElementSize(const DataType& tensor_type) {
@@ -507,8 +589,12 @@ class PlannerImpl {
     return elt_type->Size();
   }
 
+  // If allow_different_shape is true, buffers with the same number of elements but different shapes compare equal.
+  // That is only valid when reusing a freed buffer. An in-place output must have the shape of the input it replaces
+  // as the kernel may still read the input in its own layout while writing the output.
   static bool SameSize(const TensorShapeProto& shape1, const onnxruntime::NodeArg& arg1,
-                       const TensorShapeProto& shape2, const onnxruntime::NodeArg& arg2) {
+                       const TensorShapeProto& shape2, const onnxruntime::NodeArg& arg2,
+                       bool allow_different_shape) {
     const auto& ptype1 = arg1.Type();
     const auto& ptype2 = arg2.Type();
     auto type1_size = GetElementSize(ptype1);
@@ -521,20 +607,8 @@ class PlannerImpl {
     // If either of the tensors is a string, don't treat them the same. Moreover, reusing a string tensor for a string
     // tensor without releasing the previous memory can cause memory leaks; hence we don't allow reuse across string
     // tensors as well.
-    return !(is_type1_string || is_type2_string) && (type1_size == type2_size) && SameShape(shape1, shape2);
-
-    /* TODO: we can improve this if the concrete shapes are known for both as below.
-       Unclear whether this is worthwhile though.
-    if (KnownSize(p_shape1) && KnownSize(p_shape2)) {
-      // Comparison of statically-known size
-      auto size1 = NumElements(p_shape1) * EltSize(ptype1);
-      auto size2 = NumElements(p_shape2) * EltSize(ptype2);
-      return size1 == size2;
-    } else {
-      // Comparison of statically-unknown size buffers
-      return SameElementSize(ptype1, ptype2) && SameShape(shape1, shape2);
-    }
-    */
+    return !(is_type1_string || is_type2_string) && (type1_size == type2_size) &&
+           (allow_different_shape ? SameNumElements(shape1, shape2) : SameShape(shape1, shape2));
   }
 
   static bool OutputHasConsumerNode(const Node& node, int output_idx) {
@@ -546,13 +620,13 @@ class PlannerImpl {
                        });
   }
 
-  bool SameSize(const onnxruntime::NodeArg& arg1, const onnxruntime::NodeArg& arg2) {
+  bool SameSize(const onnxruntime::NodeArg& arg1, const onnxruntime::NodeArg& arg2, bool allow_different_shape) {
     if ((!arg1.Exists()) || (!arg2.Exists())) return false;
     auto p_shape1 = context_->GetShape(arg1);
     auto p_shape2 = context_->GetShape(arg2);
     // If the shapes are unknown, we conservatively assume they may be of different size.
     if ((nullptr == p_shape1) || (nullptr == p_shape2)) return false;
-    return SameSize(*p_shape1, arg1, *p_shape2, arg2);
+    return SameSize(*p_shape1, arg1, *p_shape2, arg2, allow_different_shape);
   }
 
   // Find if freelist contains a buffer of the same size as output_arg
@@ -586,7 +660,7 @@ class PlannerImpl {
       auto p_available_buffer_shape = context_->GetShape(*p_node_arg);
       if (nullptr != p_available_buffer_shape) {
         if (SameSize(*p_available_buffer_shape, *p_node_arg,
-                     *p_required_buffer_shape, output_arg)) {
+                     *p_required_buffer_shape, output_arg, /*allow_different_shape*/ true)) {
           *reusable_tensor = it->ml_value;
           freelist_.erase(it);
           return true;
@@ -1348,7 +1422,8 @@ class PlannerImpl {
                   OrtValueIndex input_arg_index{};
                   if (value_map.GetIdx(p_input_arg->Name(), input_arg_index).IsOK() &&
                       allocation_plan[input_arg_index].alloc_kind == AllocKind::kAllocate) {
-                    if (value_consumer_map[input_arg_index].size() == 1 && SameSize(*p_input_arg, *p_output_arg)) {
+                    if (value_consumer_map[input_arg_index].size() == 1 &&
+                        SameSize(*p_input_arg, *p_output_arg, /*allow_different_shape*/ false)) {
                       allocation_plan[output_idx_global].alloc_kind = AllocKind::kReuse;
                       allocation_plan[output_idx_global].reused_buffer = input_arg_index;
                       value_consumer_map[input_arg_index].insert(value_consumer_map[output_idx_global].begin(),
@@ -1420,7 +1495,7 @@ class PlannerImpl {
             }
 
             const auto* downstream_shape = context_->GetShape(*downstream_arg);
-            if (!SameSize(*downstream_shape, *downstream_arg, *shape, *node_output)) {
+            if (!SameSize(*downstream_shape, *downstream_arg, *shape, *node_output, /*allow_different_shape*/ true)) {
               node_iter = next(node_iter);
               continue;
             }
@@ -2422,11 +2497,27 @@ Status SequentialPlanner::CreatePlan(
                       outer_scope_node_arg_to_location_map,
                       ort_value_name_idx_map, context, *plan, logger);
 
-  return planner.CreatePlan(
+  ORT_RETURN_IF_ERROR(planner.CreatePlan(
 #ifdef ORT_ENABLE_STREAM
       stream_handle_registry,
 #endif
-      partition_config_file);
+      partition_config_file));
+
+#if !defined(ORT_MINIMAL_BUILD)
+  // report the planned peak so the benefit of the memory efficient order can be checked for a model
+  if (context.GetExecutionOrder() == ExecutionOrder::MEMORY_EFFICIENT &&
+      logger.OutputIsEnabled(logging::Severity::kINFO, logging::DataType::SYSTEM)) {
+    const Graph& graph = graph_viewer.GetGraph();
+    const auto& memory_efficient_order = graph_viewer.GetNodesInTopologicalOrder(ExecutionOrder::MEMORY_EFFICIENT);
+    LOGS(logger, INFO) << "Estimated peak bytes of node outputs for graph " << graph_viewer.Name()
+                       << ": " << graph.EstimatePeakActivationBytes(memory_efficient_order)
+                       << " with the memory efficient execution order, "
+                       << graph.EstimatePeakActivationBytes(graph_viewer.GetNodesInTopologicalOrder())
+                       << " with the default execution order.";
+  }
+#endif
+
+  return Status::OK();
 }
 
 #ifdef ORT_ENABLE_STREAM
@@ -2,11 +2,118 @@
 // Licensed under the MIT License.
 
 #include "core/framework/prepacked_weights_container.h"
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+
 #include "core/framework/allocator_utils.h"
 #include "core/graph/graph.h"
+#include "core/platform/env.h"
 
 namespace onnxruntime {
 
+namespace {
+
+// Layout of a shared memory file:
+//   uint64_t magic, uint64_t hash of the buffers (PrePackedWeights::GetHash), uint64_t number of buffers,
+//   uint64_t size of each buffer, followed by the buffers, each starting at an offset aligned to
+//   kSharedBufferAlignment.
+constexpr uint64_t kSharedFileMagic = 0x323057505054524F;  // "ORTPPW02"
+constexpr size_t kSharedBufferAlignment = 64;
+
+size_t AlignSharedBufferOffset(size_t offset) {
+  return (offset + kSharedBufferAlignment - 1) / kSharedBufferAlignment * kSharedBufferAlignment;
+}
+
+std::vector<uint64_t> GetSharedFileHeader(const PrePackedWeights& packed_weight, HashValue hash) {
+  std::vector<uint64_t> header{kSharedFileMagic, hash, packed_weight.buffer_sizes_.size()};
+  header.insert(header.end(), packed_weight.buffer_sizes_.begin(), packed_weight.buffer_sizes_.end());
+  return header;
+}
+
+Status WriteSharedFile(const std::filesystem::path& file_path, const PrePackedWeights& packed_weight,
+                       HashValue hash) {
+  // write to a process specific file and rename it so that other processes never map a partial file
+  std::filesystem::path temp_path(file_path);
+  temp_path += ToPathString("." + std::to_string(Env::Default().GetSelfPid()) + ".tmp");
+
+  {
+    std::ofstream out(temp_path, std::ios::binary | std::ios::trunc);
+    ORT_RETURN_IF_NOT(out, "Failed to open ", ToUTF8String(temp_path.native()), " for writing.");
+
+    const auto header = GetSharedFileHeader(packed_weight, hash);
+    const size_t header_size = header.size() * sizeof(uint64_t);
+    out.write(reinterpret_cast<const char*>(header.data()), header_size);
+
+    size_t offset = header_size;
+    const char padding[kSharedBufferAlignment] = {};
+    for (size_t i = 0; i < packed_weight.buffers_.size(); ++i) {
+      const size_t aligned_offset = AlignSharedBufferOffset(offset);
+      out.write(padding, aligned_offset - offset);
+      out.write(static_cast<const char*>(packed_weight.buffers_[i].get()), packed_weight.buffer_sizes_[i]);
+      offset = aligned_offset + packed_weight.buffer_sizes_[i];
+    }
+
+    ORT_RETURN_IF_NOT(out.good(), "Failed to write ", ToUTF8String(temp_path.native()));
+  }
+
+  std::error_code ec;
+  std::filesystem::rename(temp_path, file_path, ec);
+  if (ec) {
+    std::filesystem::remove(temp_path, ec);
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Failed to rename ", ToUTF8String(temp_path.native()), " to ",
+                           ToUTF8String(file_path.native()));
+  }
+
+  return Status::OK();
+}
+
+// Maps the file at file_path as mapped_weight if it holds the buffers of packed_weight, whose hash is `hash`.
+Status MapSharedFile(const std::filesystem::path& file_path, const PrePackedWeights& packed_weight, HashValue hash,
+                     PrePackedWeights& mapped_weight) {
+  size_t file_length = 0;
+  ORT_RETURN_IF_ERROR(Env::Default().GetFileLength(file_path.c_str(), file_length));
+
+  const auto header = GetSharedFileHeader(packed_weight, hash);
+  const size_t header_size = header.size() * sizeof(uint64_t);
+  size_t expected_length = header_size;
+  for (size_t buffer_size : packed_weight.buffer_sizes_) {
+    expected_length = AlignSharedBufferOffset(expected_length) + buffer_size;
+  }
+  ORT_RETURN_IF_NOT(file_length == expected_length, "Unexpected length of ", ToUTF8String(file_path.native()));
+
+  Env::MappedMemoryPtr mapped_memory;
+  ORT_RETURN_IF_ERROR(Env::Default().MapFileIntoMemory(file_path.c_str(), 0, file_length, mapped_memory));
+  ORT_RETURN_IF_NOT(std::memcmp(mapped_memory.get(), header.data(), header_size) == 0,
+                    "Unexpected header in ", ToUTF8String(file_path.native()));
+
+  // the buffers keep the mapping alive until the last one of them is released
+  auto mapping = std::make_shared<Env::MappedMemoryPtr>(std::move(mapped_memory));
+  PrePackedWeights weight;
+  size_t offset = header_size;
+  for (size_t i = 0; i < packed_weight.buffers_.size(); ++i) {
+    offset = AlignSharedBufferOffset(offset);
+    if (packed_weight.buffers_[i] == nullptr) {
+      // keep the place-holders so that the hash covers the same buffers
+      weight.buffers_.emplace_back(nullptr, [](void*) {});
+    } else {
+      weight.buffers_.emplace_back(mapping->get() + offset, [mapping](void*) {});
+    }
+    offset += packed_weight.buffer_sizes_[i];
+  }
+  weight.buffer_sizes_ = packed_weight.buffer_sizes_;
+
+  // the header only describes the file, so the data itself is hashed to detect a file that was damaged
+  ORT_RETURN_IF_NOT(weight.GetHash() == hash, "Unexpected data in ", ToUTF8String(file_path.native()));
+
+  mapped_weight = std::move(weight);
+  return Status::OK();
+}
+
+}  // namespace
+
 PrePackedWeights PrePackedWeights::CreateReferringCopy() const {
   PrePackedWeights copy;
   for (const auto& prepacked_buffer : buffers_) {
@@ -61,6 +168,50 @@ size_t PrepackedWeightsContainer::GetNumberOfElements() const {
   return prepacked_weights_map_.size();
 }
 
+Status PrepackedWeightsContainer::SetSharedMemoryDirectory(const PathString& directory) {
+  ORT_RETURN_IF(directory.empty(), "The shared memory directory cannot be empty.");
+
+  if (!shared_memory_directory_.empty()) {
+    ORT_RETURN_IF_NOT(shared_memory_directory_ == directory,
+                      "The pre-packed weights container already uses the shared memory directory ",
+                      ToUTF8String(shared_memory_directory_));
+    return Status::OK();
+  }
+
+  std::error_code ec;
+  std::filesystem::create_directories(directory, ec);
+  ORT_RETURN_IF(ec, "Failed to create the shared memory directory ", ToUTF8String(directory), ": ", ec.message());
+
+  shared_memory_directory_ = directory;
+  return Status::OK();
+}
+
+Status PrepackedWeightsContainer::MapToSharedMemory(const std::string& key, PrePackedWeights& packed_weight) const {
+  if (shared_memory_directory_.empty()) {
+    return Status::OK();
+  }
+
+  // the key contains the hash of the pre-packed buffers. the file also stores it, and its data is checked against
+  // it before use as a file with the same name may have been left by another build or damaged.
+  const std::filesystem::path file_path = std::filesystem::path(shared_memory_directory_) / ToPathString(key);
+  const HashValue hash = packed_weight.GetHash();
+
+  std::error_code ec;
+  if (!std::filesystem::exists(file_path, ec)) {
+    ORT_RETURN_IF_ERROR(WriteSharedFile(file_path, packed_weight, hash));
+  }
+
+  PrePackedWeights mapped_weight;
+  if (!MapSharedFile(file_path, packed_weight, hash, mapped_weight).IsOK()) {
+    // replace the stale file. processes that mapped it keep their mapping of the old file.
+    ORT_RETURN_IF_ERROR(WriteSharedFile(file_path, packed_weight, hash));
+    ORT_RETURN_IF_ERROR(MapSharedFile(file_path, packed_weight, hash, mapped_weight));
+  }
+
+  packed_weight = std::move(mapped_weight);
+  return Status::OK();
+}
+
 void PrepackedWeightsForGraph::InsertPrepackedWeights(const std::string& key, PrePackedWeights&& packed_weight) {
   // We may have duplicate entries mapped from disk if the same weight is pre-packed from subgraphs and
   // up the tree by the same kernel with the same result. The map prevents this from happening.
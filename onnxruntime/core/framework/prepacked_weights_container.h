@@ -4,6 +4,7 @@
 #pragma once
 
 #include "core/common/common.h"
+#include "core/common/path_string.h"
 #include "core/framework/allocator.h"
 #include "prepacked_weights.h"
 
@@ -54,6 +55,21 @@ class PrepackedWeightsContainer final {
   // Returns the number of elements in the container
   size_t GetNumberOfElements() const;
 
+  // Backs the pre-packed weights written to the container with files in the provided directory.
+  // If the directory is on a shared memory file system (e.g.) /dev/shm, processes on the same host
+  // that pre-pack identical weights map a single physical copy of them.
+  // Returns an error if a different directory has already been set.
+  Status SetSharedMemoryDirectory(const PathString& directory);
+
+  // Returns a boolean indicating if pre-packed weights are backed by shared memory files.
+  bool IsSharedMemoryEnabled() const { return !shared_memory_directory_.empty(); }
+
+  // Replaces the buffers of the provided PrePackedWeights instance with read-only mappings of the
+  // shared memory file for the key, creating the file from the buffers first if no process has done so yet.
+  // The key is : op_type + "+" + hash_of_prepacked_buffers_in_the_PrepackedWeights_instance.
+  // The instance is left unchanged on failure or if shared memory is not enabled.
+  Status MapToSharedMemory(const std::string& key, PrePackedWeights& packed_weight) const;
+
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(PrepackedWeightsContainer);
 
   // Resource to be acquired by the method that is going to invoke calls to the kernels'
@@ -71,6 +87,9 @@ class PrepackedWeightsContainer final {
   // to PrePackedWeights instances.
   // The key is : op_type + "+" + hash_of_prepacked_buffers_in_the_PrepackedWeights_instance.
   std::unordered_map<std::string, PrePackedWeights> prepacked_weights_map_;
+
+  // Directory holding the shared memory files. Empty if shared memory is not enabled.
+  PathString shared_memory_directory_;
 };
 
 // Maps a pre-packed weight blob key to PrepackedWeights instance
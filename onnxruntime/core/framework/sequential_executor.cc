@@ -3,6 +3,7 @@
 
 #include "core/framework/sequential_executor.h"
 
+#include <algorithm>
 #include <chrono>
 #include <thread>
 #include <vector>
@@ -430,6 +431,46 @@ class KernelScope {
 #endif
 };
 
+#ifndef NDEBUG
+// Returns true if the shapes are equal after removing leading dimensions of size 1, which do not change the layout.
+static bool HaveSameLayout(const TensorShape& lhs, const TensorShape& rhs) {
+  const auto lhs_dims = lhs.GetDims();
+  const auto rhs_dims = rhs.GetDims();
+  const auto& longer = lhs_dims.size() >= rhs_dims.size() ? lhs_dims : rhs_dims;
+  const auto& shorter = lhs_dims.size() >= rhs_dims.size() ? rhs_dims : lhs_dims;
+  const size_t offset = longer.size() - shorter.size();
+  return std::all_of(longer.begin(), longer.begin() + offset, [](int64_t dim) { return dim == 1; }) &&
+         std::equal(shorter.begin(), shorter.end(), longer.begin() + offset);
+}
+
+// The planner lets an output reuse the buffer of an input the kernel declared with MayInplace based on the shapes
+// it saw at planning time, and the frame only checks that the buffer is large enough. Kernels such as the binary
+// element-wise ops declare both inputs, so check that an input whose buffer was used for an output was not
+// broadcast, i.e. that it has the shape of the output. Otherwise the kernel overwrote elements it still had to read.
+static Status VerifyInplaceOutputs(OpKernelContextInternal& kernel_ctx, const OpKernel& kernel) {
+  for (const auto& [input_idx, output_idx] : kernel.KernelDef().MayInplace()) {
+    if (input_idx >= kernel_ctx.InputCount() || output_idx >= kernel_ctx.OutputCount()) continue;
+
+    const OrtValue* input = kernel_ctx.GetInputMLValue(input_idx);
+    const OrtValue* output = kernel_ctx.GetOutputMLValue(output_idx);
+    if (input == nullptr || output == nullptr || !input->IsTensor() || !output->IsTensor() ||
+        !input->IsAllocated() || !output->IsAllocated()) {
+      continue;
+    }
+
+    const Tensor& input_tensor = input->Get<Tensor>();
+    const Tensor& output_tensor = output->Get<Tensor>();
+    if (input_tensor.DataRaw() == output_tensor.DataRaw() && output_tensor.SizeInBytes() > 0) {
+      ORT_RETURN_IF_NOT(HaveSameLayout(input_tensor.Shape(), output_tensor.Shape()),
+                        "Output ", output_idx, " with shape ", output_tensor.Shape(), " was computed in place in the ",
+                        "buffer of input ", input_idx, " with the different shape ", input_tensor.Shape(), ".");
+    }
+  }
+
+  return Status::OK();
+}
+#endif
+
 onnxruntime::Status ExecuteKernel(StreamExecutionContext& ctx,
                                   NodeIndex idx,
                                   size_t stream_idx,
@@ -445,6 +486,7 @@ onnxruntime::Status ExecuteKernel(StreamExecutionContext& ctx,
     ctx.RecycleNodeInputs(idx);
     return Status::OK();
   }
+  ORT_RETURN_IF_ERROR(ctx.GetSessionState().PrepackKernelOnFirstUse(idx));
   // TODO: set terminate flag from run_option
   OpKernelContextInternal kernel_ctx(ctx.GetSessionState(),
                                      ctx.GetExecutionFrame(),
@@ -557,6 +599,11 @@ onnxruntime::Status ExecuteKernel(StreamExecutionContext& ctx,
       });
     }
   }
+#ifndef NDEBUG
+  if (status.IsOK()) {
+    status = VerifyInplaceOutputs(kernel_ctx, *p_kernel);
+  }
+#endif
   if (!status.IsOK()) {
     std::ostringstream ss;
     const auto& node = p_kernel->Node();
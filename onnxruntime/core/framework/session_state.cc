@@ -231,6 +231,13 @@ const KernelCreateInfo& SessionState::GetNodeKernelCreateInfo(NodeIndex node_ind
   return *entry->second;
 }
 
+// Kernel creation and pre-packing are expensive relative to the thread pool overhead, so schedule one node per task.
+static constexpr double kFinalizationCostPerNode = 1e6;
+
+bool SessionState::IsParallelFinalizationEnabled() const {
+  return sess_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigParallelFinalization, "0") == "1";
+}
+
 Status SessionState::CreateKernels(const KernelRegistryManager& kernel_registry_manager) {
   const auto& nodes = graph_viewer_->Nodes();
   if (!nodes.empty()) {
@@ -240,7 +247,8 @@ Status SessionState::CreateKernels(const KernelRegistryManager& kernel_registry_
     }
     session_kernels_.clear();
     session_kernels_.resize(max_nodeid + 1);
-    for (const auto& node : nodes) {
+
+    auto create_kernel = [this, &kernel_registry_manager](const Node& node) {
       // construct and save the kernels
       const KernelCreateInfo& kci = GetNodeKernelCreateInfo(node.Index());
 
@@ -249,7 +257,33 @@ Status SessionState::CreateKernels(const KernelRegistryManager& kernel_registry_
       const IExecutionProvider& exec_provider = *execution_providers_.Get(exec_provider_name);
 
       // assumes vector is already resize()'ed to the number of nodes in the graph
-      ORT_RETURN_IF_ERROR(kernel_registry_manager.CreateKernel(node, exec_provider, *this, kci, session_kernels_[node.Index()]));
+      return kernel_registry_manager.CreateKernel(node, exec_provider, *this, kci, session_kernels_[node.Index()]);
+    };
+
+    // kernels of other EPs may depend on per thread device state (e.g. the current CUDA device) so only CPU EP
+    // kernels are created on the thread pool.
+    InlinedVector<const Node*> cpu_nodes;
+    const bool parallel_finalization = IsParallelFinalizationEnabled();
+    for (const auto& node : nodes) {
+      if (parallel_finalization && node.GetExecutionProviderType() == kCpuExecutionProvider) {
+        cpu_nodes.push_back(&node);
+      } else {
+        ORT_RETURN_IF_ERROR(create_kernel(node));
+      }
+    }
+
+    if (!cpu_nodes.empty()) {
+      std::vector<Status> statuses(cpu_nodes.size());
+      concurrency::ThreadPool::TryParallelFor(
+          thread_pool_, static_cast<std::ptrdiff_t>(cpu_nodes.size()), kFinalizationCostPerNode,
+          [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+            for (std::ptrdiff_t i = first; i < last; ++i) {
+              statuses[i] = create_kernel(*cpu_nodes[i]);
+            }
+          });
+      for (auto& status : statuses) {
+        ORT_RETURN_IF_ERROR(status);
+      }
     }
   }
   node_index_info_.emplace(*graph_viewer_, ort_value_name_idx_map_);
@@ -418,221 +452,314 @@ static std::string GenerateKeyForPrepackedWeightsMap(const std::string& op_type,
 
 Status SessionState::PrepackConstantInitializedTensors(
     InlinedHashMap<std::string, size_t>& constant_initializers_use_count,
-    const std::unordered_map<std::string, const OrtValue*>& initializers_to_share_map) {
-  auto prepacked_constant_weights = [this, &constant_initializers_use_count, &initializers_to_share_map](
+    const std::unordered_map<std::string, const OrtValue*>& initializers_to_share_map,
+    const Node* node_to_prepack) {
+  // guards the bookkeeping shared between nodes (initializer maps, pre-packed weight containers and counters)
+  // when nodes are pre-packed in parallel. PrePack itself runs without holding it.
+  std::mutex prepack_mutex;
+
+  auto prepacked_constant_weights = [this, &constant_initializers_use_count, &initializers_to_share_map,
+                                     &prepack_mutex](
+                                        const Node& node,
                                         bool should_cache_prepacked_weights_for_shared_initializers) -> Status {
-    for (auto& node : GetGraphViewer().Nodes()) {
-      if (sess_options_.IsLoadCancellationFlagSet()) {
-        return ORT_MAKE_STATUS(ONNXRUNTIME, MODEL_LOAD_CANCELED,
-                               "Weight pre-packing was canceled due to user request.");
-      }
-      auto kernel = GetMutableKernel(node.Index());
-      int input_idx = 0;
-      for (auto& input_def : node.InputDefs()) {
-        if (input_def->Exists()) {
-          const std::string& input_name = input_def->Name();
-          SessionState* st = this;
-          auto* prepacked_for_graph = &graph_.GetPrepacked();
-          // subgraph can use the value from outer scope,
-          // so it needs to check if current node uses constant initialized tensor from current and outer graphs
-          do {
-            int ort_value_idx;
-            if (st->GetOrtValueNameIdxMap().GetIdx(input_name, ort_value_idx).IsOK()) {
-              std::unordered_map<int, OrtValue>& constant_initialized_tensors = st->constant_initialized_tensors_;
-
-              if (constant_initialized_tensors.count(ort_value_idx)) {
-                bool is_packed = false;
-                const Tensor& const_initialized_tensor = constant_initialized_tensors[ort_value_idx].Get<Tensor>();
-
-                auto iter = initializers_to_share_map.find(input_name);
-                bool is_shared_initializer = (iter != initializers_to_share_map.end());
-
-                // Caching pre-packed weights is limited to shared initializers associated with the CPU EP for now
-                if (is_shared_initializer && should_cache_prepacked_weights_for_shared_initializers &&
-                    node.GetExecutionProviderType() == kCpuExecutionProvider) {
-                  // caching of pre-packed weights' turned ON
-
-                  AllocatorPtr allocator_for_caching = prepacked_weights_container_->GetOrCreateAllocator(CPU);
-                  ORT_ENFORCE(allocator_for_caching.get() != nullptr);
-
-                  PrePackedWeights weights_to_be_filled_in;
-                  // The reason we invoke PrePack() before looking into the container for any pre-packed weight
-                  // cached by another instance of the same op_type (for the same constant initializer) is because
-                  // to truly know if we can use a cached pre-packed weight, we would have to compare the cached
-                  // pre-packed  weight with the pre-packed weight generated by this instance of the same op_type
-                  // because other static properties of the node like node attributes could play a role in the
-                  // pre-packed weights' contents.
-                  ORT_RETURN_IF_ERROR(kernel->PrePack(const_initialized_tensor, input_idx, allocator_for_caching,
-                                                      is_packed,
-                                                      &weights_to_be_filled_in));
-
-                  if (is_packed) {
-                    // BUG CHECK: Ensure that the kernel has filled in the pre-packed weight
-                    // to be cached if the weight was pre-packed
-                    ORT_ENFORCE(weights_to_be_filled_in.buffers_.size() > 0,
-                                "The kernel corresponding to the node ", node.Name(),
-                                " doesn't have an implementation that can cache computed pre-packed weights");
-
-                    const auto& op_type = node.OpType();
-
-                    // Sanity check
-                    // TODO: Check if some version of the ONNX IR allows op_type to be empty
-                    ORT_ENFORCE(!op_type.empty(), "The op type of a node cannot be empty");
-
-                    // The key for the pre-packed weights container lookup is the op_type + hash of the prepacked-weight
-                    // that we just got by invoking PrePack() on this kernel.
-
-                    const std::string prepacked_weights_container_key =
-                        GenerateKeyForPrepackedWeightsMap(op_type,
-                                                          weights_to_be_filled_in);
-
-                    bool container_contains_packed_weight = prepacked_weights_container_->HasWeight(
-                        prepacked_weights_container_key);
+    if (sess_options_.IsLoadCancellationFlagSet()) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, MODEL_LOAD_CANCELED,
+                             "Weight pre-packing was canceled due to user request.");
+    }
+    auto kernel = GetMutableKernel(node.Index());
+    int input_idx = 0;
+    for (auto& input_def : node.InputDefs()) {
+      if (input_def->Exists()) {
+        const std::string& input_name = input_def->Name();
+        std::unique_lock<std::mutex> lock(prepack_mutex);
+        SessionState* st = this;
+        auto* prepacked_for_graph = &graph_.GetPrepacked();
+        // subgraph can use the value from outer scope,
+        // so it needs to check if current node uses constant initialized tensor from current and outer graphs
+        do {
+          int ort_value_idx;
+          if (st->GetOrtValueNameIdxMap().GetIdx(input_name, ort_value_idx).IsOK()) {
+            std::unordered_map<int, OrtValue>& constant_initialized_tensors = st->constant_initialized_tensors_;
+
+            if (constant_initialized_tensors.count(ort_value_idx)) {
+              bool is_packed = false;
+              const Tensor& const_initialized_tensor = constant_initialized_tensors[ort_value_idx].Get<Tensor>();
+
+              auto iter = initializers_to_share_map.find(input_name);
+              bool is_shared_initializer = (iter != initializers_to_share_map.end());
+
+              // Caching pre-packed weights is limited to shared initializers associated with the CPU EP for now
+              if (is_shared_initializer && should_cache_prepacked_weights_for_shared_initializers &&
+                  node.GetExecutionProviderType() == kCpuExecutionProvider) {
+                // caching of pre-packed weights' turned ON
+
+                AllocatorPtr allocator_for_caching = prepacked_weights_container_->GetOrCreateAllocator(CPU);
+                ORT_ENFORCE(allocator_for_caching.get() != nullptr);
+
+                PrePackedWeights weights_to_be_filled_in;
+                // The reason we invoke PrePack() before looking into the container for any pre-packed weight
+                // cached by another instance of the same op_type (for the same constant initializer) is because
+                // to truly know if we can use a cached pre-packed weight, we would have to compare the cached
+                // pre-packed  weight with the pre-packed weight generated by this instance of the same op_type
+                // because other static properties of the node like node attributes could play a role in the
+                // pre-packed weights' contents.
+                lock.unlock();
+                ORT_RETURN_IF_ERROR(kernel->PrePack(const_initialized_tensor, input_idx, allocator_for_caching,
+                                                    is_packed,
+                                                    &weights_to_be_filled_in));
+                lock.lock();
 
-                    if (container_contains_packed_weight) {
-                      LOGS(logger_, INFO) << "Using cached version of pre-packed weight for constant initializer: "
-                                          << input_name
-                                          << " used in the node: " << node.Name() << " which is of op type: "
-                                          << node.OpType();
-
-                      const auto& prepacked_shared = prepacked_weights_container_->GetWeight(
-                          prepacked_weights_container_key);
-                      ORT_RETURN_IF_ERROR(KernelUseSharedPrePackedBuffers(*kernel, input_idx,
-                                                                          prepacked_shared,
-                                                                          node.Name()));
-
-                      ++used_shared_pre_packed_weights_counter_;
-
-                      // Write references to what is stored in the shared container
-                      // and release memory mapped entries this container may have loaded from disk
-                      std::ignore = prepacked_for_graph->ReplaceWithReferenceIfSaving(input_name,
-                                                                                      prepacked_weights_container_key,
-                                                                                      prepacked_shared);
-
-                    } else {
-                      // container doesn't contain the pre-packed weight - so write into it for sharing across
-                      // kernel instances
-
-                      // Check if we loaded it from disk, then put it into the shared container so
-                      // everybody can share the same memory mapped entry
-                      // the shared container takes ownership of the memory mapped entries
-
-                      // The next line replaces the existing entry with references to it
-                      // and returns the container that holds the memory mapped entries
-                      // so we can transfer it to shared container.
-                      // if there is not an entry, we replace it with references to weights_to_be_filled_in
-                      // in saving mode and return std::nullopt
-                      auto prepacked_from_disk = prepacked_for_graph->ReplaceWithReferenceIfSaving(
-                          input_name,
-                          prepacked_weights_container_key,
-                          weights_to_be_filled_in);
-
-                      if (prepacked_from_disk.has_value()) {
-                        weights_to_be_filled_in = std::move(*prepacked_from_disk);
-                      }
+                if (is_packed) {
+                  // BUG CHECK: Ensure that the kernel has filled in the pre-packed weight
+                  // to be cached if the weight was pre-packed
+                  ORT_ENFORCE(weights_to_be_filled_in.buffers_.size() > 0,
+                              "The kernel corresponding to the node ", node.Name(),
+                              " doesn't have an implementation that can cache computed pre-packed weights");
 
-                      if (!prepacked_weights_container_->WriteWeight(prepacked_weights_container_key,
-                                                                     std::move(weights_to_be_filled_in))) {
-                        return ORT_MAKE_STATUS(
-                            ONNXRUNTIME, FAIL,
-                            "Unable to write the provided PrePackedWeights instance into the container");
-                      }
+                  const auto& op_type = node.OpType();
 
-                      const auto& shared_prepacked = prepacked_weights_container_->GetWeight(
-                          prepacked_weights_container_key);
-                      ORT_RETURN_IF_ERROR(KernelUseSharedPrePackedBuffers(*kernel, input_idx,
-                                                                          shared_prepacked,
-                                                                          node.Name()));
-                    }
-                  }
+                  // Sanity check
+                  // TODO: Check if some version of the ONNX IR allows op_type to be empty
+                  ORT_ENFORCE(!op_type.empty(), "The op type of a node cannot be empty");
 
-                } else {
-                  // cross session caching of pre-packed weights' turned OFF
-                  // we use serialization container to share weights loaded from disk
-                  // within this session. Or if the weight is not present on disk,
-                  // we store the newly minted pre-packed data.
-
-                  AllocatorPtr session_cpu_alloc = GetAllocator(kernel->Info().GetDevice(OrtMemType::OrtMemTypeDefault));
-                  PrePackedWeights weights_to_be_filled_in;
-                  // The reason we invoke PrePack() before looking into the container for any pre-packed weight
-                  // cached by another instance of the same op_type (for the same constant initializer) is because
-                  // to truly know if we can use a cached pre-packed weight, we would have to compare the cached
-                  // pre-packed weight with the pre-packed weight generated by this instance of the same op_type because
-                  // other static properties of the node like node attributes could play a role in the pre-packed
-                  // weights' contents.
-                  ORT_RETURN_IF_ERROR(kernel->PrePack(const_initialized_tensor, input_idx, session_cpu_alloc,
-                                                      is_packed,
-                                                      &weights_to_be_filled_in));
-
-                  // Some kernels (matmul_nbits and non-CPU related kernels) do not share their pre-packed results
-                  // even though they set is_packed = true so we leave it up to them.
-                  // We can change their behavior if we wish do so in a separate PR
-                  // XXX: Interestingly enough, matmul_nbits does accept shared pre-packs, but does not
-                  // produce them.
-                  if (is_packed && !weights_to_be_filled_in.buffers_.empty()) {
-                    const auto& op_type = node.OpType();
-                    const std::string prepacked_weights_container_key = GenerateKeyForPrepackedWeightsMap(
-                        op_type,
-                        weights_to_be_filled_in);
+                  // The key for the pre-packed weights container lookup is the op_type + hash of the prepacked-weight
+                  // that we just got by invoking PrePack() on this kernel.
+
+                  const std::string prepacked_weights_container_key =
+                      GenerateKeyForPrepackedWeightsMap(op_type,
+                                                        weights_to_be_filled_in);
+
+                  bool container_contains_packed_weight = prepacked_weights_container_->HasWeight(
+                      prepacked_weights_container_key);
 
-                    // See if we can use pre-packed data from disk
-                    const auto* weights_to_use = prepacked_for_graph->GetPrepackedWeights(
+                  if (container_contains_packed_weight) {
+                    LOGS(logger_, INFO) << "Using cached version of pre-packed weight for constant initializer: "
+                                        << input_name
+                                        << " used in the node: " << node.Name() << " which is of op type: "
+                                        << node.OpType();
+
+                    const auto& prepacked_shared = prepacked_weights_container_->GetWeight(
                         prepacked_weights_container_key);
+                    ORT_RETURN_IF_ERROR(KernelUseSharedPrePackedBuffers(*kernel, input_idx,
+                                                                        prepacked_shared,
+                                                                        node.Name()));
+
+                    ++used_shared_pre_packed_weights_counter_;
+
+                    // Write references to what is stored in the shared container
+                    // and release memory mapped entries this container may have loaded from disk
+                    std::ignore = prepacked_for_graph->ReplaceWithReferenceIfSaving(input_name,
+                                                                                    prepacked_weights_container_key,
+                                                                                    prepacked_shared);
+
+                  } else {
+                    // container doesn't contain the pre-packed weight - so write into it for sharing across
+                    // kernel instances
+
+                    // Check if we loaded it from disk, then put it into the shared container so
+                    // everybody can share the same memory mapped entry
+                    // the shared container takes ownership of the memory mapped entries
+
+                    // The next line replaces the existing entry with references to it
+                    // and returns the container that holds the memory mapped entries
+                    // so we can transfer it to shared container.
+                    // if there is not an entry, we replace it with references to weights_to_be_filled_in
+                    // in saving mode and return std::nullopt
+                    auto prepacked_from_disk = prepacked_for_graph->ReplaceWithReferenceIfSaving(
+                        input_name,
+                        prepacked_weights_container_key,
+                        weights_to_be_filled_in);
 
-                    if (weights_to_use == nullptr) {
-                      // In this case pre-packed container owns the data
-                      prepacked_for_graph->WritePackedMaybeForSave(input_name, prepacked_weights_container_key,
-                                                                   std::move(weights_to_be_filled_in));
-                      weights_to_use = prepacked_for_graph->GetPrepackedWeights(prepacked_weights_container_key);
-                      assert(weights_to_use != nullptr);
+                    if (prepacked_from_disk.has_value()) {
+                      weights_to_be_filled_in = std::move(*prepacked_from_disk);
+                    } else if (!prepacked_for_graph->IsSaveModeOn()) {
+                      // let processes on this host map a single copy of the pre-packed weight.
+                      // in save mode references to the buffers are already held so they must stay in place.
+                      auto map_status = prepacked_weights_container_->MapToSharedMemory(
+                          prepacked_weights_container_key, weights_to_be_filled_in);
+                      if (!map_status.IsOK()) {
+                        LOGS(logger_, WARNING) << "Failed to share the pre-packed weight for constant initializer: "
+                                               << input_name << " across processes. "
+                                               << map_status.ErrorMessage();
+                      }
+                    }
+
+                    if (!prepacked_weights_container_->WriteWeight(prepacked_weights_container_key,
+                                                                   std::move(weights_to_be_filled_in))) {
+                      return ORT_MAKE_STATUS(
+                          ONNXRUNTIME, FAIL,
+                          "Unable to write the provided PrePackedWeights instance into the container");
                     }
 
+                    const auto& shared_prepacked = prepacked_weights_container_->GetWeight(
+                        prepacked_weights_container_key);
                     ORT_RETURN_IF_ERROR(KernelUseSharedPrePackedBuffers(*kernel, input_idx,
-                                                                        *weights_to_use,
+                                                                        shared_prepacked,
                                                                         node.Name()));
                   }
                 }
 
-                if (is_packed) {
-                  ++number_of_prepacks_counter_;
-
-                  if (constant_initializers_use_count.count(input_name) && --constant_initializers_use_count[input_name] == 0) {
-                    // release the constant initialized tensor
-                    st->initialized_tensors_.erase(ort_value_idx);
-                    constant_initialized_tensors.erase(ort_value_idx);
+              } else {
+                // cross session caching of pre-packed weights' turned OFF
+                // we use serialization container to share weights loaded from disk
+                // within this session. Or if the weight is not present on disk,
+                // we store the newly minted pre-packed data.
+
+                AllocatorPtr session_cpu_alloc = GetAllocator(kernel->Info().GetDevice(OrtMemType::OrtMemTypeDefault));
+                PrePackedWeights weights_to_be_filled_in;
+                // The reason we invoke PrePack() before looking into the container for any pre-packed weight
+                // cached by another instance of the same op_type (for the same constant initializer) is because
+                // to truly know if we can use a cached pre-packed weight, we would have to compare the cached
+                // pre-packed weight with the pre-packed weight generated by this instance of the same op_type because
+                // other static properties of the node like node attributes could play a role in the pre-packed
+                // weights' contents.
+                lock.unlock();
+                ORT_RETURN_IF_ERROR(kernel->PrePack(const_initialized_tensor, input_idx, session_cpu_alloc,
+                                                    is_packed,
+                                                    &weights_to_be_filled_in));
+                lock.lock();
+
+                // Some kernels (matmul_nbits and non-CPU related kernels) do not share their pre-packed results
+                // even though they set is_packed = true so we leave it up to them.
+                // We can change their behavior if we wish do so in a separate PR
+                // XXX: Interestingly enough, matmul_nbits does accept shared pre-packs, but does not
+                // produce them.
+                if (is_packed && !weights_to_be_filled_in.buffers_.empty()) {
+                  const auto& op_type = node.OpType();
+                  const std::string prepacked_weights_container_key = GenerateKeyForPrepackedWeightsMap(
+                      op_type,
+                      weights_to_be_filled_in);
+
+                  // See if we can use pre-packed data from disk
+                  const auto* weights_to_use = prepacked_for_graph->GetPrepackedWeights(
+                      prepacked_weights_container_key);
+
+                  if (weights_to_use == nullptr) {
+                    // In this case pre-packed container owns the data
+                    prepacked_for_graph->WritePackedMaybeForSave(input_name, prepacked_weights_container_key,
+                                                                 std::move(weights_to_be_filled_in));
+                    weights_to_use = prepacked_for_graph->GetPrepackedWeights(prepacked_weights_container_key);
+                    assert(weights_to_use != nullptr);
                   }
+
+                  ORT_RETURN_IF_ERROR(KernelUseSharedPrePackedBuffers(*kernel, input_idx,
+                                                                      *weights_to_use,
+                                                                      node.Name()));
                 }
               }
-              // stop searching in 2 cases:
-              // 1. value is not from OuterScope
-              // 2. value is from OuterScope and the current OuterScope has the value
-              if (st != this || !st->graph_.IsOuterScopeValue(input_name)) {
-                break;
+
+              if (is_packed) {
+                ++number_of_prepacks_counter_;
+
+                if (constant_initializers_use_count.count(input_name) && --constant_initializers_use_count[input_name] == 0) {
+                  // release the constant initialized tensor
+                  st->initialized_tensors_.erase(ort_value_idx);
+                  constant_initialized_tensors.erase(ort_value_idx);
+                }
               }
             }
-            st = st->Parent();
-            prepacked_for_graph = &st->graph_.GetPrepacked();
-          } while (st);
-        }
-        input_idx++;
+            // stop searching in 2 cases:
+            // 1. value is not from OuterScope
+            // 2. value is from OuterScope and the current OuterScope has the value
+            if (st != this || !st->graph_.IsOuterScopeValue(input_name)) {
+              break;
+            }
+          }
+          st = st->Parent();
+          prepacked_for_graph = &st->graph_.GetPrepacked();
+        } while (st);
       }
+      input_idx++;
     }
 
     return Status::OK();
   };
 
+  auto prepack_nodes = [this, &prepacked_constant_weights, node_to_prepack](
+                           bool should_cache_prepacked_weights_for_shared_initializers) -> Status {
+    if (node_to_prepack != nullptr) {
+      return prepacked_constant_weights(*node_to_prepack, should_cache_prepacked_weights_for_shared_initializers);
+    }
+
+    if (!IsParallelFinalizationEnabled()) {
+      for (auto& node : GetGraphViewer().Nodes()) {
+        ORT_RETURN_IF_ERROR(prepacked_constant_weights(node, should_cache_prepacked_weights_for_shared_initializers));
+      }
+      return Status::OK();
+    }
+
+    // the same initializer is only released after all of its consumers have pre-packed it, so the nodes can be
+    // processed in any order
+    InlinedVector<const Node*> cpu_nodes;
+    for (auto& node : GetGraphViewer().Nodes()) {
+      if (node.GetExecutionProviderType() == kCpuExecutionProvider) {
+        cpu_nodes.push_back(&node);
+      } else {
+        ORT_RETURN_IF_ERROR(prepacked_constant_weights(node, should_cache_prepacked_weights_for_shared_initializers));
+      }
+    }
+
+    std::vector<Status> statuses(cpu_nodes.size());
+    concurrency::ThreadPool::TryParallelFor(
+        thread_pool_, static_cast<std::ptrdiff_t>(cpu_nodes.size()), kFinalizationCostPerNode,
+        [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+          for (std::ptrdiff_t i = first; i < last; ++i) {
+            statuses[i] = prepacked_constant_weights(*cpu_nodes[i],
+                                                     should_cache_prepacked_weights_for_shared_initializers);
+          }
+        });
+    for (auto& status : statuses) {
+      ORT_RETURN_IF_ERROR(status);
+    }
+    return Status::OK();
+  };
+
   bool should_cache_prepacked_weights_for_shared_initializers = (prepacked_weights_container_ != nullptr);
 
   if (should_cache_prepacked_weights_for_shared_initializers) {
     // serialize calls to the method that looks up the container, calls UseCachedPrePackedWeight/PrePack
     // and writes pre-packed weights to the container
     std::lock_guard<std::mutex> l(prepacked_weights_container_->mutex_);
-    return prepacked_constant_weights(true);
+    // create the allocator up front as the container's allocator map is not thread safe
+    ORT_ENFORCE(prepacked_weights_container_->GetOrCreateAllocator(CPU).get() != nullptr);
+
+    const std::string shared_memory_dir = sess_options_.config_options.GetConfigOrDefault(
+        kOrtSessionOptionsConfigPrepackedWeightsSharedMemoryDir, "");
+    if (!shared_memory_dir.empty()) {
+      ORT_RETURN_IF_ERROR(prepacked_weights_container_->SetSharedMemoryDirectory(ToPathString(shared_memory_dir)));
+    }
+    return prepack_nodes(true);
   } else {
-    return prepacked_constant_weights(false);
+    return prepack_nodes(false);
   }
 }
 
+Status SessionState::PrepackKernelOnFirstUse(NodeIndex node_index) const {
+  if (lazy_prepack_once_flags_ == nullptr) {
+    return Status::OK();
+  }
+
+  // the status is kept so that every run of the node sees a failure, not just the first one
+  Status& status = lazy_prepack_statuses_[node_index];
+  std::call_once(lazy_prepack_once_flags_[node_index], [this, node_index, &status]() {
+    // the pre-packed weight containers of the graph are shared with the subgraphs so lock at the root
+    const SessionState* root = this;
+    while (root->parent_ != nullptr) {
+      root = root->parent_;
+    }
+    std::lock_guard<std::mutex> lock(root->lazy_prepack_mutex_);
+
+    // this is the deferred part of FinalizeSessionState, which owns the kernels and initializers.
+    // the original initializers are never released as other nodes may still run unpacked.
+    InlinedHashMap<std::string, size_t> constant_initializers_use_count;
+    status = const_cast<SessionState*>(this)->PrepackConstantInitializedTensors(
+        constant_initializers_use_count, sess_options_.initializers_to_share_map,
+        graph_viewer_->GetNode(node_index));
+  });
+
+  return status;
+}
+
 static int64_t
 CalculateMemoryPatternsKey(const gsl::span<const OrtValue>& tensor_inputs) {
   int64_t key = 0;
@@ -1645,9 +1772,19 @@ Status SessionState::FinalizeSessionStateImpl(const std::basic_string<PATH_CHAR_
 
   ORT_RETURN_IF_ERROR(CreateKernels(kernel_registry_manager));
 
+  const bool lazy_prepacking =
+      session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigLazyPrepacking, "0") == "1" &&
+      remove_initializers && !save_prepacked_initializers;
+
   if (!disable_prepacking) {
-    ORT_RETURN_IF_ERROR(PrepackConstantInitializedTensors(constant_initializers_use_count,
-                                                          session_options.initializers_to_share_map));
+    if (lazy_prepacking) {
+      // kernels pre-pack on their first run. see PrepackKernelOnFirstUse.
+      lazy_prepack_once_flags_ = std::make_unique<std::once_flag[]>(session_kernels_.size());
+      lazy_prepack_statuses_ = std::make_unique<Status[]>(session_kernels_.size());
+    } else {
+      ORT_RETURN_IF_ERROR(PrepackConstantInitializedTensors(constant_initializers_use_count,
+                                                            session_options.initializers_to_share_map));
+    }
   }
 
   ORT_RETURN_IF_ERROR(
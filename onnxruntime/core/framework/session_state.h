@@ -331,6 +331,12 @@ class SessionState {
     return number_of_prepacks_counter_;
   }
 
+  /**
+   * Pre-packs the constant initializers of the node the first time it is called for it if lazy pre-packing is
+   * enabled. see kOrtSessionOptionsConfigLazyPrepacking. Must be called before the kernel computes.
+   */
+  Status PrepackKernelOnFirstUse(NodeIndex node_index) const;
+
   size_t GetUsedSharedPrePackedWeightCounter() const {
     return used_shared_pre_packed_weights_counter_;
   }
@@ -402,6 +408,10 @@ class SessionState {
   // create kernels using info in kernel_create_info_map_
   Status CreateKernels(const KernelRegistryManager& custom_registry_manager);
 
+  // whether CPU kernels are created and pre-packed on the intra-op thread pool.
+  // see kOrtSessionOptionsConfigParallelFinalization.
+  bool IsParallelFinalizationEnabled() const;
+
   // remove TensorProto versions of initializers from Graph instance
   // (replaced byOrtValue instances in initialized_tensors_)
   void CleanInitializedTensorsFromGraph();
@@ -411,7 +421,8 @@ class SessionState {
    * The original constant initialized tensors will be removed to save memory.
    */
   Status PrepackConstantInitializedTensors(InlinedHashMap<std::string, size_t>& constant_initializers_use_count,
-                                           const std::unordered_map<std::string, const OrtValue*>& initializers_to_share_map);
+                                           const std::unordered_map<std::string, const OrtValue*>& initializers_to_share_map,
+                                           const Node* node_to_prepack = nullptr);
 
   SessionState* GetMutableSubgraphSessionState(onnxruntime::NodeIndex index, const std::string& attribute_name);
 
@@ -593,6 +604,14 @@ class SessionState {
   // a constant initialized weight was used by the session state
   size_t used_shared_pre_packed_weights_counter_ = 0;
 
+  // Set when lazy pre-packing is enabled. Indexed by NodeIndex.
+  std::unique_ptr<std::once_flag[]> lazy_prepack_once_flags_;
+  // Result of the lazy pre-packing of each node, returned on every call of PrepackKernelOnFirstUse.
+  // Only written under the once flag of the node.
+  std::unique_ptr<Status[]> lazy_prepack_statuses_;
+  // Serializes lazy pre-packing of the nodes in this graph and all subgraphs. Only used in the root session state.
+  mutable std::mutex lazy_prepack_mutex_;
+
 #ifdef DEBUG_NODE_INPUTS_OUTPUTS
   // Counter for number of times the session graph has been executed
   size_t graph_executions_counter_ = 0;
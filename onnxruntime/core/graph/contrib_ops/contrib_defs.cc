@@ -631,6 +631,85 @@ ONNX_MS_OPERATOR_SET_SCHEMA(
           return true;
         }));
 
+constexpr const char* FusedElementwise_ver1_doc = R"DOC(
+Applies a chain of element-wise operators in a single pass over memory.
+The running value starts as input 0 and each entry of 'ops' updates it in turn. Binary operators take their other
+operand from the input at the index given in 'operands', or from 'immediates' if that index is -1.
+'chain_is_rhs' is 1 for a Sub or Div whose running value is the right-hand side.
+All inputs must have the same number of elements as input 0. The output has the shape of input 0.
+Produced by the ElementwiseChainFusion transformer.)DOC";
+ONNX_MS_OPERATOR_SET_SCHEMA(
+    FusedElementwise, 1,
+    OpSchema()
+        .SetDomain(kMSDomain)
+        .SinceVersion(1)
+        .SetDoc(FusedElementwise_ver1_doc)
+        .Attr("ops",
+              "The ONNX operator applied by each step. One of Add, Sub, Mul, Div, Relu, Sigmoid, Tanh, Exp, Log, "
+              "Sqrt, Neg, Abs and Reciprocal.",
+              AttributeProto::STRINGS)
+        .Attr("operands", "Index of the input holding the other operand of each binary step, -1 for an immediate.",
+              AttributeProto::INTS)
+        .Attr("immediates", "The immediate operand of each step.", AttributeProto::FLOATS)
+        .Attr("chain_is_rhs", "1 if the running value is the right-hand operand of the step.", AttributeProto::INTS)
+        .Input(0, "X", "The input the chain starts from.", "T")
+        .Input(1, "operands", "The tensor operands of the binary steps.", "T", OpSchema::Variadic,
+               /*is_homogeneous*/ true, /*min_arity*/ 0)
+        .Output(0, "Y", "The output.", "T")
+        .TypeConstraint("T", {"tensor(float)"}, "Constrain input and output types to float tensors.")
+        .TypeAndShapeInferenceFunction(ONNX_NAMESPACE::propagateShapeAndTypeFromFirstInput));
+
+constexpr const char* EmbeddingBag_ver1_doc = R"DOC(
+Sums or averages the rows of an embedding table selected by each bag of indices, without materializing the
+gathered rows. The last dimension of 'indices' is the bag; the output replaces it with the embedding dimension.
+Each row may be weighted by the matching value of 'per_sample_weights'. An int8 table is dequantized with one
+scale per row from 'scales'.
+Equivalent to Gather(axis=0) followed by ReduceSum or ReduceMean over the bag axis with keepdims=0, and produced
+from that pattern by the EmbeddingBagFusion transformer.)DOC";
+ONNX_MS_OPERATOR_SET_SCHEMA(
+    EmbeddingBag, 1,
+    OpSchema()
+        .SetDomain(kMSDomain)
+        .SinceVersion(1)
+        .SetDoc(EmbeddingBag_ver1_doc)
+        .Attr("mode", "How the rows of a bag are combined: 'sum' or 'mean'.", AttributeProto::STRING,
+              std::string("sum"))
+        .Input(0, "table", "The embedding table of shape [num_rows, dim].", "T1")
+        .Input(1, "indices", "The rows to combine. The last dimension is the bag. Negative values count from the end.",
+               "Tind")
+        .Input(2, "per_sample_weights", "Optional weight of each index, with the same number of elements as indices.",
+               "T2", OpSchema::Optional)
+        .Input(3, "scales", "Optional scale of each table row of shape [num_rows]. Required for an int8 table.", "T2",
+               OpSchema::Optional)
+        .Output(0, "output", "The combined rows of shape indices.shape[:-1] + [dim].", "T2")
+        .TypeConstraint("T1", {"tensor(float)", "tensor(float16)", "tensor(int8)"},
+                        "Constrain the table to float, float16 or int8 tensors.")
+        .TypeConstraint("T2", {"tensor(float)"}, "Constrain weights, scales and output to float tensors.")
+        .TypeConstraint("Tind", {"tensor(int32)", "tensor(int64)"}, "Constrain indices to integer tensors.")
+        .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+          using namespace ONNX_NAMESPACE;
+          updateOutputElemType(ctx, 0, TensorProto::FLOAT);
+          if (!hasInputShape(ctx, 0) || !hasInputShape(ctx, 1)) {
+            return;
+          }
+
+          const auto& table_shape = getInputShape(ctx, 0);
+          const auto& indices_shape = getInputShape(ctx, 1);
+          if (table_shape.dim_size() != 2) {
+            fail_shape_inference("table must be 2-D");
+          }
+          if (indices_shape.dim_size() < 1) {
+            fail_shape_inference("indices must have at least one dimension");
+          }
+
+          TensorShapeProto output_shape;
+          for (int i = 0; i < indices_shape.dim_size() - 1; ++i) {
+            *output_shape.add_dim() = indices_shape.dim(i);
+          }
+          *output_shape.add_dim() = table_shape.dim(1);
+          updateOutputShape(ctx, 0, output_shape);
+        }));
+
 // Used to be ONNX 1.7 Inverse(12)
 // Comment out docs not to increase the binary size
 //
@@ -16,6 +16,7 @@
 #include "core/common/inlined_containers.h"
 #include "core/common/logging/logging.h"
 #include "core/common/narrow.h"
+#include "core/common/safeint.h"
 #include "core/flatbuffers/flatbuffers_utils.h"
 #include "core/framework/tensor_type_and_shape.h"
 #include "core/flatbuffers/schema/ort.fbs.h"
@@ -994,6 +995,7 @@ void Node::CreateSubgraph(const std::string& attr_name) {
 
 void Node::AddAttributeProto(AttributeProto value) {
   utils::SetNodeAttribute(std::move(value), attributes_);
+  ++attributes_version_;
   if (graph_) {
     graph_->SetGraphResolveNeeded();
     graph_->SetGraphProtoSyncNeeded();
@@ -1044,6 +1046,7 @@ void Node::AddAttribute(std::string attr_name, GraphProto value) {
 bool Node::ClearAttribute(const std::string& attr_name) {
   graph_->SetGraphResolveNeeded();
   graph_->SetGraphProtoSyncNeeded();
+  ++attributes_version_;
   return attributes_.erase(attr_name) > 0;
 }
 
@@ -1052,6 +1055,7 @@ bool Node::ClearAttribute(const std::string& attr_name) {
 int Node::PruneRemovableAttributes(gsl::span<const std::string> removable_attributes) {
   graph_->SetGraphResolveNeeded();
   graph_->SetGraphProtoSyncNeeded();
+  ++attributes_version_;
   int n_removed = 0;
   for (const auto& name : removable_attributes) {
     n_removed += static_cast<int>(attributes_.erase(name));
@@ -1965,6 +1969,228 @@ void Graph::KahnsTopologicalSort(const std::function<void(const Node*)>& enter,
   }
 }
 
+namespace {
+
+// Tracks the bytes of the node outputs that are alive while simulating running the nodes of a graph in some order.
+class ActivationLifetimes {
+ public:
+  explicit ActivationLifetimes(const Graph& graph) {
+    for (const auto& node : graph.Nodes()) {
+      for (const NodeArg* output : node.OutputDefs()) {
+        if (output->Exists()) {
+          values_[output] = ValueInfo{EstimateBytes(*output), 0};
+        }
+      }
+    }
+
+    for (const auto& node : graph.Nodes()) {
+      for (const NodeArg* input : ProducedInputs(node)) {
+        ++values_[input].remaining_uses;
+      }
+    }
+
+    // graph outputs stay alive until the end
+    for (const NodeArg* output : graph.GetOutputs()) {
+      auto it = values_.find(output);
+      if (it != values_.end()) {
+        ++it->second.remaining_uses;
+      }
+    }
+  }
+
+  // The change in the alive bytes if node runs next.
+  int64_t DeltaIfRun(const Node& node) const {
+    int64_t delta = 0;
+    for (const NodeArg* output : node.OutputDefs()) {
+      if (output->Exists()) {
+        delta += static_cast<int64_t>(values_.at(output).bytes);
+      }
+    }
+
+    for (const NodeArg* input : ProducedInputs(node)) {
+      const auto& info = values_.at(input);
+      if (info.remaining_uses == 1) {
+        delta -= static_cast<int64_t>(info.bytes);
+      }
+    }
+
+    return delta;
+  }
+
+  void Run(const Node& node) {
+    // the outputs are allocated while the inputs are still alive
+    for (const NodeArg* output : node.OutputDefs()) {
+      if (output->Exists()) {
+        alive_bytes_ += values_.at(output).bytes;
+      }
+    }
+
+    peak_bytes_ = std::max(peak_bytes_, alive_bytes_);
+
+    for (const NodeArg* input : ProducedInputs(node)) {
+      auto& info = values_.at(input);
+      if (--info.remaining_uses == 0) {
+        alive_bytes_ -= info.bytes;
+      }
+    }
+
+    for (const NodeArg* output : node.OutputDefs()) {
+      if (output->Exists() && values_.at(output).remaining_uses == 0) {
+        alive_bytes_ -= values_.at(output).bytes;
+      }
+    }
+  }
+
+  size_t PeakBytes() const { return peak_bytes_; }
+
+ private:
+  struct ValueInfo {
+    size_t bytes;
+    size_t remaining_uses;
+  };
+
+  // Unknown and symbolic dimensions count as 1. Values without a tensor type count as 0 bytes.
+  static size_t EstimateBytes(const NodeArg& node_arg) {
+    const auto* type = node_arg.TypeAsProto();
+    if (type == nullptr || !utils::HasTensorType(*type) ||
+        type->tensor_type().elem_type() == ONNX_NAMESPACE::TensorProto_DataType_UNDEFINED) {
+      return 0;
+    }
+
+    size_t bytes = DataTypeImpl::TensorTypeFromONNXEnum(type->tensor_type().elem_type())->GetElementType()->Size();
+    if (const auto* shape = node_arg.Shape(); shape != nullptr) {
+      for (const auto& dim : shape->dim()) {
+        if (utils::HasDimValue(dim) && dim.dim_value() > 0) {
+          bytes = SafeInt<size_t>(bytes) * static_cast<size_t>(dim.dim_value());
+        }
+      }
+    }
+
+    return bytes;
+  }
+
+  // The distinct explicit and implicit inputs of node that are produced by a node.
+  InlinedVector<const NodeArg*> ProducedInputs(const Node& node) const {
+    InlinedVector<const NodeArg*> inputs;
+    auto add_input = [&](const NodeArg* input) {
+      if (input->Exists() && values_.count(input) != 0 &&
+          std::find(inputs.begin(), inputs.end(), input) == inputs.end()) {
+        inputs.push_back(input);
+      }
+    };
+
+    for (const NodeArg* input : node.InputDefs()) {
+      add_input(input);
+    }
+
+    for (const NodeArg* input : node.ImplicitInputDefs()) {
+      add_input(input);
+    }
+
+    return inputs;
+  }
+
+  InlinedHashMap<const NodeArg*, ValueInfo> values_;
+  size_t alive_bytes_{0};
+  size_t peak_bytes_{0};
+};
+
+}  // namespace
+
+size_t Graph::MemoryAwareTopologicalSort(const std::function<bool(const Node*, const Node*)>& comp,
+                                         std::vector<NodeIndex>& node_orders) const {
+  ActivationLifetimes lifetimes(*this);
+  InlinedVector<size_t> in_degree(MaxNodeIndex(), 0);
+  // 1 + the position of the latest visited producer of an input of each node, 0 if there is none
+  InlinedVector<size_t> latest_input_position(MaxNodeIndex(), 0);
+  InlinedVector<const Node*> ready;
+
+  for (auto& node : Nodes()) {
+    size_t input_edge_count = node.GetInputEdgesCount();
+    in_degree[node.Index()] = input_edge_count;
+    if (input_edge_count == 0) {
+      ready.push_back(&node);
+    }
+  }
+
+  node_orders.clear();
+  node_orders.reserve(NumberOfNodes());
+
+  // The delta of a ready node only changes when another consumer of one of its inputs runs, so the deltas are cached
+  // and recomputed for those nodes only. Ready lists are short in practice, as they are bounded by the number of
+  // independent branches, so they are scanned on each step.
+  InlinedVector<int64_t> cached_delta(MaxNodeIndex(), 0);
+  InlinedVector<uint8_t> delta_is_stale(MaxNodeIndex(), 1);
+  auto delta_if_run = [&](const Node& node) {
+    if (delta_is_stale[node.Index()]) {
+      cached_delta[node.Index()] = lifetimes.DeltaIfRun(node);
+      delta_is_stale[node.Index()] = 0;
+    }
+
+    return cached_delta[node.Index()];
+  };
+
+  while (!ready.empty()) {
+    size_t best = 0;
+    int64_t best_delta = delta_if_run(*ready[0]);
+    for (size_t i = 1; i < ready.size(); ++i) {
+      const Node* candidate = ready[i];
+      const Node* current = ready[best];
+      const int64_t delta = delta_if_run(*candidate);
+      const size_t candidate_position = latest_input_position[candidate->Index()];
+      const size_t current_position = latest_input_position[current->Index()];
+      if (delta < best_delta ||
+          (delta == best_delta &&
+           (candidate_position > current_position ||
+            (candidate_position == current_position && comp(current, candidate))))) {
+        best = i;
+        best_delta = delta;
+      }
+    }
+
+    const Node* current = ready[best];
+    ready[best] = ready.back();
+    ready.pop_back();
+
+    lifetimes.Run(*current);
+    node_orders.push_back(current->Index());
+
+    // the remaining uses of the inputs of current changed, which affects the deltas of their other consumers
+    for (auto input_edge_it = current->InputEdgesBegin(); input_edge_it != current->InputEdgesEnd(); ++input_edge_it) {
+      const Node& producer = input_edge_it->GetNode();
+      for (auto edge_it = producer.OutputEdgesBegin(); edge_it != producer.OutputEdgesEnd(); ++edge_it) {
+        delta_is_stale[edge_it->GetNode().Index()] = 1;
+      }
+    }
+
+    for (auto edge_it = current->OutputEdgesBegin(); edge_it != current->OutputEdgesEnd(); ++edge_it) {
+      const Node& next = edge_it->GetNode();
+      latest_input_position[next.Index()] = node_orders.size();
+      if (--in_degree[next.Index()] == 0) {
+        ready.push_back(&next);
+      }
+    }
+  }
+
+  if (NumberOfNodes() != static_cast<int>(node_orders.size())) {
+    ORT_THROW("Some nodes are not included in the topological sort, graph have a cycle.");
+  }
+
+  return lifetimes.PeakBytes();
+}
+
+size_t Graph::EstimatePeakActivationBytes(gsl::span<const NodeIndex> node_orders) const {
+  ActivationLifetimes lifetimes(*this);
+  for (NodeIndex node_index : node_orders) {
+    const Node* node = GetNode(node_index);
+    if (node != nullptr) {
+      lifetimes.Run(*node);
+    }
+  }
+
+  return lifetimes.PeakBytes();
+}
+
 #ifdef ENABLE_TRAINING
 
 namespace {
@@ -2445,9 +2671,13 @@ void Graph::MemoryEfficientTopologicalSort(const Node* yield_op,
 GSL_SUPPRESS(es .84)  // noisy warning about ignoring return value from insert(...)
 Status Graph::PerformTopologicalSortAndCheckIsAcyclic() {
   nodes_in_topological_order_.clear();
-  std::unordered_set<NodeIndex> downstream_nodes;  // nodes downstream of the node we're currently checking
-  std::unordered_set<NodeIndex> nodes_seen;        // nodes we have seen but may not have been added to nodes_added yet
-  std::unordered_set<NodeIndex> nodes_added;       // nodes added to topo order
+  nodes_in_topological_order_.reserve(static_cast<size_t>(num_of_nodes_));
+
+  // per node state indexed by NodeIndex. flat vectors are used instead of hash sets as this runs in every Resolve.
+  const size_t max_node_index = MaxNodeIndex();
+  std::vector<bool> downstream_nodes(max_node_index);  // nodes downstream of the node we're currently checking
+  std::vector<bool> nodes_seen(max_node_index);        // nodes we have seen but may not have been added yet
+  std::vector<bool> nodes_added(max_node_index);       // nodes added to topo order
   std::stack<NodeIndex> stack;
 
   // push the root nodes into nodes_in_topological_order in the order they were defined in the model
@@ -2469,8 +2699,8 @@ Status Graph::PerformTopologicalSortAndCheckIsAcyclic() {
                   if (!has_inputs) {
                     // add to the topological list, and ensure we skip these nodes when walking the graph
                     nodes_in_topological_order_.push_back(index);
-                    nodes_added.insert(index);
-                    nodes_seen.insert(index);
+                    nodes_added[index] = true;
+                    nodes_seen[index] = true;
                   }
                 });
 
@@ -2486,16 +2716,16 @@ Status Graph::PerformTopologicalSortAndCheckIsAcyclic() {
     const NodeIndex current = stack.top();
     stack.pop();
 
-    if (nodes_added.find(current) != nodes_added.end()) {
+    if (nodes_added[current]) {
       continue;
     }
 
-    if (nodes_seen.find(current) != nodes_seen.end()) {
+    if (nodes_seen[current]) {
       // we popped the stack and are back to a node that was seen previously,
       // so we know all the upstream nodes from it have been added.
       nodes_in_topological_order_.push_back(current);
-      nodes_added.insert(current);
-      downstream_nodes.erase(current);
+      nodes_added[current] = true;
+      downstream_nodes[current] = false;
       continue;
     }
 
@@ -2506,22 +2736,22 @@ Status Graph::PerformTopologicalSortAndCheckIsAcyclic() {
 
     // node hasn't been seen before, so mark it as seen and re-add it along with its inputs
     // also mark it as downstream of anything new that is added to the stack to detect acyclic graphs
-    nodes_seen.insert(current);
-    downstream_nodes.insert(current);
+    nodes_seen[current] = true;
+    downstream_nodes[current] = true;
 
     stack.push(current);
 
     for (auto iter = node->InputNodesBegin(), end = node->InputNodesEnd(); iter != end; ++iter) {
       const NodeIndex idx = iter->Index();
       // the input to this node is also downstream of this node
-      if (downstream_nodes.find(idx) != downstream_nodes.end()) {
+      if (downstream_nodes[idx]) {
         Status status(ONNXRUNTIME, onnxruntime::common::StatusCode::FAIL,
                       "This is an invalid model. Error: the graph is not acyclic.");
         return status;
       }
 
       // avoid re-processing nodes
-      if (nodes_seen.find(idx) == nodes_seen.end()) {
+      if (!nodes_seen[idx]) {
         stack.push(idx);
       }
     }
@@ -3111,6 +3341,73 @@ common::Status Graph::TypeCheckInputsAndInitializers() {
   return Status::OK();
 }
 
+std::string Graph::GetInferenceSignature(const Node& node) const {
+  // constant initializers up to this size are included by value as inferencing may read them (e.g. a Reshape shape).
+  // larger ones are included by a hash of their contents to keep the signature small.
+  constexpr size_t kMaxInitializerSignatureBytes = 1024;
+
+  std::string signature;
+  auto append_value = [&signature](const auto& value) {
+    signature.append(reinterpret_cast<const char*>(&value), sizeof(value));
+  };
+  auto append_message = [&signature, &append_value](const google::protobuf::MessageLite& message) {
+    append_value(message.ByteSizeLong());
+    message.AppendToString(&signature);
+  };
+
+  append_value(node.op_);
+  append_value(node.since_version_);
+  append_value(node.attributes_version_);
+
+  for (const auto* input_def : node.InputDefs()) {
+    append_value(input_def);
+    if (input_def == nullptr || !input_def->Exists()) {
+      continue;
+    }
+
+    signature.append(input_def->Name()).push_back('\0');
+    const auto* type = input_def->TypeAsProto();
+    append_value(type != nullptr);
+    if (type != nullptr) {
+      append_message(*type);
+    }
+
+    const TensorProto* initializer = GetConstantInitializer(input_def->Name(), false);
+    append_value(initializer);
+    if (initializer != nullptr) {
+      // external data is identified by its location in the message, which is small.
+      if (utils::HasExternalData(*initializer) || initializer->ByteSizeLong() <= kMaxInitializerSignatureBytes) {
+        append_message(*initializer);
+      } else {
+        append_value(initializer->data_type());
+        for (const auto dim : initializer->dims()) {
+          append_value(dim);
+        }
+
+        // hash raw data in place. other storage is serialized first.
+        if (utils::HasRawData(*initializer)) {
+          append_value(std::hash<std::string_view>{}(initializer->raw_data()));
+        } else {
+          append_value(std::hash<std::string>{}(initializer->SerializeAsString()));
+        }
+      }
+    }
+  }
+
+  for (const auto* output_def : node.OutputDefs()) {
+    append_value(output_def);
+    if (output_def != nullptr && output_def->Exists()) {
+      const auto* type = output_def->TypeAsProto();
+      append_value(type != nullptr);
+      if (type != nullptr) {
+        append_message(*type);
+      }
+    }
+  }
+
+  return signature;
+}
+
 Status Graph::VerifyNodeAndOpMatch(const ResolveOptions& options) {
   CheckerContext ctx;
   ctx.set_ir_version(gsl::narrow_cast<int>(IrVersion()));
@@ -3232,7 +3529,16 @@ Status Graph::VerifyNodeAndOpMatch(const ResolveOptions& options) {
       }
     }
 
-    NO_CHANGE_ON_SYNC_FLAG(ORT_RETURN_IF_ERROR(InferAndVerifyTypeMatch(node, *p_op, options)));
+    // Type/shape inferencing is the dominant cost of re-resolving a large graph after a transformer made a local
+    // change. Skip it for nodes whose inputs, outputs and attributes are unchanged since it last ran.
+    // Subgraphs are always inferred as they depend on the outer scope, and override_types may change outputs.
+    const bool incremental_inferencing = parent_graph_ == nullptr && !options.override_types &&
+                                         !node.ContainsSubgraph();
+    if (!incremental_inferencing || node.inference_signature_.empty() ||
+        node.inference_signature_ != GetInferenceSignature(node)) {
+      NO_CHANGE_ON_SYNC_FLAG(ORT_RETURN_IF_ERROR(InferAndVerifyTypeMatch(node, *p_op, options)));
+      node.inference_signature_ = incremental_inferencing ? GetInferenceSignature(node) : std::string();
+    }
 
     // Accumulate output names of the iterated Node
     for (const auto& output : node.OutputDefs()) {
@@ -3517,6 +3823,10 @@ void Graph::RemoveInitializedTensor(const std::string& tensor_name) {
     // doesn't matter if it existed or not
     ORT_IGNORE_RETURN_VALUE(ortvalue_initializers_.erase(tensor_name));
 
+#if !defined(ORT_MINIMAL_BUILD)
+    replaced_initializer_names_.insert(tensor_name);
+#endif
+
     SetGraphResolveNeeded();
   } else {
 #if !defined(DISABLE_SPARSE_TENSORS)
@@ -3574,6 +3884,7 @@ Status Graph::ReplaceInitializedTensorImpl(ONNX_NAMESPACE::TensorProto new_initi
               "graph_proto_ is not in sync with name_to_initial_tensor_");
 
   **existing_entry = std::move(new_initializer);
+  replaced_initializer_names_.insert(name_to_initializer_it->first);
 
   return Status::OK();
 }
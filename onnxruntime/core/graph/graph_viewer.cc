@@ -148,6 +148,7 @@ GraphViewer::GraphViewer(const Graph& graph, const IndexedSubGraph* filter_info)
                 "Topological sort failed.", node_orders.size(), "!=", num_of_nodes);
     nodes_in_mem_efficient_topological_order_ = std::move(node_orders);
   } else {
+    // training keeps the default order for graphs without a YieldOp
     nodes_in_mem_efficient_topological_order_ = nodes_in_topological_order_;
   }
 #endif
@@ -321,10 +322,26 @@ const std::vector<NodeIndex>& GraphViewer::GetNodesInTopologicalOrder(ExecutionO
       ORT_THROW("Priority based topological order is not enabled for ORT minimal build.");
 #endif
     case ExecutionOrder::MEMORY_EFFICIENT:
-#ifdef ENABLE_TRAINING
+#if !defined(ORT_MINIMAL_BUILD)
+      std::call_once(mem_efficient_topological_order_once_, [this]() {
+        // the training build sets the order in the constructor
+        if (!nodes_in_mem_efficient_topological_order_.empty()) {
+          return;
+        }
+
+        std::vector<NodeIndex> node_orders;
+        graph_->MemoryAwareTopologicalSort(PriorityNodeCompare(), node_orders);
+        if (filter_info_) {
+          std::copy_if(node_orders.cbegin(), node_orders.cend(),
+                       std::back_inserter(nodes_in_mem_efficient_topological_order_),
+                       [this](NodeIndex idx) { return filtered_node_indices_.count(idx) != 0; });
+        } else {
+          nodes_in_mem_efficient_topological_order_ = std::move(node_orders);
+        }
+      });
       return nodes_in_mem_efficient_topological_order_;
 #else
-      ORT_THROW("Memory efficient topological order is not enabled for non-training build.");
+      ORT_THROW("Memory efficient topological order is not enabled for ORT minimal build.");
 #endif
     default:
       ORT_THROW("Invalid ExecutionOrder");
@@ -0,0 +1,220 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/elementwise_chain_fusion.h"
+
+#include <algorithm>
+#include <array>
+
+#include "core/graph/graph_utils.h"
+#include "core/optimizer/initializer.h"
+#include "core/optimizer/utils.h"
+
+using namespace ONNX_NAMESPACE;
+using namespace onnxruntime::common;
+
+namespace onnxruntime {
+
+namespace {
+
+bool IsSupportedBinaryOp(const Node& node) {
+  return graph_utils::IsSupportedOptypeVersionAndDomain(node, "Add", {7, 13, 14}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Sub", {7, 13, 14}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Mul", {7, 13, 14}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Div", {7, 13, 14});
+}
+
+bool IsSupportedUnaryOp(const Node& node) {
+  return graph_utils::IsSupportedOptypeVersionAndDomain(node, "Relu", {6, 13, 14}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Sigmoid", {6, 13}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Tanh", {6, 13}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Exp", {6, 13}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Log", {6, 13}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Sqrt", {6, 13}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Neg", {6, 13}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Abs", {6, 13}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Reciprocal", {6, 13});
+}
+
+bool IsFloatTensor(const NodeArg& arg) {
+  const auto* type = arg.TypeAsProto();
+  return type != nullptr && type->has_tensor_type() &&
+         type->tensor_type().elem_type() == TensorProto_DataType_FLOAT;
+}
+
+// Returns true if the shapes are known to be equal, treating dimensions with the same name as equal.
+bool SameShape(const TensorShapeProto& shape1, const TensorShapeProto& shape2) {
+  if (shape1.dim_size() != shape2.dim_size()) return false;
+
+  for (int i = 0; i < shape1.dim_size(); ++i) {
+    const auto& dim1 = shape1.dim(i);
+    const auto& dim2 = shape2.dim(i);
+    if (utils::HasDimValue(dim1) && utils::HasDimValue(dim2) && dim1.dim_value() == dim2.dim_value()) continue;
+    if (utils::HasDimParam(dim1) && utils::HasDimParam(dim2) && dim1.dim_param() == dim2.dim_param()) continue;
+    return false;
+  }
+
+  return true;
+}
+
+// One step of the fused chain.
+struct ChainStep {
+  Node* node;
+  NodeArg* operand;  // tensor operand of a binary op, nullptr if unary or the operand is an immediate
+  float immediate;
+  bool chain_is_rhs;
+};
+
+// Checks if node can apply the next step to the chain value which it consumes at input index chain_input_index.
+bool GetChainStep(const Graph& graph, Node& node, int chain_input_index, const TensorShapeProto& chain_shape,
+                  const InlinedHashSet<std::string_view>& compatible_providers, ChainStep& step) {
+  if (!graph_utils::IsSupportedProvider(node, compatible_providers) ||
+      !IsFloatTensor(*node.OutputDefs()[0])) {
+    return false;
+  }
+
+  // the output must have the shape of the chain, which also rules out broadcasting the chain value
+  const auto* output_shape = node.OutputDefs()[0]->Shape();
+  if (output_shape == nullptr || !SameShape(*output_shape, chain_shape)) {
+    return false;
+  }
+
+  step = ChainStep{&node, nullptr, 0.0f, false};
+  if (IsSupportedUnaryOp(node)) {
+    return true;
+  }
+
+  if (!IsSupportedBinaryOp(node)) {
+    return false;
+  }
+
+  step.chain_is_rhs = chain_input_index == 1;
+  NodeArg& other = *node.MutableInputDefs()[chain_input_index == 0 ? 1 : 0];
+  if (!IsFloatTensor(other)) {
+    return false;
+  }
+
+  if (optimizer_utils::IsScalar(other)) {
+    const TensorProto* tensor_proto = graph_utils::GetConstantInitializer(graph, other.Name());
+    if (tensor_proto != nullptr) {
+      Initializer init_const{*tensor_proto, graph.ModelPath()};
+      step.immediate = *init_const.data<float>();
+      return true;
+    }
+  }
+
+  const auto* other_shape = other.Shape();
+  if (other_shape == nullptr || !SameShape(*other_shape, chain_shape)) {
+    return false;
+  }
+
+  step.operand = &other;
+  return true;
+}
+
+}  // namespace
+
+Status ElementwiseChainFusion::ApplyImpl(Graph& graph, bool& modified, int graph_level,
+                                         const logging::Logger& logger) const {
+  GraphViewer graph_viewer(graph);
+  const auto& node_topology_list = graph_viewer.GetNodesInTopologicalOrder();
+  for (auto node_index : node_topology_list) {
+    auto* p_node = graph.GetNode(node_index);
+    if (!p_node) continue;
+
+    Node& node = *p_node;
+    ORT_RETURN_IF_ERROR(Recurse(node, modified, graph_level, logger));
+
+    // the chain starts at input 0 of node unless that is a scalar immediate
+    if (node.InputDefs().empty() || !node.InputDefs()[0]->Exists()) continue;
+    int chain_input_index = 0;
+    if (IsSupportedBinaryOp(node) && optimizer_utils::IsScalar(*node.InputDefs()[0]) &&
+        graph_utils::GetConstantInitializer(graph, node.InputDefs()[0]->Name()) != nullptr) {
+      chain_input_index = 1;
+    }
+
+    NodeArg* chain_input = node.MutableInputDefs()[chain_input_index];
+    const auto* chain_shape = chain_input->Shape();
+    if (chain_shape == nullptr || !IsFloatTensor(*chain_input)) continue;
+
+    InlinedVector<ChainStep> steps;
+    ChainStep step;
+    Node* current = &node;
+    while (GetChainStep(graph, *current, chain_input_index, *chain_shape, GetCompatibleExecutionProviders(), step)) {
+      steps.push_back(step);
+
+      // intermediate values must only feed the next step
+      if (current->GetOutputEdgesCount() != 1 || graph.NodeProducesGraphOutput(*current)) break;
+      Node* next = graph.GetNode(current->OutputNodesBegin()->Index());
+      chain_input_index = optimizer_utils::IndexOfNodeInput(*next, *current->OutputDefs()[0]);
+      if (chain_input_index < 0 || chain_input_index > 1 || next->InputDefs().size() > 2 ||
+          (next->InputDefs().size() == 2 && next->InputDefs()[0] == next->InputDefs()[1])) {
+        break;
+      }
+
+      current = next;
+    }
+
+    if (steps.size() < 2) continue;
+
+    InlinedVector<NodeArg*> inputs{chain_input};
+    std::vector<std::string> ops;
+    std::vector<int64_t> operands;
+    std::vector<float> immediates;
+    std::vector<int64_t> chain_is_rhs;
+    for (const auto& chain_step : steps) {
+      int64_t operand = -1;
+      if (chain_step.operand != nullptr) {
+        auto it = std::find(inputs.begin(), inputs.end(), chain_step.operand);
+        if (it == inputs.end()) {
+          it = inputs.insert(inputs.end(), chain_step.operand);
+        }
+        operand = std::distance(inputs.begin(), it);
+      }
+
+      ops.push_back(chain_step.node->OpType());
+      operands.push_back(operand);
+      immediates.push_back(chain_step.immediate);
+      chain_is_rhs.push_back(chain_step.chain_is_rhs ? 1 : 0);
+    }
+
+    Node& last_node = *steps.back().node;
+    Node& fused_node = graph.AddNode(graph.GenerateNodeName(last_node.Name() + "/ElementwiseChainFusion/"),
+                                     "FusedElementwise", "fused element-wise chain", inputs,
+                                     std::array{last_node.MutableOutputDefs()[0]}, {}, kMSDomain);
+    fused_node.AddAttribute("ops", ops);
+    fused_node.AddAttribute("operands", operands);
+    fused_node.AddAttribute("immediates", immediates);
+    fused_node.AddAttribute("chain_is_rhs", chain_is_rhs);
+    fused_node.SetExecutionProviderType(node.GetExecutionProviderType());
+
+    // The chain value does not always enter the first step at input 0 and the operands may come from anywhere
+    // upstream, so FinalizeNodeFusion can't be used. Rebuild the input edges from the producers instead.
+    for (int i = 0; i < static_cast<int>(inputs.size()); ++i) {
+      const Node* producer = graph.GetProducerNode(inputs[i]->Name());
+      if (producer != nullptr) {
+        const int src_idx = graph_utils::GetNodeOutputIndexFromOutputName(*producer, inputs[i]->Name());
+        graph.AddEdge(producer->Index(), fused_node.Index(), src_idx, i);
+      }
+    }
+
+    const auto output_edges = graph_utils::GraphEdge::GetNodeOutputEdges(last_node);
+    for (const auto& chain_step : steps) {
+      graph_utils::RemoveNodeOutputEdges(graph, *chain_step.node);
+    }
+
+    for (const auto& output_edge : output_edges) {
+      graph.AddEdge(fused_node.Index(), output_edge.dst_node, 0, output_edge.dst_arg_index);
+    }
+
+    for (const auto& chain_step : steps) {
+      graph.RemoveNode(chain_step.node->Index());
+    }
+
+    modified = true;
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
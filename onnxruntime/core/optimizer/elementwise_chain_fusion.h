@@ -0,0 +1,23 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+ * @brief Rewrite chains of float element-wise operators (e.g. Add->Mul->Sigmoid->Mul) whose intermediate results
+ * have a single consumer into one FusedElementwise node that makes a single pass over memory.
+ * Binary operators must either have a scalar constant operand or an operand of the same shape as the chain.
+ */
+class ElementwiseChainFusion : public GraphTransformer {
+ public:
+  ElementwiseChainFusion(const InlinedHashSet<std::string_view>& compatible_execution_providers = {}) noexcept
+      : GraphTransformer("ElementwiseChainFusion", compatible_execution_providers) {}
+
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+};
+
+}  // namespace onnxruntime
@@ -0,0 +1,240 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/embedding_bag_fusion.h"
+
+#include <algorithm>
+#include <array>
+
+#include "core/graph/graph_utils.h"
+#include "core/optimizer/initializer.h"
+#include "core/optimizer/utils.h"
+
+using namespace ONNX_NAMESPACE;
+using namespace onnxruntime::common;
+
+namespace onnxruntime {
+
+namespace {
+
+int64_t GetIntAttribute(const Node& node, const std::string& attr_name, int64_t default_value) {
+  const auto* attr_proto = graph_utils::GetNodeAttribute(node, attr_name);
+  return attr_proto != nullptr && attr_proto->has_i() ? attr_proto->i() : default_value;
+}
+
+int32_t GetElemType(const NodeArg& arg) {
+  const auto* type = arg.TypeAsProto();
+  return type != nullptr && type->has_tensor_type() ? type->tensor_type().elem_type()
+                                                    : TensorProto_DataType_UNDEFINED;
+}
+
+// Returns true if the node's output only feeds one other node and so can be removed once fused.
+bool FeedsOnly(const Graph& graph, const Node& node) {
+  return optimizer_utils::CheckOutputEdges(graph, node, 1);
+}
+
+// Returns true if the weights have the shape of the indices plus a trailing 1, treating dimensions with the same
+// name as equal, so that they broadcast over the embedding dimension only.
+bool IsPerSampleWeightShape(const TensorShapeProto& weights_shape, const TensorShapeProto& indices_shape) {
+  if (weights_shape.dim_size() != indices_shape.dim_size() + 1) return false;
+
+  for (int i = 0; i < indices_shape.dim_size(); ++i) {
+    const auto& dim1 = weights_shape.dim(i);
+    const auto& dim2 = indices_shape.dim(i);
+    if (utils::HasDimValue(dim1) && utils::HasDimValue(dim2) && dim1.dim_value() == dim2.dim_value()) continue;
+    if (utils::HasDimParam(dim1) && utils::HasDimParam(dim2) && dim1.dim_param() == dim2.dim_param()) continue;
+    return false;
+  }
+
+  const auto& last_dim = weights_shape.dim(indices_shape.dim_size());
+  return utils::HasDimValue(last_dim) && last_dim.dim_value() == 1;
+}
+
+// Checks if reduce_node is a ReduceSum or ReduceMean (sum only if allow_mean is false) over only the bag axis of a
+// gathered tensor of rank gathered_rank, without keeping the reduced dimension.
+bool IsBagReduction(const Graph& graph, const Node& reduce_node, int64_t gathered_rank, bool allow_mean,
+                    bool& is_mean) {
+  is_mean = graph_utils::IsSupportedOptypeVersionAndDomain(reduce_node, "ReduceMean", {1, 11, 13, 18});
+  if (!(is_mean && allow_mean) &&
+      !graph_utils::IsSupportedOptypeVersionAndDomain(reduce_node, "ReduceSum", {1, 11, 13})) {
+    return false;
+  }
+
+  if (GetIntAttribute(reduce_node, "keepdims", 1) != 0) {
+    return false;
+  }
+
+  InlinedVector<int64_t> axes;
+  const auto* axes_attr = graph_utils::GetNodeAttribute(reduce_node, "axes");
+  if (axes_attr != nullptr) {
+    axes.assign(axes_attr->ints().begin(), axes_attr->ints().end());
+  } else if (reduce_node.InputDefs().size() > 1 && reduce_node.InputDefs()[1]->Exists()) {
+    if (!optimizer_utils::AppendTensorFromInitializer(graph, *reduce_node.InputDefs()[1], axes)) {
+      return false;
+    }
+  }
+
+  // the bag axis is the second last axis of the gathered tensor
+  return axes.size() == 1 && (axes[0] == gathered_rank - 2 || axes[0] == -2);
+}
+
+// Checks if dq_node dequantizes an int8 table with one scale per row and no zero point.
+bool IsPerRowDequantize(const Graph& graph, const Node& dq_node) {
+  if (!graph_utils::IsSupportedOptypeVersionAndDomain(dq_node, "DequantizeLinear", {10, 13, 19, 21}) ||
+      GetElemType(*dq_node.InputDefs()[0]) != TensorProto_DataType_INT8 ||
+      GetElemType(*dq_node.InputDefs()[1]) != TensorProto_DataType_FLOAT ||
+      GetIntAttribute(dq_node, "block_size", 0) != 0) {
+    return false;
+  }
+
+  const auto* scale_shape = dq_node.InputDefs()[1]->Shape();
+  if (scale_shape == nullptr || scale_shape->dim_size() != 1) {
+    return false;
+  }
+
+  // the default axis of 1 would be one scale per column
+  const int64_t axis = GetIntAttribute(dq_node, "axis", 1);
+  if (axis != 0 && axis != -2) {
+    return false;
+  }
+
+  if (dq_node.InputDefs().size() > 2 && dq_node.InputDefs()[2]->Exists()) {
+    const TensorProto* zero_point = graph_utils::GetConstantInitializer(graph, dq_node.InputDefs()[2]->Name());
+    if (zero_point == nullptr || zero_point->data_type() != TensorProto_DataType_INT8) {
+      return false;
+    }
+
+    Initializer zero_point_init{*zero_point, graph.ModelPath()};
+    const auto values = zero_point_init.DataAsSpan<int8_t>();
+    if (std::any_of(values.begin(), values.end(), [](int8_t v) { return v != 0; })) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+// Checks if cast_node casts a float16 table to float. The cast is exact, so EmbeddingBag can read the table directly.
+bool IsFloat16TableCast(const Node& cast_node) {
+  return graph_utils::IsSupportedOptypeVersionAndDomain(cast_node, "Cast", {6, 9, 13, 19, 21}) &&
+         GetElemType(*cast_node.InputDefs()[0]) == TensorProto_DataType_FLOAT16 &&
+         GetIntAttribute(cast_node, "to", TensorProto_DataType_UNDEFINED) == TensorProto_DataType_FLOAT;
+}
+
+}  // namespace
+
+Status EmbeddingBagFusion::ApplyImpl(Graph& graph, bool& modified, int graph_level,
+                                     const logging::Logger& logger) const {
+  GraphViewer graph_viewer(graph);
+  const auto& node_topology_list = graph_viewer.GetNodesInTopologicalOrder();
+  for (auto node_index : node_topology_list) {
+    auto* p_node = graph.GetNode(node_index);
+    if (!p_node) continue;
+
+    Node& gather_node = *p_node;
+    ORT_RETURN_IF_ERROR(Recurse(gather_node, modified, graph_level, logger));
+
+    if (!graph_utils::IsSupportedOptypeVersionAndDomain(gather_node, "Gather", {1, 11, 13}) ||
+        !graph_utils::IsSupportedProvider(gather_node, GetCompatibleExecutionProviders()) ||
+        GetIntAttribute(gather_node, "axis", 0) != 0 || !FeedsOnly(graph, gather_node)) {
+      continue;
+    }
+
+    NodeArg* table = gather_node.MutableInputDefs()[0];
+    NodeArg* indices = gather_node.MutableInputDefs()[1];
+    const auto* table_shape = table->Shape();
+    const auto* indices_shape = indices->Shape();
+    const int32_t indices_type = GetElemType(*indices);
+    if (table_shape == nullptr || table_shape->dim_size() != 2 || indices_shape == nullptr ||
+        indices_shape->dim_size() < 1 ||
+        (indices_type != TensorProto_DataType_INT32 && indices_type != TensorProto_DataType_INT64) ||
+        GetElemType(*gather_node.OutputDefs()[0]) != TensorProto_DataType_FLOAT) {
+      continue;
+    }
+
+    const int64_t gathered_rank = indices_shape->dim_size() + 1;
+    Node* next_node = graph.GetNode(gather_node.OutputNodesBegin()->Index());
+
+    // optional Mul by per-sample weights of shape indices.shape + [1]
+    Node* mul_node = nullptr;
+    NodeArg* weights = nullptr;
+    if (graph_utils::IsSupportedOptypeVersionAndDomain(*next_node, "Mul", {7, 13, 14})) {
+      const int gathered_index = optimizer_utils::IndexOfNodeInput(*next_node, *gather_node.OutputDefs()[0]);
+      NodeArg* other = next_node->MutableInputDefs()[gathered_index == 0 ? 1 : 0];
+      const auto* other_shape = other->Shape();
+      if (!graph_utils::IsSupportedProvider(*next_node, GetCompatibleExecutionProviders()) ||
+          other == gather_node.OutputDefs()[0] || GetElemType(*other) != TensorProto_DataType_FLOAT ||
+          other_shape == nullptr || !IsPerSampleWeightShape(*other_shape, *indices_shape) ||
+          !FeedsOnly(graph, *next_node)) {
+        continue;
+      }
+
+      mul_node = next_node;
+      weights = other;
+      next_node = graph.GetNode(mul_node->OutputNodesBegin()->Index());
+    }
+
+    // weighted mean is not a common pattern and has no single meaning, so only weighted sums are fused
+    bool is_mean = false;
+    Node& reduce_node = *next_node;
+    if (!graph_utils::IsSupportedProvider(reduce_node, GetCompatibleExecutionProviders()) ||
+        !IsBagReduction(graph, reduce_node, gathered_rank, mul_node == nullptr, is_mean)) {
+      continue;
+    }
+
+    // an int8 table dequantized with per-row scales, or a float16 table cast to float, is read directly
+    Node* table_node = const_cast<Node*>(graph_utils::GetInputNode(gather_node, 0));
+    NodeArg* scales = nullptr;
+    if (table_node != nullptr && graph_utils::IsSupportedProvider(*table_node, GetCompatibleExecutionProviders()) &&
+        FeedsOnly(graph, *table_node)) {
+      if (IsPerRowDequantize(graph, *table_node)) {
+        table = table_node->MutableInputDefs()[0];
+        scales = table_node->MutableInputDefs()[1];
+      } else if (IsFloat16TableCast(*table_node)) {
+        table = table_node->MutableInputDefs()[0];
+      } else {
+        table_node = nullptr;
+      }
+    } else {
+      table_node = nullptr;
+    }
+
+    NodeArg& empty_arg = graph.GetOrCreateNodeArg("", nullptr);
+    const std::array<NodeArg*, 4> inputs{table, indices, weights ? weights : &empty_arg,
+                                         scales ? scales : &empty_arg};
+    Node& fused_node = graph.AddNode(graph.GenerateNodeName(gather_node.Name() + "/EmbeddingBagFusion/"),
+                                     "EmbeddingBag", "fused Gather and reduction over the bag axis", inputs,
+                                     std::array{reduce_node.MutableOutputDefs()[0]}, {}, kMSDomain);
+    fused_node.AddAttribute("mode", is_mean ? std::string("mean") : std::string("sum"));
+    fused_node.SetExecutionProviderType(gather_node.GetExecutionProviderType());
+
+    for (int i = 0; i < static_cast<int>(inputs.size()); ++i) {
+      if (!inputs[i]->Exists()) continue;
+      const Node* producer = graph.GetProducerNode(inputs[i]->Name());
+      if (producer != nullptr) {
+        const int src_idx = graph_utils::GetNodeOutputIndexFromOutputName(*producer, inputs[i]->Name());
+        graph.AddEdge(producer->Index(), fused_node.Index(), src_idx, i);
+      }
+    }
+
+    const auto output_edges = graph_utils::GraphEdge::GetNodeOutputEdges(reduce_node);
+    InlinedVector<Node*> fused_nodes{table_node, &gather_node, mul_node, &reduce_node};
+    for (Node* node : fused_nodes) {
+      if (node != nullptr) graph_utils::RemoveNodeOutputEdges(graph, *node);
+    }
+
+    for (const auto& output_edge : output_edges) {
+      graph.AddEdge(fused_node.Index(), output_edge.dst_node, 0, output_edge.dst_arg_index);
+    }
+
+    for (Node* node : fused_nodes) {
+      if (node != nullptr) graph.RemoveNode(node->Index());
+    }
+
+    modified = true;
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,24 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+ * @brief Rewrite Gather(axis=0) of a float embedding table followed by ReduceSum or ReduceMean over the bag axis
+ * (the last axis of the indices) into one EmbeddingBag node, so the gathered [..., bag, dim] tensor is never
+ * materialized. Also fuses a Mul by per-sample weights between Gather and ReduceSum, and a DequantizeLinear of an
+ * int8 table with per-row scales or a Cast of a float16 table to float in front of the Gather.
+ */
+class EmbeddingBagFusion : public GraphTransformer {
+ public:
+  EmbeddingBagFusion(const InlinedHashSet<std::string_view>& compatible_execution_providers = {}) noexcept
+      : GraphTransformer("EmbeddingBagFusion", compatible_execution_providers) {}
+
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+};
+
+}  // namespace onnxruntime
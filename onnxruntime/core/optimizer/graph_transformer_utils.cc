@@ -36,7 +36,9 @@
 #include "core/optimizer/double_qdq_pairs_remover.h"
 #include "core/optimizer/dropout_elimination.h"
 #include "core/optimizer/dynamic_quantize_matmul_fusion.h"
+#include "core/optimizer/elementwise_chain_fusion.h"
 #include "core/optimizer/embed_layer_norm_fusion.h"
+#include "core/optimizer/embedding_bag_fusion.h"
 #include "core/optimizer/expand_elimination.h"
 #include "core/optimizer/fast_gelu_fusion.h"
 #include "core/optimizer/free_dim_override_transformer.h"
@@ -295,6 +297,8 @@ InlinedVector<std::unique_ptr<GraphTransformer>> GenerateTransformers(
                                                             QDQIsInt8Allowed() ? "1" : "0") == "1";
       const bool enable_gelu_approximation =
           session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsEnableGeluApproximation, "0") == "1";
+      const bool enable_elementwise_chain_fusion =
+          session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsEnableElementwiseChainFusion, "0") == "1";
 
       const InlinedHashSet<std::string_view> cuda_eps = {onnxruntime::kCudaExecutionProvider};
 
@@ -409,6 +413,12 @@ InlinedVector<std::unique_ptr<GraphTransformer>> GenerateTransformers(
 #endif
 
       transformers.emplace_back(std::make_unique<MatMulNBitsFusion>(cpu_ep));
+      transformers.emplace_back(std::make_unique<EmbeddingBagFusion>(cpu_ep));
+
+      // Runs last so that the chains covered by the dedicated fusions above are fused by those instead.
+      if (enable_elementwise_chain_fusion) {
+        transformers.emplace_back(std::make_unique<ElementwiseChainFusion>(cpu_ep));
+      }
 
 #endif  // !defined(DISABLE_CONTRIB_OPS)
       // The QDQFinalCleanupTransformer must run AFTER other transformers that fuse Q/DQ nodes. Otherwise, their
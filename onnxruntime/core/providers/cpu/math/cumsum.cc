@@ -1,13 +1,17 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
 #include <functional>
+#include <numeric>
+#include <vector>
 
 #include "cumsum.h"
 #include "core/providers/common.h"
 #include "core/providers/cpu/tensor/utils.h"
 #include "core/framework/op_kernel.h"
 #include "core/framework/tensorprotoutils.h"
+#include "core/platform/threadpool.h"
 
 using namespace onnxruntime;
 
@@ -143,6 +147,51 @@ CumSum<T>::CumSum(const OpKernelInfo& info) : OpKernel(info), exclusive_(), reve
   }
 }
 
+// Columns of the [dim, lower_dim_size] slices scanned by one task
+static constexpr int64_t kCumSumColumnBlock = 256;
+// Rows of the axis scanned by one task when the axis is split
+static constexpr int64_t kCumSumAxisChunk = 2048;
+// The axis is split when there are fewer independent column blocks than this
+static constexpr int64_t kCumSumMinTasks = 16;
+
+// Scans num_rows rows of width columns, starting from the row at input/output and moving row_stride elements per row.
+// carry holds the sums of the rows scanned before this one, nullptr if there are none.
+template <typename T>
+static void ScanRows(const T* input, T* output, std::ptrdiff_t row_stride, int64_t num_rows, int64_t width,
+                     bool exclusive, const T* carry) {
+  if (exclusive) {
+    for (int64_t inner = 0; inner < width; inner++) {
+      output[inner] = carry ? carry[inner] : T{0};
+    }
+  } else {
+    for (int64_t inner = 0; inner < width; inner++) {
+      output[inner] = carry ? carry[inner] + input[inner] : input[inner];
+    }
+  }
+
+  for (int64_t cum_axis = 1; cum_axis < num_rows; cum_axis++) {
+    // an inclusive scan adds the input of the same row, an exclusive one the input of the row before it
+    const T* row_input = input + (exclusive ? cum_axis - 1 : cum_axis) * row_stride;
+    const T* prev_output = output + (cum_axis - 1) * row_stride;
+    T* row_output = output + cum_axis * row_stride;
+    for (int64_t inner = 0; inner < width; inner++) {
+      row_output[inner] = prev_output[inner] + row_input[inner];
+    }
+  }
+}
+
+// Sums num_rows rows of width columns into sums
+template <typename T>
+static void SumRows(const T* input, std::ptrdiff_t row_stride, int64_t num_rows, int64_t width, T* sums) {
+  std::fill_n(sums, width, T{0});
+  for (int64_t cum_axis = 0; cum_axis < num_rows; cum_axis++) {
+    const T* row_input = input + cum_axis * row_stride;
+    for (int64_t inner = 0; inner < width; inner++) {
+      sums[inner] += row_input[inner];
+    }
+  }
+}
+
 template <typename T>
 Status CumSum<T>::Compute(OpKernelContext* ctx) const {
   const Tensor* input = ctx->Input<Tensor>(0);   // input tensor
@@ -166,8 +215,10 @@ Status CumSum<T>::Compute(OpKernelContext* ctx) const {
   // 1) out[upper_dims...][0][lower_dims...] = 0
   // 2) out[upper_dims...][i][lower_dims...] =
   //      in[upper_dims...][i-1][lower_dims...] + out[upper_dims...][i-1][lower_dims...]
-  // we loop through the [upper_dims...] and start applying the identity in each slice
-  // since the [lower_dims...] are adjecent in memory, so we can add them like vectors
+  // each [upper_dims...] slice is a [dim, lower_dim_size] matrix that is scanned row by row, and since the
+  // [lower_dims...] are adjecent in memory we can add the rows like vectors. the slices and blocks of their columns
+  // are independent tasks. when there are too few of them to keep the threads busy a long axis is also split into
+  // chunks: the sums of the chunks are computed first and their prefix sums are the carries the chunks start from.
 
   const auto input_shape = input->Shape().GetDims();
   const size_t axis = onnxruntime::narrow<size_t>(axis_input);
@@ -177,71 +228,75 @@ Status CumSum<T>::Compute(OpKernelContext* ctx) const {
   const int64_t lower_dim_size =  // sizes of the slices we can treat as 1D arrays
       std::accumulate(input_shape.begin() + axis + 1, input_shape.end(), static_cast<int64_t>(1), std::multiplies<int64_t>());
 
-  if (!reverse_) {
-    const auto* input_iter = input->Data<T>();
-    auto* output_iter = output_tensor.MutableData<T>();
-    const auto* prev_output_iter = output_iter;
+  const bool exclusive = exclusive_ != 0;
+  const bool reverse = reverse_ != 0;
+  const T* input_data = input->Data<T>();
+  T* output_data = output_tensor.MutableData<T>();
 
-    if (exclusive_) {
-      for (int64_t outer = 0; outer < upper_dim_count; outer++) {
-        prev_output_iter = output_iter;
-        for (int64_t inner = 0; inner < lower_dim_size; inner++) {
-          *(output_iter++) = 0;
-        }
-        for (int64_t cum_axis = 1; cum_axis < dim; cum_axis++) {
-          for (int64_t inner = 0; inner < lower_dim_size; inner++) {
-            *(output_iter++) = *(prev_output_iter++) + *(input_iter++);
-          }
-        }
-        input_iter += lower_dim_size;
-      }
-    } else {
-      for (int64_t outer = 0; outer < upper_dim_count; outer++) {
-        prev_output_iter = output_iter;
-        for (int64_t inner = 0; inner < lower_dim_size; inner++) {
-          *(output_iter++) = *(input_iter++);
-        }
-        for (int64_t cum_axis = 1; cum_axis < dim; cum_axis++) {
-          for (int64_t inner = 0; inner < lower_dim_size; inner++) {
-            *(output_iter++) = *(prev_output_iter++) + *(input_iter++);
-          }
-        }
+  // the tasks only depend on the shape, so the results don't depend on the number of threads
+  const int64_t slice_size = dim * lower_dim_size;
+  const std::ptrdiff_t row_stride = onnxruntime::narrow<std::ptrdiff_t>(reverse ? -lower_dim_size : lower_dim_size);
+  const int64_t column_blocks = (lower_dim_size + kCumSumColumnBlock - 1) / kCumSumColumnBlock;
+  const int64_t num_slices = upper_dim_count * column_blocks;
+  const bool split_axis = num_slices < kCumSumMinTasks && dim >= 2 * kCumSumAxisChunk;
+  const int64_t axis_chunk_rows = split_axis ? kCumSumAxisChunk : dim;
+  const int64_t axis_chunks = (dim + axis_chunk_rows - 1) / axis_chunk_rows;
+
+  // [upper_dim_count, axis_chunks, lower_dim_size] sums of the chunks of a split axis, which are then replaced by
+  // the sums of all the chunks before them in scan order
+  std::vector<T> carries(split_axis ? onnxruntime::narrow<size_t>(upper_dim_count * axis_chunks * lower_dim_size) : 0);
+
+  const auto process_tasks = [&](std::ptrdiff_t first, std::ptrdiff_t last, bool sum_chunks) {
+    for (std::ptrdiff_t task = first; task < last; ++task) {
+      const int64_t chunk = task % axis_chunks;
+      const int64_t slice = task / axis_chunks;
+      const int64_t outer = slice / column_blocks;
+      const int64_t column = (slice % column_blocks) * kCumSumColumnBlock;
+      const int64_t width = std::min(kCumSumColumnBlock, lower_dim_size - column);
+      const int64_t row = chunk * axis_chunk_rows;  // first row of the chunk in scan order
+      const int64_t num_rows = std::min(axis_chunk_rows, dim - row);
+      const int64_t offset = outer * slice_size + (reverse ? dim - 1 - row : row) * lower_dim_size + column;
+      T* carry = split_axis ? carries.data() + (outer * axis_chunks + chunk) * lower_dim_size + column : nullptr;
+
+      if (sum_chunks) {
+        SumRows(input_data + offset, row_stride, num_rows, width, carry);
+      } else {
+        ScanRows(input_data + offset, output_data + offset, row_stride, num_rows, width, exclusive,
+                 chunk == 0 ? nullptr : carry);
       }
     }
-  } else {
-    // in this case the logic is mostly the same, but we start from the end
-    const auto* input_iter = input->Data<T>() + input->Shape().Size();
-    auto* output_iter = output_tensor.MutableData<T>() + output_shape.Size();
-    const auto* prev_output_iter = output_iter;
-
-    if (exclusive_) {
-      for (int64_t outer = upper_dim_count - 1; outer >= 0; outer--) {
-        prev_output_iter = output_iter;
-        for (int64_t inner = lower_dim_size - 1; inner >= 0; inner--) {
-          *(--output_iter) = 0;
-        }
-        for (int64_t cum_axis = dim - 1; cum_axis > 0; cum_axis--) {
-          for (int64_t inner = lower_dim_size - 1; inner >= 0; inner--) {
-            *(--output_iter) = *(--prev_output_iter) + *(--input_iter);
-          }
-        }
-        input_iter -= lower_dim_size;
-      }
-    } else {
-      for (int64_t outer = upper_dim_count - 1; outer >= 0; outer--) {
-        prev_output_iter = output_iter;
-        for (int64_t inner = lower_dim_size - 1; inner >= 0; inner--) {
-          *(--output_iter) = *(--input_iter);
-        }
-        for (int64_t cum_axis = dim - 1; cum_axis > 0; cum_axis--) {
-          for (int64_t inner = lower_dim_size - 1; inner >= 0; inner--) {
-            *(--output_iter) = *(--prev_output_iter) + *(--input_iter);
-          }
+  };
+
+  concurrency::ThreadPool* tp = ctx->GetOperatorThreadPool();
+  const std::ptrdiff_t num_tasks = onnxruntime::narrow<std::ptrdiff_t>(num_slices * axis_chunks);
+  const double task_elements = static_cast<double>(axis_chunk_rows * std::min(kCumSumColumnBlock, lower_dim_size));
+  const TensorOpCost task_cost{task_elements * sizeof(T), task_elements * sizeof(T), task_elements};
+
+  if (split_axis) {
+    concurrency::ThreadPool::TryParallelFor(tp, num_tasks, TensorOpCost{task_cost.bytes_loaded, 0.0, task_elements},
+                                            [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+                                              process_tasks(first, last, true);
+                                            });
+
+    for (int64_t outer = 0; outer < upper_dim_count; outer++) {
+      T* outer_carries = carries.data() + outer * axis_chunks * lower_dim_size;
+      for (int64_t inner = 0; inner < lower_dim_size; inner++) {
+        T running_sum = 0;
+        for (int64_t chunk = 0; chunk < axis_chunks; chunk++) {
+          T& carry = outer_carries[chunk * lower_dim_size + inner];
+          const T chunk_sum = carry;
+          carry = running_sum;
+          running_sum += chunk_sum;
         }
       }
     }
   }
 
+  concurrency::ThreadPool::TryParallelFor(tp, num_tasks, task_cost,
+                                          [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+                                            process_tasks(first, last, false);
+                                          });
+
   return Status::OK();
 }
 
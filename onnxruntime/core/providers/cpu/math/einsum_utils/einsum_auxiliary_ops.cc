@@ -3,6 +3,9 @@
 
 #include "einsum_auxiliary_ops.h"
 
+#include "core/mlas/inc/mlas.h"
+#include "core/util/math_cpuonly.h"
+
 using namespace onnxruntime::common;
 
 namespace onnxruntime {
@@ -32,19 +35,45 @@ Status Transpose(const gsl::span<const size_t>& permutation, const Tensor& input
 template <typename T>
 Status MatMul(const T* input_1_data, const T* input_2_data, T* output_data,
               size_t left_stride, size_t right_stride, size_t output_stride,
-              size_t num_batches, size_t M, size_t K, size_t N, concurrency::ThreadPool* tp,
+              size_t num_batches, size_t M, size_t K, size_t N,
+              bool transpose_input_1, bool transpose_input_2, concurrency::ThreadPool* tp,
               void* /*einsum_cuda_assets*/) {
-  for (size_t i = 0; i < num_batches; ++i) {
-    math::MatMul<T>(
-        static_cast<int>(M),
-        static_cast<int>(N),
-        static_cast<int>(K),
-        input_1_data + i * left_stride,
-        input_2_data + i * right_stride,
-        output_data + i * output_stride, tp);
-  }
+  if constexpr (std::is_same_v<T, float>) {
+    // A single call for all the batches lets MLAS spread many small multiplications across threads
+    std::vector<MLAS_SGEMM_DATA_PARAMS> data(num_batches);
+    for (size_t i = 0; i < num_batches; ++i) {
+      data[i].A = input_1_data + i * left_stride;
+      data[i].lda = transpose_input_1 ? M : K;
+      data[i].B = input_2_data + i * right_stride;
+      data[i].ldb = transpose_input_2 ? K : N;
+      data[i].C = output_data + i * output_stride;
+      data[i].ldc = N;
+    }
+    MlasGemmBatch(transpose_input_1 ? CblasTrans : CblasNoTrans, transpose_input_2 ? CblasTrans : CblasNoTrans,
+                  M, N, K, data.data(), num_batches, tp);
+    return Status::OK();
+  } else {
+    for (size_t i = 0; i < num_batches; ++i) {
+      const T* a = input_1_data + i * left_stride;
+      const T* b = input_2_data + i * right_stride;
+      T* c = output_data + i * output_stride;
+      if (!transpose_input_1 && !transpose_input_2) {
+        math::MatMul<T>(static_cast<int>(M), static_cast<int>(N), static_cast<int>(K), a, b, c, tp);
+        continue;
+      }
 
-  return Status::OK();
+      // The row major C = op(A) * op(B) is the column major C' = op(B)' * op(A)'
+      auto c_mat = EigenMatrixMap<T>(c, N, M);
+      if (transpose_input_1 && transpose_input_2) {
+        c_mat.noalias() = ConstEigenMatrixMap<T>(b, K, N).transpose() * ConstEigenMatrixMap<T>(a, M, K).transpose();
+      } else if (transpose_input_1) {
+        c_mat.noalias() = ConstEigenMatrixMap<T>(b, N, K) * ConstEigenMatrixMap<T>(a, M, K).transpose();
+      } else {
+        c_mat.noalias() = ConstEigenMatrixMap<T>(b, K, N).transpose() * ConstEigenMatrixMap<T>(a, K, M);
+      }
+    }
+    return Status::OK();
+  }
 }
 
 // CPU specific ReduceSum helper
@@ -304,7 +333,8 @@ template <typename T>
 std::unique_ptr<Tensor> MatMul(const Tensor& input_1, const gsl::span<const int64_t>& input_shape_1_override,
                                const Tensor& input_2, const gsl::span<const int64_t>& input_shape_2_override,
                                AllocatorPtr allocator, concurrency::ThreadPool* tp, void* einsum_cuda_assets,
-                               const DeviceHelpers::MatMul<T>& device_matmul_func) {
+                               const DeviceHelpers::MatMul<T>& device_matmul_func,
+                               bool transpose_input_1, bool transpose_input_2) {
   // Sanity checks before the actual MatMul
   ORT_ENFORCE(input_1.DataType() == input_2.DataType(), "Data types of the inputs must match for MatMul");
   ORT_ENFORCE(input_shape_1_override.size() == 3 && input_shape_2_override.size() == 3, "Only 1 batch dimension is allowed for MatMul");
@@ -335,7 +365,8 @@ std::unique_ptr<Tensor> MatMul(const Tensor& input_1, const gsl::span<const int6
   T* output_data = output->MutableData<T>();
 
   auto status = device_matmul_func(input_1_data, input_2_data, output_data,
-                                   left_offset, right_offset, output_offset, batches, M, K, N, tp, einsum_cuda_assets);
+                                   left_offset, right_offset, output_offset, batches, M, K, N,
+                                   transpose_input_1, transpose_input_2, tp, einsum_cuda_assets);
 
   if (!status.IsOK()) {
     ORT_THROW(ONNXRUNTIME, FAIL, "Einsum op: Exception during MatMul operation: ",
@@ -359,14 +390,16 @@ std::unique_ptr<Tensor> ReduceSum(const Tensor& input, const TensorShape& input_
 template Status DeviceHelpers::CpuDeviceHelpers::MatMul<float>(
     const float* input_1_data, const float* input_2_data, float* output_data,
     size_t left_stride, size_t right_stride, size_t output_stride,
-    size_t num_batches, size_t M, size_t K, size_t N, concurrency::ThreadPool* tp,
+    size_t num_batches, size_t M, size_t K, size_t N,
+    bool transpose_input_1, bool transpose_input_2, concurrency::ThreadPool* tp,
     void* einsum_cuda_assets);
 
 template std::unique_ptr<Tensor> MatMul<float>(
     const Tensor& input_1, const gsl::span<const int64_t>& input_shape_1_override,
     const Tensor& input_2, const gsl::span<const int64_t>& input_shape_2_override,
     AllocatorPtr allocator, concurrency::ThreadPool* tp, void* einsum_cuda_assets,
-    const DeviceHelpers::MatMul<float>& device_matmul_func);
+    const DeviceHelpers::MatMul<float>& device_matmul_func,
+    bool transpose_input_1, bool transpose_input_2);
 
 template std::unique_ptr<Tensor> DeviceHelpers::CpuDeviceHelpers::ReduceSum<float>(
     const Tensor& input, gsl::span<const int64_t> reduce_axes,
@@ -383,14 +416,16 @@ template std::unique_ptr<Tensor> ReduceSum<float>(
 template Status DeviceHelpers::CpuDeviceHelpers::MatMul<int32_t>(
     const int32_t* input_1_data, const int32_t* input_2_data, int32_t* output_data,
     size_t left_stride, size_t right_stride, size_t output_stride,
-    size_t num_batches, size_t M, size_t K, size_t N, concurrency::ThreadPool* tp,
+    size_t num_batches, size_t M, size_t K, size_t N,
+    bool transpose_input_1, bool transpose_input_2, concurrency::ThreadPool* tp,
     void* einsum_cuda_assets);
 
 template std::unique_ptr<Tensor> MatMul<int32_t>(
     const Tensor& input_1, const gsl::span<const int64_t>& input_shape_1_override,
     const Tensor& input_2, const gsl::span<const int64_t>& input_shape_2_override,
     AllocatorPtr allocator, concurrency::ThreadPool* tp, void* einsum_cuda_assets,
-    const DeviceHelpers::MatMul<int32_t>& device_matmul_func);
+    const DeviceHelpers::MatMul<int32_t>& device_matmul_func,
+    bool transpose_input_1, bool transpose_input_2);
 
 template std::unique_ptr<Tensor> DeviceHelpers::CpuDeviceHelpers::ReduceSum<int32_t>(
     const Tensor& input, gsl::span<const int64_t> reduce_axes,
@@ -408,14 +443,16 @@ template std::unique_ptr<Tensor> ReduceSum<int32_t>(
 template Status DeviceHelpers::CpuDeviceHelpers::MatMul<double>(
     const double* input_1_data, const double* input_2_data, double* output_data,
     size_t left_stride, size_t right_stride, size_t output_stride,
-    size_t num_batches, size_t M, size_t K, size_t N, concurrency::ThreadPool* tp,
+    size_t num_batches, size_t M, size_t K, size_t N,
+    bool transpose_input_1, bool transpose_input_2, concurrency::ThreadPool* tp,
     void* einsum_cuda_assets);
 
 template std::unique_ptr<Tensor> MatMul<double>(
     const Tensor& input_1, const gsl::span<const int64_t>& input_shape_1_override,
     const Tensor& input_2, const gsl::span<const int64_t>& input_shape_2_override,
     AllocatorPtr allocator, concurrency::ThreadPool* tp, void* einsum_cuda_assets,
-    const DeviceHelpers::MatMul<double>& device_matmul_func);
+    const DeviceHelpers::MatMul<double>& device_matmul_func,
+    bool transpose_input_1, bool transpose_input_2);
 
 template std::unique_ptr<Tensor> DeviceHelpers::CpuDeviceHelpers::ReduceSum<double>(
     const Tensor& input, gsl::span<const int64_t> reduce_axes,
@@ -433,7 +470,8 @@ template std::unique_ptr<Tensor> ReduceSum<double>(
 template Status DeviceHelpers::CpuDeviceHelpers::MatMul<int64_t>(
     const int64_t* input_1_data, const int64_t* input_2_data, int64_t* output_data,
     size_t left_stride, size_t right_stride, size_t output_stride,
-    size_t num_batches, size_t M, size_t K, size_t N, concurrency::ThreadPool* tp,
+    size_t num_batches, size_t M, size_t K, size_t N,
+    bool transpose_input_1, bool transpose_input_2, concurrency::ThreadPool* tp,
     void* einsum_cuda_assets);
 
 template std::unique_ptr<Tensor> DeviceHelpers::CpuDeviceHelpers::ReduceSum<int64_t>(
@@ -446,7 +484,8 @@ template std::unique_ptr<Tensor> MatMul<int64_t>(
     const Tensor& input_1, const gsl::span<const int64_t>& input_shape_1_override,
     const Tensor& input_2, const gsl::span<const int64_t>& input_shape_2_override,
     AllocatorPtr allocator, concurrency::ThreadPool* tp, void* einsum_cuda_assets,
-    const DeviceHelpers::MatMul<int64_t>& device_matmul_func);
+    const DeviceHelpers::MatMul<int64_t>& device_matmul_func,
+    bool transpose_input_1, bool transpose_input_2);
 
 template std::unique_ptr<Tensor> ReduceSum<int64_t>(
     const Tensor& input, const TensorShape& input_shape_override,
@@ -458,7 +497,8 @@ template std::unique_ptr<Tensor> MatMul<MLFloat16>(
     const Tensor& input_1, const gsl::span<const int64_t>& input_shape_1_override,
     const Tensor& input_2, const gsl::span<const int64_t>& input_shape_2_override,
     AllocatorPtr allocator, concurrency::ThreadPool* tp, void* einsum_cuda_assets,
-    const DeviceHelpers::MatMul<MLFloat16>& device_matmul_func);
+    const DeviceHelpers::MatMul<MLFloat16>& device_matmul_func,
+    bool transpose_input_1, bool transpose_input_2);
 
 template std::unique_ptr<Tensor> ReduceSum<MLFloat16>(
     const Tensor& input, const TensorShape& input_shape_override,
@@ -3,6 +3,11 @@
 
 #include "einsum_compute_preprocessor.h"
 
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <numeric>
+
 namespace onnxruntime {
 
 EinsumComputePreprocessor::EinsumComputePreprocessor(EinsumEquationPreprocessor& einsum_equation_preprocessor,
@@ -29,6 +34,8 @@ Status EinsumComputePreprocessor::Run() {
 
   ORT_RETURN_IF_ERROR(PreprocessInputs());
 
+  CalculateContractionPath();
+
   return Status::OK();
 }
 
@@ -60,6 +67,10 @@ int64_t EinsumComputePreprocessor::GetNumSubscriptIndices() const {
   return num_subscript_indices_;
 }
 
+const EinsumOp::ContractionPath& EinsumComputePreprocessor::GetContractionPath() const {
+  return contraction_path_;
+}
+
 void EinsumComputePreprocessor::SetDeviceHelpers(const EinsumOp::DeviceHelpers::Diagonal& device_diagonal_func,
                                                  const EinsumOp::DeviceHelpers::Transpose& device_transpose_func) {
   device_diagonal_func_ = device_diagonal_func;
@@ -476,4 +487,155 @@ Status EinsumComputePreprocessor::PreprocessInputs() {
   return Status::OK();
 }
 
+namespace {
+
+// Up to this many inputs every contraction order is tried, above it the order is chosen greedily
+constexpr size_t kMaxInputsForExhaustiveContractionSearch = 6;
+
+using LabelDims = std::vector<int64_t>;
+
+// Computes the dims of the result of contracting operands[a] and operands[b] and the number of multiply-adds
+// it takes. A label is summed out by the contraction if it is not in the output and no other operand has it.
+LabelDims ContractedDims(const std::vector<LabelDims>& operands, size_t a, size_t b,
+                         const std::vector<bool>& label_in_output, double& cost) {
+  const size_t num_labels = label_in_output.size();
+  LabelDims result(num_labels, 1);
+  cost = 1.;
+  for (size_t label = 0; label < num_labels; ++label) {
+    const int64_t dim = std::max(operands[a][label], operands[b][label]);
+    cost *= static_cast<double>(dim);
+
+    bool needed = label_in_output[label];
+    for (size_t k = 0; k < operands.size() && !needed; ++k) {
+      needed = k != a && k != b && operands[k][label] > 1;
+    }
+    if (needed) {
+      result[label] = dim;
+    }
+  }
+  return result;
+}
+
+// Applies one step of a contraction path to the list of operands and returns its cost
+double ApplyContraction(std::vector<LabelDims>& operands, size_t a, size_t b,
+                        const std::vector<bool>& label_in_output) {
+  double cost;
+  operands[a] = ContractedDims(operands, a, b, label_in_output, cost);
+  operands.erase(operands.begin() + b);
+  return cost;
+}
+
+void SearchContractionPath(const std::vector<LabelDims>& operands, const std::vector<bool>& label_in_output,
+                           double cost, EinsumOp::ContractionPath& path,
+                           double& best_cost, EinsumOp::ContractionPath& best_path) {
+  if (operands.size() == 1) {
+    if (cost < best_cost) {
+      best_cost = cost;
+      best_path = path;
+    }
+    return;
+  }
+
+  for (size_t a = 0; a < operands.size(); ++a) {
+    for (size_t b = a + 1; b < operands.size(); ++b) {
+      std::vector<LabelDims> next = operands;
+      const double next_cost = cost + ApplyContraction(next, a, b, label_in_output);
+      if (next_cost >= best_cost) {
+        continue;
+      }
+      path.emplace_back(a, b);
+      SearchContractionPath(next, label_in_output, next_cost, path, best_cost, best_path);
+      path.pop_back();
+    }
+  }
+}
+
+// At each step contracts the pair that is cheapest to contract, preferring the smaller result on a tie
+EinsumOp::ContractionPath GreedyContractionPath(std::vector<LabelDims> operands,
+                                                const std::vector<bool>& label_in_output, double& total_cost) {
+  EinsumOp::ContractionPath path;
+  total_cost = 0.;
+  while (operands.size() > 1) {
+    size_t best_a = 0;
+    size_t best_b = 1;
+    double best_cost = std::numeric_limits<double>::max();
+    double best_size = std::numeric_limits<double>::max();
+    for (size_t a = 0; a < operands.size(); ++a) {
+      for (size_t b = a + 1; b < operands.size(); ++b) {
+        double cost;
+        const LabelDims result = ContractedDims(operands, a, b, label_in_output, cost);
+        const double size = std::accumulate(result.begin(), result.end(), 1., std::multiplies<double>());
+        if (cost < best_cost || (cost == best_cost && size < best_size)) {
+          best_a = a;
+          best_b = b;
+          best_cost = cost;
+          best_size = size;
+        }
+      }
+    }
+    total_cost += ApplyContraction(operands, best_a, best_b, label_in_output);
+    path.emplace_back(best_a, best_b);
+  }
+  return path;
+}
+
+}  // namespace
+
+void EinsumComputePreprocessor::CalculateContractionPath() {
+  const size_t num_inputs = homogenized_input_dims_.size();
+  contraction_path_.clear();
+  if (num_inputs < 2) {
+    return;
+  }
+
+  // The inputs are contracted left to right unless another order is cheaper
+  for (size_t i = 1; i < num_inputs; ++i) {
+    contraction_path_.emplace_back(0, 1);
+  }
+  if (num_inputs == 2) {
+    return;
+  }
+
+  std::vector<int64_t> key;
+  key.reserve(num_inputs * onnxruntime::narrow<size_t>(num_subscript_indices_));
+  std::vector<LabelDims> operands;
+  operands.reserve(num_inputs);
+  for (const auto& dims : homogenized_input_dims_) {
+    const auto dims_span = dims.GetDims();
+    key.insert(key.end(), dims_span.begin(), dims_span.end());
+    operands.emplace_back(dims_span.begin(), dims_span.end());
+  }
+
+  auto& cache = *einsum_equation_preprocessor_.contraction_path_cache_;
+  if (cache.Find(key, contraction_path_)) {
+    return;
+  }
+
+  std::vector<bool> label_in_output(onnxruntime::narrow<size_t>(num_subscript_indices_));
+  for (size_t label = 0; label < label_in_output.size(); ++label) {
+    label_in_output[label] = subscript_indices_to_output_indices_[label] != -1;
+  }
+
+  double best_cost = 0.;
+  {
+    std::vector<LabelDims> remaining = operands;
+    for (const auto& step : contraction_path_) {
+      best_cost += ApplyContraction(remaining, step.first, step.second, label_in_output);
+    }
+  }
+
+  if (num_inputs <= kMaxInputsForExhaustiveContractionSearch) {
+    EinsumOp::ContractionPath path;
+    SearchContractionPath(operands, label_in_output, 0., path, best_cost, contraction_path_);
+  } else {
+    double greedy_cost;
+    auto greedy_path = GreedyContractionPath(operands, label_in_output, greedy_cost);
+    if (greedy_cost < best_cost) {
+      contraction_path_ = std::move(greedy_path);
+    }
+  }
+
+  cache.Insert(key, contraction_path_);
+}
+
 }  // namespace onnxruntime
@@ -15,6 +15,11 @@
 
 #include "einsum_auxiliary_ops.h"
 
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+
 namespace onnxruntime {
 
 namespace EinsumOp {
@@ -41,6 +46,40 @@ inline int64_t LetterToIndex(char ch) {
   return -1;
 }
 
+// The order in which the operands are contracted pair-wise.
+// Each step contracts the operands at positions `first` and `second` (first < second) of the current list of
+// operands, the result takes the place of `first` and `second` is removed from the list.
+using ContractionPath = std::vector<std::pair<size_t, size_t>>;
+
+// Holds the contraction paths computed for the input shapes seen so far so that the search
+// is only done once per shape. Shared by all the Compute() calls of a kernel.
+class ContractionPathCache {
+ public:
+  // Past this many distinct shapes, new paths are computed on every call instead of being cached
+  static constexpr size_t kMaxEntries = 64;
+
+  bool Find(const std::vector<int64_t>& key, ContractionPath& path) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = paths_.find(key);
+    if (it == paths_.end()) {
+      return false;
+    }
+    path = it->second;
+    return true;
+  }
+
+  void Insert(const std::vector<int64_t>& key, const ContractionPath& path) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (paths_.size() < kMaxEntries) {
+      paths_.emplace(key, path);
+    }
+  }
+
+ private:
+  mutable std::mutex mutex_;
+  std::map<std::vector<int64_t>, ContractionPath> paths_;
+};
+
 }  // namespace EinsumOp
 
 struct EinsumEquationPreprocessor {
@@ -76,9 +115,6 @@ struct EinsumEquationPreprocessor {
   }
 
   // Holds the pre-processed equation string
-  // In theory, we could re-write the einsum equation to lower overall cost of intermediate arrays
-  // See numpy.einsum_path for details/examples
-  // These are very advanced optimizations that we don't require for the average use-case
   std::string einsum_preprocessed_equation_;
 
   // In explicit form, holds the left side of the einsum equation
@@ -95,6 +131,11 @@ struct EinsumEquationPreprocessor {
 
   // Flag indicating if the Einsum op is being used in explicit form (i.e.) contains '->'
   bool is_explicit_ = false;
+
+  // Contraction paths for the input shapes seen so far (see numpy.einsum_path)
+  // Copies of this preprocessor share the cache
+  std::shared_ptr<EinsumOp::ContractionPathCache> contraction_path_cache_ =
+      std::make_shared<EinsumOp::ContractionPathCache>();
 };
 
 // Prologue:
@@ -142,6 +183,9 @@ class EinsumComputePreprocessor final {
   // Get the number of subscript indices (subscript labels) in the einsum equation
   int64_t GetNumSubscriptIndices() const;
 
+  // Get the order in which the (preprocessed) inputs are to be contracted pair-wise
+  const EinsumOp::ContractionPath& GetContractionPath() const;
+
   // Pass-in device specific functions
   // (Pass-in CPU implementation or CUDA implementation function depending on the kernel using this class)
   void SetDeviceHelpers(const EinsumOp::DeviceHelpers::Diagonal& diagonal_func,
@@ -164,6 +208,9 @@ class EinsumComputePreprocessor final {
 
   Status PreprocessInputs();
 
+  // Chooses the contraction order with the lowest number of multiply-adds based on the homogenized input dims
+  void CalculateContractionPath();
+
   // private members
   // Instance of EinsumEquationPreprocessor
   EinsumEquationPreprocessor einsum_equation_preprocessor_;
@@ -206,6 +253,9 @@ class EinsumComputePreprocessor final {
   // Holds the final calculated output dimensions
   TensorShapeVector output_dims_;
 
+  // Order in which the inputs are contracted pair-wise
+  EinsumOp::ContractionPath contraction_path_;
+
   // All subscript indices in the equation for each input
   std::vector<std::vector<int64_t>> input_subscript_indices_;
 
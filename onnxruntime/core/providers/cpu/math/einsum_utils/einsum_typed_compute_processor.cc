@@ -194,6 +194,7 @@ std::unique_ptr<Tensor> EinsumTypedComputeProcessor<T>::PairwiseOperandProcess(c
   }
 
   // Permutate the left operand so that the axes order go like this: [lro, lo, reduce_dims, ro]
+  // If it is already ordered as [lro, reduce_dims, lo, ro], it is multiplied transposed instead
   TensorShapeVector reshaped_dims;
   InlinedVector<size_t> left_permutation;
   left_permutation.reserve(lro.size() + lo.size() + reduce_dims.size() + ro.size());
@@ -204,26 +205,34 @@ std::unique_ptr<Tensor> EinsumTypedComputeProcessor<T>::PairwiseOperandProcess(c
     left_permutation.push_back(onnxruntime::narrow<size_t>(a));
   }
   left_permutation.insert(left_permutation.end(), ro.begin(), ro.end());
-  if (EinsumOp::IsTransposeRequired(current_left ? current_left->Shape().NumDimensions() : left_dims.size(),
-                                    left_permutation)) {
-    if (current_left && IsTransposeReshapeForEinsum(left_permutation,
-                                                    current_left->Shape().GetDims(),
-                                                    reshaped_dims)) {
-      // This can be done because current_* tensors (if they exist) and output tensors are
-      // intermediate tensors and cannot be input tensors to the Einsum node itself
-      // (which are immutable).
-      // Covered by ExplicitEinsumAsTensorContractionReshapeLeft.
-      current_left->Reshape(reshaped_dims);
+
+  InlinedVector<size_t> left_permutation_transposed;
+  left_permutation_transposed.reserve(left_permutation.size());
+  left_permutation_transposed.insert(left_permutation_transposed.end(), lro.begin(), lro.end());
+  for (auto& a : reduce_dims) {
+    left_permutation_transposed.push_back(onnxruntime::narrow<size_t>(a));
+  }
+  left_permutation_transposed.insert(left_permutation_transposed.end(), lo.begin(), lo.end());
+  left_permutation_transposed.insert(left_permutation_transposed.end(), ro.begin(), ro.end());
+
+  // MatMul only reads the buffer with the [lro, lo, reduce_dims] (or [lro, reduce_dims, lo]) view, so a permutation
+  // that only moves dims of value 1 needs neither a transpose nor a reshape, even for the op's inputs.
+  // Covered by ExplicitEinsumAsTensorContractionReshapeLeft.
+  bool transpose_left = false;
+  const auto current_left_dims = current_left ? current_left->Shape().GetDims() : left_dims;
+  if (!IsTransposeReshapeForEinsum(left_permutation, current_left_dims, reshaped_dims)) {
+    if (IsTransposeReshapeForEinsum(left_permutation_transposed, current_left_dims, reshaped_dims)) {
+      transpose_left = true;
     } else {
       // Covered by ExplicitEinsumAsTensorContraction, DiagonalWithMatmul, ...
-      current_left = EinsumOp::Transpose(current_left ? *current_left : left,
-                                         current_left ? current_left->Shape().GetDims() : left_dims,
+      current_left = EinsumOp::Transpose(current_left ? *current_left : left, current_left_dims,
                                          left_permutation, allocator_, einsum_ep_assets_,
                                          device_transpose_func_);
     }
   }
 
   // Permutate the right operand so that the axes order go like this: [lro, reduce_dims, ro, lo]
+  // If it is already ordered as [lro, ro, reduce_dims, lo], it is multiplied transposed instead
   InlinedVector<size_t> right_permutation;
   right_permutation.reserve(lro.size() + lo.size() + reduce_dims.size() + ro.size());
   right_permutation.insert(right_permutation.end(), lro.begin(), lro.end());
@@ -233,18 +242,26 @@ std::unique_ptr<Tensor> EinsumTypedComputeProcessor<T>::PairwiseOperandProcess(c
   }
   right_permutation.insert(right_permutation.end(), ro.begin(), ro.end());
   right_permutation.insert(right_permutation.end(), lo.begin(), lo.end());
-  if (EinsumOp::IsTransposeRequired(current_right ? current_right->Shape().GetDims().size() : right_dims.size(),
-                                    right_permutation)) {
-    if (current_right && IsTransposeReshapeForEinsum(right_permutation,
-                                                     current_right->Shape().GetDims(),
-                                                     reshaped_dims)) {
-      // See note following the previous call of function IsTransposeReshapeForEinsum.
-      // Covered by ExplicitEinsumAsBatchedMatmulWithBroadcasting_1, ExplicitEinsumAsMatmul_2, ...
-      current_right->Reshape(reshaped_dims);
+
+  InlinedVector<size_t> right_permutation_transposed;
+  right_permutation_transposed.reserve(right_permutation.size());
+  right_permutation_transposed.insert(right_permutation_transposed.end(), lro.begin(), lro.end());
+  right_permutation_transposed.insert(right_permutation_transposed.end(), ro.begin(), ro.end());
+  for (auto& a : reduce_dims) {
+    right_permutation_transposed.push_back(onnxruntime::narrow<size_t>(a));
+  }
+  right_permutation_transposed.insert(right_permutation_transposed.end(), lo.begin(), lo.end());
+
+  // See the note on the left operand.
+  // Covered by ExplicitEinsumAsBatchedMatmulWithBroadcasting_1, ExplicitEinsumAsMatmul_2, ...
+  bool transpose_right = false;
+  const auto current_right_dims = current_right ? current_right->Shape().GetDims() : right_dims;
+  if (!IsTransposeReshapeForEinsum(right_permutation, current_right_dims, reshaped_dims)) {
+    if (IsTransposeReshapeForEinsum(right_permutation_transposed, current_right_dims, reshaped_dims)) {
+      transpose_right = true;
     } else {
       // Covered by DiagonalWithMatmul, ExplicitEinsumAsBatchedMatmul, ...
-      current_right = EinsumOp::Transpose(current_right ? *current_right : right,
-                                          current_right ? current_right->Shape().GetDims() : right_dims,
+      current_right = EinsumOp::Transpose(current_right ? *current_right : right, current_right_dims,
                                           right_permutation, allocator_, einsum_ep_assets_,
                                           device_transpose_func_);
     }
@@ -308,7 +325,8 @@ std::unique_ptr<Tensor> EinsumTypedComputeProcessor<T>::PairwiseOperandProcess(c
   // Multiply the mutated inputs
   auto output = EinsumOp::MatMul<T>(current_left ? *current_left : left, TensorShapeVector{lro_size, lo_size, reduced_size},
                                     current_right ? *current_right : right, TensorShapeVector{lro_size, reduced_size, ro_size},
-                                    allocator_, tp_, einsum_ep_assets_, device_matmul_func_);
+                                    allocator_, tp_, einsum_ep_assets_, device_matmul_func_,
+                                    transpose_left, transpose_right);
 
   output->Reshape(output_dims);
 
@@ -357,10 +375,9 @@ Status EinsumTypedComputeProcessor<T>::Run() {
 
   auto num_inputs = context_->InputCount();
 
-  // Pre-process the first input so as to reduce any dims that only it has
-  std::unique_ptr<const Tensor> result;
-
-  {
+  // Reduce the dims that only the input has and finalize the output if there is a single input
+  if (num_inputs == 1) {
+    std::unique_ptr<const Tensor> result;
     TensorShapeVector reduced_dims;
     TensorShapeVector preserved_dims;                                           // dims which were not reduced
     reduced_dims.reserve(onnxruntime::narrow<size_t>(num_subscript_labels));    // num_subscript_labels is the upper bound. No harm in over-reserving.
@@ -374,51 +391,73 @@ Status EinsumTypedComputeProcessor<T>::Run() {
       }
     }
 
-    // Reduce the dims that are last seen in the first input alone
     if (reduced_dims.size() != 0) {
       result = EinsumOp::ReduceSum<T>(preprocessed_inputs[0] ? *preprocessed_inputs[0] : *raw_inputs[0],
                                       homogenized_input_dims[0].GetDims(), reduced_dims, allocator_, tp_,
                                       einsum_ep_assets_, device_reduce_sum_func_);
-    } else {
+    } else if (preprocessed_inputs[0]) {
       // Check if there is a pre-processed version of this input
       // If so assign it to result
-      if (preprocessed_inputs[0]) {
-        result = std::move(preprocessed_inputs[0]);
-      }
+      result = std::move(preprocessed_inputs[0]);
     }
 
-    // Finalize the output at this stage if num_inputs == 1
-    if (num_inputs == 1) {
-      // Finalize the output by applying any transpose required to get
-      // it to the required output ordering and move it to the op's output
-      FinalizeOutput(result ? *result : *raw_inputs[0], preserved_dims);
+    // Finalize the output by applying any transpose required to get
+    // it to the required output ordering and move it to the op's output
+    FinalizeOutput(result ? *result : *raw_inputs[0], preserved_dims);
 
-      return Status::OK();
-    }
+    return Status::OK();
   }
 
-  // Process the operands in a pair-wise fashion
+  // Process the operands in a pair-wise fashion, in the order chosen by the preprocessor.
+  // Each step replaces the first operand of the pair with their product and removes the second one.
   {
-    bool is_final_pair = false;
-    // Keep processing each input pair-wise
-    for (int input = 1; input < num_inputs; ++input) {
+    const auto& subscript_indices_to_output_indices =
+        einsum_compute_preprocessor_.GetMappedSubscriptIndicesToOutputindices();
+    const auto& contraction_path = einsum_compute_preprocessor_.GetContractionPath();
+
+    // Use either the preprocessed inputs (if it is available) or the corresponding raw inputs
+    std::vector<std::unique_ptr<const Tensor>> owned_operands;
+    std::vector<const Tensor*> operands;
+    std::vector<TensorShape> operand_dims;
+    owned_operands.reserve(num_inputs);
+    operands.reserve(num_inputs);
+    operand_dims.reserve(num_inputs);
+    for (int input = 0; input < num_inputs; ++input) {
+      operands.push_back(preprocessed_inputs[input] ? preprocessed_inputs[input].get() : raw_inputs[input]);
+      operand_dims.push_back(homogenized_input_dims[input]);
+      owned_operands.push_back(std::move(preprocessed_inputs[input]));
+    }
+
+    for (size_t step = 0; step < contraction_path.size(); ++step) {
+      const size_t first = contraction_path[step].first;
+      const size_t second = contraction_path[step].second;
+
       TensorShapeVector reduced_dims;
       reduced_dims.reserve(onnxruntime::narrow<size_t>(num_subscript_labels));  // num_subscript_labels is the upper bound. No harm in over-reserving by a small margin.
       for (int64_t dim = 0; dim < num_subscript_labels; ++dim) {
-        if (mapped_indices_to_last_input_index[onnxruntime::narrow<size_t>(dim)] == input) {
-          // This is the last input we are seeing this dimension (and it doesn't occur in the output), so reduce along the dimension
+        // Reduce along the dimension if it doesn't occur in the output and no other operand left needs it
+        if (subscript_indices_to_output_indices[onnxruntime::narrow<size_t>(dim)] != -1) {
+          continue;
+        }
+        bool needed_later = false;
+        for (size_t k = 0; k < operands.size() && !needed_later; ++k) {
+          needed_later = k != first && k != second && operand_dims[k][onnxruntime::narrow<size_t>(dim)] > 1;
+        }
+        if (!needed_later) {
           reduced_dims.push_back(dim);
         }
       }
-      if (input == num_inputs - 1) {
-        is_final_pair = true;
-      }
-      // Use either the preprocessed inputs (if it is available) or the corresponding raw inputs
-      result = PairwiseOperandProcess(result ? *result : *raw_inputs[0],
-                                      result ? result->Shape() : homogenized_input_dims[0],
-                                      preprocessed_inputs[input] ? *preprocessed_inputs[input] : *raw_inputs[input],
-                                      homogenized_input_dims[input],
-                                      reduced_dims, is_final_pair);
+
+      auto result = PairwiseOperandProcess(*operands[first], operand_dims[first],
+                                           *operands[second], operand_dims[second],
+                                           reduced_dims, step + 1 == contraction_path.size());
+
+      operand_dims[first] = result->Shape();
+      operands[first] = result.get();
+      owned_operands[first] = std::move(result);
+      operands.erase(operands.begin() + second);
+      operand_dims.erase(operand_dims.begin() + second);
+      owned_operands.erase(owned_operands.begin() + second);
     }
   }
 
@@ -76,12 +76,27 @@ void Exp<float>::operator()(std::ptrdiff_t first, std::ptrdiff_t last) const {
 }
 }  // namespace functors
 
-#define REG_ELEMENTWISE_TYPED_KERNEL(OP_TYPE, VERSION, TYPE, KERNEL_CLASS)         \
-  ONNX_CPU_OPERATOR_TYPED_KERNEL(                                                  \
-      OP_TYPE,                                                                     \
-      VERSION,                                                                     \
-      TYPE,                                                                        \
-      KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<TYPE>()), \
+// The kernels are coefficient-wise so the output can reuse the buffer of input 0 when it has the output's size,
+// which is only possible when input 0 is not broadcast. The binary variants also allow reusing input 1, which is
+// not safe for kernels like Max_6 that write input 0 to the output before reading the other inputs.
+#define REG_ELEMENTWISE_TYPED_KERNEL(OP_TYPE, VERSION, TYPE, KERNEL_CLASS)          \
+  ONNX_CPU_OPERATOR_TYPED_KERNEL(                                                   \
+      OP_TYPE,                                                                      \
+      VERSION,                                                                      \
+      TYPE,                                                                         \
+      KernelDefBuilder()                                                            \
+          .TypeConstraint("T", DataTypeImpl::GetTensorType<TYPE>())                 \
+          .MayInplace(0, 0),                                                        \
+      KERNEL_CLASS<TYPE>);
+
+#define REG_ELEMENTWISE_BINARY_TYPED_KERNEL(OP_TYPE, VERSION, TYPE, KERNEL_CLASS)   \
+  ONNX_CPU_OPERATOR_TYPED_KERNEL(                                                   \
+      OP_TYPE,                                                                      \
+      VERSION,                                                                      \
+      TYPE,                                                                         \
+      KernelDefBuilder()                                                            \
+          .TypeConstraint("T", DataTypeImpl::GetTensorType<TYPE>())                 \
+          .MayInplace({{0, 0}, {1, 0}}),                                            \
       KERNEL_CLASS<TYPE>);
 
 #define REG_ELEMENTWISE_LOGICALOP_TYPED_KERNEL(OP_TYPE, VERSION, TYPE, KERNEL_CLASS) \
@@ -94,12 +109,24 @@ void Exp<float>::operator()(std::ptrdiff_t first, std::ptrdiff_t last) const {
           .TypeConstraint("T1", DataTypeImpl::GetTensorType<bool>()),                \
       KERNEL_CLASS<TYPE>);
 
-#define REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(OP_TYPE, VERSION_FROM, VERSION_TO, TYPE, KERNEL_CLASS) \
-  ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(                                                           \
-      OP_TYPE,                                                                                        \
-      VERSION_FROM, VERSION_TO,                                                                       \
-      TYPE,                                                                                           \
-      KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<TYPE>()),                    \
+#define REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(OP_TYPE, VERSION_FROM, VERSION_TO, TYPE, KERNEL_CLASS)        \
+  ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(                                                                  \
+      OP_TYPE,                                                                                               \
+      VERSION_FROM, VERSION_TO,                                                                              \
+      TYPE,                                                                                                  \
+      KernelDefBuilder()                                                                                     \
+          .TypeConstraint("T", DataTypeImpl::GetTensorType<TYPE>())                                          \
+          .MayInplace(0, 0),                                                                                 \
+      KERNEL_CLASS<TYPE>);
+
+#define REG_ELEMENTWISE_BINARY_VERSIONED_TYPED_KERNEL(OP_TYPE, VERSION_FROM, VERSION_TO, TYPE, KERNEL_CLASS) \
+  ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(                                                                  \
+      OP_TYPE,                                                                                               \
+      VERSION_FROM, VERSION_TO,                                                                              \
+      TYPE,                                                                                                  \
+      KernelDefBuilder()                                                                                     \
+          .TypeConstraint("T", DataTypeImpl::GetTensorType<TYPE>())                                          \
+          .MayInplace({{0, 0}, {1, 0}}),                                                                     \
       KERNEL_CLASS<TYPE>);
 
 #define REG_ELEMENTWISE_LOGICALOP_VERSIONED_TYPED_KERNEL(OP_TYPE, VERSION_FROM, VERSION_TO, TYPE, KERNEL_CLASS) \
@@ -117,7 +144,8 @@ void Exp<float>::operator()(std::ptrdiff_t first, std::ptrdiff_t last) const {
       OP_TYPE,                                                                   \
       VERSION,                                                                   \
       KernelDefBuilder()                                                         \
-          .TypeConstraint("T", CONSTRAINTS),                                     \
+          .TypeConstraint("T", CONSTRAINTS)                                      \
+          .MayInplace(0, 0),                                                     \
       KERNEL_CLASS);
 
 #define REG_ELEMENTWISE_VERSIONED_KERNEL_NONT(OP_TYPE, VERSION_FROM, VERSION_TO, KERNEL_CLASS, \
@@ -127,7 +155,8 @@ void Exp<float>::operator()(std::ptrdiff_t first, std::ptrdiff_t last) const {
       VERSION_FROM,                                                                            \
       VERSION_TO,                                                                              \
       KernelDefBuilder()                                                                       \
-          .TypeConstraint("T", CONSTRAINTS),                                                   \
+          .TypeConstraint("T", CONSTRAINTS)                                                    \
+          .MayInplace(0, 0),                                                                   \
       KERNEL_CLASS);
 
 #define REG_ELEMENTWISE_KERNEL_NONT_2(OP_TYPE, VERSION, KERNEL_CLASS, \
@@ -138,7 +167,8 @@ void Exp<float>::operator()(std::ptrdiff_t first, std::ptrdiff_t last) const {
       VERSION,                                                        \
       KernelDefBuilder()                                              \
           .TypeConstraint("T", T1_CONSTRAINTS)                        \
-          .TypeConstraint("T1", T2_CONSTRAINTS),                      \
+          .TypeConstraint("T1", T2_CONSTRAINTS)                       \
+          .MayInplace(0, 0),                                          \
       KERNEL_CLASS);
 
 #define REG_ELEMENTWISE_VERSIONED_KERNEL_NONT_2(OP_TYPE, VERSION_FROM, VERSION_TO, KERNEL_CLASS, \
@@ -150,100 +180,101 @@ void Exp<float>::operator()(std::ptrdiff_t first, std::ptrdiff_t last) const {
       VERSION_TO,                                                                                \
       KernelDefBuilder()                                                                         \
           .TypeConstraint("T", T1_CONSTRAINTS)                                                   \
-          .TypeConstraint("T1", T2_CONSTRAINTS),                                                 \
+          .TypeConstraint("T1", T2_CONSTRAINTS)                                                  \
+          .MayInplace(0, 0),                                                                     \
       KERNEL_CLASS);
 
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Add, 7, 12, float, Add);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Add, 7, 12, double, Add);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Add, 7, 12, int32_t, Add);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Add, 7, 12, int64_t, Add);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Add, 7, 12, uint32_t, Add);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Add, 7, 12, uint64_t, Add);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Add, 13, 13, float, Add);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Add, 13, 13, double, Add);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Add, 13, 13, int32_t, Add);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Add, 13, 13, int64_t, Add);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Add, 13, 13, uint32_t, Add);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Add, 13, 13, uint64_t, Add);
-REG_ELEMENTWISE_TYPED_KERNEL(Add, 14, float, Add);
-REG_ELEMENTWISE_TYPED_KERNEL(Add, 14, double, Add);
-REG_ELEMENTWISE_TYPED_KERNEL(Add, 14, int8_t, Add);
-REG_ELEMENTWISE_TYPED_KERNEL(Add, 14, int16_t, Add);
-REG_ELEMENTWISE_TYPED_KERNEL(Add, 14, int32_t, Add);
-REG_ELEMENTWISE_TYPED_KERNEL(Add, 14, int64_t, Add);
-REG_ELEMENTWISE_TYPED_KERNEL(Add, 14, uint8_t, Add);
-REG_ELEMENTWISE_TYPED_KERNEL(Add, 14, uint16_t, Add);
-REG_ELEMENTWISE_TYPED_KERNEL(Add, 14, uint32_t, Add);
-REG_ELEMENTWISE_TYPED_KERNEL(Add, 14, uint64_t, Add);
-
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Sub, 7, 12, float, Sub);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Sub, 7, 12, double, Sub);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Sub, 7, 12, int32_t, Sub);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Sub, 7, 12, int64_t, Sub);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Sub, 7, 12, uint32_t, Sub);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Sub, 7, 12, uint64_t, Sub);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Sub, 13, 13, float, Sub);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Sub, 13, 13, double, Sub);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Sub, 13, 13, int32_t, Sub);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Sub, 13, 13, int64_t, Sub);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Sub, 13, 13, uint32_t, Sub);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Sub, 13, 13, uint64_t, Sub);
-REG_ELEMENTWISE_TYPED_KERNEL(Sub, 14, float, Sub);
-REG_ELEMENTWISE_TYPED_KERNEL(Sub, 14, double, Sub);
-REG_ELEMENTWISE_TYPED_KERNEL(Sub, 14, int8_t, Sub);
-REG_ELEMENTWISE_TYPED_KERNEL(Sub, 14, int16_t, Sub);
-REG_ELEMENTWISE_TYPED_KERNEL(Sub, 14, int32_t, Sub);
-REG_ELEMENTWISE_TYPED_KERNEL(Sub, 14, int64_t, Sub);
-REG_ELEMENTWISE_TYPED_KERNEL(Sub, 14, uint8_t, Sub);
-REG_ELEMENTWISE_TYPED_KERNEL(Sub, 14, uint16_t, Sub);
-REG_ELEMENTWISE_TYPED_KERNEL(Sub, 14, uint32_t, Sub);
-REG_ELEMENTWISE_TYPED_KERNEL(Sub, 14, uint64_t, Sub);
-
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Mul, 7, 12, float, Mul);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Mul, 7, 12, double, Mul);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Mul, 7, 12, int32_t, Mul);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Mul, 7, 12, int64_t, Mul);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Mul, 7, 12, uint32_t, Mul);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Mul, 7, 12, uint64_t, Mul);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Mul, 13, 13, float, Mul);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Mul, 13, 13, double, Mul);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Mul, 13, 13, int32_t, Mul);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Mul, 13, 13, int64_t, Mul);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Mul, 13, 13, uint32_t, Mul);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Mul, 13, 13, uint64_t, Mul);
-REG_ELEMENTWISE_TYPED_KERNEL(Mul, 14, float, Mul);
-REG_ELEMENTWISE_TYPED_KERNEL(Mul, 14, double, Mul);
-REG_ELEMENTWISE_TYPED_KERNEL(Mul, 14, int8_t, Mul);
-REG_ELEMENTWISE_TYPED_KERNEL(Mul, 14, int16_t, Mul);
-REG_ELEMENTWISE_TYPED_KERNEL(Mul, 14, int32_t, Mul);
-REG_ELEMENTWISE_TYPED_KERNEL(Mul, 14, int64_t, Mul);
-REG_ELEMENTWISE_TYPED_KERNEL(Mul, 14, uint8_t, Mul);
-REG_ELEMENTWISE_TYPED_KERNEL(Mul, 14, uint16_t, Mul);
-REG_ELEMENTWISE_TYPED_KERNEL(Mul, 14, uint32_t, Mul);
-REG_ELEMENTWISE_TYPED_KERNEL(Mul, 14, uint64_t, Mul);
-
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Div, 7, 12, float, Div);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Div, 7, 12, double, Div);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Div, 7, 12, int32_t, Div);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Div, 7, 12, int64_t, Div);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Div, 7, 12, uint32_t, Div);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Div, 7, 12, uint64_t, Div);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Div, 13, 13, float, Div);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Div, 13, 13, double, Div);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Div, 13, 13, int32_t, Div);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Div, 13, 13, int64_t, Div);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Div, 13, 13, uint32_t, Div);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Div, 13, 13, uint64_t, Div);
-REG_ELEMENTWISE_TYPED_KERNEL(Div, 14, float, Div);
-REG_ELEMENTWISE_TYPED_KERNEL(Div, 14, double, Div);
-REG_ELEMENTWISE_TYPED_KERNEL(Div, 14, int8_t, Div);
-REG_ELEMENTWISE_TYPED_KERNEL(Div, 14, int16_t, Div);
-REG_ELEMENTWISE_TYPED_KERNEL(Div, 14, int32_t, Div);
-REG_ELEMENTWISE_TYPED_KERNEL(Div, 14, int64_t, Div);
-REG_ELEMENTWISE_TYPED_KERNEL(Div, 14, uint8_t, Div);
-REG_ELEMENTWISE_TYPED_KERNEL(Div, 14, uint16_t, Div);
-REG_ELEMENTWISE_TYPED_KERNEL(Div, 14, uint32_t, Div);
-REG_ELEMENTWISE_TYPED_KERNEL(Div, 14, uint64_t, Div);
+REG_ELEMENTWISE_BINARY_VERSIONED_TYPED_KERNEL(Add, 7, 12, float, Add);
+REG_ELEMENTWISE_BINARY_VERSIONED_TYPED_KERNEL(Add, 7, 12, double, Add);
+REG_ELEMENTWISE_BINARY_VERSIONED_TYPED_KERNEL(Add, 7, 12, int32_t, Add);
+REG_ELEMENTWISE_BINARY_VERSIONED_TYPED_KERNEL(Add, 7, 12, int64_t, Add);
+REG_ELEMENTWISE_BINARY_VERSIONED_TYPED_KERNEL(Add, 7, 12, uint32_t, Add);
+REG_ELEMENTWISE_BINARY_VERSIONED_TYPED_KERNEL(Add, 7, 12, uint64_t, Add);
+REG_ELEMENTWISE_BINARY_VERSIONED_TYPED_KERNEL(Add, 13, 13, float, Add);
+REG_ELEMENTWISE_BINARY_VERSIONED_TYPED_KERNEL(Add, 13, 13, double, Add);
+REG_ELEMENTWISE_BINARY_VERSIONED_TYPED_KERNEL(Add, 13, 13, int32_t, Add);
+REG_ELEMENTWISE_BINARY_VERSIONED_TYPED_KERNEL(Add, 13, 13, int64_t, Add);
+REG_ELEMENTWISE_BINARY_VERSIONED_TYPED_KERNEL(Add, 13, 13, uint32_t, Add);
+REG_ELEMENTWISE_BINARY_VERSIONED_TYPED_KERNEL(Add, 13, 13, uint64_t, Add);
+REG_ELEMENTWISE_BINARY_TYPED_KERNEL(Add, 14, float, Add);
+REG_ELEMENTWISE_BINARY_TYPED_KERNEL(Add, 14, double, Add);
+REG_ELEMENTWISE_BINARY_TYPED_KERNEL(Add, 14, int8_t, Add);
+REG_ELEMENTWISE_BINARY_TYPED_KERNEL(Add, 14, int16_t, Add);
+REG_ELEMENTWISE_BINARY_TYPED_KERNEL(Add, 14, int32_t, Add);
+REG_ELEMENTWISE_BINARY_TYPED_KERNEL(Add, 14, int64_t, Add);
+REG_ELEMENTWISE_BINARY_TYPED_KERNEL(Add, 14, uint8_t, Add);
+REG_ELEMENTWISE_BINARY_TYPED_KERNEL(Add, 14, uint16_t, Add);
+REG_ELEMENTWISE_BINARY_TYPED_KERNEL(Add, 14, uint32_t, Add);
+REG_ELEMENTWISE_BINARY_TYPED_KERNEL(Add, 14, uint64_t, Add);
+
+REG_ELEMENTWISE_BINARY_VERSIONED_TYPED_KERNEL(Sub, 7, 12, float, Sub);
+REG_ELEMENTWISE_BINARY_VERSIONED_TYPED_KERNEL(Sub, 7, 12, double, Sub);
+REG_ELEMENTWISE_BINARY_VERSIONED_TYPED_KERNEL(Sub, 7, 12, int32_t, Sub);
+REG_ELEMENTWISE_BINARY_VERSIONED_TYPED_KERNEL(Sub, 7, 12, int64_t, Sub);
+REG_ELEMENTWISE_BINARY_VERSIONED_TYPED_KERNEL(Sub, 7, 12, uint32_t, Sub);
+REG_ELEMENTWISE_BINARY_VERSIONED_TYPED_KERNEL(Sub, 7, 12, uint64_t, Sub);
+REG_ELEMENTWISE_BINARY_VERSIONED_TYPED_KERNEL(Sub, 13, 13, float, Sub);
+REG_ELEMENTWISE_BINARY_VERSIONED_TYPED_KERNEL(Sub, 13, 13, double, Sub);
+REG_ELEMENTWISE_BINARY_VERSIONED_TYPED_KERNEL(Sub, 13, 13, int32_t, Sub);
+REG_ELEMENTWISE_BINARY_VERSIONED_TYPED_KERNEL(Sub, 13, 13, int64_t, Sub);
+REG_ELEMENTWISE_BINARY_VERSIONED_TYPED_KERNEL(Sub, 13, 13, uint32_t, Sub);
+REG_ELEMENTWISE_BINARY_VERSIONED_TYPED_KERNEL(Sub, 13, 13, uint64_t, Sub);
+REG_ELEMENTWISE_BINARY_TYPED_KERNEL(Sub, 14, float, Sub);
+REG_ELEMENTWISE_BINARY_TYPED_KERNEL(Sub, 14, double, Sub);
+REG_ELEMENTWISE_BINARY_TYPED_KERNEL(Sub, 14, int8_t, Sub);
+REG_ELEMENTWISE_BINARY_TYPED_KERNEL(Sub, 14, int16_t, Sub);
+REG_ELEMENTWISE_BINARY_TYPED_KERNEL(Sub, 14, int32_t, Sub);
+REG_ELEMENTWISE_BINARY_TYPED_KERNEL(Sub, 14, int64_t, Sub);
+REG_ELEMENTWISE_BINARY_TYPED_KERNEL(Sub, 14, uint8_t, Sub);
+REG_ELEMENTWISE_BINARY_TYPED_KERNEL(Sub, 14, uint16_t, Sub);
+REG_ELEMENTWISE_BINARY_TYPED_KERNEL(Sub, 14, uint32_t, Sub);
+REG_ELEMENTWISE_BINARY_TYPED_KERNEL(Sub, 14, uint64_t, Sub);
+
+REG_ELEMENTWISE_BINARY_VERSIONED_TYPED_KERNEL(Mul, 7, 12, float, Mul);
+REG_ELEMENTWISE_BINARY_VERSIONED_TYPED_KERNEL(Mul, 7, 12, double, Mul);
+REG_ELEMENTWISE_BINARY_VERSIONED_TYPED_KERNEL(Mul, 7, 12, int32_t, Mul);
+REG_ELEMENTWISE_BINARY_VERSIONED_TYPED_KERNEL(Mul, 7, 12, int64_t, Mul);
+REG_ELEMENTWISE_BINARY_VERSIONED_TYPED_KERNEL(Mul, 7, 12, uint32_t, Mul);
+REG_ELEMENTWISE_BINARY_VERSIONED_TYPED_KERNEL(Mul, 7, 12, uint64_t, Mul);
+REG_ELEMENTWISE_BINARY_VERSIONED_TYPED_KERNEL(Mul, 13, 13, float, Mul);
+REG_ELEMENTWISE_BINARY_VERSIONED_TYPED_KERNEL(Mul, 13, 13, double, Mul);
+REG_ELEMENTWISE_BINARY_VERSIONED_TYPED_KERNEL(Mul, 13, 13, int32_t, Mul);
+REG_ELEMENTWISE_BINARY_VERSIONED_TYPED_KERNEL(Mul, 13, 13, int64_t, Mul);
+REG_ELEMENTWISE_BINARY_VERSIONED_TYPED_KERNEL(Mul, 13, 13, uint32_t, Mul);
+REG_ELEMENTWISE_BINARY_VERSIONED_TYPED_KERNEL(Mul, 13, 13, uint64_t, Mul);
+REG_ELEMENTWISE_BINARY_TYPED_KERNEL(Mul, 14, float, Mul);
+REG_ELEMENTWISE_BINARY_TYPED_KERNEL(Mul, 14, double, Mul);
+REG_ELEMENTWISE_BINARY_TYPED_KERNEL(Mul, 14, int8_t, Mul);
+REG_ELEMENTWISE_BINARY_TYPED_KERNEL(Mul, 14, int16_t, Mul);
+REG_ELEMENTWISE_BINARY_TYPED_KERNEL(Mul, 14, int32_t, Mul);
+REG_ELEMENTWISE_BINARY_TYPED_KERNEL(Mul, 14, int64_t, Mul);
+REG_ELEMENTWISE_BINARY_TYPED_KERNEL(Mul, 14, uint8_t, Mul);
+REG_ELEMENTWISE_BINARY_TYPED_KERNEL(Mul, 14, uint16_t, Mul);
+REG_ELEMENTWISE_BINARY_TYPED_KERNEL(Mul, 14, uint32_t, Mul);
+REG_ELEMENTWISE_BINARY_TYPED_KERNEL(Mul, 14, uint64_t, Mul);
+
+REG_ELEMENTWISE_BINARY_VERSIONED_TYPED_KERNEL(Div, 7, 12, float, Div);
+REG_ELEMENTWISE_BINARY_VERSIONED_TYPED_KERNEL(Div, 7, 12, double, Div);
+REG_ELEMENTWISE_BINARY_VERSIONED_TYPED_KERNEL(Div, 7, 12, int32_t, Div);
+REG_ELEMENTWISE_BINARY_VERSIONED_TYPED_KERNEL(Div, 7, 12, int64_t, Div);
+REG_ELEMENTWISE_BINARY_VERSIONED_TYPED_KERNEL(Div, 7, 12, uint32_t, Div);
+REG_ELEMENTWISE_BINARY_VERSIONED_TYPED_KERNEL(Div, 7, 12, uint64_t, Div);
+REG_ELEMENTWISE_BINARY_VERSIONED_TYPED_KERNEL(Div, 13, 13, float, Div);
+REG_ELEMENTWISE_BINARY_VERSIONED_TYPED_KERNEL(Div, 13, 13, double, Div);
+REG_ELEMENTWISE_BINARY_VERSIONED_TYPED_KERNEL(Div, 13, 13, int32_t, Div);
+REG_ELEMENTWISE_BINARY_VERSIONED_TYPED_KERNEL(Div, 13, 13, int64_t, Div);
+REG_ELEMENTWISE_BINARY_VERSIONED_TYPED_KERNEL(Div, 13, 13, uint32_t, Div);
+REG_ELEMENTWISE_BINARY_VERSIONED_TYPED_KERNEL(Div, 13, 13, uint64_t, Div);
+REG_ELEMENTWISE_BINARY_TYPED_KERNEL(Div, 14, float, Div);
+REG_ELEMENTWISE_BINARY_TYPED_KERNEL(Div, 14, double, Div);
+REG_ELEMENTWISE_BINARY_TYPED_KERNEL(Div, 14, int8_t, Div);
+REG_ELEMENTWISE_BINARY_TYPED_KERNEL(Div, 14, int16_t, Div);
+REG_ELEMENTWISE_BINARY_TYPED_KERNEL(Div, 14, int32_t, Div);
+REG_ELEMENTWISE_BINARY_TYPED_KERNEL(Div, 14, int64_t, Div);
+REG_ELEMENTWISE_BINARY_TYPED_KERNEL(Div, 14, uint8_t, Div);
+REG_ELEMENTWISE_BINARY_TYPED_KERNEL(Div, 14, uint16_t, Div);
+REG_ELEMENTWISE_BINARY_TYPED_KERNEL(Div, 14, uint32_t, Div);
+REG_ELEMENTWISE_BINARY_TYPED_KERNEL(Div, 14, uint64_t, Div);
 
 REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Abs, 6, 12, float, Abs);
 REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Abs, 6, 12, double, Abs);
@@ -538,7 +569,8 @@ ONNX_CPU_OPERATOR_KERNEL(
     Not,
     1,
     KernelDefBuilder()
-        .TypeConstraint("T", DataTypeImpl::GetTensorType<bool>()),
+        .TypeConstraint("T", DataTypeImpl::GetTensorType<bool>())
+        .MayInplace(0, 0),
     Not);
 
 ONNX_CPU_OPERATOR_KERNEL(
@@ -546,7 +578,8 @@ ONNX_CPU_OPERATOR_KERNEL(
     7,
     KernelDefBuilder()
         .TypeConstraint("T", DataTypeImpl::GetTensorType<bool>())
-        .TypeConstraint("T1", DataTypeImpl::GetTensorType<bool>()),
+        .TypeConstraint("T1", DataTypeImpl::GetTensorType<bool>())
+        .MayInplace({{0, 0}, {1, 0}}),
     And);
 
 ONNX_CPU_OPERATOR_KERNEL(
@@ -554,7 +587,8 @@ ONNX_CPU_OPERATOR_KERNEL(
     7,
     KernelDefBuilder()
         .TypeConstraint("T", DataTypeImpl::GetTensorType<bool>())
-        .TypeConstraint("T1", DataTypeImpl::GetTensorType<bool>()),
+        .TypeConstraint("T1", DataTypeImpl::GetTensorType<bool>())
+        .MayInplace({{0, 0}, {1, 0}}),
     Or);
 
 ONNX_CPU_OPERATOR_KERNEL(
@@ -562,7 +596,8 @@ ONNX_CPU_OPERATOR_KERNEL(
     7,
     KernelDefBuilder()
         .TypeConstraint("T", DataTypeImpl::GetTensorType<bool>())
-        .TypeConstraint("T1", DataTypeImpl::GetTensorType<bool>()),
+        .TypeConstraint("T1", DataTypeImpl::GetTensorType<bool>())
+        .MayInplace({{0, 0}, {1, 0}}),
     Xor);
 
 using AllocateTensorFunc = std::unique_ptr<Tensor> (*)(const TensorAllocator& tensor_allocator,
@@ -36,15 +36,17 @@ ONNX_CPU_OPERATOR_VERSIONED_KERNEL(
     Sign,
     9,
     12,
-    KernelDefBuilder().TypeConstraint("T",
-                                      BuildKernelDefConstraintsFromTypeList<EnabledSignDataTypes>()),
+    KernelDefBuilder()
+        .TypeConstraint("T", BuildKernelDefConstraintsFromTypeList<EnabledSignDataTypes>())
+        .MayInplace(0, 0),
     Sign);
 
 ONNX_CPU_OPERATOR_KERNEL(
     Sign,
     13,
-    KernelDefBuilder().TypeConstraint("T",
-                                      BuildKernelDefConstraintsFromTypeList<EnabledSignDataTypes>()),
+    KernelDefBuilder()
+        .TypeConstraint("T", BuildKernelDefConstraintsFromTypeList<EnabledSignDataTypes>())
+        .MayInplace(0, 0),
     Sign);
 
 namespace sign_internal {
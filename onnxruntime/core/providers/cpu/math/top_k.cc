@@ -24,7 +24,10 @@
 #include "core/util/math_cpuonly.h"
 #include <queue>
 #include <algorithm>
+#include <array>
 #include <cmath>
+#include <cstring>
+#include <type_traits>
 #include <core/common/safeint.h>
 
 namespace onnxruntime {
@@ -140,6 +143,218 @@ static void SelectTopK(const Comparator& comparer,
   // the data_holder now contains the indices of the top k elements in the first k elements
 }
 
+// Radix selection of the top k values of long float rows.
+//
+// The values are mapped to unsigned keys with the same order. -0 and +0 map to the same key so equal values have equal
+// keys, and the keys are inverted when selecting the smallest values so the top k are always the largest keys.
+// The k-th largest key is found one digit at a time from histograms of the keys, then a scan of the row picks the keys
+// above it and the lowest indices with keys equal to it, which matches the tie break of the comparators.
+// Computing the keys and the first histogram is the only full pass over the row that does real work, so it is kept
+// simple enough for the compiler to vectorize and is split across threads when there is a single row.
+namespace radix_top_k {
+
+// below these sizes nth_element and the heap are as fast
+constexpr int64_t kMinRowSize = 16 * 1024;
+constexpr unsigned kMinK = 32;
+constexpr std::ptrdiff_t kMinChunkSize = 16 * 1024;
+
+// the key is split into digits of 11, 11 and 10 bits starting from the most significant bit
+constexpr int kNumDigits = 3;
+constexpr int kDigitShifts[kNumDigits] = {21, 10, 0};
+constexpr uint32_t kDigitMasks[kNumDigits] = {0x7FF, 0x7FF, 0x3FF};
+constexpr size_t kNumBuckets = 2048;
+using Histogram = std::array<uint32_t, kNumBuckets>;
+
+inline uint32_t ToKey(float value, bool largest) {
+  value = value == 0.0f ? 0.0f : value;  // -0 == +0
+  uint32_t bits;
+  memcpy(&bits, &value, sizeof(bits));
+  bits = (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+  return largest ? bits : ~bits;
+}
+
+// Finds the bucket that holds the k-th largest key. On return k is the rank of the key within the bucket and the
+// number of keys in higher buckets has been added to num_greater.
+inline uint32_t FindBucket(const uint32_t* histogram, uint32_t num_buckets, size_t& k, size_t& num_greater) {
+  for (uint32_t bucket = num_buckets; bucket-- > 0;) {
+    if (histogram[bucket] >= k) {
+      return bucket;
+    }
+
+    k -= histogram[bucket];
+    num_greater += histogram[bucket];
+  }
+
+  ORT_THROW("TopK radix select did not find ", k, " keys");
+}
+
+struct Buffers {
+  std::vector<uint32_t> keys;
+  std::vector<uint32_t> candidates;
+  std::vector<Histogram> histograms;
+  std::vector<uint8_t> has_nan;
+  std::vector<std::vector<int64_t>> greater;
+  std::vector<std::vector<int64_t>> equal;
+};
+
+// Selects the indices of the top k values in row and writes them to top_k in no particular order.
+// The row is split into chunks processed on threadpool, which can be nullptr to process it on the calling thread.
+// Returns false without selecting anything if the row contains NaN, which the keys can't order like the comparators.
+inline bool SelectTopKOfRow(const float* row, std::ptrdiff_t n, size_t k, bool largest,
+                            concurrency::ThreadPool* threadpool, Buffers& buffers, int64_t* top_k) {
+  const std::ptrdiff_t num_chunks =
+      threadpool == nullptr
+          ? 1
+          : std::max<std::ptrdiff_t>(1, std::min<std::ptrdiff_t>(
+                                            concurrency::ThreadPool::DegreeOfParallelism(threadpool),
+                                            n / kMinChunkSize));
+  const auto chunks = static_cast<size_t>(num_chunks);
+  buffers.keys.resize(static_cast<size_t>(n));
+  buffers.histograms.resize(chunks);
+  buffers.has_nan.resize(chunks);
+  buffers.greater.resize(chunks);
+  buffers.equal.resize(chunks);
+  uint32_t* keys = buffers.keys.data();
+
+  concurrency::ThreadPool::TrySimpleParallelFor(threadpool, num_chunks, [&](std::ptrdiff_t chunk) {
+    const auto work = concurrency::ThreadPool::PartitionWork(chunk, num_chunks, n);
+    Histogram& histogram = buffers.histograms[static_cast<size_t>(chunk)];
+    histogram.fill(0);
+    bool has_nan = false;
+    for (std::ptrdiff_t i = work.start; i < work.end; ++i) {
+      has_nan |= std::isnan(row[i]);
+      keys[i] = ToKey(row[i], largest);
+      ++histogram[keys[i] >> kDigitShifts[0]];
+    }
+    buffers.has_nan[static_cast<size_t>(chunk)] = has_nan;
+  });
+
+  Histogram histogram = buffers.histograms[0];
+  for (size_t chunk = 1; chunk < chunks; ++chunk) {
+    for (size_t bucket = 0; bucket < kNumBuckets; ++bucket) {
+      histogram[bucket] += buffers.histograms[chunk][bucket];
+    }
+  }
+
+  if (std::any_of(buffers.has_nan.begin(), buffers.has_nan.end(), [](uint8_t has_nan) { return has_nan != 0; })) {
+    return false;
+  }
+
+  // find the k-th largest key one digit at a time, keeping only the keys that share its leading digits
+  size_t rank = k;
+  size_t num_greater = 0;
+  uint32_t bucket = FindBucket(histogram.data(), kNumBuckets, rank, num_greater);
+  uint32_t threshold = bucket << kDigitShifts[0];
+
+  auto& candidates = buffers.candidates;
+  candidates.clear();
+  for (std::ptrdiff_t i = 0; i < n; ++i) {
+    if ((keys[i] >> kDigitShifts[0]) == bucket) {
+      candidates.push_back(keys[i]);
+    }
+  }
+
+  for (int digit = 1; digit < kNumDigits; ++digit) {
+    const int shift = kDigitShifts[digit];
+    const uint32_t mask = kDigitMasks[digit];
+    histogram.fill(0);
+    for (uint32_t key : candidates) {
+      ++histogram[(key >> shift) & mask];
+    }
+
+    bucket = FindBucket(histogram.data(), mask + 1, rank, num_greater);
+    threshold |= bucket << shift;
+    candidates.erase(std::remove_if(candidates.begin(), candidates.end(),
+                                    [shift, mask, bucket](uint32_t key) { return ((key >> shift) & mask) != bucket; }),
+                     candidates.end());
+  }
+
+  // every key above the threshold is selected. the keys equal to it fill the remaining places in index order.
+  const size_t num_equal = k - num_greater;
+  concurrency::ThreadPool::TrySimpleParallelFor(threadpool, num_chunks, [&](std::ptrdiff_t chunk) {
+    const auto work = concurrency::ThreadPool::PartitionWork(chunk, num_chunks, n);
+    auto& greater = buffers.greater[static_cast<size_t>(chunk)];
+    auto& equal = buffers.equal[static_cast<size_t>(chunk)];
+    greater.clear();
+    equal.clear();
+    for (std::ptrdiff_t i = work.start; i < work.end; ++i) {
+      if (keys[i] > threshold) {
+        greater.push_back(i);
+      } else if (keys[i] == threshold && equal.size() < num_equal) {
+        equal.push_back(i);
+      }
+    }
+  });
+
+  for (const auto& greater : buffers.greater) {
+    top_k = std::copy(greater.begin(), greater.end(), top_k);
+  }
+
+  size_t remaining = num_equal;
+  for (const auto& equal : buffers.equal) {
+    const size_t count = std::min(remaining, equal.size());
+    top_k = std::copy(equal.begin(), equal.begin() + count, top_k);
+    remaining -= count;
+  }
+
+  return true;
+}
+
+}  // namespace radix_top_k
+
+// Finds the top k elements of each row with radix_top_k::SelectTopKOfRow. Only used for float rows that are contiguous.
+template <class Comparator>
+static void FindTopKElementsRadixSelect(const float* input_data, int64_t rows, int64_t cols, const unsigned k,
+                                        bool sorted, int64_t num_threads, concurrency::ThreadPool* threadpool,
+                                        EigenMatrixMapRowMajor<float>& values_map,
+                                        EigenMatrixMapRowMajor<int64_t>& indices_map) {
+  constexpr bool largest = std::is_same_v<Comparator, GreaterValueCmp<float>>;
+
+  // with a single row the threads split the row instead
+  const bool split_rows = rows > 1;
+  if (!split_rows) {
+    num_threads = 1;
+  }
+
+  auto find_top_k = [&](std::ptrdiff_t batch) {
+    auto work = concurrency::ThreadPool::PartitionWork(batch, onnxruntime::narrow<size_t>(num_threads),
+                                                       onnxruntime::narrow<size_t>(rows));
+    Comparator comparer(input_data);
+    radix_top_k::Buffers buffers;
+    std::vector<int64_t> data_holder;
+
+    for (auto i = work.start; i < work.end; ++i) {
+      const auto row_offset = i * cols;
+      data_holder.resize(k);
+      if (radix_top_k::SelectTopKOfRow(input_data + row_offset, onnxruntime::narrow<std::ptrdiff_t>(cols), k, largest,
+                                       split_rows ? nullptr : threadpool, buffers, data_holder.data())) {
+        for (auto& idx : data_holder) {
+          idx += row_offset;
+        }
+
+        if (sorted) {
+          std::sort(data_holder.begin(), data_holder.end(), comparer);
+        }
+      } else {
+        data_holder.resize(onnxruntime::narrow<size_t>(cols));
+        SelectTopK<Comparator>(comparer, row_offset, cols, 1, 0, k, sorted, data_holder);
+      }
+
+      for (int64_t l = 0; l < k; ++l) {
+        int64_t idx = data_holder[onnxruntime::narrow<size_t>(l)];
+        values_map(i, onnxruntime::narrow<size_t>(l)) = input_data[idx];
+        indices_map(i, onnxruntime::narrow<size_t>(l)) = idx - row_offset;
+      }
+    }
+  };
+
+  if (num_threads <= 1) {
+    find_top_k(0);
+  } else {
+    concurrency::ThreadPool::TrySimpleParallelFor(threadpool, onnxruntime::narrow<ptrdiff_t>(num_threads), find_top_k);
+  }
+}
+
 // Given an input tensor 'input' and metadata values - 'k' and 'axis_parsed',
 // this method will extract the sorted top k largest/smallest elements and place them in the output tensor 'values'
 // along with the metadata output 'indices'
@@ -173,6 +388,14 @@ static void FindTopKElements(const Tensor* input, const TensorShape& input_shape
   int64_t threads_needed = static_cast<int64_t>(std::floor(input_shape.Size() * k / (128 * 1024)));
   num_threads = std::max(std::min(threads_needed, num_threads), static_cast<int64_t>(1));
 
+  if constexpr (std::is_same_v<typename Comparator::DataType, float>) {
+    if (block_slice == 1 && num_blocks >= radix_top_k::kMinRowSize && k >= radix_top_k::kMinK) {
+      FindTopKElementsRadixSelect<Comparator>(input_data, rows, cols, k, sorted, num_threads, threadpool,
+                                              values_map, indices_map);
+      return;
+    }
+  }
+
   // from testing various batch sizes relative to k, the following appears to work well as a selector.
   // tested with following combinations
   //   batch_size = [ 8, 16, 32, 64, 128, 256, 512, 1024, 2048 ]
@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 #include "core/providers/cpu/ml/array_feature_extractor.h"
+#include "core/common/inlined_containers.h"
 
 /**
 https://github.com/onnx/onnx/blob/main/onnx/defs/traditionalml/defs.cc
@@ -92,12 +93,37 @@ common::Status ArrayFeatureExtractorOp<T>::Compute(OpKernelContext* context) con
   Tensor* Z = context->Output(0, z_shape);
   T* z_data = Z->MutableData<T>();
 
+  // Group the indices into runs of consecutive values so each run is copied with a single
+  // std::copy_n (a memmove for the numeric types) instead of element by element.
+  // Common cases such as selecting a slice of the features produce a single run.
+  struct IndexRun {
+    int64_t start;
+    int64_t length;
+  };
+  InlinedVector<IndexRun> runs;
+  for (int64_t j = 0; j < num_indices; ++j) {
+    if (!runs.empty() && runs.back().start + runs.back().length == y_data[j]) {
+      ++runs.back().length;
+    } else {
+      runs.push_back({y_data[j], 1});
+    }
+  }
+
   const int64_t x_size_until_last_dim = x_shape.SizeToDimension(x_num_dims - 1);
-  for (int64_t i = 0; i < x_size_until_last_dim; ++i) {
-    for (int64_t j = 0; j < num_indices; ++j) {
-      *z_data++ = x_data[y_data[j]];
+  if (runs.size() * 2 <= static_cast<size_t>(num_indices)) {
+    for (int64_t i = 0; i < x_size_until_last_dim; ++i) {
+      for (const auto& run : runs) {
+        z_data = std::copy_n(x_data + run.start, run.length, z_data);
+      }
+      x_data += stride;
+    }
+  } else {
+    for (int64_t i = 0; i < x_size_until_last_dim; ++i) {
+      for (int64_t j = 0; j < num_indices; ++j) {
+        *z_data++ = x_data[y_data[j]];
+      }
+      x_data += stride;
     }
-    x_data += stride;
   }
 
   return Status::OK();
@@ -5,6 +5,7 @@
 #include <string>
 #include <vector>
 #include "core/common/common.h"
+#include "core/common/inlined_containers.h"
 #include "core/framework/op_kernel.h"
 
 namespace onnxruntime {
@@ -16,11 +17,32 @@ class DictVectorizerOp final : public OpKernel {
     // In some stupid models, the vocabulary could have duplicated elements.
     // We must support that, otherwise some tests will be break.
     ORT_ENFORCE(info.GetAttrs(std::is_same<AttrType, std::string>::value ? "string_vocabulary" : "int64_vocabulary", vocabulary_).IsOK());
+
+    vocabulary_index_.reserve(vocabulary_.size());
+    for (size_t i = 0, end = vocabulary_.size(); i < end; ++i) {
+      if (!vocabulary_index_.emplace(vocabulary_[i], i).second) {
+        has_duplicates_ = true;
+      }
+    }
   }
   common::Status Compute(OpKernelContext* ctx) const override {
     const auto* map = ctx->Input<std::map<AttrType, TargetType> >(0);
     auto* Y = ctx->Output(0, {1, static_cast<int64_t>(vocabulary_.size())});
     auto* y_data = Y->MutableData<TargetType>();
+
+    // Sparse inputs, where the map holds far fewer entries than the vocabulary, are scattered
+    // into the zero filled output so the cost is proportional to the size of the map.
+    if (!has_duplicates_ && map->size() < vocabulary_.size()) {
+      std::fill_n(y_data, vocabulary_.size(), TargetType());
+      for (const auto& entry : *map) {
+        auto index = vocabulary_index_.find(entry.first);
+        if (index != vocabulary_index_.end()) {
+          y_data[index->second] = entry.second;
+        }
+      }
+      return Status::OK();
+    }
+
     for (size_t i = 0, end = vocabulary_.size(); i < end; ++i) {
       auto index = map->find(vocabulary_[i]);
       if (index != map->end()) {
@@ -34,6 +56,9 @@ class DictVectorizerOp final : public OpKernel {
   }
 
   std::vector<AttrType> vocabulary_;
+  // Position of each vocabulary entry in the output. Only used if the vocabulary has no duplicates.
+  InlinedHashMap<AttrType, size_t> vocabulary_index_;
+  bool has_duplicates_ = false;
 };
 
 }  // namespace ml
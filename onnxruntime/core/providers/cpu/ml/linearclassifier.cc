@@ -36,6 +36,7 @@ LinearClassifier::LinearClassifier(const OpKernelInfo& info)
 
   using_strings_ = !classlabels_strings_.empty();
   class_count_ = static_cast<ptrdiff_t>(intercepts_.size());
+  coefficients_by_feature_ = TransposeSparseLinearCoefficients(coefficients_, class_count_);
 }
 
 // Use GEMM for the calculations, with broadcasting of intercepts
@@ -43,6 +44,7 @@ LinearClassifier::LinearClassifier(const OpKernelInfo& info)
 //
 // X: [num_batches, num_features]
 // coefficients_: [num_targets, num_features]
+// coefficients_by_feature_: [num_features, num_targets], or empty if the sparse path is disabled.
 // intercepts_: [num_targets]
 // scores: X * coefficients_^T + intercepts_: [num_batches, num_targets]
 void LinearClassifier::ComputeImpl(const gsl::span<const float> input,
@@ -60,13 +62,22 @@ void LinearClassifier::ComputeImpl(const gsl::span<const float> input,
               "Scores output is incorrect size. Expected:", scores_output_size,
               " Found:", scores_output_data.size());
 
-  TensorShape intercepts_shape({num_targets});
-  onnxruntime::Gemm<float>::ComputeGemm(CBLAS_TRANSPOSE::CblasNoTrans, CBLAS_TRANSPOSE::CblasTrans,
-                                        num_batches, num_targets, num_features,
-                                        1.f, input_data, coefficients.data(), 1.f,
-                                        intercepts.data(), &intercepts_shape,
-                                        scores_output_data.data(),
-                                        threadpool);
+  // Inputs such as the output of DictVectorizer over a large vocabulary are mostly zeros.
+  // Skip the zero features in that case rather than doing a dense GEMM.
+  if (IsSparseLinearInput(input) &&
+      coefficients_by_feature_.size() == SafeInt<size_t>(num_targets) * num_features &&
+      intercepts.size() == static_cast<size_t>(num_targets)) {
+    ComputeSparseLinear(input_data, num_batches, num_features, num_targets,
+                        coefficients_by_feature_.data(), intercepts.data(), scores_output_data.data(), threadpool);
+  } else {
+    TensorShape intercepts_shape({num_targets});
+    onnxruntime::Gemm<float>::ComputeGemm(CBLAS_TRANSPOSE::CblasNoTrans, CBLAS_TRANSPOSE::CblasTrans,
+                                          num_batches, num_targets, num_features,
+                                          1.f, input_data, coefficients.data(), 1.f,
+                                          intercepts.data(), &intercepts_shape,
+                                          scores_output_data.data(),
+                                          threadpool);
+  }
 
   float* score = scores_output_data.data();
   float* end_scores = score + (num_batches * num_targets);  // we haven't added extra targets yet so iterate the original scores
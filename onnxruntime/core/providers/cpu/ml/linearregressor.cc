@@ -23,6 +23,7 @@ LinearRegressor::LinearRegressor(const OpKernelInfo& info)
       post_transform_(MakeTransform(info.GetAttrOrDefault<std::string>("post_transform", "NONE"))) {
   ORT_THROW_IF_ERROR(info.GetAttr<int64_t>("targets", &num_targets_));
   ORT_THROW_IF_ERROR(info.GetAttrs<float>("coefficients", coefficients_));
+  coefficients_by_feature_ = TransposeSparseLinearCoefficients(coefficients_, narrow<ptrdiff_t>(num_targets_));
 
   // use the intercepts_ if they're valid
   use_intercepts_ = intercepts_.size() == static_cast<size_t>(num_targets_);
@@ -33,18 +34,31 @@ LinearRegressor::LinearRegressor(const OpKernelInfo& info)
 //
 // X: [num_batches, num_features]
 // coefficients_: [num_targets, num_features]
+// coefficients_by_feature_: [num_features, num_targets], or empty if the sparse path is disabled.
 // intercepts_: optional [num_targets].
 // Output: X * coefficients_^T + intercepts_: [num_batches, num_targets]
 template <typename T>
 static Status ComputeImpl(const Tensor& input, ptrdiff_t num_batches, ptrdiff_t num_features, ptrdiff_t num_targets,
                           const std::vector<float>& coefficients,
+                          const std::vector<float>& coefficients_by_feature,
                           const std::vector<float>* intercepts, Tensor& output,
                           POST_EVAL_TRANSFORM post_transform,
                           concurrency::ThreadPool* threadpool) {
   const T* input_data = input.Data<T>();
   T* output_data = output.MutableData<T>();
 
-  if (intercepts != nullptr) {
+  // Inputs such as the output of DictVectorizer over a large vocabulary are mostly zeros.
+  // Skip the zero features in that case rather than doing a dense GEMM.
+  bool use_sparse = false;
+  if constexpr (std::is_same_v<T, float>) {
+    use_sparse = coefficients_by_feature.size() == SafeInt<size_t>(num_targets) * num_features &&
+                 IsSparseLinearInput(input.DataAsSpan<float>());
+  }
+
+  if (use_sparse) {
+    ComputeSparseLinear(input_data, num_batches, num_features, num_targets, coefficients_by_feature.data(),
+                        intercepts != nullptr ? intercepts->data() : nullptr, output_data, threadpool);
+  } else if (intercepts != nullptr) {
     TensorShape intercepts_shape({num_targets});
     onnxruntime::Gemm<T>::ComputeGemm(CBLAS_TRANSPOSE::CblasNoTrans, CBLAS_TRANSPOSE::CblasTrans,
                                       num_batches, num_targets, num_features,
@@ -91,7 +105,7 @@ Status LinearRegressor::Compute(OpKernelContext* ctx) const {
   switch (element_type) {
     case ONNX_NAMESPACE::TensorProto_DataType_FLOAT: {
       status = ComputeImpl<float>(X, num_batches, num_features, narrow<ptrdiff_t>(num_targets_), coefficients_,
-                                  use_intercepts_ ? &intercepts_ : nullptr,
+                                  coefficients_by_feature_, use_intercepts_ ? &intercepts_ : nullptr,
                                   Y, post_transform_, tp);
 
       break;
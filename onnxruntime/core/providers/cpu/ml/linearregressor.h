@@ -19,6 +19,7 @@ class LinearRegressor final : public OpKernel {
  private:
   int64_t num_targets_;
   std::vector<float> coefficients_;
+  std::vector<float> coefficients_by_feature_;
   std::vector<float> intercepts_;
   bool use_intercepts_;
   POST_EVAL_TRANSFORM post_transform_;
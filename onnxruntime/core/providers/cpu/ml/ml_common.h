@@ -2,6 +2,8 @@
 // Licensed under the MIT License.
 
 #pragma once
+#include <algorithm>
+#include <cmath>
 #include "core/common/common.h"
 #include "core/common/safeint.h"
 #include "core/framework/op_kernel.h"
@@ -528,5 +530,112 @@ void batched_update_scores_inplace(gsl::span<T> scores, int64_t num_batches_in,
     }
   }
 }
+
+// Linear models score inputs with a non-zero ratio at or below this value by visiting
+// only the non-zero features instead of running a dense GEMM.
+static constexpr float kSparseLinearInputMaxDensity = 0.1f;
+
+// Returns true if the fraction of non-zero values in input is small enough for ComputeSparseLinear
+// to be cheaper than a dense GEMM. The non-zero values are counted branch free in blocks, and the count stops
+// as soon as it passes the limit, so a dense input is rejected after reading about a tenth of it.
+static inline bool IsSparseLinearInput(gsl::span<const float> input) {
+  if (input.empty()) {
+    return false;
+  }
+
+  constexpr size_t kBlockSize = 256;
+  const size_t max_non_zero = static_cast<size_t>(kSparseLinearInputMaxDensity * static_cast<float>(input.size()));
+  const float* data = input.data();
+  const size_t size = input.size();
+
+  size_t num_non_zero = 0;
+  for (size_t start = 0; start < size; start += kBlockSize) {
+    const size_t end = std::min(start + kBlockSize, size);
+    for (size_t i = start; i < end; ++i) {
+      num_non_zero += data[i] != 0.f ? 1 : 0;
+    }
+
+    if (num_non_zero > max_non_zero) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+// Transposes coefficients from [num_targets, num_features] to the feature-major [num_features, num_targets]
+// layout read by ComputeSparseLinear. Kernels call this once at construction.
+//
+// Returns an empty vector, which disables the sparse path, if the coefficients do not divide into num_targets rows
+// or contain a non-finite value. ComputeSparseLinear skips zero features, so 0 * inf or 0 * NaN would not poison the
+// output as it does in the dense GEMM; keeping such models on the dense path gives the same results on both paths.
+static inline std::vector<float> TransposeSparseLinearCoefficients(gsl::span<const float> coefficients,
+                                                                   ptrdiff_t num_targets) {
+  std::vector<float> coefficients_by_feature;
+  if (num_targets <= 0 || coefficients.empty() || coefficients.size() % static_cast<size_t>(num_targets) != 0) {
+    return coefficients_by_feature;
+  }
+
+  for (const float value : coefficients) {
+    if (!std::isfinite(value)) {
+      return coefficients_by_feature;
+    }
+  }
+
+  const ptrdiff_t num_features = static_cast<ptrdiff_t>(coefficients.size()) / num_targets;
+  coefficients_by_feature.resize(coefficients.size());
+  for (ptrdiff_t target = 0; target < num_targets; ++target) {
+    for (ptrdiff_t feature = 0; feature < num_features; ++feature) {
+      coefficients_by_feature[feature * num_targets + target] = coefficients[target * num_features + feature];
+    }
+  }
+
+  return coefficients_by_feature;
+}
+
+// Computes output = X * coefficients^T + intercepts touching only the non-zero values of X.
+//
+// X: [num_batches, num_features]
+// coefficients_by_feature: [num_features, num_targets], see TransposeSparseLinearCoefficients
+// intercepts: optional [num_targets]. May be nullptr.
+// output: [num_batches, num_targets]
+//
+// Each batch row is independent so rows are processed in parallel. The coefficients of a non-zero feature are
+// contiguous so the inner loop over the targets reads them sequentially.
+static inline void ComputeSparseLinear(const float* input, ptrdiff_t num_batches, ptrdiff_t num_features,
+                                       ptrdiff_t num_targets, const float* coefficients_by_feature,
+                                       const float* intercepts, float* output, concurrency::ThreadPool* threadpool) {
+  const TensorOpCost cost{static_cast<double>(num_features * sizeof(float)),
+                          static_cast<double>(num_targets * sizeof(float)),
+                          static_cast<double>(num_features + num_targets)};
+
+  concurrency::ThreadPool::TryParallelFor(
+      threadpool, num_batches, cost,
+      [input, num_features, num_targets, coefficients_by_feature, intercepts, output](ptrdiff_t first,
+                                                                                      ptrdiff_t last) {
+        for (ptrdiff_t batch = first; batch < last; ++batch) {
+          const float* x = input + batch * num_features;
+          float* y = output + batch * num_targets;
+          if (intercepts != nullptr) {
+            std::copy_n(intercepts, num_targets, y);
+          } else {
+            std::fill_n(y, num_targets, 0.f);
+          }
+
+          for (ptrdiff_t feature = 0; feature < num_features; ++feature) {
+            const float value = x[feature];
+            if (value == 0.f) {
+              continue;
+            }
+
+            const float* coefficient = coefficients_by_feature + feature * num_targets;
+            for (ptrdiff_t target = 0; target < num_targets; ++target) {
+              y[target] += value * coefficient[target];
+            }
+          }
+        }
+      });
+}
+
 }  // namespace ml
 }  // namespace onnxruntime
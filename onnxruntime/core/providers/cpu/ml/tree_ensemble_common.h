@@ -54,6 +54,23 @@ class TreeEnsembleCommon : public TreeEnsembleCommonAttributes {
   std::vector<SparseValue<ThresholdType>> weights_;
   std::vector<TreeNodeElement<ThresholdType>*> roots_;
 
+  // Node of a tree stored as a complete binary tree, see BuildCompleteTrees.
+  struct CompleteTreeNode {
+    ThresholdType threshold;
+    int feature_id;
+  };
+  struct CompleteTree {
+    size_t nodes_offset;
+    size_t leaves_offset;
+    int depth;
+  };
+  // When not empty, complete_trees_[i] is the complete binary tree layout of roots_[i].
+  // Internal nodes are in complete_nodes_ and leaves in complete_leaves_, both in breadth first order.
+  std::vector<CompleteTreeNode> complete_nodes_;
+  std::vector<TreeNodeElement<ThresholdType>*> complete_leaves_;
+  std::vector<CompleteTree> complete_trees_;
+  NODE_MODE_ORT complete_trees_mode_{NODE_MODE_ORT::BRANCH_LEQ};
+
  public:
   TreeEnsembleCommon() {}
 
@@ -68,6 +85,8 @@ class TreeEnsembleCommon : public TreeEnsembleCommonAttributes {
  protected:
   TreeNodeElement<ThresholdType>* ProcessTreeNodeLeave(TreeNodeElement<ThresholdType>* root,
                                                        const InputType* x_data) const;
+  // Returns the leaf reached by x_data in the tree_index-th tree.
+  TreeNodeElement<ThresholdType>* ProcessTreeLeave(size_t tree_index, const InputType* x_data) const;
 
   template <typename AGG>
   void ComputeAgg(concurrency::ThreadPool* ttp, const Tensor* X, Tensor* Y, Tensor* label, const AGG& agg) const;
@@ -84,6 +103,8 @@ class TreeEnsembleCommon : public TreeEnsembleCommonAttributes {
                   gsl::span<const int64_t> nodes_missing_value_tracks_true, std::vector<size_t>& updated_mapping,
                   int64_t tree_id, const InlinedVector<TreeNodeElementId>& node_tree_ids, gsl::span<const float> target_class_weights,
                   gsl::span<const ThresholdType> target_class_weights_as_tensor, InlinedVector<std::pair<TreeNodeElementId, uint32_t>>& indices);
+  void BuildCompleteTrees();
+  void FillCompleteTree(const TreeNodeElement<ThresholdType>* node, const CompleteTree& tree, size_t index, int level);
 };
 
 // Below is simple implementation of `bit_cast` as it is supported from c++20 and the current supported version is c++17
@@ -308,8 +329,11 @@ Status TreeEnsembleCommon<InputType, ThresholdType, OutputType>::Init(
     }
   }
 
+  BuildCompleteTrees();
+
 #if defined(_TREE_DEBUG)
   std::cout << "TreeEnsemble:same_mode_=" << (same_mode_ ? 1 : 0) << "\n";
+  std::cout << "TreeEnsemble:complete_trees_=" << (complete_trees_.empty() ? 0 : 1) << "\n";
   for (auto& node : nodes_) {
     std::cout << node.str() << "\n";
   }
@@ -317,6 +341,98 @@ Status TreeEnsembleCommon<InputType, ThresholdType, OutputType>::Init(
   return Status::OK();
 }
 
+// Trees deeper than this are never converted into complete binary trees.
+constexpr int kMaxCompleteTreeDepth = 12;
+// The complete binary trees may use at most this many times the memory of nodes_.
+constexpr size_t kMaxCompleteTreeExpansion = 4;
+
+template <typename T>
+int ComputeTreeDepth(const TreeNodeElement<T>* node, int max_depth) {
+  if (!node->is_not_leaf()) {
+    return 0;
+  }
+  if (max_depth == 0) {
+    // deeper than allowed, no need to look further
+    return 1;
+  }
+  return 1 + std::max(ComputeTreeDepth(node + 1, max_depth - 1),
+                      ComputeTreeDepth(node->truenode_or_weight.ptr, max_depth - 1));
+}
+
+// Shallow trees with the same comparison on every node are also stored as complete binary trees
+// so that the traversal does a fixed number of steps and computes the next node index from the
+// comparison result instead of branching on it. A leaf shallower than the depth of its tree is
+// replicated in every leaf slot below it and the padding nodes above those slots compare feature 0,
+// the result does not matter as both children are the same leaf.
+// Only BRANCH_LEQ and BRANCH_LT ensembles without missing value tracking are converted.
+template <typename InputType, typename ThresholdType, typename OutputType>
+void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::BuildCompleteTrees() {
+  complete_nodes_.clear();
+  complete_leaves_.clear();
+  complete_trees_.clear();
+
+  if (!same_mode_ || has_missing_tracks_ || roots_.empty()) {
+    return;
+  }
+
+  complete_trees_mode_ = NODE_MODE_ORT::BRANCH_LEQ;
+  for (const auto& node : nodes_) {
+    if (node.is_not_leaf()) {
+      complete_trees_mode_ = node.mode();
+      break;
+    }
+  }
+  if (complete_trees_mode_ != NODE_MODE_ORT::BRANCH_LEQ && complete_trees_mode_ != NODE_MODE_ORT::BRANCH_LT) {
+    return;
+  }
+
+  std::vector<CompleteTree> trees;
+  trees.reserve(roots_.size());
+  size_t n_complete_nodes = 0;
+  size_t n_complete_leaves = 0;
+  for (const auto* root : roots_) {
+    int depth = ComputeTreeDepth(root, kMaxCompleteTreeDepth);
+    if (depth > kMaxCompleteTreeDepth) {
+      return;
+    }
+    trees.push_back({n_complete_nodes, n_complete_leaves, depth});
+    n_complete_nodes += (size_t{1} << depth) - 1;
+    n_complete_leaves += size_t{1} << depth;
+  }
+
+  if (n_complete_nodes * sizeof(CompleteTreeNode) + n_complete_leaves * sizeof(TreeNodeElement<ThresholdType>*) >
+      kMaxCompleteTreeExpansion * nodes_.size() * sizeof(TreeNodeElement<ThresholdType>)) {
+    return;
+  }
+
+  complete_nodes_.resize(n_complete_nodes);
+  complete_leaves_.resize(n_complete_leaves);
+  for (size_t i = 0; i < roots_.size(); ++i) {
+    FillCompleteTree(roots_[i], trees[i], 0, 0);
+  }
+  complete_trees_ = std::move(trees);
+}
+
+template <typename InputType, typename ThresholdType, typename OutputType>
+void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::FillCompleteTree(
+    const TreeNodeElement<ThresholdType>* node, const CompleteTree& tree, size_t index, int level) {
+  if (level == tree.depth) {
+    complete_leaves_[tree.leaves_offset + index - ((size_t{1} << tree.depth) - 1)] =
+        const_cast<TreeNodeElement<ThresholdType>*>(node);
+    return;
+  }
+
+  if (node->is_not_leaf()) {
+    complete_nodes_[tree.nodes_offset + index] = {node->value_or_unique_weight, node->feature_id};
+    FillCompleteTree(node->truenode_or_weight.ptr, tree, 2 * index + 1, level + 1);
+    FillCompleteTree(node + 1, tree, 2 * index + 2, level + 1);
+  } else {
+    complete_nodes_[tree.nodes_offset + index] = {ThresholdType{}, 0};
+    FillCompleteTree(node, tree, 2 * index + 1, level + 1);
+    FillCompleteTree(node, tree, 2 * index + 2, level + 1);
+  }
+}
+
 template <typename InputType, typename ThresholdType, typename OutputType>
 bool TreeEnsembleCommon<InputType, ThresholdType, OutputType>::CheckIfSubtreesAreEqual(
     const size_t left_id, const size_t right_id, const int64_t tree_id, const InlinedVector<NODE_MODE_ONNX>& cmodes,
@@ -512,7 +628,7 @@ void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ComputeAgg(concur
       ScoreValue<ThresholdType> score = {0, 0};
       if (n_trees_ <= parallel_tree_ || max_num_threads == 1) { /* section A: 1 output, 1 row and not enough trees to parallelize */
         for (int64_t j = 0; j < n_trees_; ++j) {
-          agg.ProcessTreeNodePrediction1(score, *ProcessTreeNodeLeave(roots_[onnxruntime::narrow<size_t>(j)], x_data));
+          agg.ProcessTreeNodePrediction1(score, *ProcessTreeLeave(onnxruntime::narrow<size_t>(j), x_data));
         }
       } else { /* section B: 1 output, 1 row and enough trees to parallelize */
         std::vector<ScoreValue<ThresholdType>> scores(onnxruntime::narrow<size_t>(n_trees_), {0, 0});
@@ -520,7 +636,7 @@ void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ComputeAgg(concur
             ttp,
             SafeInt<int32_t>(n_trees_),
             [this, &scores, &agg, x_data](ptrdiff_t j) {
-              agg.ProcessTreeNodePrediction1(scores[j], *ProcessTreeNodeLeave(roots_[j], x_data));
+              agg.ProcessTreeNodePrediction1(scores[j], *ProcessTreeLeave(j, x_data));
             },
             max_num_threads);
 
@@ -551,7 +667,7 @@ void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ComputeAgg(concur
         }
         for (j = 0; j < static_cast<size_t>(n_trees_); ++j) {
           for (i = batch; i < batch_end; ++i) {
-            agg.ProcessTreeNodePrediction1(scores[SafeInt<ptrdiff_t>(i - batch)], *ProcessTreeNodeLeave(roots_[j], x_data + i * stride));
+            agg.ProcessTreeNodePrediction1(scores[SafeInt<ptrdiff_t>(i - batch)], *ProcessTreeLeave(j, x_data + i * stride));
           }
         }
         for (i = batch; i < batch_end; ++i) {
@@ -576,7 +692,7 @@ void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ComputeAgg(concur
               for (auto j = work.start; j < work.end; ++j) {
                 for (int64_t i = begin_n; i < end_n; ++i) {
                   agg.ProcessTreeNodePrediction1(scores[batch_num * SafeInt<ptrdiff_t>(N) + i],
-                                                 *ProcessTreeNodeLeave(roots_[j], x_data + i * stride));
+                                                 *ProcessTreeLeave(j, x_data + i * stride));
                 }
               }
             });
@@ -602,7 +718,7 @@ void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ComputeAgg(concur
           [this, &agg, x_data, z_data, stride, label_data](ptrdiff_t i) {
             ScoreValue<ThresholdType> score = {0, 0};
             for (size_t j = 0; j < static_cast<size_t>(n_trees_); ++j) {
-              agg.ProcessTreeNodePrediction1(score, *ProcessTreeNodeLeave(roots_[j], x_data + i * stride));
+              agg.ProcessTreeNodePrediction1(score, *ProcessTreeLeave(j, x_data + i * stride));
             }
 
             agg.FinalizeScores1(z_data + i, score,
@@ -615,7 +731,7 @@ void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ComputeAgg(concur
       if (n_trees_ <= parallel_tree_ || max_num_threads == 1) { /* section A2 */
         InlinedVector<ScoreValue<ThresholdType>> scores(onnxruntime::narrow<size_t>(n_targets_or_classes_), {0, 0});
         for (int64_t j = 0; j < n_trees_; ++j) {
-          agg.ProcessTreeNodePrediction(scores, *ProcessTreeNodeLeave(roots_[onnxruntime::narrow<size_t>(j)], x_data), weights_);
+          agg.ProcessTreeNodePrediction(scores, *ProcessTreeLeave(onnxruntime::narrow<size_t>(j), x_data), weights_);
         }
         agg.FinalizeScores(scores, z_data, -1, label_data);
       } else { /* section B2: 2+ outputs, 1 row, enough trees to parallelize */
@@ -628,7 +744,7 @@ void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ComputeAgg(concur
               scores[batch_num].resize(onnxruntime::narrow<size_t>(n_targets_or_classes_), {0, 0});
               auto work = concurrency::ThreadPool::PartitionWork(batch_num, num_threads, onnxruntime::narrow<size_t>(n_trees_));
               for (auto j = work.start; j < work.end; ++j) {
-                agg.ProcessTreeNodePrediction(scores[batch_num], *ProcessTreeNodeLeave(roots_[j], x_data), weights_);
+                agg.ProcessTreeNodePrediction(scores[batch_num], *ProcessTreeLeave(j, x_data), weights_);
               }
             });
         for (size_t i = 1, limit = scores.size(); i < limit; ++i) {
@@ -651,7 +767,7 @@ void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ComputeAgg(concur
         }
         for (j = 0, limit = roots_.size(); j < limit; ++j) {
           for (i = batch; i < batch_end; ++i) {
-            agg.ProcessTreeNodePrediction(scores[SafeInt<ptrdiff_t>(i - batch)], *ProcessTreeNodeLeave(roots_[j], x_data + i * stride), weights_);
+            agg.ProcessTreeNodePrediction(scores[SafeInt<ptrdiff_t>(i - batch)], *ProcessTreeLeave(j, x_data + i * stride), weights_);
           }
         }
         for (i = batch; i < batch_end; ++i) {
@@ -677,7 +793,7 @@ void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ComputeAgg(concur
               for (auto j = work.start; j < work.end; ++j) {
                 for (int64_t i = begin_n; i < end_n; ++i) {
                   agg.ProcessTreeNodePrediction(scores[batch_num * SafeInt<ptrdiff_t>(N) + i],
-                                                *ProcessTreeNodeLeave(roots_[j], x_data + i * stride), weights_);
+                                                *ProcessTreeLeave(j, x_data + i * stride), weights_);
                 }
               }
             });
@@ -709,7 +825,7 @@ void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ComputeAgg(concur
             for (auto i = work.start; i < work.end; ++i) {
               std::fill(scores.begin(), scores.end(), ScoreValue<ThresholdType>({0, 0}));
               for (j = 0, limit = roots_.size(); j < limit; ++j) {
-                agg.ProcessTreeNodePrediction(scores, *ProcessTreeNodeLeave(roots_[j], x_data + i * stride), weights_);
+                agg.ProcessTreeNodePrediction(scores, *ProcessTreeLeave(j, x_data + i * stride), weights_);
               }
 
               agg.FinalizeScores(scores,
@@ -743,6 +859,31 @@ inline bool SetMembershipCheck(T1 val, T2 mask) {
   return CANMASK(val, T2) && (((1ll << (val_as_int - 1)) & bit_cast_int(mask)) != 0);
 }
 
+template <typename InputType, typename ThresholdType, typename OutputType>
+inline TreeNodeElement<ThresholdType>*
+TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ProcessTreeLeave(
+    size_t tree_index, const InputType* x_data) const {
+  if (complete_trees_.empty()) {
+    return ProcessTreeNodeLeave(roots_[tree_index], x_data);
+  }
+
+  const CompleteTree& tree = complete_trees_[tree_index];
+  const CompleteTreeNode* nodes = complete_nodes_.data() + tree.nodes_offset;
+  size_t index = 0;
+  if (complete_trees_mode_ == NODE_MODE_ORT::BRANCH_LEQ) {
+    for (int level = 0; level < tree.depth; ++level) {
+      const CompleteTreeNode& node = nodes[index];
+      index = 2 * index + 1 + static_cast<size_t>(!(x_data[node.feature_id] <= node.threshold));
+    }
+  } else {
+    for (int level = 0; level < tree.depth; ++level) {
+      const CompleteTreeNode& node = nodes[index];
+      index = 2 * index + 1 + static_cast<size_t>(!(x_data[node.feature_id] < node.threshold));
+    }
+  }
+  return complete_leaves_[tree.leaves_offset + index - ((size_t{1} << tree.depth) - 1)];
+}
+
 template <typename InputType, typename ThresholdType, typename OutputType>
 TreeNodeElement<ThresholdType>*
 TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ProcessTreeNodeLeave(
@@ -2,6 +2,10 @@
 // Licensed under the MIT License.
 
 #include "core/providers/cpu/ml/zipmap.h"
+
+#include <numeric>
+
+#include "core/platform/threadpool.h"
 #include "core/util/math_cpuonly.h"
 /**
 https://github.com/onnx/onnx/blob/main/onnx/defs/traditionalml/defs.cc
@@ -35,6 +39,28 @@ ONNX_CPU_OPERATOR_ML_KERNEL(
                                             DataTypeImpl::GetType<std::vector<std::map<std::int64_t, float>>>()}),
     ZipMapOp);
 
+namespace {
+template <typename TKey>
+std::vector<size_t> SortLabelIndices(const std::vector<TKey>& classlabels) {
+  std::vector<size_t> indices(classlabels.size());
+  std::iota(indices.begin(), indices.end(), size_t{0});
+  std::stable_sort(indices.begin(), indices.end(),
+                   [&classlabels](size_t lhs, size_t rhs) { return classlabels[lhs] < classlabels[rhs]; });
+
+  // keep the last occurrence of each label
+  std::vector<size_t> unique_indices;
+  unique_indices.reserve(indices.size());
+  for (size_t i = 0; i < indices.size(); ++i) {
+    if (i + 1 < indices.size() && classlabels[indices[i]] == classlabels[indices[i + 1]]) {
+      continue;
+    }
+    unique_indices.push_back(indices[i]);
+  }
+
+  return unique_indices;
+}
+}  // namespace
+
 ZipMapOp::ZipMapOp(const OpKernelInfo& info)
     : OpKernel(info),
       classlabels_int64s_(info.GetAttrsOrDefault<int64_t>("classlabels_int64s")),
@@ -42,6 +68,43 @@ ZipMapOp::ZipMapOp(const OpKernelInfo& info)
   ORT_ENFORCE(classlabels_strings_.empty() ^ classlabels_int64s_.empty(),
               "Must provide classlabels_strings or classlabels_int64s but not both.");
   using_strings_ = !classlabels_strings_.empty();
+  sorted_label_indices_ = using_strings_ ? SortLabelIndices(classlabels_strings_)
+                                         : SortLabelIndices(classlabels_int64s_);
+}
+
+template <typename TKey>
+common::Status ZipMapOp::ComputeImpl(OpKernelContext& context, const std::vector<TKey>& classlabels,
+                                     const float* x_data, int64_t batch_size, int64_t features_per_batch) const {
+  if (features_per_batch != static_cast<int64_t>(classlabels.size())) {
+    return Status(ONNXRUNTIME,
+                  INVALID_ARGUMENT,
+                  "Input features_per_batch[" + std::to_string(features_per_batch) +
+                      "] != number of classlabels[" + std::to_string(classlabels.size()) + "]");
+  }
+
+  auto* y_data = context.Output<std::vector<std::map<TKey, float>>>(0);
+  if (y_data == nullptr) return Status(common::ONNXRUNTIME, common::FAIL, "input count mismatch");
+
+  y_data->resize(onnxruntime::narrow<size_t>(batch_size));
+
+  // Building the maps is dominated by node allocations, so rows are filled in parallel.
+  // Each row writes to its own map and the vector was sized above.
+  const double num_labels = static_cast<double>(sorted_label_indices_.size());
+  concurrency::ThreadPool::TryParallelFor(
+      context.GetOperatorThreadPool(), onnxruntime::narrow<std::ptrdiff_t>(batch_size),
+      TensorOpCost{num_labels * sizeof(float), num_labels * sizeof(std::pair<const TKey, float>), num_labels * 64.0},
+      [this, &classlabels, x_data, features_per_batch, y_data](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t n = first; n < last; ++n) {
+          const float* row = x_data + n * features_per_batch;
+          auto& map = (*y_data)[static_cast<size_t>(n)];
+          map.clear();
+          for (size_t j : sorted_label_indices_) {
+            map.emplace_hint(map.end(), classlabels[j], row[j]);
+          }
+        }
+      });
+
+  return common::Status::OK();
 }
 
 common::Status ZipMapOp::Compute(OpKernelContext* context) const {
@@ -68,48 +131,10 @@ common::Status ZipMapOp::Compute(OpKernelContext* context) const {
   const auto* x_data = X.Data<float>();
 
   if (using_strings_) {
-    if (features_per_batch != static_cast<int64_t>(classlabels_strings_.size())) {
-      return Status(ONNXRUNTIME,
-                    INVALID_ARGUMENT,
-                    "Input features_per_batch[" + std::to_string(features_per_batch) +
-                        "] != number of classlabels[" + std::to_string(classlabels_strings_.size()) + "]");
-    }
-    auto* y_data = context->Output<std::vector<std::map<std::string, float>>>(0);
-    if (y_data == nullptr) return Status(common::ONNXRUNTIME, common::FAIL, "input count mismatch");
-
-    // auto* y_data = Y->MutableData<std::vector<std::map<std::string, float>>>();
-    y_data->resize(onnxruntime::narrow<size_t>(batch_size));
-    int64_t current_weight_0 = 0;
-    for (int64_t n = 0; n < batch_size; n++) {
-      std::map<std::string, float> map1;
-      for (int64_t j = 0; j < features_per_batch; j++) {
-        map1[classlabels_strings_[onnxruntime::narrow<size_t>(j)]] = x_data[current_weight_0 + j];
-      }
-      current_weight_0 += features_per_batch;
-      (*y_data)[onnxruntime::narrow<size_t>(n)] = std::move(map1);
-    }
-  } else {
-    if (features_per_batch != static_cast<int64_t>(classlabels_int64s_.size())) {
-      return Status(ONNXRUNTIME,
-                    INVALID_ARGUMENT,
-                    "Input features_per_batch[" + std::to_string(features_per_batch) +
-                        "] != number of classlabels[" + std::to_string(classlabels_int64s_.size()) + "]");
-    }
-    auto* y_data = context->Output<std::vector<std::map<std::int64_t, float>>>(0);
-    if (y_data == nullptr) return Status(common::ONNXRUNTIME, common::FAIL, "input count mismatch");
-    // auto* y_data = Y->MutableData<std::vector<std::map<int64_t, float>>>();
-    y_data->resize(onnxruntime::narrow<size_t>(batch_size));
-    int64_t current_weight_0 = 0;
-    for (int n = 0; n < batch_size; n++) {
-      std::map<int64_t, float> map2;
-      for (int j = 0; j < features_per_batch; j++) {
-        map2[classlabels_int64s_[j]] = x_data[current_weight_0 + j];
-      }
-      current_weight_0 += features_per_batch;
-      (*y_data)[n] = std::move(map2);
-    }
+    return ComputeImpl(*context, classlabels_strings_, x_data, batch_size, features_per_batch);
   }
-  return common::Status::OK();
+
+  return ComputeImpl(*context, classlabels_int64s_, x_data, batch_size, features_per_batch);
 }
 }  // namespace ml
 }  // namespace onnxruntime
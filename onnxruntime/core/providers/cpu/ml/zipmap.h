@@ -13,7 +13,15 @@ class ZipMapOp final : public OpKernel {
   common::Status Compute(OpKernelContext* context) const override;
 
  private:
+  template <typename TKey>
+  common::Status ComputeImpl(OpKernelContext& context, const std::vector<TKey>& classlabels,
+                             const float* x_data, int64_t batch_size, int64_t features_per_batch) const;
+
   bool using_strings_;
+  // Indices of the class labels ordered by label value. If a label is duplicated only its last
+  // occurrence is kept, as that is the value that ends up in the map.
+  // Inserting in this order lets each map be built with constant time hinted insertion.
+  std::vector<size_t> sorted_label_indices_;
   std::vector<int64_t> classlabels_int64s_;
   std::vector<std::string> classlabels_strings_;
 };
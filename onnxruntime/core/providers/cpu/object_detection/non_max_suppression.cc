@@ -13,10 +13,14 @@ limitations under the License.
 
 #include "non_max_suppression.h"
 
-#include <queue>
+#include <algorithm>
+#include <cmath>
+#include <limits>
 #include <utility>
+#include <vector>
 
 #include "core/common/narrow.h"
+#include "core/platform/threadpool.h"
 #include "non_max_suppression_helper.h"
 
 // TODO:fix the warnings
@@ -118,6 +122,112 @@ Status NonMaxSuppressionBase::GetThresholdsFromInputs(const PrepareContext& pc,
   return Status::OK();
 }
 
+namespace {
+
+// Corners and areas of boxes in structure-of-arrays layout, so the IoU of one box against many can be vectorized.
+struct BoxCorners {
+  std::vector<float> x_min, y_min, x_max, y_max, area;
+
+  void Resize(size_t size) {
+    x_min.resize(size);
+    y_min.resize(size);
+    x_max.resize(size);
+    y_max.resize(size);
+    area.resize(size);
+  }
+
+  void Clear() {
+    x_min.clear();
+    y_min.clear();
+    x_max.clear();
+    y_max.clear();
+    area.clear();
+  }
+
+  void PushBack(const BoxCorners& other, size_t i) {
+    x_min.push_back(other.x_min[i]);
+    y_min.push_back(other.y_min[i]);
+    x_max.push_back(other.x_max[i]);
+    y_max.push_back(other.y_max[i]);
+    area.push_back(other.area[i]);
+  }
+};
+
+// Converts the boxes to corners using the same arithmetic as SuppressByIOU.
+void ComputeBoxCorners(const float* boxes_data, size_t num_boxes, int64_t center_point_box, BoxCorners& corners) {
+  corners.Resize(num_boxes);
+  for (size_t i = 0; i < num_boxes; ++i) {
+    const float* box = boxes_data + 4 * i;
+    float x_min, y_min, x_max, y_max;
+    if (0 == center_point_box) {
+      // boxes data format [y1, x1, y2, x2]
+      MaxMin(box[1], box[3], x_min, x_max);
+      MaxMin(box[0], box[2], y_min, y_max);
+    } else {
+      // boxes data format [x_center, y_center, width, height]
+      const float width_half = box[2] / 2;
+      const float height_half = box[3] / 2;
+      x_min = box[0] - width_half;
+      x_max = box[0] + width_half;
+      y_min = box[1] - height_half;
+      y_max = box[1] + height_half;
+    }
+
+    corners.x_min[i] = x_min;
+    corners.y_min[i] = y_min;
+    corners.x_max[i] = x_max;
+    corners.y_max[i] = y_max;
+    corners.area[i] = (x_max - x_min) * (y_max - y_min);
+  }
+}
+
+// Returns true if the IoU of box i with any of the kept boxes exceeds iou_threshold. The kept boxes are checked in
+// blocks without early exit inside a block so the inner loop is branch free and vectorizes.
+bool SuppressedByKeptBoxes(const BoxCorners& boxes, size_t i, const BoxCorners& kept, float iou_threshold) {
+  constexpr size_t block_size = 16;
+  const float x_min = boxes.x_min[i];
+  const float y_min = boxes.y_min[i];
+  const float x_max = boxes.x_max[i];
+  const float y_max = boxes.y_max[i];
+  const float area = boxes.area[i];
+  const size_t num_kept = kept.area.size();
+
+  for (size_t block_start = 0; block_start < num_kept; block_start += block_size) {
+    const size_t block_end = std::min(num_kept, block_start + block_size);
+    bool suppressed = false;
+    for (size_t k = block_start; k < block_end; ++k) {
+      const float intersection_width = std::min(x_max, kept.x_max[k]) - std::max(x_min, kept.x_min[k]);
+      const float intersection_height = std::min(y_max, kept.y_max[k]) - std::max(y_min, kept.y_min[k]);
+      const float intersection_area = intersection_width * intersection_height;
+      const float union_area = area + kept.area[k] - intersection_area;
+      suppressed |= (intersection_width > .0f) & (intersection_height > .0f) & (intersection_area > .0f) &
+                    (area > .0f) & (kept.area[k] > .0f) & (union_area > .0f) &
+                    (intersection_area / union_area > iou_threshold);
+    }
+
+    if (suppressed) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+struct BoxInfo {
+  float score_{};
+  int64_t index_{};
+
+  BoxInfo() = default;
+  explicit BoxInfo(float score, int64_t idx) : score_(score), index_(idx) {}
+
+  // highest score first, lowest index first for equal scores
+  inline bool operator<(const BoxInfo& rhs) const {
+    return score_ > rhs.score_ || (score_ == rhs.score_ && index_ < rhs.index_);
+  }
+};
+
+}  // namespace
+
 Status NonMaxSuppression::Compute(OpKernelContext* ctx) const {
   PrepareContext pc;
   ORT_RETURN_IF_ERROR(PrepareCompute(ctx, pc));
@@ -135,75 +245,98 @@ Status NonMaxSuppression::Compute(OpKernelContext* ctx) const {
 
   const auto* const boxes_data = pc.boxes_data_;
   const auto* const scores_data = pc.scores_data_;
+  const auto center_point_box = GetCenterPointBox();
+  const size_t num_boxes = static_cast<size_t>(pc.num_boxes_);
+  const size_t max_kept = static_cast<size_t>(std::min<int64_t>(max_output_boxes_per_class, pc.num_boxes_));
 
-  struct BoxInfoPtr {
-    float score_{};
-    int64_t index_{};
-
-    BoxInfoPtr() = default;
-    explicit BoxInfoPtr(float score, int64_t idx) : score_(score), index_(idx) {}
-    inline bool operator<(const BoxInfoPtr& rhs) const {
-      return score_ < rhs.score_ || (score_ == rhs.score_ && index_ > rhs.index_);
-    }
-  };
+  // The boxes are shared by all the classes of a batch so convert them once.
+  std::vector<BoxCorners> batch_corners(narrow<size_t>(pc.num_batches_));
+  for (int64_t batch_index = 0; batch_index < pc.num_batches_; ++batch_index) {
+    ComputeBoxCorners(boxes_data + batch_index * pc.num_boxes_ * 4, num_boxes, center_point_box,
+                      batch_corners[static_cast<size_t>(batch_index)]);
+  }
 
-  const auto center_point_box = GetCenterPointBox();
+  // Each (batch, class) pair is independent. Every task writes the boxes it selects to its own slot and the
+  // slots are concatenated in order afterwards so the output doesn't depend on the number of threads.
+  const int64_t num_tasks = pc.num_batches_ * pc.num_classes_;
+  std::vector<std::vector<int64_t>> selected_per_task(narrow<size_t>(num_tasks));
+
+  const double cost = static_cast<double>(num_boxes) * 64;
+  concurrency::ThreadPool::TryParallelFor(
+      ctx->GetOperatorThreadPool(), narrow<std::ptrdiff_t>(num_tasks), cost,
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        std::vector<BoxInfo> candidate_boxes;
+        candidate_boxes.reserve(num_boxes);
+        std::vector<int64_t> nan_boxes;
+        BoxCorners sorted_corners;
+        BoxCorners kept;
+
+        for (std::ptrdiff_t task = first; task < last; ++task) {
+          const int64_t batch_index = task / pc.num_classes_;
+          const auto* class_scores = scores_data + task * pc.num_boxes_;
+          const BoxCorners& corners = batch_corners[static_cast<size_t>(batch_index)];
+
+          // Filter by score_threshold_. NaN scores can't be ordered by std::sort so they go last.
+          candidate_boxes.clear();
+          nan_boxes.clear();
+          for (size_t box_index = 0; box_index < num_boxes; ++box_index) {
+            const float score = class_scores[box_index];
+            if (pc.score_threshold_ == nullptr || score > score_threshold) {
+              if (std::isnan(score)) {
+                nan_boxes.push_back(static_cast<int64_t>(box_index));
+              } else {
+                candidate_boxes.emplace_back(score, static_cast<int64_t>(box_index));
+              }
+            }
+          }
 
-  std::vector<SelectedIndex> selected_indices;
-  std::vector<BoxInfoPtr> selected_boxes_inside_class;
-  selected_boxes_inside_class.reserve(std::min<size_t>(static_cast<size_t>(max_output_boxes_per_class), pc.num_boxes_));
+          std::sort(candidate_boxes.begin(), candidate_boxes.end());
+          for (int64_t box_index : nan_boxes) {
+            candidate_boxes.emplace_back(std::numeric_limits<float>::quiet_NaN(), box_index);
+          }
 
-  for (int64_t batch_index = 0; batch_index < pc.num_batches_; ++batch_index) {
-    for (int64_t class_index = 0; class_index < pc.num_classes_; ++class_index) {
-      int64_t box_score_offset = (batch_index * pc.num_classes_ + class_index) * pc.num_boxes_;
-      const float* batch_boxes = boxes_data + (batch_index * pc.num_boxes_ * 4);
-      std::vector<BoxInfoPtr> candidate_boxes;
-      candidate_boxes.reserve(pc.num_boxes_);
-
-      // Filter by score_threshold_
-      const auto* class_scores = scores_data + box_score_offset;
-      if (pc.score_threshold_ != nullptr) {
-        for (int64_t box_index = 0; box_index < pc.num_boxes_; ++box_index, ++class_scores) {
-          if (*class_scores > score_threshold) {
-            candidate_boxes.emplace_back(*class_scores, box_index);
+          // Gather the corners in score order so the greedy pass reads them sequentially.
+          const size_t num_candidates = candidate_boxes.size();
+          sorted_corners.Resize(num_candidates);
+          for (size_t i = 0; i < num_candidates; ++i) {
+            const auto box_index = static_cast<size_t>(candidate_boxes[i].index_);
+            sorted_corners.x_min[i] = corners.x_min[box_index];
+            sorted_corners.y_min[i] = corners.y_min[box_index];
+            sorted_corners.x_max[i] = corners.x_max[box_index];
+            sorted_corners.y_max[i] = corners.y_max[box_index];
+            sorted_corners.area[i] = corners.area[box_index];
           }
-        }
-      } else {
-        for (int64_t box_index = 0; box_index < pc.num_boxes_; ++box_index, ++class_scores) {
-          candidate_boxes.emplace_back(*class_scores, box_index);
-        }
-      }
-      std::priority_queue<BoxInfoPtr, std::vector<BoxInfoPtr>> sorted_boxes(std::less<BoxInfoPtr>(), std::move(candidate_boxes));
-
-      selected_boxes_inside_class.clear();
-      // Get the next box with top score, filter by iou_threshold
-      while (!sorted_boxes.empty() && static_cast<int64_t>(selected_boxes_inside_class.size()) < max_output_boxes_per_class) {
-        const BoxInfoPtr& next_top_score = sorted_boxes.top();
-
-        bool selected = true;
-        // Check with existing selected boxes for this class, suppress if exceed the IOU (Intersection Over Union) threshold
-        for (const auto& selected_index : selected_boxes_inside_class) {
-          if (SuppressByIOU(batch_boxes, next_top_score.index_, selected_index.index_, center_point_box, iou_threshold)) {
-            selected = false;
-            break;
+
+          // Take the boxes with top score first, suppress if exceed the IOU (Intersection Over Union) threshold
+          // with any box already selected for this class.
+          auto& selected = selected_per_task[static_cast<size_t>(task)];
+          kept.Clear();
+          for (size_t i = 0; i < num_candidates && kept.area.size() < max_kept; ++i) {
+            if (!SuppressedByKeptBoxes(sorted_corners, i, kept, iou_threshold)) {
+              kept.PushBack(sorted_corners, i);
+              selected.push_back(candidate_boxes[i].index_);
+            }
           }
         }
+      });
 
-        if (selected) {
-          selected_boxes_inside_class.push_back(next_top_score);
-          selected_indices.emplace_back(batch_index, class_index, next_top_score.index_);
-        }
-        sorted_boxes.pop();
-      }  // while
-    }  // for class_index
-  }  // for batch_index
+  size_t num_selected = 0;
+  for (const auto& selected : selected_per_task) {
+    num_selected += selected.size();
+  }
 
   constexpr auto last_dim = 3;
-  const auto num_selected = selected_indices.size();
   Tensor* output = ctx->Output(0, {static_cast<int64_t>(num_selected), last_dim});
   ORT_ENFORCE(output != nullptr);
   static_assert(last_dim * sizeof(int64_t) == sizeof(SelectedIndex), "Possible modification of SelectedIndex");
-  memcpy(output->MutableData<int64_t>(), selected_indices.data(), num_selected * sizeof(SelectedIndex));
+  auto* selected_indices = reinterpret_cast<SelectedIndex*>(output->MutableData<int64_t>());
+  for (int64_t task = 0; task < num_tasks; ++task) {
+    const int64_t batch_index = task / pc.num_classes_;
+    const int64_t class_index = task % pc.num_classes_;
+    for (int64_t box_index : selected_per_task[static_cast<size_t>(task)]) {
+      *selected_indices++ = SelectedIndex(batch_index, class_index, box_index);
+    }
+  }
 
   return Status::OK();
 }
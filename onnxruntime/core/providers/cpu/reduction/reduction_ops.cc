@@ -801,6 +801,13 @@ bool CommonFastReduceSwitch(OpKernelContext* ctx,
       reduced_dims, input_axes.empty() ? axes_ : input_axes,
       fast_shape, output_shape, fast_axes, keepdims_ != 0, noop_with_empty_axes);
 
+  // a reduction over every element is KR with a single row
+  if (fast_kind == FastReduceKind::kR && IsFastReduceKindAvailable(FastReduceKind::kKR, which_fast_reduce)) {
+    const int64_t size = fast_shape[0];
+    fast_shape = {1, size};
+    fast_kind = FastReduceKind::kKR;
+  }
+
   if (which_fast_reduce != FastReduceKind::kNone) {
     if (IsFastReduceKindAvailable(fast_kind, which_fast_reduce)) {
       Tensor* output = ctx->Output(0, output_shape);
@@ -811,26 +818,16 @@ bool CommonFastReduceSwitch(OpKernelContext* ctx,
           return true;
         }
         case FastReduceKind::kRK: {
+          // ReduceOuterReduceInner parallelizes over blocks of columns and, for few columns, over rows,
+          // so unlike the former implementations it does not need a minimum size.
           ValidateFastReduceRK(fast_shape, *output);
-          if ((fast_shape[0] > concurrency::ThreadPool::DegreeOfParallelism(ctx->GetOperatorThreadPool()) * 16) &&
-              (std::max(fast_shape[0], fast_shape[1]) >
-               concurrency::ThreadPool::DegreeOfParallelism(ctx->GetOperatorThreadPool()) * 256)) {
-            // See benchmarks in PR #7719.
-            case_rk(*input, fast_shape, *output, ctx->GetOperatorThreadPool());
-            return true;
-          } else {
-            break;
-          }
+          case_rk(*input, fast_shape, *output, ctx->GetOperatorThreadPool());
+          return true;
         }
         case FastReduceKind::kKRK:
           ValidateFastReduceKRK(fast_shape, *output);
-          if (fast_shape[0] >= std::max(2, concurrency::ThreadPool::DegreeOfParallelism(ctx->GetOperatorThreadPool()))) {
-            // See benchmarks in PR #7719.
-            case_krk(*input, fast_shape, *output, ctx->GetOperatorThreadPool());
-            return true;
-          } else {
-            break;
-          }
+          case_krk(*input, fast_shape, *output, ctx->GetOperatorThreadPool());
+          return true;
         case FastReduceKind::kRKR:
           ValidateFastReduceRKR(fast_shape, *output);
           if (fast_shape[1] >= std::max(2, concurrency::ThreadPool::DegreeOfParallelism(ctx->GetOperatorThreadPool()))) {
@@ -1074,6 +1071,13 @@ std::unique_ptr<Tensor> ReduceSum<T>::Impl(const Tensor& input, gsl::span<const
     return output;
   }
 
+  // a reduction over every element is KR with a single row
+  if (fast_kind == FastReduceKind::kR) {
+    const int64_t size = fast_shape[0];
+    fast_shape = {1, size};
+    fast_kind = FastReduceKind::kKR;
+  }
+
   if (IsFastReduceKindAvailable(fast_kind, ReduceAggregatorSum<T>::WhichFastReduce())) {
     switch (fast_kind) {
       case FastReduceKind::kKR: {
@@ -1083,23 +1087,12 @@ std::unique_ptr<Tensor> ReduceSum<T>::Impl(const Tensor& input, gsl::span<const
       }
       case FastReduceKind::kRK:
         ValidateFastReduceRK(fast_shape, *output);
-        if (std::max(fast_shape[0], fast_shape[1]) >
-            concurrency::ThreadPool::DegreeOfParallelism(tp) * 256) {
-          // See benchmarks in PR #7719.
-          ReduceAggregatorSum<T>::FastReduceRK(input, fast_shape, *output, tp);
-          return output;
-        } else {
-          break;
-        }
+        ReduceAggregatorSum<T>::FastReduceRK(input, fast_shape, *output, tp);
+        return output;
       case FastReduceKind::kKRK:
         ValidateFastReduceKRK(fast_shape, *output);
-        if (fast_shape[0] >= std::max(2, concurrency::ThreadPool::DegreeOfParallelism(tp))) {
-          // See benchmarks in PR #7719.
-          ReduceAggregatorSum<T>::FastReduceKRK(input, fast_shape, *output, tp);
-          return output;
-        } else {
-          break;
-        }
+        ReduceAggregatorSum<T>::FastReduceKRK(input, fast_shape, *output, tp);
+        return output;
       case FastReduceKind::kRKR:
         ValidateFastReduceRKR(fast_shape, *output);
         if (fast_shape[0] >= std::max(2, concurrency::ThreadPool::DegreeOfParallelism(tp))) {
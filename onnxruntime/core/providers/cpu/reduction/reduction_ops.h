@@ -16,7 +16,9 @@
 #include "core/platform/threadpool.h"
 #include "core/providers/cpu/reduction/reduction_kernel_base.h"
 #include "core/common/safeint.h"
+#include <algorithm>
 #include <cmath>
+#include <vector>
 
 namespace onnxruntime {
 
@@ -47,6 +49,130 @@ constexpr TensorOpCost ParallelReduceFastCost(int64_t n_row, int64_t n_col, int6
                       static_cast<double>(n_row * n_col * element_size * n_ops)};
 }
 
+/* Element-wise operations used by ReduceOuterReduceInner. */
+template <typename T>
+struct ReduceOpSum {
+  static T Reduce(const T* data, int64_t size) { return ConstEigenVectorArrayMap<T>(data, size).sum(); }
+  static void Accumulate(T* acc, const T* data, int64_t size) {
+    EigenVectorArrayMap<T>(acc, size) += ConstEigenVectorArrayMap<T>(data, size);
+  }
+};
+
+template <typename T>
+struct ReduceOpMax {
+  static T Reduce(const T* data, int64_t size) { return ConstEigenVectorArrayMap<T>(data, size).maxCoeff(); }
+  static void Accumulate(T* acc, const T* data, int64_t size) {
+    EigenVectorArrayMap<T> acc_map(acc, size);
+    acc_map = acc_map.max(ConstEigenVectorArrayMap<T>(data, size));
+  }
+};
+
+template <typename T>
+struct ReduceOpMin {
+  static T Reduce(const T* data, int64_t size) { return ConstEigenVectorArrayMap<T>(data, size).minCoeff(); }
+  static void Accumulate(T* acc, const T* data, int64_t size) {
+    EigenVectorArrayMap<T> acc_map(acc, size);
+    acc_map = acc_map.min(ConstEigenVectorArrayMap<T>(data, size));
+  }
+};
+
+/**
+  Reduces a tensor viewed as [n_outer, n_reduce, n_inner] along its middle axis. KR, RK and KRK shapes
+  (and R, as [1, n, 1]) all map onto this form. OP is one of the ReduceOp* structs above.
+
+  When n_inner is 1 every output is a contiguous reduction. Otherwise the inner axis is cut into blocks
+  whose accumulators stay in L1 and every row of the reduced axis is added to the block with contiguous,
+  vectorized loads, so no output is ever computed with a strided loop.
+  Work is parallelized over (outer, block) pairs. When there are fewer pairs than threads and the reduction
+  is long, the reduced axis is split as well and the partial results are combined pairwise in a fixed order,
+  so the result does not depend on how the thread pool schedules the work.
+*/
+template <typename T, typename OP>
+void ReduceOuterReduceInner(const T* data, int64_t n_outer, int64_t n_reduce, int64_t n_inner, T* out,
+                            concurrency::ThreadPool* tp) {
+  // below this many elements per partial result, splitting the reduced axis costs more than it saves
+  constexpr int64_t kMinElementsPerSplit = 32768;
+  constexpr int64_t kInnerBlockSize = std::max<int64_t>(16, 16384 / static_cast<int64_t>(sizeof(T)));
+  if (n_outer == 0 || n_reduce == 0 || n_inner == 0) {
+    return;
+  }
+
+  const int64_t block_size = std::min(n_inner, kInnerBlockSize);
+  const int64_t n_blocks = (n_inner + block_size - 1) / block_size;
+  const int64_t n_tasks = n_outer * n_blocks;
+
+  int64_t n_splits = 1;
+  const int64_t dop = concurrency::ThreadPool::DegreeOfParallelism(tp);
+  if (n_tasks < dop) {
+    const int64_t max_splits = std::max<int64_t>(1, n_reduce * block_size / kMinElementsPerSplit);
+    n_splits = std::min((dop + n_tasks - 1) / n_tasks, max_splits);
+  }
+  const int64_t rows_per_split = (n_reduce + n_splits - 1) / n_splits;
+  n_splits = (n_reduce + rows_per_split - 1) / rows_per_split;
+
+  // reduces rows [row_begin, row_end) of one block into dst
+  auto reduce_block = [data, n_reduce, n_inner, block_size, n_blocks](int64_t task, int64_t row_begin,
+                                                                      int64_t row_end, T* dst) {
+    const int64_t outer = task / n_blocks;
+    const int64_t inner_begin = (task % n_blocks) * block_size;
+    const int64_t size = std::min(block_size, n_inner - inner_begin);
+    const T* p = data + (outer * n_reduce + row_begin) * n_inner + inner_begin;
+    if (n_inner == 1) {
+      *dst = OP::Reduce(p, row_end - row_begin);
+      return;
+    }
+
+    memcpy(dst, p, SafeInt<size_t>(size) * sizeof(T));
+    for (int64_t row = row_begin + 1; row < row_end; ++row) {
+      p += n_inner;
+      OP::Accumulate(dst, p, size);
+    }
+  };
+
+  auto block_offset = [n_inner, block_size, n_blocks](int64_t task) {
+    return (task / n_blocks) * n_inner + (task % n_blocks) * block_size;
+  };
+
+  if (n_splits == 1) {
+    concurrency::ThreadPool::TryParallelFor(
+        tp, onnxruntime::narrow<std::ptrdiff_t>(n_tasks), ParallelReduceFastCost(n_reduce, block_size, sizeof(T), 2),
+        [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+          for (std::ptrdiff_t task = first; task < last; ++task) {
+            reduce_block(task, 0, n_reduce, out + block_offset(task));
+          }
+        });
+    return;
+  }
+
+  const int64_t output_size = n_outer * n_inner;
+  std::vector<T> partials(SafeInt<size_t>(n_splits) * output_size);
+  concurrency::ThreadPool::TryParallelFor(
+      tp, onnxruntime::narrow<std::ptrdiff_t>(n_tasks * n_splits),
+      ParallelReduceFastCost(rows_per_split, block_size, sizeof(T), 2),
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t i = first; i < last; ++i) {
+          const int64_t split = i % n_splits;
+          const int64_t task = i / n_splits;
+          const int64_t row_begin = split * rows_per_split;
+          const int64_t row_end = std::min(n_reduce, row_begin + rows_per_split);
+          reduce_block(task, row_begin, row_end, partials.data() + split * output_size + block_offset(task));
+        }
+      });
+
+  // pairwise combination, 0+1, 2+3, ... then 0+2, ... so that the order never changes
+  for (int64_t task = 0; task < n_tasks; ++task) {
+    const int64_t offset = block_offset(task);
+    const int64_t size = std::min(block_size, n_inner - (task % n_blocks) * block_size);
+    for (int64_t stride = 1; stride < n_splits; stride *= 2) {
+      for (int64_t split = 0; split + stride < n_splits; split += 2 * stride) {
+        OP::Accumulate(partials.data() + split * output_size + offset,
+                       partials.data() + (split + stride) * output_size + offset, size);
+      }
+    }
+    memcpy(out + offset, partials.data() + offset, SafeInt<size_t>(size) * sizeof(T));
+  }
+}
+
 /**
   This only improves reduce function when reduced axes are contiguous:
   if len(shape) == 4, any single axis is ok, axes=(0, 1) or (1, 2) or (2, 3) is ok,
@@ -231,51 +357,20 @@ class ReduceAggregatorSum : public ReduceAggregator<T, T> {
 
   static void FastReduceKR(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
                            Tensor& output, concurrency::ThreadPool* tp) {
-    const T* data = input.Data<T>();
-    T* out = output.MutableData<T>();
-    int64_t stridei = fast_shape[1];
-    concurrency::ThreadPool::TryParallelFor(
-        tp, onnxruntime::narrow<std::ptrdiff_t>(fast_shape[0]), ParallelReduceFastCost(1, stridei, sizeof(T), 6),
-        [data, stridei, out](ptrdiff_t first, ptrdiff_t last) {
-          for (ptrdiff_t d = first; d < last; ++d) {
-            out[d] = aggall(data + d * stridei, stridei);
-          }
-        });
+    ReduceOuterReduceInner<T, ReduceOpSum<T>>(input.Data<T>(), fast_shape[0], fast_shape[1], 1,
+                                              output.MutableData<T>(), tp);
   }
 
   static void FastReduceRK(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
                            Tensor& output, concurrency::ThreadPool* tp) {
-    int64_t N = fast_shape[1];
-    const T* data = input.Data<T>();
-    T* out = output.MutableData<T>();
-
-    int64_t n_rows = fast_shape[0];
-    memcpy(out, data, SafeInt<size_t>(N) * sizeof(T));
-    concurrency::ThreadPool::TryParallelFor(
-        tp, onnxruntime::narrow<std::ptrdiff_t>(N), ParallelReduceFastCost(1, n_rows, sizeof(T), 6),
-        [data, out, N, n_rows](ptrdiff_t begin, ptrdiff_t end) {
-          for (int64_t row = 1; row < n_rows; ++row) {
-            EigenVectorArrayMap<T>(out + begin, end - begin) += ConstEigenVectorArrayMap<T>(
-                data + row * N + begin, end - begin);
-          }
-        });
+    ReduceOuterReduceInner<T, ReduceOpSum<T>>(input.Data<T>(), 1, fast_shape[0], fast_shape[1],
+                                              output.MutableData<T>(), tp);
   }
 
   static void FastReduceKRK(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
                             Tensor& output, concurrency::ThreadPool* tp) {
-    int64_t N = fast_shape[2];
-    const T* data = input.Data<T>();
-    int64_t stridei = fast_shape[1] * fast_shape[2];
-    int64_t strideo = fast_shape[2];
-    T* out = output.MutableData<T>();
-    std::vector<T> one(onnxruntime::narrow<size_t>(fast_shape[1]), 1);
-    concurrency::ThreadPool::TryParallelFor(
-        tp, onnxruntime::narrow<ptrdiff_t>(fast_shape[0]), ParallelReduceFastCost(fast_shape[1], fast_shape[2], sizeof(T), 6),
-        [one, data, fast_shape, stridei, strideo, out, N](ptrdiff_t begin, ptrdiff_t last) {
-          for (ptrdiff_t d = begin; d < last; ++d) {
-            math::MatMul<T>(1, onnxruntime::narrow<ptrdiff_t>(N), onnxruntime::narrow<ptrdiff_t>(fast_shape[1]), one.data(), data + stridei * d, out + strideo * d, nullptr);
-          }
-        });
+    ReduceOuterReduceInner<T, ReduceOpSum<T>>(input.Data<T>(), fast_shape[0], fast_shape[1], fast_shape[2],
+                                              output.MutableData<T>(), tp);
   }
 
   static void FastReduceRKR(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
@@ -320,40 +415,19 @@ class ReduceAggregatorMean : public ReduceAggregatorSum<T> {
   static void FastReduceKR(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
                            Tensor& output, concurrency::ThreadPool* tp) {
     ReduceAggregatorSum<T>::FastReduceKR(input, fast_shape, output, tp);
-    // TODO: use MLAS or BLAS
-    T* out = output.MutableData<T>();
-    T* end = out + fast_shape[0];
-    for (; out != end; ++out) {
-      *out /= static_cast<T>(fast_shape[1]);
-    }
+    EigenVectorArrayMap<T>(output.MutableData<T>(), fast_shape[0]) /= static_cast<T>(fast_shape[1]);
   }
 
   static void FastReduceRK(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
                            Tensor& output, concurrency::ThreadPool* tp) {
     ReduceAggregatorSum<T>::FastReduceRK(input, fast_shape, output, tp);
-    // TODO: use MLAS or BLAS
-    T* out = output.MutableData<T>();
-    T* end = out + fast_shape[1];
-    for (; out != end; ++out) {
-      *out /= static_cast<T>(fast_shape[0]);
-    }
+    EigenVectorArrayMap<T>(output.MutableData<T>(), fast_shape[1]) /= static_cast<T>(fast_shape[0]);
   }
 
   static void FastReduceKRK(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
                             Tensor& output, concurrency::ThreadPool* tp) {
     ReduceAggregatorSum<T>::FastReduceKRK(input, fast_shape, output, tp);
-    int64_t strideo = fast_shape[2];
-    T* out = output.MutableData<T>();
-    T* begin;
-    T* end;
-    T div = static_cast<T>(fast_shape[1]);
-    for (int64_t d = 0; d < fast_shape[0]; ++d) {
-      begin = out + strideo * d;
-      end = begin + strideo;
-      for (; begin != end; ++begin) {
-        *begin /= div;
-      }
-    }
+    EigenVectorArrayMap<T>(output.MutableData<T>(), fast_shape[0] * fast_shape[2]) /= static_cast<T>(fast_shape[1]);
   }
 
   static void FastReduceRKR(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
@@ -401,24 +475,21 @@ class ReduceAggregatorMax : public ReduceAggregator<T> {
                            Tensor& output, concurrency::ThreadPool* tp) {
     const T* data = input.Data<T>();
     T* out = output.MutableData<T>();
-    int64_t stridei = fast_shape[1];
-    concurrency::ThreadPool::TryParallelFor(
-        tp, onnxruntime::narrow<std::ptrdiff_t>(fast_shape[0]), ParallelReduceFastCost(1, stridei, sizeof(T), 6),
-        [data, stridei, out](std::ptrdiff_t first, std::ptrdiff_t last) {
-          if constexpr (std::is_same_v<bool, T>) { /* bool specific impl */
+    if constexpr (std::is_same_v<bool, T>) { /* bool specific impl */
+      int64_t stridei = fast_shape[1];
+      concurrency::ThreadPool::TryParallelFor(
+          tp, onnxruntime::narrow<std::ptrdiff_t>(fast_shape[0]), ParallelReduceFastCost(1, stridei, sizeof(T), 6),
+          [data, stridei, out](std::ptrdiff_t first, std::ptrdiff_t last) {
             EigenVectorMap<bool>(out + first, last - first) = ConstEigenMatrixMap<bool>(
                                                                   data + first * stridei, onnxruntime::narrow<size_t>(stridei), last - first)
                                                                   .cast<unsigned char>()
                                                                   .colwise()
                                                                   .maxCoeff()
                                                                   .cast<bool>();
-          } else {
-            EigenVectorMap<T>(out + first, last - first) = ConstEigenMatrixMap<T>(
-                                                               data + first * stridei, onnxruntime::narrow<size_t>(stridei), last - first)
-                                                               .colwise()
-                                                               .maxCoeff();
-          }
-        });
+          });
+    } else {
+      ReduceOuterReduceInner<T, ReduceOpMax<T>>(data, fast_shape[0], fast_shape[1], 1, out, tp);
+    }
   }
 
   static void FastReduceRK(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
@@ -427,37 +498,34 @@ class ReduceAggregatorMax : public ReduceAggregator<T> {
     int64_t N = fast_shape[1];
     const T* data = input.Data<T>();
     T* out = output.MutableData<T>();
-    memcpy(out, data, SafeInt<size_t>(N) * sizeof(T));
-
-    concurrency::ThreadPool::TryParallelFor(
-        tp, onnxruntime::narrow<std::ptrdiff_t>(N), ParallelReduceFastCost(1, n_rows, sizeof(T), 6),
-        [data, out, N, n_rows](ptrdiff_t begin, ptrdiff_t end) {
-          const T* p;
-          for (int64_t row = 1; row < n_rows; ++row) {
-            p = data + row * N;
-            for (int64_t j = begin; j < end; ++j) {
-              if constexpr (std::is_same_v<bool, T>) { /* bool specific impl */
+    if constexpr (std::is_same_v<bool, T>) { /* bool specific impl */
+      memcpy(out, data, SafeInt<size_t>(N) * sizeof(T));
+      concurrency::ThreadPool::TryParallelFor(
+          tp, onnxruntime::narrow<std::ptrdiff_t>(N), ParallelReduceFastCost(1, n_rows, sizeof(T), 6),
+          [data, out, N, n_rows](ptrdiff_t begin, ptrdiff_t end) {
+            for (int64_t row = 1; row < n_rows; ++row) {
+              const T* p = data + row * N;
+              for (int64_t j = begin; j < end; ++j) {
                 out[j] = out[j] || p[j];
-              } else {
-                if (out[j] < p[j])
-                  out[j] = p[j];
               }
             }
-          }
-        });
+          });
+    } else {
+      ReduceOuterReduceInner<T, ReduceOpMax<T>>(data, 1, n_rows, N, out, tp);
+    }
   }
 
   static void FastReduceKRK(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
                             Tensor& output, concurrency::ThreadPool* tp) {
     const T* data = input.Data<T>();
     T* out = output.MutableData<T>();
-    int64_t stridei = fast_shape[1] * fast_shape[2];
-    int64_t strideo = fast_shape[2];
-    concurrency::ThreadPool::TryParallelFor(
-        tp, onnxruntime::narrow<std::ptrdiff_t>(fast_shape[0]), ParallelReduceFastCost(fast_shape[1], fast_shape[2], sizeof(T), 6),
-        [data, fast_shape, stridei, strideo, out](ptrdiff_t begin, ptrdiff_t end) {
-          for (ptrdiff_t j = begin; j < end; ++j) {
-            if constexpr (std::is_same_v<bool, T>) { /* bool specific impl */
+    if constexpr (std::is_same_v<bool, T>) { /* bool specific impl */
+      int64_t stridei = fast_shape[1] * fast_shape[2];
+      int64_t strideo = fast_shape[2];
+      concurrency::ThreadPool::TryParallelFor(
+          tp, onnxruntime::narrow<std::ptrdiff_t>(fast_shape[0]), ParallelReduceFastCost(fast_shape[1], fast_shape[2], sizeof(T), 6),
+          [data, fast_shape, stridei, strideo, out](ptrdiff_t begin, ptrdiff_t end) {
+            for (ptrdiff_t j = begin; j < end; ++j) {
               EigenVectorMap<bool>(out + j * strideo, onnxruntime::narrow<size_t>(strideo)) =
                   ConstEigenMatrixMap<bool>(
                       data + j * stridei, onnxruntime::narrow<size_t>(fast_shape[2]), onnxruntime::narrow<size_t>(fast_shape[1]))
@@ -465,15 +533,11 @@ class ReduceAggregatorMax : public ReduceAggregator<T> {
                       .rowwise()
                       .maxCoeff()
                       .cast<bool>();
-            } else {
-              EigenVectorMap<T>(out + j * strideo, onnxruntime::narrow<size_t>(strideo)) =
-                  ConstEigenMatrixMap<T>(
-                      data + j * stridei, onnxruntime::narrow<size_t>(fast_shape[2]), onnxruntime::narrow<size_t>(fast_shape[1]))
-                      .rowwise()
-                      .maxCoeff();
             }
-          }
-        });
+          });
+    } else {
+      ReduceOuterReduceInner<T, ReduceOpMax<T>>(data, fast_shape[0], fast_shape[1], fast_shape[2], out, tp);
+    }
   }
 
   static void FastReduceRKR(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
@@ -611,24 +675,21 @@ class ReduceAggregatorMin : public ReduceAggregator<T, T> {
                            Tensor& output, concurrency::ThreadPool* tp) {
     const T* data = input.Data<T>();
     T* out = output.MutableData<T>();
-    int64_t stridei = fast_shape[1];
-    concurrency::ThreadPool::TryParallelFor(
-        tp, onnxruntime::narrow<std::ptrdiff_t>(fast_shape[0]), ParallelReduceFastCost(1, stridei, sizeof(T), 6),
-        [data, stridei, out](std::ptrdiff_t first, std::ptrdiff_t last) {
-          if constexpr (std::is_same_v<bool, T>) { /* bool specific impl */
+    if constexpr (std::is_same_v<bool, T>) { /* bool specific impl */
+      int64_t stridei = fast_shape[1];
+      concurrency::ThreadPool::TryParallelFor(
+          tp, onnxruntime::narrow<std::ptrdiff_t>(fast_shape[0]), ParallelReduceFastCost(1, stridei, sizeof(T), 6),
+          [data, stridei, out](std::ptrdiff_t first, std::ptrdiff_t last) {
             EigenVectorMap<bool>(out + first, last - first) = ConstEigenMatrixMap<bool>(
                                                                   data + first * stridei, onnxruntime::narrow<size_t>(stridei), last - first)
                                                                   .cast<unsigned char>()
                                                                   .colwise()
                                                                   .minCoeff()
                                                                   .cast<bool>();
-          } else {
-            EigenVectorMap<T>(out + first, last - first) = ConstEigenMatrixMap<T>(
-                                                               data + first * stridei, onnxruntime::narrow<size_t>(stridei), last - first)
-                                                               .colwise()
-                                                               .minCoeff();
-          }
-        });
+          });
+    } else {
+      ReduceOuterReduceInner<T, ReduceOpMin<T>>(data, fast_shape[0], fast_shape[1], 1, out, tp);
+    }
   }
 
   static void FastReduceRK(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
@@ -637,37 +698,34 @@ class ReduceAggregatorMin : public ReduceAggregator<T, T> {
     int64_t N = fast_shape[1];
     const T* data = input.Data<T>();
     T* out = output.MutableData<T>();
-    memcpy(out, data, SafeInt<size_t>(N) * sizeof(T));
-
-    concurrency::ThreadPool::TryParallelFor(
-        tp, onnxruntime::narrow<std::ptrdiff_t>(N), ParallelReduceFastCost(1, n_rows, sizeof(T), 6),
-        [data, out, N, n_rows](ptrdiff_t begin, ptrdiff_t end) {
-          const T* p;
-          for (int64_t row = 1; row < n_rows; ++row) {
-            p = data + row * N;
-            for (int64_t j = begin; j < end; ++j) {
-              if constexpr (std::is_same_v<bool, T>) { /* bool specific impl */
+    if constexpr (std::is_same_v<bool, T>) { /* bool specific impl */
+      memcpy(out, data, SafeInt<size_t>(N) * sizeof(T));
+      concurrency::ThreadPool::TryParallelFor(
+          tp, onnxruntime::narrow<std::ptrdiff_t>(N), ParallelReduceFastCost(1, n_rows, sizeof(T), 6),
+          [data, out, N, n_rows](ptrdiff_t begin, ptrdiff_t end) {
+            for (int64_t row = 1; row < n_rows; ++row) {
+              const T* p = data + row * N;
+              for (int64_t j = begin; j < end; ++j) {
                 out[j] = out[j] && p[j];
-              } else {
-                if (out[j] > p[j])
-                  out[j] = p[j];
               }
             }
-          }
-        });
+          });
+    } else {
+      ReduceOuterReduceInner<T, ReduceOpMin<T>>(data, 1, n_rows, N, out, tp);
+    }
   }
 
   static void FastReduceKRK(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
                             Tensor& output, concurrency::ThreadPool* tp) {
     const T* data = input.Data<T>();
     T* out = output.MutableData<T>();
-    int64_t stridei = fast_shape[1] * fast_shape[2];
-    int64_t strideo = fast_shape[2];
-    concurrency::ThreadPool::TryParallelFor(
-        tp, onnxruntime::narrow<std::ptrdiff_t>(fast_shape[0]), ParallelReduceFastCost(fast_shape[1], fast_shape[2], sizeof(T), 6),
-        [data, fast_shape, stridei, strideo, out](ptrdiff_t begin, ptrdiff_t end) {
-          for (ptrdiff_t j = begin; j < end; ++j) {
-            if constexpr (std::is_same_v<bool, T>) { /* bool specific impl */
+    if constexpr (std::is_same_v<bool, T>) { /* bool specific impl */
+      int64_t stridei = fast_shape[1] * fast_shape[2];
+      int64_t strideo = fast_shape[2];
+      concurrency::ThreadPool::TryParallelFor(
+          tp, onnxruntime::narrow<std::ptrdiff_t>(fast_shape[0]), ParallelReduceFastCost(fast_shape[1], fast_shape[2], sizeof(T), 6),
+          [data, fast_shape, stridei, strideo, out](ptrdiff_t begin, ptrdiff_t end) {
+            for (ptrdiff_t j = begin; j < end; ++j) {
               EigenVectorMap<bool>(out + j * strideo, onnxruntime::narrow<size_t>(strideo)) =
                   ConstEigenMatrixMap<bool>(
                       data + j * stridei, onnxruntime::narrow<size_t>(fast_shape[2]), onnxruntime::narrow<size_t>(fast_shape[1]))
@@ -675,15 +733,11 @@ class ReduceAggregatorMin : public ReduceAggregator<T, T> {
                       .rowwise()
                       .minCoeff()
                       .cast<bool>();
-            } else {
-              EigenVectorMap<T>(out + j * strideo, onnxruntime::narrow<size_t>(strideo)) =
-                  ConstEigenMatrixMap<T>(
-                      data + j * stridei, onnxruntime::narrow<size_t>(fast_shape[2]), onnxruntime::narrow<size_t>(fast_shape[1]))
-                      .rowwise()
-                      .minCoeff();
             }
-          }
-        });
+          });
+    } else {
+      ReduceOuterReduceInner<T, ReduceOpMin<T>>(data, fast_shape[0], fast_shape[1], fast_shape[2], out, tp);
+    }
   }
 
   static void FastReduceRKR(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
@@ -178,6 +178,10 @@ using namespace rnn::detail;
 #define DumpMatrix(...) ((void)0)
 #endif
 
+// Multiply-adds of the recurrent GEMMs of one step up to which the two directions of a bidirectional GRU run
+// concurrently instead of one after the other with those GEMMs split across the thread pool.
+static constexpr double kMaxConcurrentDirectionsStepCost = 1 << 20;
+
 bool DeepCpuGruOp::TryPackInputWeights(const Tensor& weights, AllocatorPtr& alloc) {
   const auto& shape = weights.Shape();
   if (shape.NumDimensions() != 3) {
@@ -194,6 +198,15 @@ bool DeepCpuGruOp::TryPackInputWeights(const Tensor& weights, AllocatorPtr& allo
   const size_t N = static_cast<size_t>(shape[1]);
   const size_t K = static_cast<size_t>(shape[2]);
 
+  if (quantize_weights_) {
+    if (!PackQuantizedWeights(weights.Data<float>(), N * K, N, K, num_directions_, alloc, pre_packed_input_weights_)) {
+      return false;
+    }
+
+    pre_packed_input_weights_.shape_ = shape;
+    return true;
+  }
+
   const size_t packed_weights_size = MlasGemmPackBSize(N, K);
   if (packed_weights_size == 0) {
     return false;
@@ -244,6 +257,22 @@ bool DeepCpuGruOp::TryPackRecurrentWeights(const Tensor& weights, AllocatorPtr&
   const auto hidden_size_x_2 = N - hidden_size_;
 
   // We are making two packed buffers, one for ZR weights and another for H weights.
+  if (quantize_weights_) {
+    const size_t weights_stride = narrow<size_t>(N * K);
+    const auto* weights_data = weights.Data<float>();
+    if (!PackQuantizedWeights(weights_data, weights_stride, narrow<size_t>(hidden_size_x_2), narrow<size_t>(K),
+                              num_directions_, alloc, pre_packed_recurrent_ZR_) ||
+        !PackQuantizedWeights(weights_data + hidden_size_x_2 * K, weights_stride, narrow<size_t>(hidden_size_),
+                              narrow<size_t>(K), num_directions_, alloc, pre_packed_recurrent_H_)) {
+      pre_packed_recurrent_ZR_.buffer_.reset();
+      return false;
+    }
+
+    pre_packed_recurrent_ZR_.shape_ = shape;
+    pre_packed_recurrent_H_.shape_ = shape;
+    return true;
+  }
+
   const size_t ZR_packed_size = MlasGemmPackBSize(narrow<size_t>(hidden_size_x_2), narrow<size_t>(K));
   if (ZR_packed_size == 0) {
     return false;
@@ -403,8 +432,6 @@ Status DeepCpuGruOp::ComputeImpl(OpKernelContext& context) const {
   AllocatorPtr alloc;
   status = context.GetTempSpaceAllocator(&alloc);
   ORT_RETURN_IF_ERROR(status);
-  const auto* input_weights = (W != nullptr) ? W->Data<T>() : nullptr;
-  const auto recurrent_weights = (R != nullptr) ? R->DataAsSpan<T>() : gsl::span<const T>();
   gsl::span<const T> bias = B != nullptr ? B->DataAsSpan<T>() : gsl::span<const T>();
 
   // spans for first direction
@@ -414,21 +441,6 @@ Status DeepCpuGruOp::ComputeImpl(OpKernelContext& context) const {
   const size_t recurrent_weights_size_per_direction = recurrent_weights_size_per_direction_ZR + recurrent_weights_size_per_direction_H;
   const size_t bias_size_per_direction = 6 * hidden_size_;
 
-  GemmWeights<T> input_weights_1(0, input_weights, input_weights_size_per_direction, pre_packed_input_weights_);
-
-  GemmWeights<T> recurrent_weights_ZR_1;
-  GemmWeights<T> recurrent_weights_H_1;
-  if (R != nullptr) {
-    auto recurrent_ZR_span = recurrent_weights.subspan(0, recurrent_weights_size_per_direction_ZR);
-    auto recurrent_H_span = recurrent_weights.subspan(recurrent_weights_size_per_direction_ZR, recurrent_weights_size_per_direction_H);
-    recurrent_weights_ZR_1.Init(0, recurrent_ZR_span.data(), recurrent_ZR_span.size(), pre_packed_recurrent_ZR_, nullptr);
-    recurrent_weights_H_1.Init(0, recurrent_H_span.data(), recurrent_H_span.size(), pre_packed_recurrent_H_, nullptr);
-  } else {
-    // The data ptr and the size are taken from pre-packed buffer
-    recurrent_weights_ZR_1.Init(0, nullptr, 0, pre_packed_recurrent_ZR_, nullptr);
-    recurrent_weights_H_1.Init(0, nullptr, 0, pre_packed_recurrent_H_, nullptr);
-  }
-
   gsl::span<const T> bias_1 = bias.empty() ? bias : bias.subspan(0, bias_size_per_direction);
 
   gsl::span<const T> input = X.DataAsSpan<T>();
@@ -461,60 +473,178 @@ Status DeepCpuGruOp::ComputeImpl(OpKernelContext& context) const {
 
   gsl::span<T> hidden_output_1 = hidden_output.subspan(0, hidden_output_size_per_direction);
 
-  if (direction_ == Direction::kBidirectional) {
-    GemmWeights<T> input_weights_2(1, input_weights, input_weights_size_per_direction, pre_packed_input_weights_);
+  // runs the directions with either float or quantized weights. the weights of the second direction are only used
+  // by a bidirectional GRU.
+  const auto compute_directions = [&](const auto& input_weights_1, const auto& recurrent_weights_ZR_1,
+                                      const auto& recurrent_weights_H_1, const auto& input_weights_2,
+                                      const auto& recurrent_weights_ZR_2, const auto& recurrent_weights_H_2) {
+    if (direction_ == Direction::kBidirectional) {
+      gsl::span<const T> bias_2 = bias.empty() ? bias : bias.subspan(bias_size_per_direction, bias_size_per_direction);
+
+      gsl::span<const T> initial_hidden_2 = initial_hidden.empty()
+                                                ? initial_hidden
+                                                : initial_hidden.subspan(initial_hidden_size_per_direction,
+                                                                         initial_hidden_size_per_direction);
+      gsl::span<T> output_2 = output.empty()
+                                  ? output
+                                  : output.subspan(per_direction_offset, output_size - per_direction_offset);
+
+      gsl::span<T> hidden_output_2 = hidden_output.subspan(hidden_output_size_per_direction,
+                                                           hidden_output_size_per_direction);
+
+      detail::UniDirectionalGru<T> fw(alloc, seq_length, batch_size, input_size, hidden_size_,
+                                      linear_before_reset_ != 0, Direction::kForward, bias_1, initial_hidden_1,
+                                      activation_funcs_.Entries()[0],
+                                      activation_funcs_.Entries()[1],
+                                      clip_, thread_pool);
+
+      detail::UniDirectionalGru<T> bw(alloc, seq_length, batch_size, input_size, hidden_size_,
+                                      linear_before_reset_ != 0, Direction::kReverse, bias_2, initial_hidden_2,
+                                      activation_funcs_.Entries()[2],
+                                      activation_funcs_.Entries()[3],
+                                      clip_, thread_pool);
+
+      // The recurrent GEMMs of a step have batch_size rows. Unless they are large, they can't keep the threads busy.
+      // The directions are independent, so after projecting the inputs of both on the thread pool, run their
+      // recurrences concurrently.
+      const double step_cost = static_cast<double>(batch_size) * hidden_size_ * hidden_size_ * 3;
+      if (concurrency::ThreadPool::DegreeOfParallelism(thread_pool) > 1 && step_cost <= kMaxConcurrentDirectionsStepCost) {
+        fw.ProjectInputs(input, sequence_lens_span, input_weights_1);
+        bw.ProjectInputs(input, sequence_lens_span, input_weights_2);
+
+        concurrency::ThreadPool::TrySimpleParallelFor(thread_pool, 2, [&](std::ptrdiff_t i) {
+          if (i == 0) {
+            fw.Compute(input, sequence_lens_span, num_directions_, input_weights_1, recurrent_weights_ZR_1,
+                       recurrent_weights_H_1, output_1, hidden_output_1);
+          } else {
+            bw.Compute(input, sequence_lens_span, num_directions_, input_weights_2, recurrent_weights_ZR_2,
+                       recurrent_weights_H_2, output_2, hidden_output_2);
+          }
+        });
+      } else {
+        fw.Compute(input, sequence_lens_span, num_directions_, input_weights_1, recurrent_weights_ZR_1,
+                   recurrent_weights_H_1, output_1, hidden_output_1);
+        bw.Compute(input, sequence_lens_span, num_directions_, input_weights_2, recurrent_weights_ZR_2,
+                   recurrent_weights_H_2, output_2, hidden_output_2);
+      }
+    } else {
+      detail::UniDirectionalGru<T> gru_p(alloc, seq_length, batch_size, input_size, hidden_size_,
+                                         linear_before_reset_ != 0, direction_, bias_1, initial_hidden_1,
+                                         activation_funcs_.Entries()[0],
+                                         activation_funcs_.Entries()[1],
+                                         clip_, thread_pool);
+      gru_p.Compute(input, sequence_lens_span, num_directions_, input_weights_1, recurrent_weights_ZR_1, recurrent_weights_H_1,
+                    output_1, hidden_output_1);
+    }
+  };
+
+  if (quantize_weights_) {
+    // W and R that are not constant are quantized for this run. The recurrent weights are quantized separately for
+    // the ZR and H GEMMs so each has the [K, N] layout and the per column scales it needs.
+    IAllocatorUniquePtr<int8_t> quantized_W;
+    IAllocatorUniquePtr<int8_t> quantized_R_ZR;
+    IAllocatorUniquePtr<int8_t> quantized_R_H;
+    IAllocatorUniquePtr<float> W_scales_buffer;
+    IAllocatorUniquePtr<float> R_ZR_scales_buffer;
+    IAllocatorUniquePtr<float> R_H_scales_buffer;
+
+    const size_t hidden_size = static_cast<size_t>(hidden_size_);
+    const size_t num_directions = static_cast<size_t>(num_directions_);
+
+    const float* W_scales = (W != nullptr)
+                                ? QuantizeWeights(W->Data<float>(), input_weights_size_per_direction, 3 * hidden_size,
+                                                  static_cast<size_t>(input_size), num_directions, alloc, quantized_W,
+                                                  W_scales_buffer)
+                                : GetPackedQuantizedScales(pre_packed_input_weights_, num_directions_);
+    const float* R_ZR_scales = (R != nullptr)
+                                   ? QuantizeWeights(R->Data<float>(), recurrent_weights_size_per_direction,
+                                                     2 * hidden_size, hidden_size, num_directions, alloc,
+                                                     quantized_R_ZR, R_ZR_scales_buffer)
+                                   : GetPackedQuantizedScales(pre_packed_recurrent_ZR_, num_directions_);
+    const float* R_H_scales = (R != nullptr)
+                                  ? QuantizeWeights(R->Data<float>() + recurrent_weights_size_per_direction_ZR,
+                                                    recurrent_weights_size_per_direction, hidden_size, hidden_size,
+                                                    num_directions, alloc, quantized_R_H, R_H_scales_buffer)
+                                  : GetPackedQuantizedScales(pre_packed_recurrent_H_, num_directions_);
+
+    QuantizationParameter quant_para_W_1(W_scales, nullptr, true /*is_signed*/, 3 * hidden_size);
+    QuantizationParameter quant_para_R_ZR_1(R_ZR_scales, nullptr, true /*is_signed*/, 2 * hidden_size);
+    QuantizationParameter quant_para_R_H_1(R_H_scales, nullptr, true /*is_signed*/, hidden_size);
+
+    GemmWeights<uint8_t> input_weights_1(0, reinterpret_cast<const uint8_t*>(quantized_W.get()),
+                                         input_weights_size_per_direction, pre_packed_input_weights_,
+                                         &quant_para_W_1);
+    GemmWeights<uint8_t> recurrent_weights_ZR_1(0, reinterpret_cast<const uint8_t*>(quantized_R_ZR.get()),
+                                                recurrent_weights_size_per_direction_ZR, pre_packed_recurrent_ZR_,
+                                                &quant_para_R_ZR_1);
+    GemmWeights<uint8_t> recurrent_weights_H_1(0, reinterpret_cast<const uint8_t*>(quantized_R_H.get()),
+                                               recurrent_weights_size_per_direction_H, pre_packed_recurrent_H_,
+                                               &quant_para_R_H_1);
+
+    QuantizationParameter quant_para_W_2(quant_para_W_1);
+    QuantizationParameter quant_para_R_ZR_2(quant_para_R_ZR_1);
+    QuantizationParameter quant_para_R_H_2(quant_para_R_H_1);
+
+    GemmWeights<uint8_t> input_weights_2;
+    GemmWeights<uint8_t> recurrent_weights_ZR_2;
+    GemmWeights<uint8_t> recurrent_weights_H_2;
+
+    if (direction_ == Direction::kBidirectional) {
+      quant_para_W_2.scale += quant_para_W_2.scale_size;
+      quant_para_R_ZR_2.scale += quant_para_R_ZR_2.scale_size;
+      quant_para_R_H_2.scale += quant_para_R_H_2.scale_size;
+
+      input_weights_2.Init(1, reinterpret_cast<const uint8_t*>(quantized_W.get()),
+                           input_weights_size_per_direction, pre_packed_input_weights_, &quant_para_W_2);
+      recurrent_weights_ZR_2.Init(1, reinterpret_cast<const uint8_t*>(quantized_R_ZR.get()),
+                                  recurrent_weights_size_per_direction_ZR, pre_packed_recurrent_ZR_, &quant_para_R_ZR_2);
+      recurrent_weights_H_2.Init(1, reinterpret_cast<const uint8_t*>(quantized_R_H.get()),
+                                 recurrent_weights_size_per_direction_H, pre_packed_recurrent_H_, &quant_para_R_H_2);
+    }
 
-    GemmWeights<T> recurrent_weights_ZR_2;
-    GemmWeights<T> recurrent_weights_H_2;
+    compute_directions(input_weights_1, recurrent_weights_ZR_1, recurrent_weights_H_1,
+                       input_weights_2, recurrent_weights_ZR_2, recurrent_weights_H_2);
+  } else {
+    const auto* input_weights = (W != nullptr) ? W->Data<T>() : nullptr;
+    const auto recurrent_weights = (R != nullptr) ? R->DataAsSpan<T>() : gsl::span<const T>();
+
+    GemmWeights<T> input_weights_1(0, input_weights, input_weights_size_per_direction, pre_packed_input_weights_);
+
+    GemmWeights<T> recurrent_weights_ZR_1;
+    GemmWeights<T> recurrent_weights_H_1;
     if (R != nullptr) {
-      auto recurrent_ZR_span = recurrent_weights.subspan(recurrent_weights_size_per_direction, recurrent_weights_size_per_direction_ZR);
-      auto recurrent_H_span = recurrent_weights.subspan(recurrent_weights_size_per_direction + recurrent_weights_size_per_direction_ZR,
-                                                        recurrent_weights_size_per_direction_H);
-      // Indices are zero since the span already provides the correct view even though we are taking the second direction weights
-      recurrent_weights_ZR_2.Init(0, recurrent_ZR_span.data(), recurrent_ZR_span.size(), pre_packed_recurrent_ZR_, nullptr);
-      recurrent_weights_H_2.Init(0, recurrent_H_span.data(), recurrent_H_span.size(), pre_packed_recurrent_H_, nullptr);
+      auto recurrent_ZR_span = recurrent_weights.subspan(0, recurrent_weights_size_per_direction_ZR);
+      auto recurrent_H_span = recurrent_weights.subspan(recurrent_weights_size_per_direction_ZR, recurrent_weights_size_per_direction_H);
+      recurrent_weights_ZR_1.Init(0, recurrent_ZR_span.data(), recurrent_ZR_span.size(), pre_packed_recurrent_ZR_, nullptr);
+      recurrent_weights_H_1.Init(0, recurrent_H_span.data(), recurrent_H_span.size(), pre_packed_recurrent_H_, nullptr);
     } else {
       // The data ptr and the size are taken from pre-packed buffer
-      recurrent_weights_ZR_2.Init(1, nullptr, 0, pre_packed_recurrent_ZR_, nullptr);
-      recurrent_weights_H_2.Init(1, nullptr, 0, pre_packed_recurrent_H_, nullptr);
+      recurrent_weights_ZR_1.Init(0, nullptr, 0, pre_packed_recurrent_ZR_, nullptr);
+      recurrent_weights_H_1.Init(0, nullptr, 0, pre_packed_recurrent_H_, nullptr);
     }
 
-    gsl::span<const T> bias_2 = bias.empty() ? bias : bias.subspan(bias_size_per_direction, bias_size_per_direction);
-
-    gsl::span<const T> initial_hidden_2 = initial_hidden.empty()
-                                              ? initial_hidden
-                                              : initial_hidden.subspan(initial_hidden_size_per_direction,
-                                                                       initial_hidden_size_per_direction);
-    gsl::span<T> output_2 = output.empty()
-                                ? output
-                                : output.subspan(per_direction_offset, output_size - per_direction_offset);
-
-    gsl::span<T> hidden_output_2 = hidden_output.subspan(hidden_output_size_per_direction,
-                                                         hidden_output_size_per_direction);
-
-    detail::UniDirectionalGru<T> fw(alloc, seq_length, batch_size, input_size, hidden_size_,
-                                    linear_before_reset_ != 0, Direction::kForward, bias_1, initial_hidden_1,
-                                    activation_funcs_.Entries()[0],
-                                    activation_funcs_.Entries()[1],
-                                    clip_, thread_pool);
-    fw.Compute(input, sequence_lens_span, num_directions_, input_weights_1, recurrent_weights_ZR_1, recurrent_weights_H_1,
-               output_1, hidden_output_1);
-
-    detail::UniDirectionalGru<T> bw(alloc, seq_length, batch_size, input_size, hidden_size_,
-                                    linear_before_reset_ != 0, Direction::kReverse, bias_2, initial_hidden_2,
-                                    activation_funcs_.Entries()[2],
-                                    activation_funcs_.Entries()[3],
-                                    clip_, thread_pool);
-    bw.Compute(input, sequence_lens_span, num_directions_, input_weights_2, recurrent_weights_ZR_2, recurrent_weights_H_2,
-               output_2, hidden_output_2);
-  } else {
-    detail::UniDirectionalGru<T> gru_p(alloc, seq_length, batch_size, input_size, hidden_size_,
-                                       linear_before_reset_ != 0, direction_, bias_1, initial_hidden_1,
-                                       activation_funcs_.Entries()[0],
-                                       activation_funcs_.Entries()[1],
-                                       clip_, thread_pool);
-    gru_p.Compute(input, sequence_lens_span, num_directions_, input_weights_1, recurrent_weights_ZR_1, recurrent_weights_H_1,
-                  output_1, hidden_output_1);
+    GemmWeights<T> input_weights_2;
+    GemmWeights<T> recurrent_weights_ZR_2;
+    GemmWeights<T> recurrent_weights_H_2;
+    if (direction_ == Direction::kBidirectional) {
+      input_weights_2.Init(1, input_weights, input_weights_size_per_direction, pre_packed_input_weights_, nullptr);
+
+      if (R != nullptr) {
+        auto recurrent_ZR_span = recurrent_weights.subspan(recurrent_weights_size_per_direction, recurrent_weights_size_per_direction_ZR);
+        auto recurrent_H_span = recurrent_weights.subspan(recurrent_weights_size_per_direction + recurrent_weights_size_per_direction_ZR,
+                                                          recurrent_weights_size_per_direction_H);
+        // Indices are zero since the span already provides the correct view even though we are taking the second direction weights
+        recurrent_weights_ZR_2.Init(0, recurrent_ZR_span.data(), recurrent_ZR_span.size(), pre_packed_recurrent_ZR_, nullptr);
+        recurrent_weights_H_2.Init(0, recurrent_H_span.data(), recurrent_H_span.size(), pre_packed_recurrent_H_, nullptr);
+      } else {
+        // The data ptr and the size are taken from pre-packed buffer
+        recurrent_weights_ZR_2.Init(1, nullptr, 0, pre_packed_recurrent_ZR_, nullptr);
+        recurrent_weights_H_2.Init(1, nullptr, 0, pre_packed_recurrent_H_, nullptr);
+      }
+    }
+
+    compute_directions(input_weights_1, recurrent_weights_ZR_1, recurrent_weights_H_1,
+                       input_weights_2, recurrent_weights_ZR_2, recurrent_weights_H_2);
   }
 
   if (!output.empty())
@@ -612,12 +742,13 @@ UniDirectionalGru<T>::UniDirectionalGru(AllocatorPtr allocator,
 }
 
 template <typename T>
+template <typename WeightT>
 void UniDirectionalGru<T>::Compute(gsl::span<const T> inputs_arg,
                                    gsl::span<const int> sequence_lengths_arg,
                                    const int num_directions,
-                                   const GemmWeights<T>& input_weights_s,
-                                   const GemmWeights<T>& recurrent_weightsZR_s,
-                                   const GemmWeights<T>& recurrent_weightsH_s,
+                                   const GemmWeights<WeightT>& input_weights_s,
+                                   const GemmWeights<WeightT>& recurrent_weightsZR_s,
+                                   const GemmWeights<WeightT>& recurrent_weightsH_s,
                                    gsl::span<T>& outputs,
                                    gsl::span<T>& final_hidden_state) {
   ComputeImpl(inputs_arg, sequence_lengths_arg, num_directions,
@@ -626,12 +757,13 @@ void UniDirectionalGru<T>::Compute(gsl::span<const T> inputs_arg,
 }
 
 template <typename T>
+template <typename WeightT>
 void UniDirectionalGru<T>::Compute(gsl::span<const T> inputs_arg,
                                    gsl::span<const int> sequence_lengths_arg,
                                    const int num_directions,
-                                   const GemmWeights<T>& input_weights_s,
-                                   const GemmWeights<T>& recurrent_weightsZR_s,
-                                   const GemmWeights<T>& recurrent_weightsH_s,
+                                   const GemmWeights<WeightT>& input_weights_s,
+                                   const GemmWeights<WeightT>& recurrent_weightsZR_s,
+                                   const GemmWeights<WeightT>& recurrent_weightsH_s,
                                    gsl::span<T>& outputs,
                                    gsl::span<T>& final_hidden_state,
                                    gsl::span<T>& zrh) {
@@ -641,56 +773,86 @@ void UniDirectionalGru<T>::Compute(gsl::span<const T> inputs_arg,
 }
 
 template <typename T>
-void UniDirectionalGru<T>::ComputeImpl(gsl::span<const T> inputs_arg,
-                                       gsl::span<const int> sequence_lengths_arg,
-                                       const int num_directions,
-                                       const GemmWeights<T>& input_weights_s,
-                                       const GemmWeights<T>& recurrent_weightsZR_s,
-                                       const GemmWeights<T>& recurrent_weightsH_s,
-                                       gsl::span<T>& outputs,
-                                       gsl::span<T>& final_hidden_state,
-                                       gsl::span<T>& zrh) {
-  using span_T_const_iter = typename gsl::span<const T>::iterator;
-  using span_T_iter = typename gsl::span<T>::iterator;
+template <typename WeightT>
+void UniDirectionalGru<T>::ProjectInputs(gsl::span<const T> inputs,
+                                         gsl::span<const int> sequence_lengths,
+                                         const GemmWeights<WeightT>& input_weights_s) {
+  ProjectInputsImpl(inputs, GetSequenceLengths(sequence_lengths), input_weights_s, outputZRH_);
+  inputs_projected_ = true;
+}
 
-  // copy inputs_arg as we may change it to point to inputs_reverse_
-  gsl::span<const T> inputs = inputs_arg;
-  gsl::span<const int> sequence_lengths = sequence_lengths_arg;
+template <typename T>
+gsl::span<const int> UniDirectionalGru<T>::GetSequenceLengths(gsl::span<const int> sequence_lengths) {
+  if (!sequence_lengths.empty())
+    return sequence_lengths;
 
   // if sequence lengths weren't provided, use internal array and init all to seq_length
-  if (sequence_lengths.empty()) {
+  if (sequence_lengths_.empty())
     sequence_lengths_ = Allocate(allocator_, batch_size_, sequence_lengths_ptr_, true, seq_length_);
-    sequence_lengths = sequence_lengths_;
-  }
-
-  gsl::span<const T> input_weights;
-  if (!input_weights_s.is_prepacked_) {
-    input_weights = input_weights_s.GetUnpackedSpan();
-    DumpMatrix("Inputs", inputs.data(), seq_length_ * batch_size_, input_size_);
-    DumpMatrix("input_weights", input_weights.data(), 3 * hidden_size_, input_size_);
-    DumpMatrix("recurrent_weights", recurrent_weights.data(), 3 * hidden_size_, hidden_size_);
-  }
 
-  gsl::span<const T> recurrent_weightsZR;
-  if (!recurrent_weightsZR_s.is_prepacked_)
-    recurrent_weightsZR = recurrent_weightsZR_s.GetUnpackedSpan();
+  return sequence_lengths_;
+}
 
-  gsl::span<const T> recurrent_weightsH;
-  if (!recurrent_weightsH_s.is_prepacked_)
-    recurrent_weightsH = recurrent_weightsH_s.GetUnpackedSpan();
+template <typename T>
+template <typename WeightT>
+void UniDirectionalGru<T>::ProjectInputsImpl(gsl::span<const T> inputs_arg,
+                                             gsl::span<const int> sequence_lengths,
+                                             const GemmWeights<WeightT>& input_weights_s,
+                                             gsl::span<T>& zrh) {
+  // copy inputs_arg as we may change it to point to inputs_reverse_
+  gsl::span<const T> inputs = inputs_arg;
 
-  gsl::span<T> original_outputs = outputs;
-  const bool output_sequence = !outputs.empty();
+  DumpMatrix("Inputs", inputs.data(), seq_length_ * batch_size_, input_size_);
 
   if (direction_ == kReverse) {
     ReverseSequence(inputs, inputs_reverse_, sequence_lengths, seq_length_, batch_size_, input_size_, 1, ttp_);
     // DumpMatrix("Reversed inputs", inputs_reverse_.data(), seq_length_ * batch_size_, input_size_);
 
     inputs = inputs_reverse_;
+  }
 
-    if (output_sequence) {
-      outputs = outputs_reverse_;
-    }
+  const int32_t max_sequence_length = *std::max_element(sequence_lengths.begin(), sequence_lengths.end());
+  const int hidden_size_x3 = 3 * hidden_size_;
+  const int total_rows = max_sequence_length * batch_size_;
+
+  const float alpha = 1.0f;
+
+  AllocateQuantizeBuffers<WeightT>(max_sequence_length);
+
+  // apply weights to all the inputs
+  ComputeGemm(total_rows, hidden_size_x3, input_size_, alpha,
+              inputs,
+              input_weights_s,
+              0.f,
+              zrh, hidden_size_x3,
+              quantized_input_or_a_.data(),
+              nullptr,
+              ttp_);
+
+  DumpMatrix("inputs with weights applied", zrh.data(), seq_length_ * batch_size_ * 3, hidden_size_);
+}
+
+template <typename T>
+template <typename WeightT>
+void UniDirectionalGru<T>::ComputeImpl(gsl::span<const T> inputs_arg,
+                                       gsl::span<const int> sequence_lengths_arg,
+                                       const int num_directions,
+                                       const GemmWeights<WeightT>& input_weights_s,
+                                       const GemmWeights<WeightT>& recurrent_weightsZR_s,
+                                       const GemmWeights<WeightT>& recurrent_weightsH_s,
+                                       gsl::span<T>& outputs,
+                                       gsl::span<T>& final_hidden_state,
+                                       gsl::span<T>& zrh) {
+  using span_T_const_iter = typename gsl::span<const T>::iterator;
+  using span_T_iter = typename gsl::span<T>::iterator;
+
+  gsl::span<const int> sequence_lengths = GetSequenceLengths(sequence_lengths_arg);
+
+  gsl::span<T> original_outputs = outputs;
+  const bool output_sequence = !outputs.empty();
+
+  if (direction_ == kReverse && output_sequence) {
+    outputs = outputs_reverse_;
   }
 
   // Calculate the max and min length
@@ -700,35 +862,13 @@ void UniDirectionalGru<T>::ComputeImpl(gsl::span<const T> inputs_arg,
 
   const int hidden_size_x2 = 2 * hidden_size_;
   const int hidden_size_x3 = 3 * hidden_size_;
-  const int total_rows = max_sequence_length * batch_size_;
-
-  float alpha = 1.0f;
 
-  // apply weights to all the inputs
-  if (!input_weights_s.is_prepacked_) {
-    ComputeGemm(total_rows, hidden_size_x3, input_size_, alpha,
-                inputs.begin(), inputs.end(),
-                input_size_,
-                input_weights.begin(), input_weights.end(),
-                input_size_, 0.f,
-                zrh.begin(), zrh.end(),
-                hidden_size_x3, ttp_);
-  } else {
-    MlasGemm(
-        CblasNoTrans,
-        static_cast<size_t>(total_rows),
-        static_cast<size_t>(hidden_size_x3),
-        static_cast<size_t>(input_size_),
-        alpha,
-        inputs.data(),
-        static_cast<size_t>(input_size_),
-        input_weights_s.buffer_,
-        0.0f,
-        &*zrh.begin(),
-        static_cast<size_t>(hidden_size_x3), ttp_);
-  }
+  const float alpha = 1.0f;
 
-  DumpMatrix("inputs with weights applied", zrh.data(), seq_length_ * batch_size_ * 3, hidden_size_);
+  // if the caller projected the inputs it runs this recurrence concurrently with another one, so stay on this thread
+  concurrency::ThreadPool* thread_pool = inputs_projected_ ? nullptr : ttp_;
+  if (!inputs_projected_)
+    ProjectInputsImpl(inputs_arg, sequence_lengths, input_weights_s, zrh);
 
   // output shape is [seq_length, num_directions, batch_size, hidden_size]
   // if we are doing 2 directions and this is the forward pass we're writing to the real output so
@@ -777,7 +917,7 @@ void UniDirectionalGru<T>::ComputeImpl(gsl::span<const T> inputs_arg,
     // below.  This lets the runtime system amortize loop entry/exit
     // costs over a series of short kernels, and promotes cache
     // affinity between iterations of successive loops.
-    onnxruntime::concurrency::ThreadPool::ParallelSection ps(ttp_);
+    onnxruntime::concurrency::ThreadPool::ParallelSection ps(thread_pool);
 
     // for each item in sequence run all calculations
     for (int step = 0; step < max_sequence_length; step++) {
@@ -790,25 +930,15 @@ void UniDirectionalGru<T>::ComputeImpl(gsl::span<const T> inputs_arg,
 
       // calculate Ht-1*R[zr], and add to the weighted inputs that are in zrh
       // Ht-1 * R[zr] + Xt*(W[zr]^T)
-      if (!recurrent_weightsZR_s.is_prepacked_) {
-        ComputeGemm(batch_size_, hidden_size_x2, hidden_size_, alpha,
-                    prev_Ht, prev_Ht_end,
-                    hidden_size_,
-                    recurrent_weightsZR.begin(), recurrent_weightsZR.end(),
-                    hidden_size_, 1.f,  // beta == 1 so we add existing values in zrh
-                    zrh.begin() + out_added_offset, zrh.end(),
-                    hidden_size_x3, ttp_);
-      } else {
-        MlasGemm(
-            CblasNoTrans,
-            static_cast<size_t>(batch_size_), static_cast<size_t>(hidden_size_x2), static_cast<size_t>(hidden_size_), alpha,
-            &*prev_Ht,
-            static_cast<size_t>(hidden_size_),
-            recurrent_weightsZR_s.buffer_,
-            1.f,
-            &*(zrh.begin() + out_added_offset),
-            static_cast<size_t>(hidden_size_x3), ttp_);
-      }
+      ComputeGemm(batch_size_, hidden_size_x2, hidden_size_, alpha,
+                  gsl::span<const T>(&*prev_Ht, prev_Ht_end - prev_Ht),
+                  recurrent_weightsZR_s,
+                  1.f,  // beta == 1 so we add existing values in zrh
+                  zrh.subspan(out_added_offset),
+                  hidden_size_x3,
+                  quantized_input_or_a_.data(),
+                  quantized_C_buffer_.data(),
+                  thread_pool);
 
       DumpMatrix("Ht-1 * R[zr] + Xt*(W[zr]^T)" + seqno_str,
                  zrh.data() + out_added_offset, batch_size_, hidden_size_x2, 0, hidden_size_x3);
@@ -822,27 +952,15 @@ void UniDirectionalGru<T>::ComputeImpl(gsl::span<const T> inputs_arg,
         }
 
         // compute Ht-1 * (Rh^T) + Rbh
-        if (!recurrent_weightsH_s.is_prepacked_) {
-          ComputeGemm(batch_size_, hidden_size_, hidden_size_, alpha,
-                      prev_Ht, prev_Ht_end,  // Ht-1
-                      hidden_size_,
-                      recurrent_weightsH.begin(), recurrent_weightsH.end(),  // Rh^T
-                      hidden_size_,
-                      use_bias_ ? 1.f : 0.f,  // don't add values in linear_output_ if no bias input
-                      linear_output_.begin(),
-                      linear_output_.end(),  // pre: Rbh if use_bias_, post:output
-                      hidden_size_, ttp_);
-        } else {
-          MlasGemm(
-              CblasNoTrans,
-              static_cast<size_t>(batch_size_), static_cast<size_t>(hidden_size_), static_cast<size_t>(hidden_size_), alpha,
-              &*prev_Ht,
-              static_cast<size_t>(hidden_size_),
-              recurrent_weightsH_s.buffer_,
-              use_bias_ ? 1.f : 0.f,  // don't add values in linear_output_ if no bias input
-              &*linear_output_.begin(),
-              static_cast<size_t>(hidden_size_), ttp_);
-        }
+        ComputeGemm(batch_size_, hidden_size_, hidden_size_, alpha,
+                    gsl::span<const T>(&*prev_Ht, prev_Ht_end - prev_Ht),  // Ht-1
+                    recurrent_weightsH_s,                                  // Rh^T
+                    use_bias_ ? 1.f : 0.f,                                 // don't add values in linear_output_ if no bias input
+                    linear_output_,                                        // pre: Rbh if use_bias_, post:output
+                    hidden_size_,
+                    quantized_input_or_a_.data(),
+                    quantized_C_buffer_.data(),
+                    thread_pool);
 
         DumpMatrix("Ht-1 * (Rh^T) + Rbh " + seqno_str, linear_output_.data(), batch_size_, hidden_size_);
       }
@@ -904,28 +1022,17 @@ void UniDirectionalGru<T>::ComputeImpl(gsl::span<const T> inputs_arg,
 #endif
 
         // out_H currently contains Xt*(Wh^T).
-        auto out_H = zrh.begin() + out_added_offset + hidden_size_x2;
+        auto out_H = zrh.subspan(out_added_offset + hidden_size_x2);
 
         // Calculate Xt*(Wh^T) + rt (.) Ht-1 * Rh
-        if (!recurrent_weightsH_s.is_prepacked_) {
-          ComputeGemm(batch_size_, hidden_size_, hidden_size_, alpha,
-                      cur_h_local, cur_h_local_end,  // rt (.) Ht-1
-                      hidden_size_,
-                      recurrent_weightsH.begin(), recurrent_weightsH.end(),  // Rh^T
-                      hidden_size_, 1.f,                                     // beta == 1 to add Xt*(Wh^T) from out_H
-                      out_H, zrh.end(),
-                      hidden_size_x3, ttp_);
-        } else {
-          MlasGemm(
-              CblasNoTrans,
-              static_cast<size_t>(batch_size_), static_cast<size_t>(hidden_size_), static_cast<size_t>(hidden_size_), alpha,
-              &*cur_h_local,
-              static_cast<size_t>(hidden_size_),
-              recurrent_weightsH_s.buffer_,
-              1.f,  // beta == 1 to add Xt*(Wh^T) from out_H
-              &*out_H,
-              static_cast<size_t>(hidden_size_x3), ttp_);
-        }
+        ComputeGemm(batch_size_, hidden_size_, hidden_size_, alpha,
+                    gsl::span<const T>(cur_h_),  // rt (.) Ht-1
+                    recurrent_weightsH_s,        // Rh^T
+                    1.f,                         // beta == 1 to add Xt*(Wh^T) from out_H
+                    out_H, hidden_size_x3,
+                    quantized_input_or_a_.data(),
+                    quantized_C_buffer_.data(),
+                    thread_pool);
       }
 
       DumpMatrix("Xt*(Wh^T) + (" + label + ")" + seqno_str, zrh.data() + out_added_offset,
@@ -1042,7 +1149,22 @@ void UniDirectionalGru<T>::ComputeImpl(gsl::span<const T> inputs_arg,
   if (output_sequence && direction_ == kReverse) {
     ReverseSequence<T>(outputs, original_outputs,
                        sequence_lengths, seq_length_,
-                       batch_size_, hidden_size_, num_directions, ttp_);
+                       batch_size_, hidden_size_, num_directions, thread_pool);
+  }
+}
+
+template <typename T>
+template <typename WeightT>
+void UniDirectionalGru<T>::AllocateQuantizeBuffers(int max_sequence_length) {
+  // Can not specialize on WeightT without specify T explicitly, so use sizeof
+  if constexpr (sizeof(WeightT) == 1) {
+    const int hidden_size_x2 = 2 * hidden_size_;
+    const int total_rows = max_sequence_length * batch_size_;
+
+    int input_or_a_size = std::max(total_rows * input_size_, batch_size_ * hidden_size_);
+    quantized_input_or_a_ = Allocate(allocator_, input_or_a_size, quantized_input_or_a_ptr_, false);
+    // the ZR GEMM has the widest output of the recurrent GEMMs that add to their output
+    quantized_C_buffer_ = Allocate(allocator_, batch_size_ * hidden_size_x2, quantized_C_buffer_ptr_, false);
   }
 }
 
@@ -1080,6 +1202,27 @@ void UniDirectionalGru<T>::AllocateBuffers() {
 }
 
 template class UniDirectionalGru<float>;
+template void UniDirectionalGru<float>::Compute<float>(
+    gsl::span<const float> inputs, gsl::span<const int> sequence_lengths, int num_directions,
+    const GemmWeights<float>& input_weights, const GemmWeights<float>& recurrent_weights_ZR,
+    const GemmWeights<float>& recurrent_weights_H, gsl::span<float>& outputs, gsl::span<float>& final_hidden_state);
+
+template void UniDirectionalGru<float>::Compute<uint8_t>(
+    gsl::span<const float> inputs, gsl::span<const int> sequence_lengths, int num_directions,
+    const GemmWeights<uint8_t>& input_weights, const GemmWeights<uint8_t>& recurrent_weights_ZR,
+    const GemmWeights<uint8_t>& recurrent_weights_H, gsl::span<float>& outputs, gsl::span<float>& final_hidden_state);
+
+template void UniDirectionalGru<float>::Compute<float>(
+    gsl::span<const float> inputs, gsl::span<const int> sequence_lengths, int num_directions,
+    const GemmWeights<float>& input_weights, const GemmWeights<float>& recurrent_weights_ZR,
+    const GemmWeights<float>& recurrent_weights_H, gsl::span<float>& outputs, gsl::span<float>& final_hidden_state,
+    gsl::span<float>& zrh);
+
+template void UniDirectionalGru<float>::ProjectInputs<float>(
+    gsl::span<const float> inputs, gsl::span<const int> sequence_lengths, const GemmWeights<float>& input_weights);
+
+template void UniDirectionalGru<float>::ProjectInputs<uint8_t>(
+    gsl::span<const float> inputs, gsl::span<const int> sequence_lengths, const GemmWeights<uint8_t>& input_weights);
 
 }  // namespace detail
 }  // namespace onnxruntime
@@ -8,6 +8,7 @@
 #include "core/common/narrow.h"
 #include "core/framework/op_kernel.h"
 #include "core/providers/cpu/rnn/rnn_helpers.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
 
 namespace onnxruntime {
 
@@ -54,6 +55,8 @@ class DeepCpuGruOp final : public OpKernel {
     layout_ = info.GetAttrOrDefault("layout", static_cast<int64_t>(0));
     ORT_ENFORCE(layout_ == 0,
                 "Batchwise recurrent operations (layout == 1) are not supported. If you need support create a github issue with justification.");
+
+    quantize_weights_ = info.GetConfigOptions().GetConfigOrDefault(kOrtSessionOptionsQuantizeGruWeights, "0") == "1";
   }
 
   Status Compute(OpKernelContext* context) const override;
@@ -91,6 +94,10 @@ class DeepCpuGruOp final : public OpKernel {
   // recurrent_weights_H_ fwd, followed by bwd
   rnn::detail::PackedWeights pre_packed_recurrent_H_;
 
+  // If set, the pre-packed buffers hold int8 weights followed by their per column scales,
+  // and W or R are quantized in Compute if they are not constant.
+  bool quantize_weights_ = false;
+
   template <typename T>
   Status ComputeImpl(OpKernelContext& context) const;
 };
@@ -107,29 +114,45 @@ class UniDirectionalGru {
                     onnxruntime::concurrency::ThreadPool* ttp,
                     const bool training_mode = false);
 
+  template <typename WeightT>
   void Compute(gsl::span<const T> inputs, gsl::span<const int> sequence_lengths, int num_directions,
-               const rnn::detail::GemmWeights<T>& input_weights,
-               const rnn::detail::GemmWeights<T>& recurrent_weights_ZR,
-               const rnn::detail::GemmWeights<T>& recurrent_weights_H,
+               const rnn::detail::GemmWeights<WeightT>& input_weights,
+               const rnn::detail::GemmWeights<WeightT>& recurrent_weights_ZR,
+               const rnn::detail::GemmWeights<WeightT>& recurrent_weights_H,
                gsl::span<T>& outputs, gsl::span<T>& final_hidden_state);
 
   // This function overloads the above one by adding two additional reference inputs that are computed in this kernel:
   //   - zrh: intermediate gate computations
   // This extra output is needed for training for gradient computation.
+  template <typename WeightT>
   void Compute(gsl::span<const T> inputs, gsl::span<const int> sequence_lengths, int num_directions,
-               const rnn::detail::GemmWeights<T>& input_weights,
-               const rnn::detail::GemmWeights<T>& recurrent_weights_ZR,
-               const rnn::detail::GemmWeights<T>& recurrent_weights_H,
+               const rnn::detail::GemmWeights<WeightT>& input_weights,
+               const rnn::detail::GemmWeights<WeightT>& recurrent_weights_ZR,
+               const rnn::detail::GemmWeights<WeightT>& recurrent_weights_H,
                gsl::span<T>& outputs, gsl::span<T>& final_hidden_state,
                gsl::span<T>& zrh);
 
+  // Computes Xt*(W[zrh]^T) for all the steps in one GEMM on the thread pool. A following call to Compute without zrh
+  // skips that GEMM and runs the recurrence on the calling thread, so the recurrences of the two directions of a
+  // bidirectional GRU can run concurrently.
+  template <typename WeightT>
+  void ProjectInputs(gsl::span<const T> inputs, gsl::span<const int> sequence_lengths,
+                     const rnn::detail::GemmWeights<WeightT>& input_weights);
+
   ~UniDirectionalGru() = default;
 
  private:
+  gsl::span<const int> GetSequenceLengths(gsl::span<const int> sequence_lengths);
+
+  template <typename WeightT>
+  void ProjectInputsImpl(gsl::span<const T> inputs, gsl::span<const int> sequence_lengths,
+                         const rnn::detail::GemmWeights<WeightT>& input_weights, gsl::span<T>& zrh);
+
+  template <typename WeightT>
   void ComputeImpl(gsl::span<const T> inputs, gsl::span<const int> sequence_lengths, int num_directions,
-                   const rnn::detail::GemmWeights<T>& input_weights,
-                   const rnn::detail::GemmWeights<T>& recurrent_weights_ZR,
-                   const rnn::detail::GemmWeights<T>& recurrent_weights_H,
+                   const rnn::detail::GemmWeights<WeightT>& input_weights,
+                   const rnn::detail::GemmWeights<WeightT>& recurrent_weights_ZR,
+                   const rnn::detail::GemmWeights<WeightT>& recurrent_weights_H,
                    gsl::span<T>& outputs, gsl::span<T>& final_hidden_state,
                    gsl::span<T>& zrh);
 
@@ -191,7 +214,19 @@ class UniDirectionalGru {
 
   void AllocateBuffers();
 
+  // Quantized operation related allocation members
+  template <typename WeightT>
+  void AllocateQuantizeBuffers(int max_sequence_length);
+
+  // Buffer shared for quantized input whole, and quantized a each sequence step
+  IAllocatorUniquePtr<uint8_t> quantized_input_or_a_ptr_;
+  gsl::span<uint8_t> quantized_input_or_a_;
+
+  IAllocatorUniquePtr<int32_t> quantized_C_buffer_ptr_;
+  gsl::span<int32_t> quantized_C_buffer_;
+
   onnxruntime::concurrency::ThreadPool* ttp_;
+  bool inputs_projected_ = false;
 
   const bool training_mode_ = false;
 };
@@ -226,6 +226,31 @@ Status DeepCpuLstmOp::TryPackWeights(const Tensor& weights, PackedWeights& packe
   return Status::OK();
 }
 
+Status DeepCpuLstmOp::TryPackQuantizedWeights(const Tensor& weights, PackedWeights& packed_weights, bool& is_packed,
+                                              AllocatorPtr& alloc) {
+  const auto& shape = weights.Shape();
+  if (shape.NumDimensions() != 3) {
+    return Status::OK();
+  }
+
+  // weights: [num_directions, 4*hidden_size, input_size]
+  // recurrence weights: [num_directions, 4*hidden_size, hidden_size]
+  const size_t N = static_cast<size_t>(shape[1]);
+  const size_t K = static_cast<size_t>(shape[2]);
+
+  if ((shape[0] != num_directions_) || (N != static_cast<size_t>(hidden_size_) * 4)) {
+    return Status::OK();
+  }
+
+  if (!PackQuantizedWeights(weights.Data<float>(), N * K, N, K, num_directions_, alloc, packed_weights)) {
+    return Status::OK();
+  }
+
+  packed_weights.shape_ = shape;
+  is_packed = true;
+  return Status::OK();
+}
+
 static void UseSharedPrePackedBuffersImpl(std::vector<BufferUniquePtr>& prepacked_buffers,
                                           rnn::detail::PackedWeights& packed_tensor) {
   packed_tensor.buffer_ = std::move(prepacked_buffers[0]);
@@ -238,7 +263,8 @@ Status DeepCpuLstmOp::PrePack(const Tensor& tensor, int input_idx,
 
   if (tensor.IsDataType<float>()) {
     if (input_idx == 1) {
-      ORT_RETURN_IF_ERROR(TryPackWeights(tensor, packed_W_, is_packed, alloc));
+      ORT_RETURN_IF_ERROR(quantize_weights_ ? TryPackQuantizedWeights(tensor, packed_W_, is_packed, alloc)
+                                            : TryPackWeights(tensor, packed_W_, is_packed, alloc));
 
       bool share_prepacked_weights = (prepacked_weights != nullptr);
       if (is_packed && share_prepacked_weights) {
@@ -246,7 +272,8 @@ Status DeepCpuLstmOp::PrePack(const Tensor& tensor, int input_idx,
         prepacked_weights->buffer_sizes_.push_back(packed_W_.buffer_size_);
       }
     } else if (input_idx == 2) {
-      ORT_RETURN_IF_ERROR(TryPackWeights(tensor, packed_R_, is_packed, alloc));
+      ORT_RETURN_IF_ERROR(quantize_weights_ ? TryPackQuantizedWeights(tensor, packed_R_, is_packed, alloc)
+                                            : TryPackWeights(tensor, packed_R_, is_packed, alloc));
 
       bool share_prepacked_weights = (prepacked_weights != nullptr);
       if (is_packed && share_prepacked_weights) {
@@ -275,6 +302,81 @@ Status DeepCpuLstmOp::UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& pr
   return Status::OK();
 }
 
+Status DeepCpuLstmOp::ComputeQuantized(OpKernelContext& context) const {
+  const Tensor& X = *context.Input<Tensor>(0);  // inputs. [seq_length, batch_size, input_size]
+
+  const Tensor* W = packed_W_.buffer_ ? nullptr : context.Input<Tensor>(1);
+  // weights. [num_directions, 4*hidden_size, input_size]
+  const Tensor* R = packed_R_.buffer_ ? nullptr : context.Input<Tensor>(2);
+  // recurrence weights. [num_directions, 4*hidden_size, hidden_size]
+
+  const auto& X_shape = X.Shape();
+  const auto& W_shape = (W != nullptr) ? W->Shape() : packed_W_.shape_;
+  const auto& R_shape = (R != nullptr) ? R->Shape() : packed_R_.shape_;
+
+  // the quantized GEMM reads the weights with the shapes implied by X and hidden_size, so check them up front
+  const int64_t hidden_size_x4 = static_cast<int64_t>(hidden_size_) * 4;
+  if (X_shape.NumDimensions() != 3)
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Input X must have 3 dimensions only. Actual:", X_shape);
+
+  if (W_shape != TensorShape({num_directions_, hidden_size_x4, X_shape[2]}))
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Input W must have shape {", num_directions_, ",",
+                           hidden_size_x4, ",", X_shape[2], "}. Actual:", W_shape);
+
+  if (R_shape != TensorShape({num_directions_, hidden_size_x4, hidden_size_}))
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Input R must have shape {", num_directions_, ",",
+                           hidden_size_x4, ",", hidden_size_, "}. Actual:", R_shape);
+
+  AllocatorPtr alloc;
+  ORT_RETURN_IF_ERROR(context.GetTempSpaceAllocator(&alloc));
+
+  IAllocatorUniquePtr<int8_t> quantized_W;
+  IAllocatorUniquePtr<int8_t> quantized_R;
+  IAllocatorUniquePtr<float> W_scales_buffer;
+  IAllocatorUniquePtr<float> R_scales_buffer;
+
+  const size_t input_weights_size_per_direction = SafeInt<size_t>(W_shape[1]) * W_shape[2];
+  const size_t hidden_weights_size_per_direction = SafeInt<size_t>(R_shape[1]) * R_shape[2];
+
+  const float* W_scales = (W != nullptr)
+                              ? QuantizeWeights(W->Data<float>(), input_weights_size_per_direction,
+                                                static_cast<size_t>(W_shape[1]), static_cast<size_t>(W_shape[2]),
+                                                static_cast<size_t>(num_directions_), alloc, quantized_W, W_scales_buffer)
+                              : GetPackedQuantizedScales(packed_W_, num_directions_);
+  const float* R_scales = (R != nullptr)
+                              ? QuantizeWeights(R->Data<float>(), hidden_weights_size_per_direction,
+                                                static_cast<size_t>(R_shape[1]), static_cast<size_t>(R_shape[2]),
+                                                static_cast<size_t>(num_directions_), alloc, quantized_R, R_scales_buffer)
+                              : GetPackedQuantizedScales(packed_R_, num_directions_);
+
+  const auto* input_weights = reinterpret_cast<const uint8_t*>(quantized_W.get());
+  const auto* recurrent_weights = reinterpret_cast<const uint8_t*>(quantized_R.get());
+
+  const size_t scale_size = static_cast<size_t>(hidden_size_x4);
+
+  QuantizationParameter quant_para_W_1(W_scales, nullptr, true /*is_signed*/, scale_size);
+  QuantizationParameter quant_para_R_1(R_scales, nullptr, true /*is_signed*/, scale_size);
+
+  GemmWeights<uint8_t> W_1(0, input_weights, input_weights_size_per_direction, packed_W_, &quant_para_W_1);
+  GemmWeights<uint8_t> R_1(0, recurrent_weights, hidden_weights_size_per_direction, packed_R_, &quant_para_R_1);
+
+  GemmWeights<uint8_t> W_2;
+  GemmWeights<uint8_t> R_2;
+
+  QuantizationParameter quant_para_W_2(quant_para_W_1);
+  QuantizationParameter quant_para_R_2(quant_para_R_1);
+
+  if (direction_ == Direction::kBidirectional) {
+    quant_para_W_2.scale += scale_size;
+    quant_para_R_2.scale += scale_size;
+
+    W_2.Init(1, input_weights, input_weights_size_per_direction, packed_W_, &quant_para_W_2);
+    R_2.Init(1, recurrent_weights, hidden_weights_size_per_direction, packed_R_, &quant_para_R_2);
+  }
+
+  return LSTMBase::ComputeImpl<float, uint8_t>(context, W_1, W_2, R_1, R_2);
+}
+
 Status DeepCpuLstmOp::Compute(OpKernelContext* context) const {
   const Tensor& X = *context->Input<Tensor>(0);  // inputs. [seq_length, batch_size, input_size]
 
@@ -282,6 +384,10 @@ Status DeepCpuLstmOp::Compute(OpKernelContext* context) const {
   // auto& logger = context->Logger();
 
   if (X.IsDataType<float>()) {
+    if (quantize_weights_) {
+      return ComputeQuantized(*context);
+    }
+
     const Tensor* W = packed_W_.buffer_ ? nullptr : context->Input<Tensor>(1);
     // weights. [num_directions, 4*hidden_size, input_size]
     const Tensor* R = packed_R_.buffer_ ? nullptr : context->Input<Tensor>(2);
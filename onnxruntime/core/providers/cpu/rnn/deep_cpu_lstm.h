@@ -9,6 +9,7 @@
 
 #include "core/framework/op_kernel.h"
 #include "core/providers/cpu/rnn/rnn_helpers.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
 
 namespace onnxruntime {
 
@@ -16,7 +17,9 @@ namespace onnxruntime {
 /// For details, refer to http://aka.ms/dl-optimization/.
 class DeepCpuLstmOp final : public OpKernel, public LSTMBase {
  public:
-  DeepCpuLstmOp(const OpKernelInfo& info) : OpKernel(info), LSTMBase(info) {}
+  DeepCpuLstmOp(const OpKernelInfo& info) : OpKernel(info), LSTMBase(info) {
+    quantize_weights_ = info.GetConfigOptions().GetConfigOrDefault(kOrtSessionOptionsQuantizeLstmWeights, "0") == "1";
+  }
 
   Status PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
                  /*out*/ bool& is_packed,
@@ -34,11 +37,20 @@ class DeepCpuLstmOp final : public OpKernel, public LSTMBase {
   Status TryPackWeights(const Tensor& weights, rnn::detail::PackedWeights& packed_weights,
                         bool& is_packed, AllocatorPtr& alloc);
 
+  Status TryPackQuantizedWeights(const Tensor& weights, rnn::detail::PackedWeights& packed_weights,
+                                 bool& is_packed, AllocatorPtr& alloc);
+
+  Status ComputeQuantized(OpKernelContext& context) const;
+
   template <typename T>
   Status ComputeImpl(OpKernelContext& context) const;
 
   rnn::detail::PackedWeights packed_W_;
   rnn::detail::PackedWeights packed_R_;
+
+  // If set, packed_W_ and packed_R_ hold int8 weights followed by their per column scales,
+  // and W or R are quantized in Compute if they are not constant.
+  bool quantize_weights_ = false;
 };
 
 }  // namespace onnxruntime
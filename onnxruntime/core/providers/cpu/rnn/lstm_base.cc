@@ -153,10 +153,28 @@ Status LSTMBase::ComputeImpl(OpKernelContext& context,
                                         initial_cell_2, activation_funcs_.Entries()[3], activation_funcs_.Entries()[4],
                                         activation_funcs_.Entries()[5], clip_, thread_pool);
 
-    fw.Compute(input, sequence_lens_span, num_directions_, W_1, R_1, output_1,
-               hidden_output_1, last_cell_1);
-    bw.Compute(input, sequence_lens_span, num_directions_, W_2, R_2, output_2,
-               hidden_output_2, last_cell_2);
+    // Unless the batch is large enough to split the recurrence by rows, each step of a recurrence is a GEMM with a
+    // few rows that can't keep the threads busy. The directions are independent, so after projecting the inputs of
+    // both on the thread pool, run their recurrences concurrently.
+    if (concurrency::ThreadPool::DegreeOfParallelism(thread_pool) > 1 && !fw.IsBatchParallel()) {
+      fw.ProjectInputs(input, sequence_lens_span, W_1);
+      bw.ProjectInputs(input, sequence_lens_span, W_2);
+
+      concurrency::ThreadPool::TrySimpleParallelFor(thread_pool, 2, [&](std::ptrdiff_t i) {
+        if (i == 0) {
+          fw.Compute(input, sequence_lens_span, num_directions_, W_1, R_1, output_1,
+                     hidden_output_1, last_cell_1);
+        } else {
+          bw.Compute(input, sequence_lens_span, num_directions_, W_2, R_2, output_2,
+                     hidden_output_2, last_cell_2);
+        }
+      });
+    } else {
+      fw.Compute(input, sequence_lens_span, num_directions_, W_1, R_1, output_1,
+                 hidden_output_1, last_cell_1);
+      bw.Compute(input, sequence_lens_span, num_directions_, W_2, R_2, output_2,
+                 hidden_output_2, last_cell_2);
+    }
   } else {
     lstm::UniDirectionalLstm<InputT> fw(alloc, logger, seq_length, batch_size, input_size, hidden_size_, direction_,
                                         input_forget_, bias_1, peephole_weights_1, initial_hidden_1, initial_cell_1,
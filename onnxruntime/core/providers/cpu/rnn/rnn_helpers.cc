@@ -3,6 +3,7 @@
 
 #include "core/providers/cpu/rnn/rnn_helpers.h"
 
+#include <algorithm>
 #include <cmath>
 #include <cstring>
 #include <iomanip>
@@ -207,6 +208,92 @@ void DumpMatrixImpl(const std::string& name, const float* src, int row, int col,
 }
 #endif
 
+// Quantizes the weights of one direction, [N, K] with one row per output column, to int8 in the [K, N] layout of
+// the B operand of a quantized GEMM, with one symmetric scale per column.
+static void QuantizeWeightsPerColumn(const float* weights, size_t N, size_t K, int8_t* quantized, float* scales) {
+#if defined(MLAS_TARGET_AMD64_IX86)
+  // u8s8 products can saturate the 16 bit intermediates of CPUs without VNNI, so use 7 bit weights there
+  const float quantized_max = MlasPlatformU8S8Overflow() ? 63.f : 127.f;
+#else
+  const float quantized_max = 127.f;
+#endif
+
+  for (size_t n = 0; n < N; n++) {
+    const float* column = weights + n * K;
+    float max_abs = 0.f;
+    for (size_t k = 0; k < K; k++) {
+      max_abs = std::max(max_abs, std::abs(column[k]));
+    }
+
+    const float scale = max_abs == 0.f ? 1.f : max_abs / quantized_max;
+    scales[n] = scale;
+    for (size_t k = 0; k < K; k++) {
+      quantized[k * N + n] = static_cast<int8_t>(std::nearbyint(column[k] / scale));
+    }
+  }
+}
+
+// The per column scales of pre-packed quantized weights follow the packed weights of all the directions
+static size_t QuantizedScalesOffset(size_t packed_weights_size, int num_directions) {
+  constexpr size_t alignment = 64;
+  const size_t size = SafeInt<size_t>(packed_weights_size) * num_directions;
+  return (size + alignment - 1) / alignment * alignment;
+}
+
+bool PackQuantizedWeights(const float* weights, size_t weights_stride, size_t N, size_t K, int num_directions,
+                          AllocatorPtr& alloc, PackedWeights& packed_weights) {
+  const size_t packed_weights_size = MlasGemmPackBSize(N, K, false /*AIsSigned*/, true /*BIsSigned*/);
+  if (packed_weights_size == 0) {
+    return false;
+  }
+
+  const size_t scales_offset = QuantizedScalesOffset(packed_weights_size, num_directions);
+  const size_t buffer_size = SafeInt<size_t>(N) * num_directions * sizeof(float) + scales_offset;
+  packed_weights.buffer_ = IAllocator::MakeUniquePtr<void>(alloc, buffer_size, true);
+
+  auto* packed_weights_data = packed_weights.buffer_.get();
+
+  // Initialize memory to 0 as there could be some padding associated with pre-packed
+  // buffer memory and we don not want it uninitialized and generate different hashes
+  // if and when we try to cache this pre-packed buffer for sharing between sessions.
+  memset(packed_weights_data, 0, buffer_size);
+
+  packed_weights.buffer_size_ = buffer_size;
+  packed_weights.weights_size_ = packed_weights_size;
+
+  auto* scales = reinterpret_cast<float*>(static_cast<uint8_t*>(packed_weights_data) + scales_offset);
+  std::vector<int8_t> quantized_weights(N * K);
+
+  for (int i = 0; i < num_directions; i++) {
+    QuantizeWeightsPerColumn(weights, N, K, quantized_weights.data(), scales + i * N);
+    MlasGemmPackB(N, K, reinterpret_cast<const uint8_t*>(quantized_weights.data()), N,
+                  false /*AIsSigned*/, true /*BIsSigned*/, packed_weights_data);
+    packed_weights_data = static_cast<uint8_t*>(packed_weights_data) + packed_weights_size;
+    weights += weights_stride;
+  }
+
+  return true;
+}
+
+const float* GetPackedQuantizedScales(const PackedWeights& packed_weights, int num_directions) {
+  return reinterpret_cast<const float*>(static_cast<const uint8_t*>(packed_weights.buffer_.get()) +
+                                        QuantizedScalesOffset(packed_weights.weights_size_, num_directions));
+}
+
+const float* QuantizeWeights(const float* weights, size_t weights_stride, size_t N, size_t K, size_t num_directions,
+                             AllocatorPtr alloc, IAllocatorUniquePtr<int8_t>& quantized_weights,
+                             IAllocatorUniquePtr<float>& scales) {
+  auto quantized_span = Allocate(alloc, SafeInt<size_t>(num_directions) * N * K, quantized_weights);
+  auto scales_span = Allocate(alloc, SafeInt<size_t>(num_directions) * N, scales);
+
+  for (size_t i = 0; i < num_directions; i++) {
+    QuantizeWeightsPerColumn(weights + i * weights_stride, N, K, quantized_span.data() + i * N * K,
+                             scales_span.data() + i * N);
+  }
+
+  return scales_span.data();
+}
+
 void ComputeGemm(const int M,
                  const int N,
                  const int K,
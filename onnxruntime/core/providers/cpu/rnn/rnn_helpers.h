@@ -169,6 +169,23 @@ struct PackedWeights {
   TensorShape shape_;
 };
 
+// Quantizes the [N, K] weights of each direction, which start weights_stride elements apart, to int8 with one
+// symmetric scale per output column, and packs them for the quantized GEMM. The scales of all the directions
+// follow the packed weights in the same buffer. Returns false if MLAS does not support packing.
+// The caller sets the shape of packed_weights.
+bool PackQuantizedWeights(const float* weights, size_t weights_stride, size_t N, size_t K, int num_directions,
+                          AllocatorPtr& alloc, PackedWeights& packed_weights);
+
+// Returns the per column scales of the first direction of weights packed by PackQuantizedWeights.
+const float* GetPackedQuantizedScales(const PackedWeights& packed_weights, int num_directions);
+
+// Quantizes the [N, K] weights of each direction like PackQuantizedWeights, for weights that can not be pre-packed
+// because they are not constant. The quantized weights have the [num_directions, K, N] layout expected for unpacked
+// weights by the quantized GEMM. Returns the per column scales of the first direction.
+const float* QuantizeWeights(const float* weights, size_t weights_stride, size_t N, size_t K, size_t num_directions,
+                             AllocatorPtr alloc, IAllocatorUniquePtr<int8_t>& quantized_weights,
+                             IAllocatorUniquePtr<float>& scales);
+
 struct QuantizationParameter {
   QuantizationParameter(const float* scale,
                         const uint8_t* zero_point,
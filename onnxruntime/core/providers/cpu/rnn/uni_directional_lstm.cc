@@ -220,6 +220,49 @@ void UniDirectionalLstm<T>::AllocateQuantizeBuffers(int max_sequence_length) {
   }
 }
 
+template <typename T>
+gsl::span<const int> UniDirectionalLstm<T>::GetSequenceLengths(const gsl::span<const int>& sequence_lengths) {
+  if (!sequence_lengths.empty())
+    return sequence_lengths;
+
+  // if sequence lengths weren't provided, use internal array and init all to seq_length
+  if (sequence_lengths_.empty())
+    sequence_lengths_ = Allocate(allocator_, batch_size_, sequence_lengths_ptr_, true, seq_length_);
+
+  return sequence_lengths_;
+}
+
+template <typename T>
+template <typename WeightT>
+void UniDirectionalLstm<T>::ProjectInputsImpl(const gsl::span<const T>& inputs_arg,
+                                              const gsl::span<const int>& sequence_lengths,
+                                              const GemmWeights<WeightT>& input_weights, gsl::span<T>& output_iofc) {
+  gsl::span<const T> inputs = inputs_arg;
+  if (direction_ == kReverse) {
+    ReverseSequence(inputs, inputs_reverse_, sequence_lengths, seq_length_, batch_size_, input_size_, 1, thread_pool_);
+    inputs = inputs_reverse_;
+  }
+
+  // DumpMatrix("Input", inputs.data(), seq_length_, batch_size_ * input_size_);
+
+  const int max_sequence_length = *std::max_element(sequence_lengths.begin(), sequence_lengths.end());
+  const int hidden_size_x4 = 4 * hidden_size_;
+  const int total_rows = max_sequence_length * batch_size_;
+
+  AllocateQuantizeBuffers<WeightT>(max_sequence_length);
+
+  // apply the weights to all the inputs and save to output_IOFC.
+  // beta is 0 so this zeros out any existing data
+  ComputeGemm(total_rows, hidden_size_x4, input_size_, 1.0f, inputs,
+              input_weights,
+              0.0f, output_iofc, hidden_size_x4,
+              quantized_input_or_a_.data(),
+              nullptr,
+              thread_pool_);
+
+  DumpMatrix("Xt*(W[iofc]^T)", output_iofc.data(), total_rows, hidden_size_x4);
+}
+
 template <typename T>
 template <typename WeightT>
 void UniDirectionalLstm<T>::ComputeImpl(const gsl::span<const T>& inputs_arg,
@@ -228,15 +271,7 @@ void UniDirectionalLstm<T>::ComputeImpl(const gsl::span<const T>& inputs_arg,
                                         gsl::span<T>& outputs, gsl::span<T>& final_hidden_state,
                                         gsl::span<T>& final_cell_state, gsl::span<T>& all_cell_states,
                                         gsl::span<T>& output_iofc) {
-  // copy spans (just T* and size, not data in span) as we may change them
-  gsl::span<const T> inputs = inputs_arg;
-  gsl::span<const int> sequence_lengths = sequence_lengths_arg;
-
-  // if sequence lengths weren't provided, use internal array and init all to seq_length
-  if (sequence_lengths.empty()) {
-    sequence_lengths_ = Allocate(allocator_, batch_size_, sequence_lengths_ptr_, true, seq_length_);
-    sequence_lengths = sequence_lengths_;
-  }
+  gsl::span<const int> sequence_lengths = GetSequenceLengths(sequence_lengths_arg);
 
   // LSTM Layer
   gsl::span<const T> batched_hidden_state_one_step = batched_hidden0_;
@@ -258,15 +293,8 @@ void UniDirectionalLstm<T>::ComputeImpl(const gsl::span<const T>& inputs_arg,
   gsl::span<T> original_outputs = outputs;
   const bool output_sequence = !outputs.empty();
 
-  if (direction_ == kReverse) {
-    ReverseSequence(inputs, inputs_reverse_, sequence_lengths, seq_length_, batch_size_, input_size_, 1, thread_pool_);
-    inputs = inputs_reverse_;
-
-    if (output_sequence)
-      outputs = outputs_reverse_;
-  }
-
-  // DumpMatrix("Input", inputs.data(), seq_length_, batch_size_ * input_size_);
+  if (direction_ == kReverse && output_sequence)
+    outputs = outputs_reverse_;
 
   // Calculate the max and min length
   const auto min_max_pair = std::minmax_element(sequence_lengths.begin(), sequence_lengths.end());
@@ -274,25 +302,15 @@ void UniDirectionalLstm<T>::ComputeImpl(const gsl::span<const T>& inputs_arg,
   int min_sequence_length = std::min(seq_length_, *min_max_pair.first);
 
   ///**************************LSTM Calculations****************************/
-  float alpha = 1.0f;
-  float beta = 0.0f;  // first call to ComputeGemm zeros out any existing data
-
-  const int hidden_size_x4 = 4 * hidden_size_;
-  const int total_rows = max_sequence_length * batch_size_;
+  // if the caller projected the inputs it runs this recurrence concurrently with another one, so stay on this thread
+  concurrency::ThreadPool* thread_pool = inputs_projected_ ? nullptr : thread_pool_;
+  if (!inputs_projected_)
+    ProjectInputsImpl(inputs_arg, sequence_lengths, input_weights, output_iofc);
 
-  AllocateQuantizeBuffers<WeightT>(max_sequence_length);
-
-  // apply the weights to all the inputs and save to output_IOFC
-  ComputeGemm(total_rows, hidden_size_x4, input_size_, alpha, inputs,
-              input_weights,
-              beta, output_iofc, hidden_size_x4,
-              quantized_input_or_a_.data(),
-              nullptr,
-              thread_pool_);
-
-  DumpMatrix("Xt*(W[iofc]^T)", output_iofc.data(), total_rows, hidden_size_x4);
+  const float alpha = 1.0f;
+  const float beta = 1.0f;  // calls to ComputeGemm add to Xt*(W[iofc]^T)
 
-  beta = 1.0f;  // calls to ComputeGemm now add to existing data
+  const int hidden_size_x4 = 4 * hidden_size_;
 
   // NOTE: we could refine the bounds checking in the calls below that use these values to instead
   // explicitly check just the range for each iteration, however if it's going to run over
@@ -403,9 +421,9 @@ void UniDirectionalLstm<T>::ComputeImpl(const gsl::span<const T>& inputs_arg,
   if (batch_parallel_) {
     double gemm_cost = num_seq_to_compute * hidden_size_x4 * hidden_size_;
     double cost = max_sequence_length * (gemm_cost + num_seq_to_compute);
-    ExecuteLambdaInParallel(sequences_calculator, batch_size_, num_seq_to_compute, cost, thread_pool_);
+    ExecuteLambdaInParallel(sequences_calculator, batch_size_, num_seq_to_compute, cost, thread_pool);
   } else {
-    sequences_calculator(0, thread_pool_);
+    sequences_calculator(0, thread_pool);
   }
 
   for (int i = 0; i < batch_size_; i++) {
@@ -449,7 +467,7 @@ void UniDirectionalLstm<T>::ComputeImpl(const gsl::span<const T>& inputs_arg,
 
   if (output_sequence && direction_ == Direction::kReverse)
     ReverseSequence<T>(outputs, original_outputs, sequence_lengths, seq_length_, batch_size_, hidden_size_,
-                       num_directions, thread_pool_);
+                       num_directions, thread_pool);
 }
 
 // #define PREVIOUS_BROKEN_VERSION
@@ -629,6 +647,14 @@ void UniDirectionalLstm<T>::Compute(const gsl::span<const T>& inputs_arg,
               final_hidden_state, final_cell_state, dummy_all_cell_states, output_iofc_);
 }
 
+template <typename T>
+template <typename WeightT>
+void UniDirectionalLstm<T>::ProjectInputs(const gsl::span<const T>& inputs, const gsl::span<const int>& sequence_lengths,
+                                          const GemmWeights<WeightT>& input_weights) {
+  ProjectInputsImpl(inputs, GetSequenceLengths(sequence_lengths), input_weights, output_iofc_);
+  inputs_projected_ = true;
+}
+
 template <typename T>
 void UniDirectionalLstm<T>::Compute(const gsl::span<const T>& inputs, const gsl::span<const int>& sequence_lengths,
                                     int num_directions, const GemmWeights<T>& input_weights,
@@ -654,5 +680,13 @@ template void UniDirectionalLstm<float>::Compute<uint8_t>(
     gsl::span<float>& outputs,
     gsl::span<float>& final_hidden_state, gsl::span<float>& final_cell_state);
 
+template void UniDirectionalLstm<float>::ProjectInputs<float>(
+    const gsl::span<const float>& inputs, const gsl::span<const int>& sequence_lengths,
+    const GemmWeights<float>& input_weights);
+
+template void UniDirectionalLstm<float>::ProjectInputs<uint8_t>(
+    const gsl::span<const float>& inputs, const gsl::span<const int>& sequence_lengths,
+    const GemmWeights<uint8_t>& input_weights);
+
 }  // namespace lstm
 }  // namespace onnxruntime
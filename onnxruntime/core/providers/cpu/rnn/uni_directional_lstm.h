@@ -47,6 +47,16 @@ class UniDirectionalLstm {
                gsl::span<T>& final_hidden_state, gsl::span<T>& final_cell_state, gsl::span<T>& all_cell_states,
                gsl::span<T>& iofc);
 
+  // Computes Xt*(W[iofc]^T) for all the steps in one GEMM on the thread pool. A following call to Compute with the
+  // same inputs skips that GEMM and runs the recurrence on the calling thread, so the recurrences of the two
+  // directions of a bidirectional LSTM can run concurrently.
+  template <typename WeightT>
+  void ProjectInputs(const gsl::span<const T>& inputs, const gsl::span<const int>& sequence_lengths,
+                     const GemmWeights<WeightT>& input_weights);
+
+  // true if the recurrence is split across the threads of the thread pool by batch rows
+  bool IsBatchParallel() const { return batch_parallel_; }
+
   ~UniDirectionalLstm() = default;
 
  private:
@@ -68,6 +78,12 @@ class UniDirectionalLstm {
   void LoadPeepholeWeights(const gsl::span<const T>& peephole_weights);
   void LoadBias(const gsl::span<const T>& WbRb_values);
 
+  gsl::span<const int> GetSequenceLengths(const gsl::span<const int>& sequence_lengths);
+
+  template <typename WeightT>
+  void ProjectInputsImpl(const gsl::span<const T>& inputs, const gsl::span<const int>& sequence_lengths,
+                         const GemmWeights<WeightT>& input_weights, gsl::span<T>& output_iofc);
+
   template <typename WeightT>
   void ComputeImpl(const gsl::span<const T>& inputs, const gsl::span<const int>& sequence_lengths, int num_directions,
                    const GemmWeights<WeightT>& input_weights, const GemmWeights<WeightT>& recurrent_weights, gsl::span<T>& outputs,
@@ -87,6 +103,7 @@ class UniDirectionalLstm {
   float clip_;
 
   bool batch_parallel_;
+  bool inputs_projected_ = false;
 
   bool use_bias_;
   bool use_peepholes_;
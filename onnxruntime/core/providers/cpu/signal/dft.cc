@@ -3,10 +3,13 @@
 
 #include "core/providers/cpu/signal/dft.h"
 
+#include <algorithm>
 #include <cmath>
 #include <complex>
 #include <functional>
 #include <limits>
+#include <memory>
+#include <type_traits>
 #include <vector>
 #include <core/common/safeint.h>
 
@@ -48,15 +51,6 @@ static bool is_complex_valued_signal(const onnxruntime::TensorShape& shape) {
   return shape.NumDimensions() > 2 && shape[shape.NumDimensions() - 1] == 2;
 }
 
-constexpr static bool is_power_of_2(size_t size) {
-  unsigned n_bits = 0;
-  while (size != 0) {
-    n_bits += size & 1;
-    size = size >> 1;
-  }
-  return n_bits == 1;
-}
-
 static const unsigned char BitReverseTable256[] = {
     0x00, 0x80, 0x40, 0xC0, 0x20, 0xA0, 0x60, 0xE0, 0x10, 0x90, 0x50, 0xD0, 0x30, 0xB0, 0x70, 0xF0, 0x08, 0x88, 0x48,
     0xC8, 0x28, 0xA8, 0x68, 0xE8, 0x18, 0x98, 0x58, 0xD8, 0x38, 0xB8, 0x78, 0xF8, 0x04, 0x84, 0x44, 0xC4, 0x24, 0xA4,
@@ -313,9 +307,85 @@ static Status dft_bluestein_z_chirp(
   return Status::OK();
 }
 
+// Computes one DFT with a cached mixed-radix plan. x holds number_of_samples values which are x_stride elements
+// apart and is zero padded or truncated to the plan length. The first output_size values of the spectrum are
+// written y_stride elements apart. Exactly one of plan and real_plan is set; real_plan is only used for real
+// input and computes the spectrum with a complex FFT of half the length.
+template <typename T, typename U>
+static void fft_mixed_radix(const signal::FFTPlan<T>* plan, const signal::RealFFTPlan<T>* real_plan, const U* x,
+                            size_t x_stride, size_t number_of_samples, const T* window, std::complex<T>* y,
+                            size_t y_stride, size_t output_size, bool inverse,
+                            InlinedVector<std::complex<T>>& input, InlinedVector<std::complex<T>>& output) {
+  const size_t dft_length = plan ? plan->Length() : real_plan->Length();
+  const size_t samples = std::min(number_of_samples, dft_length);
+  auto sample = [&](size_t n) -> std::complex<T> {
+    if (n >= samples) return std::complex<T>(0, 0);
+    const std::complex<T> value(x[n * x_stride]);
+    return window ? value * window[n] : value;
+  };
+
+  const T scale = inverse ? static_cast<T>(1) / static_cast<T>(dft_length) : static_cast<T>(1);
+  if constexpr (std::is_same_v<T, U>) {
+    if (real_plan) {
+      const size_t half_length = dft_length / 2;
+      input.resize(half_length);
+      output.resize(half_length + 1);
+      for (size_t m = 0; m < half_length; ++m) {
+        input[m] = std::complex<T>(sample(2 * m).real(), sample(2 * m + 1).real());
+      }
+
+      real_plan->Transform(input.data(), output.data());
+
+      // The spectrum of a real signal is conjugate symmetric, and its inverse transform is the conjugate of
+      // the forward transform.
+      for (size_t i = 0; i < output_size; ++i) {
+        std::complex<T> value = i <= half_length ? output[i] : std::conj(output[dft_length - i]);
+        if (inverse) value = std::conj(value) * scale;
+        y[i * y_stride] = value;
+      }
+      return;
+    }
+  }
+
+  input.resize(dft_length);
+  output.resize(dft_length);
+  for (size_t n = 0; n < dft_length; ++n) {
+    input[n] = sample(n);
+  }
+
+  plan->Transform(input.data(), 1, output.data());
+
+  for (size_t i = 0; i < output_size; ++i) {
+    y[i * y_stride] = inverse ? output[i] * scale : output[i];
+  }
+}
+
+// Returns the plans to use for dft_length, or none if the length needs the Bluestein algorithm.
+template <typename T, typename U>
+static void get_fft_plans(signal::FFTPlanCache& plan_cache, size_t dft_length, bool inverse,
+                          std::shared_ptr<const signal::FFTPlan<T>>& plan,
+                          std::shared_ptr<const signal::RealFFTPlan<T>>& real_plan) {
+  if constexpr (std::is_same_v<T, U>) {
+    if (signal::RealFFTPlan<T>::IsSupported(dft_length)) {
+      real_plan = plan_cache.GetRealPlan<T>(dft_length);
+      return;
+    }
+  }
+
+  if (signal::FFTPlan<T>::IsSupported(dft_length)) {
+    plan = plan_cache.GetPlan<T>(dft_length, inverse);
+  }
+}
+
+// Cost of one transform of length n for TryParallelFor.
+static double fft_cost(size_t n) {
+  return static_cast<double>(n) * (std::log2(static_cast<double>(n)) + 1.0) * 8.0;
+}
+
 template <typename T, typename U>
 static Status discrete_fourier_transform(OpKernelContext* ctx, const Tensor* X, Tensor* Y, Tensor& b_fft, Tensor& chirp,
-                                         int64_t axis, int64_t dft_length, const Tensor* window, bool is_onesided, bool inverse,
+                                         int64_t axis, int64_t dft_length, const Tensor* window, bool /*is_onesided*/, bool inverse,
+                                         signal::FFTPlanCache& plan_cache,
                                          InlinedVector<std::complex<T>>& V,
                                          InlinedVector<std::complex<T>>& temp_output) {
   // Get shape
@@ -332,10 +402,12 @@ static Status discrete_fourier_transform(OpKernelContext* ctx, const Tensor* X,
     batch_and_signal_rank -= 1;
   }
 
-  // Calculate x/y offsets/strides
-  for (size_t i = 0; i < total_dfts; i++) {
-    size_t X_offset = 0;
-    size_t X_stride = onnxruntime::narrow<size_t>(X_shape.SizeFromDimension(SafeInt<size_t>(axis) + 1) / complex_input_factor);
+  const size_t X_stride = onnxruntime::narrow<size_t>(X_shape.SizeFromDimension(SafeInt<size_t>(axis) + 1) / complex_input_factor);
+  const size_t Y_stride = onnxruntime::narrow<size_t>(Y_shape.SizeFromDimension(SafeInt<size_t>(axis) + 1) / 2);
+
+  // Calculate x/y offsets
+  auto get_offsets = [&](size_t i, size_t& X_offset, size_t& Y_offset) {
+    X_offset = 0;
     size_t cumulative_packed_stride = total_dfts;
     size_t temp = i;
     for (size_t r = 0; r < batch_and_signal_rank; r++) {
@@ -348,8 +420,7 @@ static Status discrete_fourier_transform(OpKernelContext* ctx, const Tensor* X,
       X_offset += index * SafeInt<size_t>(X_shape.SizeFromDimension(r + 1)) / complex_input_factor;
     }
 
-    size_t Y_offset = 0;
-    size_t Y_stride = onnxruntime::narrow<size_t>(Y_shape.SizeFromDimension(SafeInt<size_t>(axis) + 1) / 2);
+    Y_offset = 0;
     cumulative_packed_stride = total_dfts;
     temp = i;
     for (size_t r = 0; r < batch_and_signal_rank; r++) {
@@ -361,20 +432,48 @@ static Status discrete_fourier_transform(OpKernelContext* ctx, const Tensor* X,
       temp -= (index * cumulative_packed_stride);
       Y_offset += index * SafeInt<size_t>(Y_shape.SizeFromDimension(r + 1)) / 2;
     }
+  };
+
+  std::shared_ptr<const signal::FFTPlan<T>> plan;
+  std::shared_ptr<const signal::RealFFTPlan<T>> real_plan;
+  get_fft_plans<T, U>(plan_cache, onnxruntime::narrow<size_t>(dft_length), inverse, plan, real_plan);
+
+  if (plan || real_plan) {
+    // The plans are shared and read-only, so the signals can be transformed in parallel with per-thread buffers.
+    const auto* X_data = reinterpret_cast<const U*>(X->DataRaw());
+    auto* Y_data = reinterpret_cast<std::complex<T>*>(Y->MutableDataRaw());
+    const auto* window_data = window ? window->Data<T>() : nullptr;
+    const size_t number_of_samples = onnxruntime::narrow<size_t>(X_shape[onnxruntime::narrow<size_t>(axis)]);
+    const size_t output_size = onnxruntime::narrow<size_t>(Y_shape[onnxruntime::narrow<size_t>(axis)]);
+    concurrency::ThreadPool::TryParallelFor(
+        ctx->GetOperatorThreadPool(), static_cast<std::ptrdiff_t>(total_dfts),
+        fft_cost(onnxruntime::narrow<size_t>(dft_length)),
+        [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+          InlinedVector<std::complex<T>> input;
+          InlinedVector<std::complex<T>> output;
+          for (auto i = static_cast<size_t>(first); i < static_cast<size_t>(last); i++) {
+            size_t X_offset, Y_offset;
+            get_offsets(i, X_offset, Y_offset);
+            fft_mixed_radix<T, U>(plan.get(), real_plan.get(), X_data + X_offset, X_stride, number_of_samples,
+                                  window_data, Y_data + Y_offset, Y_stride, output_size, inverse, input, output);
+          }
+        });
+    return Status::OK();
+  }
 
-    if (is_power_of_2(onnxruntime::narrow<size_t>(dft_length))) {
-      ORT_RETURN_IF_ERROR((fft_radix2<T, U>(ctx, X, Y, X_offset, X_stride, Y_offset, Y_stride, axis, onnxruntime::narrow<size_t>(dft_length), window,
-                                            is_onesided, inverse, V, temp_output)));
-    } else {
-      ORT_RETURN_IF_ERROR(
-          (dft_bluestein_z_chirp<T, U>(ctx, X, Y, b_fft, chirp, X_offset, X_stride, Y_offset, Y_stride, axis, onnxruntime::narrow<size_t>(dft_length), window, inverse, V, temp_output)));
-    }
+  // Lengths with other prime factors use the Bluestein algorithm, which shares its buffers between the signals.
+  for (size_t i = 0; i < total_dfts; i++) {
+    size_t X_offset, Y_offset;
+    get_offsets(i, X_offset, Y_offset);
+    ORT_RETURN_IF_ERROR(
+        (dft_bluestein_z_chirp<T, U>(ctx, X, Y, b_fft, chirp, X_offset, X_stride, Y_offset, Y_stride, axis, onnxruntime::narrow<size_t>(dft_length), window, inverse, V, temp_output)));
   }
 
   return Status::OK();
 }
 
-static Status discrete_fourier_transform(OpKernelContext* ctx, int64_t axis, bool is_onesided, bool inverse) {
+static Status discrete_fourier_transform(OpKernelContext* ctx, int64_t axis, bool is_onesided, bool inverse,
+                                         signal::FFTPlanCache& plan_cache) {
   // Get input shape
   const auto* X = ctx->Input<Tensor>(0);
   const auto* dft_length = ctx->Input<Tensor>(1);
@@ -415,10 +514,10 @@ static Status discrete_fourier_transform(OpKernelContext* ctx, int64_t axis, boo
     InlinedVector<std::complex<float>> temp_output;
     if (is_real_valued) {
       ORT_RETURN_IF_ERROR((discrete_fourier_transform<float, float>(ctx, X, Y, b_fft, chirp, axis, number_of_samples, nullptr,
-                                                                    is_onesided, inverse, V, temp_output)));
+                                                                    is_onesided, inverse, plan_cache, V, temp_output)));
     } else if (is_complex_valued) {
       ORT_RETURN_IF_ERROR((discrete_fourier_transform<float, std::complex<float>>(
-          ctx, X, Y, b_fft, chirp, axis, number_of_samples, nullptr, is_onesided, inverse, V, temp_output)));
+          ctx, X, Y, b_fft, chirp, axis, number_of_samples, nullptr, is_onesided, inverse, plan_cache, V, temp_output)));
     } else {
       ORT_THROW(
           "Unsupported input signal shape. The signal's first dimension must be the batch dimension and its second "
@@ -431,10 +530,10 @@ static Status discrete_fourier_transform(OpKernelContext* ctx, int64_t axis, boo
     InlinedVector<std::complex<double>> temp_output;
     if (is_real_valued) {
       ORT_RETURN_IF_ERROR((discrete_fourier_transform<double, double>(ctx, X, Y, b_fft, chirp, axis, number_of_samples, nullptr,
-                                                                      is_onesided, inverse, V, temp_output)));
+                                                                      is_onesided, inverse, plan_cache, V, temp_output)));
     } else if (is_complex_valued) {
       ORT_RETURN_IF_ERROR((discrete_fourier_transform<double, std::complex<double>>(
-          ctx, X, Y, b_fft, chirp, axis, number_of_samples, nullptr, is_onesided, inverse, V, temp_output)));
+          ctx, X, Y, b_fft, chirp, axis, number_of_samples, nullptr, is_onesided, inverse, plan_cache, V, temp_output)));
     } else {
       ORT_THROW(
           "Unsupported input signal shape. The signal's first dimension must be the batch dimension and its second "
@@ -456,12 +555,13 @@ Status DFT::Compute(OpKernelContext* ctx) const {
     axis = axes_tensor->Data<int64_t>()[0];
   }
 
-  ORT_RETURN_IF_ERROR(discrete_fourier_transform(ctx, axis, is_onesided_, is_inverse_));
+  ORT_RETURN_IF_ERROR(discrete_fourier_transform(ctx, axis, is_onesided_, is_inverse_, plan_cache_));
   return Status::OK();
 }
 
 template <typename T, typename U>
-static Status short_time_fourier_transform(OpKernelContext* ctx, bool is_onesided, bool /*inverse*/) {
+static Status short_time_fourier_transform(OpKernelContext* ctx, bool is_onesided, bool /*inverse*/,
+                                           signal::FFTPlanCache& plan_cache) {
   // Attr("onesided"): default = 1
   // Input(0, "signal") type = T1
   // Input(1, "frame_length") type = T2
@@ -529,6 +629,33 @@ static Status short_time_fourier_transform(OpKernelContext* ctx, bool is_oneside
   auto dft_input_shape = onnxruntime::TensorShape({1, window_size, signal_components});
   auto dft_output_shape = onnxruntime::TensorShape({1, dft_output_size, output_components});
 
+  std::shared_ptr<const signal::FFTPlan<T>> plan;
+  std::shared_ptr<const signal::RealFFTPlan<T>> real_plan;
+  get_fft_plans<T, U>(plan_cache, onnxruntime::narrow<size_t>(window_size), false, plan, real_plan);
+
+  // signal_data points to whole (possibly complex) samples, so the frame offsets don't include the components
+  if (plan || real_plan) {
+    // The frames are independent and the plans are read-only, so transform them in parallel.
+    const auto* window_data = window ? window->Data<T>() : nullptr;
+    concurrency::ThreadPool::TryParallelFor(
+        ctx->GetOperatorThreadPool(), static_cast<std::ptrdiff_t>(batch_size * n_dfts),
+        fft_cost(onnxruntime::narrow<size_t>(window_size)),
+        [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+          InlinedVector<std::complex<T>> input;
+          InlinedVector<std::complex<T>> output;
+          for (std::ptrdiff_t frame = first; frame < last; frame++) {
+            const int64_t batch_idx = frame / n_dfts;
+            const int64_t i = frame % n_dfts;
+            const U* input_frame_begin = signal_data + (batch_idx * signal_size) + (i * frame_step);
+            auto* output_frame_begin = reinterpret_cast<std::complex<T>*>(Y_data) + frame * dft_output_size;
+            fft_mixed_radix<T, U>(plan.get(), real_plan.get(), input_frame_begin, 1,
+                                  onnxruntime::narrow<size_t>(window_size), window_data, output_frame_begin, 1,
+                                  onnxruntime::narrow<size_t>(dft_output_size), false, input, output);
+          }
+        });
+    return Status::OK();
+  }
+
   Tensor b_fft, chirp;
   InlinedVector<std::complex<T>> V;
   InlinedVector<std::complex<T>> temp_output;
@@ -536,8 +663,7 @@ static Status short_time_fourier_transform(OpKernelContext* ctx, bool is_oneside
   // Run each dft of each batch as if it was a real-valued batch size 1 dft operation
   for (int64_t batch_idx = 0; batch_idx < batch_size; batch_idx++) {
     for (int64_t i = 0; i < n_dfts; i++) {
-      auto input_frame_begin =
-          signal_data + (batch_idx * signal_size * signal_components) + (i * frame_step * signal_components);
+      auto input_frame_begin = signal_data + (batch_idx * signal_size) + (i * frame_step);
 
       auto output_frame_begin = Y_data + (batch_idx * n_dfts * dft_output_size * output_components) +
                                 (i * dft_output_size * output_components);
@@ -549,7 +675,7 @@ static Status short_time_fourier_transform(OpKernelContext* ctx, bool is_oneside
 
       // Run individual dft
       ORT_RETURN_IF_ERROR((discrete_fourier_transform<T, U>(ctx, &input, &output, b_fft, chirp, 1, window_size, window, is_onesided,
-                                                            false, V, temp_output)));
+                                                            false, plan_cache, V, temp_output)));
     }
   }
 
@@ -576,9 +702,9 @@ Status STFT::Compute(OpKernelContext* ctx) const {
   const auto element_size = data_type->Size();
   if (element_size == sizeof(float)) {
     if (is_real_valued) {
-      ORT_RETURN_IF_ERROR((short_time_fourier_transform<float, float>(ctx, is_onesided_, false)));
+      ORT_RETURN_IF_ERROR((short_time_fourier_transform<float, float>(ctx, is_onesided_, false, plan_cache_)));
     } else if (is_complex_valued) {
-      ORT_RETURN_IF_ERROR((short_time_fourier_transform<float, std::complex<float>>(ctx, is_onesided_, false)));
+      ORT_RETURN_IF_ERROR((short_time_fourier_transform<float, std::complex<float>>(ctx, is_onesided_, false, plan_cache_)));
     } else {
       ORT_THROW(
           "Unsupported input signal shape. The signal's first dimenstion must be the batch dimension and its second "
@@ -588,9 +714,9 @@ Status STFT::Compute(OpKernelContext* ctx) const {
     }
   } else if (element_size == sizeof(double)) {
     if (is_real_valued) {
-      ORT_RETURN_IF_ERROR((short_time_fourier_transform<double, double>(ctx, is_onesided_, false)));
+      ORT_RETURN_IF_ERROR((short_time_fourier_transform<double, double>(ctx, is_onesided_, false, plan_cache_)));
     } else if (is_complex_valued) {
-      ORT_RETURN_IF_ERROR((short_time_fourier_transform<double, std::complex<double>>(ctx, is_onesided_, false)));
+      ORT_RETURN_IF_ERROR((short_time_fourier_transform<double, std::complex<double>>(ctx, is_onesided_, false, plan_cache_)));
     } else {
       ORT_THROW(
           "Unsupported input signal shape. The signal's first dimenstion must be the batch dimension and its second "
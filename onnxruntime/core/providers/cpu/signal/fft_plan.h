@@ -0,0 +1,307 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <cmath>
+#include <complex>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/common/inlined_containers.h"
+
+namespace onnxruntime {
+namespace signal {
+
+constexpr double kPi = 3.14159265358979323846;
+
+// Mixed-radix decimation-in-time FFT for lengths whose only prime factors are 2, 3 and 5.
+// The factorization and the twiddle factors are computed once, so a plan can be reused for every signal of
+// the same length and direction. Plans are immutable after construction and can be used from several threads.
+template <typename T>
+class FFTPlan {
+ public:
+  static bool IsSupported(size_t length) {
+    if (length == 0) return false;
+    for (size_t radix : {2, 3, 5}) {
+      while (length % radix == 0) length /= radix;
+    }
+    return length == 1;
+  }
+
+  FFTPlan(size_t length, bool inverse) : length_(length), inverse_(inverse) {
+    ORT_ENFORCE(IsSupported(length), "FFT length ", length, " has prime factors other than 2, 3 and 5.");
+
+    // radix 4 first as it needs the fewest multiplications per output
+    size_t remaining = length;
+    for (size_t radix : {4, 2, 3, 5}) {
+      while (remaining % radix == 0) {
+        remaining /= radix;
+        factors_.push_back({radix, remaining});
+      }
+    }
+
+    // computed in double so that float plans are as accurate as possible
+    const double direction = inverse ? 1.0 : -1.0;
+    twiddles_.resize(length);
+    for (size_t i = 0; i < length; ++i) {
+      const double angle = direction * 2.0 * kPi * static_cast<double>(i) / static_cast<double>(length);
+      twiddles_[i] = std::complex<T>(static_cast<T>(std::cos(angle)), static_cast<T>(std::sin(angle)));
+    }
+  }
+
+  size_t Length() const { return length_; }
+
+  // Computes the unscaled transform of the Length() values of x, which are x_stride elements apart, into the
+  // contiguous buffer y. y must not overlap x.
+  void Transform(const std::complex<T>* x, size_t x_stride, std::complex<T>* y) const {
+    if (factors_.empty()) {
+      y[0] = x[0];
+      return;
+    }
+
+    Work(y, x, 1, x_stride, 0);
+  }
+
+ private:
+  void Work(std::complex<T>* out, const std::complex<T>* in, size_t fstride, size_t in_stride,
+            size_t factor_index) const {
+    const size_t p = factors_[factor_index].first;
+    const size_t m = factors_[factor_index].second;
+
+    if (m == 1) {
+      for (size_t i = 0; i < p; ++i) {
+        out[i] = *in;
+        in += fstride * in_stride;
+      }
+    } else {
+      // each of the p sub-transforms of length m takes every p-th input
+      for (size_t i = 0; i < p; ++i) {
+        Work(out + i * m, in, fstride * p, in_stride, factor_index + 1);
+        in += fstride * in_stride;
+      }
+    }
+
+    switch (p) {
+      case 2:
+        Butterfly2(out, fstride, m);
+        break;
+      case 3:
+        Butterfly3(out, fstride, m);
+        break;
+      case 4:
+        Butterfly4(out, fstride, m);
+        break;
+      default:
+        Butterfly5(out, fstride, m);
+        break;
+    }
+  }
+
+  void Butterfly2(std::complex<T>* out, size_t fstride, size_t m) const {
+    std::complex<T>* out1 = out + m;
+    for (size_t k = 0; k < m; ++k) {
+      const std::complex<T> t = out1[k] * twiddles_[k * fstride];
+      out1[k] = out[k] - t;
+      out[k] += t;
+    }
+  }
+
+  void Butterfly3(std::complex<T>* out, size_t fstride, size_t m) const {
+    const T epi3 = twiddles_[fstride * m].imag();
+    std::complex<T>* out1 = out + m;
+    std::complex<T>* out2 = out + 2 * m;
+    for (size_t k = 0; k < m; ++k) {
+      const std::complex<T> s1 = out1[k] * twiddles_[k * fstride];
+      const std::complex<T> s2 = out2[k] * twiddles_[2 * k * fstride];
+      const std::complex<T> s3 = s1 + s2;
+      const std::complex<T> s0 = (s1 - s2) * epi3;
+      const std::complex<T> half = out[k] - s3 * static_cast<T>(0.5);
+      out[k] += s3;
+      out1[k] = std::complex<T>(half.real() - s0.imag(), half.imag() + s0.real());
+      out2[k] = std::complex<T>(half.real() + s0.imag(), half.imag() - s0.real());
+    }
+  }
+
+  void Butterfly4(std::complex<T>* out, size_t fstride, size_t m) const {
+    std::complex<T>* out1 = out + m;
+    std::complex<T>* out2 = out + 2 * m;
+    std::complex<T>* out3 = out + 3 * m;
+    for (size_t k = 0; k < m; ++k) {
+      const std::complex<T> s0 = out1[k] * twiddles_[k * fstride];
+      const std::complex<T> s1 = out2[k] * twiddles_[2 * k * fstride];
+      const std::complex<T> s2 = out3[k] * twiddles_[3 * k * fstride];
+      const std::complex<T> s5 = out[k] - s1;
+      const std::complex<T> s3 = s0 + s2;
+      const std::complex<T> s4 = s0 - s2;
+      out[k] += s1;
+      out2[k] = out[k] - s3;
+      out[k] += s3;
+      if (inverse_) {
+        out1[k] = std::complex<T>(s5.real() - s4.imag(), s5.imag() + s4.real());
+        out3[k] = std::complex<T>(s5.real() + s4.imag(), s5.imag() - s4.real());
+      } else {
+        out1[k] = std::complex<T>(s5.real() + s4.imag(), s5.imag() - s4.real());
+        out3[k] = std::complex<T>(s5.real() - s4.imag(), s5.imag() + s4.real());
+      }
+    }
+  }
+
+  void Butterfly5(std::complex<T>* out, size_t fstride, size_t m) const {
+    const std::complex<T> ya = twiddles_[fstride * m];
+    const std::complex<T> yb = twiddles_[fstride * 2 * m];
+    std::complex<T>* out1 = out + m;
+    std::complex<T>* out2 = out + 2 * m;
+    std::complex<T>* out3 = out + 3 * m;
+    std::complex<T>* out4 = out + 4 * m;
+    for (size_t k = 0; k < m; ++k) {
+      const std::complex<T> s0 = out[k];
+      const std::complex<T> s1 = out1[k] * twiddles_[k * fstride];
+      const std::complex<T> s2 = out2[k] * twiddles_[2 * k * fstride];
+      const std::complex<T> s3 = out3[k] * twiddles_[3 * k * fstride];
+      const std::complex<T> s4 = out4[k] * twiddles_[4 * k * fstride];
+
+      const std::complex<T> s7 = s1 + s4;
+      const std::complex<T> s10 = s1 - s4;
+      const std::complex<T> s8 = s2 + s3;
+      const std::complex<T> s9 = s2 - s3;
+
+      out[k] = s0 + s7 + s8;
+
+      const std::complex<T> s5(s0.real() + s7.real() * ya.real() + s8.real() * yb.real(),
+                               s0.imag() + s7.imag() * ya.real() + s8.imag() * yb.real());
+      const std::complex<T> s6(s10.imag() * ya.imag() + s9.imag() * yb.imag(),
+                               -s10.real() * ya.imag() - s9.real() * yb.imag());
+      out1[k] = s5 - s6;
+      out4[k] = s5 + s6;
+
+      const std::complex<T> s11(s0.real() + s7.real() * yb.real() + s8.real() * ya.real(),
+                                s0.imag() + s7.imag() * yb.real() + s8.imag() * ya.real());
+      const std::complex<T> s12(-s10.imag() * yb.imag() + s9.imag() * ya.imag(),
+                                s10.real() * yb.imag() - s9.real() * ya.imag());
+      out2[k] = s11 + s12;
+      out3[k] = s11 - s12;
+    }
+  }
+
+  size_t length_;
+  bool inverse_;
+  InlinedVector<std::pair<size_t, size_t>> factors_;  // (radix, remaining length) for each stage
+  std::vector<std::complex<T>> twiddles_;
+};
+
+// Forward DFT of a real signal of even length using a complex FFT of half the length.
+// The even and odd samples are packed into the real and imaginary parts of the half-length signal and the
+// two interleaved spectra are separated afterwards, which halves the work compared to a complex FFT.
+template <typename T>
+class RealFFTPlan {
+ public:
+  static bool IsSupported(size_t length) {
+    return length % 2 == 0 && FFTPlan<T>::IsSupported(length / 2);
+  }
+
+  explicit RealFFTPlan(size_t length) : length_(length), half_(length / 2, false) {
+    const size_t half_length = length / 2;
+    twiddles_.resize(half_length);
+    for (size_t k = 0; k < half_length; ++k) {
+      const double angle = -2.0 * kPi * static_cast<double>(k) / static_cast<double>(length);
+      twiddles_[k] = std::complex<T>(static_cast<T>(std::cos(angle)), static_cast<T>(std::sin(angle)));
+    }
+  }
+
+  size_t Length() const { return length_; }
+
+  // packed holds x[2m] + i * x[2m + 1] for m < Length() / 2. Writes the first Length() / 2 + 1 values of the
+  // spectrum of x to y, which must not overlap packed. The remaining values are the conjugates of these.
+  void Transform(const std::complex<T>* packed, std::complex<T>* y) const {
+    const size_t half_length = length_ / 2;
+    half_.Transform(packed, 1, y);
+
+    const std::complex<T> z0 = y[0];
+    y[0] = std::complex<T>(z0.real() + z0.imag(), 0);
+    y[half_length] = std::complex<T>(z0.real() - z0.imag(), 0);
+
+    for (size_t k = 1; k <= half_length / 2; ++k) {
+      const size_t j = half_length - k;
+      const std::complex<T> zk = y[k];
+      const std::complex<T> zj = y[j];
+      const std::complex<T> yk = Combine(zk, zj, twiddles_[k]);
+      const std::complex<T> yj = Combine(zj, zk, twiddles_[j]);
+      y[k] = yk;
+      y[j] = yj;
+    }
+  }
+
+ private:
+  // X[k] = (Z[k] + conj(Z[n/2 - k])) / 2 - i * W^k * (Z[k] - conj(Z[n/2 - k])) / 2
+  static std::complex<T> Combine(std::complex<T> zk, std::complex<T> zj, std::complex<T> twiddle) {
+    const std::complex<T> even = (zk + std::conj(zj)) * static_cast<T>(0.5);
+    const std::complex<T> odd = twiddle * (zk - std::conj(zj)) * static_cast<T>(0.5);
+    return std::complex<T>(even.real() + odd.imag(), even.imag() - odd.real());
+  }
+
+  size_t length_;
+  FFTPlan<T> half_;
+  std::vector<std::complex<T>> twiddles_;
+};
+
+// Plans for the lengths and directions a kernel has seen. The cache is bounded, as dft_length is an input and
+// may change on every run.
+class FFTPlanCache {
+ public:
+  template <typename T>
+  std::shared_ptr<const FFTPlan<T>> GetPlan(size_t length, bool inverse) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& plans = Plans<T>().complex;
+    auto it = plans.find({length, inverse});
+    if (it == plans.end()) {
+      if (plans.size() >= kMaxPlans) plans.clear();
+      it = plans.emplace(std::make_pair(length, inverse), std::make_shared<const FFTPlan<T>>(length, inverse)).first;
+    }
+
+    return it->second;
+  }
+
+  template <typename T>
+  std::shared_ptr<const RealFFTPlan<T>> GetRealPlan(size_t length) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& plans = Plans<T>().real;
+    auto it = plans.find(length);
+    if (it == plans.end()) {
+      if (plans.size() >= kMaxPlans) plans.clear();
+      it = plans.emplace(length, std::make_shared<const RealFFTPlan<T>>(length)).first;
+    }
+
+    return it->second;
+  }
+
+ private:
+  static constexpr size_t kMaxPlans = 16;
+
+  template <typename T>
+  struct PlanMaps {
+    std::map<std::pair<size_t, bool>, std::shared_ptr<const FFTPlan<T>>> complex;
+    std::map<size_t, std::shared_ptr<const RealFFTPlan<T>>> real;
+  };
+
+  template <typename T>
+  PlanMaps<T>& Plans() {
+    if constexpr (std::is_same_v<T, float>) {
+      return float_plans_;
+    } else {
+      return double_plans_;
+    }
+  }
+
+  std::mutex mutex_;
+  PlanMaps<float> float_plans_;
+  PlanMaps<double> double_plans_;
+};
+
+}  // namespace signal
+}  // namespace onnxruntime
@@ -2,6 +2,11 @@
 // Licensed under the MIT License.
 
 #include "core/providers/cpu/tensor/compress.h"
+
+#include <algorithm>
+#include <numeric>
+
+#include "core/platform/threadpool.h"
 #include "core/providers/common.h"
 using namespace ::onnxruntime::common;
 
@@ -25,6 +30,19 @@ ONNX_CPU_OPERATOR_KERNEL(
         .TypeConstraint("T1", DataTypeImpl::GetTensorType<bool>()),
     Compress);
 
+// Condition entries handled by one task. Fixed, so the work split doesn't depend on the number of threads.
+static constexpr int64_t kCompressChunkSize = 16384;
+
+// Copies the entries of [begin, end) with a true condition to consecutive entries of output
+template <typename T>
+static void CompressChunk(const T* input, const bool* condition, int64_t begin, int64_t end, T* output) {
+  for (int64_t i = begin; i < end; ++i) {
+    if (condition[i]) {
+      *output++ = input[i];
+    }
+  }
+}
+
 Status Compress::Compute(OpKernelContext* ctx) const {
   const auto* input_tensor = ctx->Input<Tensor>(0);
   size_t rank = input_tensor->Shape().NumDimensions();
@@ -38,17 +56,33 @@ Status Compress::Compute(OpKernelContext* ctx) const {
   auto condition_length = condition->Shape().Size();
   auto condition_data = condition->Data<bool>();
 
-  int64_t positive_condition_count = 0;
   // if has axis, we need to compress on dimension[axis], otherwise compress on the flattened input data
   int64_t compress_input_length = has_axis_ ? input_dimensions[onnxruntime::narrow<size_t>(axis)] : input_tensor->Shape().Size();
   int64_t valid_condition_length = compress_input_length < condition_length ? compress_input_length : condition_length;
 
-  // Figure out output shape
-  for (int i = 0; i < valid_condition_length; ++i) {
-    if (condition_data[i]) {
-      ++positive_condition_count;
-    }
-  }
+  concurrency::ThreadPool* tp = ctx->GetOperatorThreadPool();
+
+  // Count the true conditions of each chunk. Without an axis the prefix sums are also where the chunks are copied to.
+  const int64_t num_chunks = (valid_condition_length + kCompressChunkSize - 1) / kCompressChunkSize;
+  std::vector<int64_t> chunk_offsets(onnxruntime::narrow<size_t>(num_chunks) + 1, 0);
+  concurrency::ThreadPool::TryParallelFor(
+      tp, num_chunks, TensorOpCost{static_cast<double>(kCompressChunkSize), 0.0, static_cast<double>(kCompressChunkSize)},
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t chunk = first; chunk < last; ++chunk) {
+          const int64_t begin = chunk * kCompressChunkSize;
+          const int64_t end = std::min(begin + kCompressChunkSize, valid_condition_length);
+          // branch free so the compiler can vectorize it
+          int64_t count = 0;
+          for (int64_t i = begin; i < end; ++i) {
+            count += condition_data[i] ? 1 : 0;
+          }
+
+          chunk_offsets[chunk + 1] = count;
+        }
+      });
+
+  std::partial_sum(chunk_offsets.begin(), chunk_offsets.end(), chunk_offsets.begin());
+  const int64_t positive_condition_count = chunk_offsets.back();
 
   std::vector<int64_t> output_dims(input_dimensions.begin(), input_dimensions.end());
   if (has_axis_) {
@@ -68,7 +102,6 @@ Status Compress::Compute(OpKernelContext* ctx) const {
   auto* output_data = static_cast<uint8_t*>(output_tensor->MutableDataRaw());
   auto element_bytes = input_tensor->DataType()->Size();
   bool is_string_type = input_tensor->IsDataTypeString();
-  int64_t output_index = 0;
 
   if (has_axis_) {
     int64_t axes_left_stride = 1;
@@ -81,42 +114,76 @@ Status Compress::Compute(OpKernelContext* ctx) const {
       axes_right_stride *= input_dimensions[i];
     }
     int64_t axes_included_right_stride = axes_right_stride * input_dimensions[onnxruntime::narrow<size_t>(axis)];
-    int64_t axes_included_right_stride_bytes = axes_included_right_stride * element_bytes;
     ORT_ENFORCE(axes_right_stride >= 0 &&
                 static_cast<uint64_t>(axes_right_stride) < std::numeric_limits<size_t>::max());
     size_t axes_right_stride_bytes = 0;
     if (!IAllocator::CalcMemSizeForArray(static_cast<size_t>(axes_right_stride), element_bytes,
                                          &axes_right_stride_bytes))
       return Status(ONNXRUNTIME, FAIL, "size overflow");
-    for (int i = 0; i < axes_left_stride; ++i) {
-      for (int j = 0; j < valid_condition_length; ++j) {
-        if (!condition_data[j]) {
-          continue;
-        }
-        if (is_string_type) {
-          for (int idxItem = 0; idxItem < axes_right_stride; ++idxItem) {
-            reinterpret_cast<std::string*>(output_data)[output_index + idxItem] =
-                reinterpret_cast<const std::string*>(input_data)[i * axes_included_right_stride + j * axes_right_stride + idxItem];
-          }
-          output_index += axes_right_stride;
-        } else {
-          memcpy(output_data + output_index, input_data + i * axes_included_right_stride_bytes + j * axes_right_stride_bytes, axes_right_stride_bytes);
-          output_index += axes_right_stride_bytes;
-        }
+
+    std::vector<int64_t> selected;
+    selected.reserve(onnxruntime::narrow<size_t>(positive_condition_count));
+    for (int64_t j = 0; j < valid_condition_length; ++j) {
+      if (condition_data[j]) {
+        selected.push_back(j);
       }
     }
+
+    // every selected slice of every outer index is an independent copy to its place in the output
+    const std::ptrdiff_t num_slices = onnxruntime::narrow<std::ptrdiff_t>(axes_left_stride * positive_condition_count);
+    const auto slice_bytes = static_cast<double>(axes_right_stride_bytes);
+    concurrency::ThreadPool::TryParallelFor(
+        tp, num_slices, TensorOpCost{slice_bytes, slice_bytes, slice_bytes},
+        [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+          for (std::ptrdiff_t slice = first; slice < last; ++slice) {
+            const int64_t i = slice / positive_condition_count;
+            const int64_t j = selected[onnxruntime::narrow<size_t>(slice % positive_condition_count)];
+            const int64_t input_offset = i * axes_included_right_stride + j * axes_right_stride;
+            const int64_t output_offset = slice * axes_right_stride;
+            if (is_string_type) {
+              const auto* src = reinterpret_cast<const std::string*>(input_data) + input_offset;
+              std::copy(src, src + axes_right_stride, reinterpret_cast<std::string*>(output_data) + output_offset);
+            } else {
+              memcpy(output_data + output_offset * element_bytes, input_data + input_offset * element_bytes,
+                     axes_right_stride_bytes);
+            }
+          }
+        });
   } else {
-    for (int i = 0; i < valid_condition_length; ++i) {
-      if (!condition_data[i]) {
-        continue;
-      }
-      if (is_string_type) {
-        reinterpret_cast<std::string*>(output_data)[output_index] = reinterpret_cast<const std::string*>(input_data)[i];
-      } else {
-        memcpy(output_data + output_index * element_bytes, input_data + i * element_bytes, element_bytes);
-      }
-      ++output_index;
-    }
+    concurrency::ThreadPool::TryParallelFor(
+        tp, num_chunks,
+        TensorOpCost{static_cast<double>(kCompressChunkSize * (element_bytes + 1)),
+                     static_cast<double>(kCompressChunkSize * element_bytes), static_cast<double>(kCompressChunkSize)},
+        [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+          for (std::ptrdiff_t chunk = first; chunk < last; ++chunk) {
+            const int64_t begin = chunk * kCompressChunkSize;
+            const int64_t end = std::min(begin + kCompressChunkSize, valid_condition_length);
+            const int64_t output_index = chunk_offsets[chunk];
+            if (is_string_type) {
+              CompressChunk(reinterpret_cast<const std::string*>(input_data), condition_data, begin, end,
+                            reinterpret_cast<std::string*>(output_data) + output_index);
+            } else if (element_bytes == sizeof(uint8_t)) {
+              CompressChunk(input_data, condition_data, begin, end, output_data + output_index);
+            } else if (element_bytes == sizeof(uint16_t)) {
+              CompressChunk(reinterpret_cast<const uint16_t*>(input_data), condition_data, begin, end,
+                            reinterpret_cast<uint16_t*>(output_data) + output_index);
+            } else if (element_bytes == sizeof(uint32_t)) {
+              CompressChunk(reinterpret_cast<const uint32_t*>(input_data), condition_data, begin, end,
+                            reinterpret_cast<uint32_t*>(output_data) + output_index);
+            } else if (element_bytes == sizeof(uint64_t)) {
+              CompressChunk(reinterpret_cast<const uint64_t*>(input_data), condition_data, begin, end,
+                            reinterpret_cast<uint64_t*>(output_data) + output_index);
+            } else {
+              uint8_t* output = output_data + output_index * element_bytes;
+              for (int64_t i = begin; i < end; ++i) {
+                if (condition_data[i]) {
+                  memcpy(output, input_data + i * element_bytes, element_bytes);
+                  output += element_bytes;
+                }
+              }
+            }
+          }
+        });
   }
 
   return Status::OK();
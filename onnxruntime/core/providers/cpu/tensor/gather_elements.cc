@@ -1,6 +1,7 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <atomic>
 #include <string>
 #include "gather_elements.h"
 #include "onnxruntime_config.h"
@@ -106,21 +107,28 @@ static void core_impl(const Tensor* input_tensor, const Tensor* indices_tensor,
   int64_t axis_size = input_tensor->Shape()[onnxruntime::narrow<size_t>(axis)];
 
   bool innermost_axis = axis == input_rank - 1;
-  bool index_error = false;
+  std::atomic<bool> index_error{false};
 
   auto MainLoop = [&](auto* output_data, auto* input_data) {
-    auto BatchWork = [&](size_t inner_dim) {
+    // Rows are handed out in chunks sized by the cost model, so small tensors run inline and large ones
+    // are not split into more tasks than there are threads to run them.
+    const double row_bytes = static_cast<double>(inner_dim_size) * (sizeof(*output_data) + sizeof(Tin));
+    const TensorOpCost cost{row_bytes, static_cast<double>(inner_dim_size * sizeof(*output_data)),
+                            static_cast<double>(inner_dim_size) * 2.0};
+    auto RangeWork = [&](std::ptrdiff_t first, std::ptrdiff_t last) {
       ORT_TRY {
-        auto output = output_data + inner_dim_size * inner_dim;
-        auto input = input_data + CalculateOffset(inner_dim, input_shape_pitches, onnxruntime::narrow<size_t>(axis), indices_shape);
-        auto indices = indices_data + inner_dim_size * inner_dim;
-
-        if (innermost_axis) {
-          for (size_t i = 0; i < inner_dim_size; i++)
-            output[i] = input[GetIndex(i, indices, axis_size)];
-        } else {
-          for (size_t i = 0; i < inner_dim_size; i++)
-            output[i] = input[GetIndex(i, indices, axis_size) * axis_pitch + i];
+        for (auto inner_dim = static_cast<size_t>(first); inner_dim < static_cast<size_t>(last); ++inner_dim) {
+          auto output = output_data + inner_dim_size * inner_dim;
+          auto input = input_data + CalculateOffset(inner_dim, input_shape_pitches, onnxruntime::narrow<size_t>(axis), indices_shape);
+          auto indices = indices_data + inner_dim_size * inner_dim;
+
+          if (innermost_axis) {
+            for (size_t i = 0; i < inner_dim_size; i++)
+              output[i] = input[GetIndex(i, indices, axis_size)];
+          } else {
+            for (size_t i = 0; i < inner_dim_size; i++)
+              output[i] = input[GetIndex(i, indices, axis_size) * axis_pitch + i];
+          }
         }
       }
       ORT_CATCH(const std::exception&) {
@@ -128,7 +136,7 @@ static void core_impl(const Tensor* input_tensor, const Tensor* indices_tensor,
       }
     };
 
-    concurrency::ThreadPool::TryBatchParallelFor(ttp, num_inner_dim, BatchWork, 0);
+    concurrency::ThreadPool::TryParallelFor(ttp, static_cast<std::ptrdiff_t>(num_inner_dim), cost, RangeWork);
   };
 
   // Iterate over the elements based on the element size (or if it's a string). For everything but strings
@@ -3,10 +3,12 @@
 
 #include "core/providers/cpu/tensor/nonzero_op.h"
 
+#include <algorithm>
 #include <cassert>
+#include <numeric>
 #include <vector>
-#include <core/common/safeint.h>
-#include "core/util/math_cpuonly.h"
+#include "core/common/narrow.h"
+#include "core/platform/threadpool.h"
 
 namespace onnxruntime {
 // kernel builder functions
@@ -51,6 +53,9 @@ NONZERO_TYPED_KERNEL(float)
 #undef NONZERO_9_TYPED_KERNEL
 #undef NONZERO_TYPED_KERNEL
 
+// Elements of X scanned by one task. Fixed, so the work split doesn't depend on the number of threads.
+static constexpr int64_t kNonZeroChunkSize = 16384;
+
 template <typename T>
 Status NonZero<T>::Compute(OpKernelContext* context) const {
   const auto X = context->Input<Tensor>(0);
@@ -59,59 +64,88 @@ Status NonZero<T>::Compute(OpKernelContext* context) const {
   const auto& X_shape = X->Shape();
   assert(X_shape.Size() >= 0);
 
-  const Eigen::Index coordinate_size = X_shape.IsScalar() ? 1 : onnxruntime::narrow<Eigen::Index>(X_shape.NumDimensions());
-  std::vector<int64_t> non_zero_indices_buffer{};
-  // reserve enough space for indices for every element of X
-  non_zero_indices_buffer.reserve(SafeInt<size_t>(X_shape.Size()) * coordinate_size);
-
+  // a scalar is handled as a tensor of shape {1}
+  const TensorShapeVector dims = X_shape.IsScalar() ? TensorShapeVector{1} : X_shape.AsShapeVector();
+  const int64_t coordinate_size = static_cast<int64_t>(dims.size());
+  const int64_t size = X_shape.Size();
   const T* data = X->Data<T>();
 
-  if (X_shape.IsScalar()) {
-    const T& value = *data;
-    if (value != T{}) {
-      non_zero_indices_buffer.push_back(0);
-    }
-  } else {
-    std::vector<int64_t> coordinate(coordinate_size, 0);
-
-    // as we iterate the entries, increment the coordinate for the current entry
-    // e.g. if shape is {2,2}, we start with 0,0 increment to 0,1 increment to 1,0 and finally 1,1
-    auto increment_coordinate = [&coordinate, &coordinate_size, &X_shape]() {
-      for (Eigen::Index idx = coordinate_size - 1; idx >= 0; --idx) {
-        int64_t& cur_coord = coordinate[idx];
-        if (cur_coord != X_shape[idx] - 1) {
-          ++cur_coord;
-          break;
+  concurrency::ThreadPool* tp = context->GetOperatorThreadPool();
+
+  // first pass: count the non-zero values of each chunk
+  const int64_t num_chunks = (size + kNonZeroChunkSize - 1) / kNonZeroChunkSize;
+  std::vector<int64_t> chunk_offsets(onnxruntime::narrow<size_t>(num_chunks) + 1, 0);
+  const TensorOpCost count_cost{static_cast<double>(kNonZeroChunkSize * sizeof(T)), 0.0,
+                                static_cast<double>(kNonZeroChunkSize)};
+  concurrency::ThreadPool::TryParallelFor(
+      tp, num_chunks, count_cost, [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t chunk = first; chunk < last; ++chunk) {
+          const T* chunk_data = data + chunk * kNonZeroChunkSize;
+          const int64_t chunk_size = std::min(kNonZeroChunkSize, size - chunk * kNonZeroChunkSize);
+          // branch free so the compiler can vectorize it
+          int64_t count = 0;
+          for (int64_t i = 0; i < chunk_size; ++i) {
+            count += chunk_data[i] != T{} ? 1 : 0;
+          }
+
+          chunk_offsets[chunk + 1] = count;
         }
-        cur_coord = 0;
-      }
-    };
-
-    for (size_t i = 0, end = onnxruntime::narrow<size_t>(X_shape.Size()); i < end; ++i) {
-      const T& value = *data++;
-      if (value != T{}) {
-        non_zero_indices_buffer.insert(non_zero_indices_buffer.end(),
-                                       coordinate.begin(), coordinate.end());
-      }
-
-      increment_coordinate();
-    }
-  }
-
-  const Eigen::Index num_non_zero_values = onnxruntime::narrow<Eigen::Index>(non_zero_indices_buffer.size()) / coordinate_size;
+      });
 
-  // transpose result for output
-  ConstEigenMatrixMapRowMajor<int64_t> non_zero_indices_matrix{
-      non_zero_indices_buffer.data(),
-      num_non_zero_values, coordinate_size};
+  std::partial_sum(chunk_offsets.begin(), chunk_offsets.end(), chunk_offsets.begin());
+  const int64_t num_non_zero_values = chunk_offsets.back();
 
   Tensor* const Y = context->Output(0, {coordinate_size, num_non_zero_values});
   ORT_ENFORCE(Y, "failed to get first output!");
 
-  EigenMatrixMapRowMajor<int64_t> y_matrix{
-      Y->MutableData<int64_t>(),
-      coordinate_size, num_non_zero_values};
-  y_matrix = non_zero_indices_matrix.transpose();
+  if (num_non_zero_values == 0) {
+    return Status::OK();
+  }
+
+  // second pass: each chunk writes the coordinates of its non-zero values straight into their columns of Y
+  int64_t* y_data = Y->MutableData<int64_t>();
+  const TensorOpCost write_cost{static_cast<double>(kNonZeroChunkSize * sizeof(T)),
+                                static_cast<double>(num_non_zero_values * coordinate_size * sizeof(int64_t)) /
+                                    static_cast<double>(num_chunks),
+                                static_cast<double>(kNonZeroChunkSize * coordinate_size)};
+  concurrency::ThreadPool::TryParallelFor(
+      tp, num_chunks, write_cost, [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        TensorShapeVector coordinate(dims.size());
+        for (std::ptrdiff_t chunk = first; chunk < last; ++chunk) {
+          if (chunk_offsets[chunk + 1] == chunk_offsets[chunk]) {
+            continue;
+          }
+
+          const int64_t begin = chunk * kNonZeroChunkSize;
+          const int64_t end = std::min(begin + kNonZeroChunkSize, size);
+
+          // coordinate of the first entry of the chunk
+          for (int64_t idx = coordinate_size - 1, remaining = begin; idx >= 0; --idx) {
+            coordinate[idx] = remaining % dims[idx];
+            remaining /= dims[idx];
+          }
+
+          int64_t column = chunk_offsets[chunk];
+          for (int64_t i = begin; i < end; ++i) {
+            if (data[i] != T{}) {
+              for (int64_t idx = 0; idx < coordinate_size; ++idx) {
+                y_data[idx * num_non_zero_values + column] = coordinate[idx];
+              }
+
+              ++column;
+            }
+
+            // as we iterate the entries, increment the coordinate for the current entry
+            // e.g. if shape is {2,2}, we start with 0,0 increment to 0,1 increment to 1,0 and finally 1,1
+            for (int64_t idx = coordinate_size - 1; idx >= 0; --idx) {
+              if (++coordinate[idx] != dims[idx]) {
+                break;
+              }
+              coordinate[idx] = 0;
+            }
+          }
+        }
+      });
 
   return Status::OK();
 }
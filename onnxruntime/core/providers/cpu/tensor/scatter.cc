@@ -2,6 +2,8 @@
 // Licensed under the MIT License.
 
 // https://github.com/onnx/onnx/blob/main/docs/Operators.md#Scatter
+#include <algorithm>
+#include <mutex>
 #include <type_traits>
 #include <core/common/safeint.h>
 
@@ -10,6 +12,7 @@
 #include "core/framework/element_type_lists.h"
 #include "core/framework/op_kernel.h"
 #include "core/framework/op_kernel_type_control_utils.h"
+#include "core/platform/threadpool.h"
 #include "core/providers/common.h"
 #include "core/providers/op_kernel_type_control.h"
 #if defined(ENABLE_TRAINING_OPS)
@@ -266,14 +269,12 @@ template <class Tdata, typename FuncT>
 Status ScatterData(
     const FuncT& func,
     const Tensor* data_input, const std::vector<int64_t>& indices_data, const Tensor* updates_input, int64_t axis,
-    Tensor* data_output) {
+    Tensor* data_output, concurrency::ThreadPool* tp) {
   const TensorShape& input_data_shape = data_input->Shape();
 
   const auto input_elements = input_data_shape.Size();
   const auto total_input_bytes = data_input->SizeInBytes();
 
-  const auto num_indices = narrow<int64_t>(indices_data.size());
-
   const auto* src_base = static_cast<const Tdata*>(data_input->DataRaw());
   auto* dst_base = static_cast<Tdata*>(data_output->MutableDataRaw());
 
@@ -296,17 +297,9 @@ Status ScatterData(
   const auto num_dims = input_data_shape.NumDimensions();
   ORT_RETURN_IF_NOT(num_dims > 0, "ScatterElements op: input tensor must have at least one dimension");
 
-  // Allocate and zero out counts. The input/output is of the same rank as
-  // indices/updates but the actual dimensions of indices/updates must be less or equal
-  // than that of input/output because we can update no more elements than
-  // the input contains. As we walk through the indices/updates
-  // we maintain dimension count as we will need to use it
-  // to compute output offset but using input/output dim values.
-  // We treat the whole array as a number where each element having
-  // different cardinality according to the upd_shape dimensions.
-  // As each counter reaches its max (upd_shape) it resets to zero
-  // and we carry to the more significant dim (right to left)
-  std::vector<int64_t> dim_counters(num_dims);
+  if (indices_data.empty()) {
+    return Status::OK();
+  }
 
   // This vector contains number of elements under the dimension.
   // For example, for the dimensions of [4, 2, 3] the vector
@@ -314,11 +307,11 @@ Status ScatterData(
   // contains 3 elements of dim 2.
   // For each count of dim 0 we would have 2x3=6 elements.
   // The last value is always 1.
-  // We use it to compute output element offset. For a given value of
-  // counters we multiple each counter value per corresponding entry of dim_block_size value
-  // and add up resulting the output element offset. However, for dimensions
-  // that are equal to the specified axis value we take indices_data[index]
-  // instead of the counter value.
+  // We use it to compute output element offset. For a given index of
+  // updates we multiply each coordinate per corresponding entry of dim_block_size value
+  // and add up resulting the output element offset. However, for the dimension
+  // that is equal to the specified axis value we take indices_data[index]
+  // instead of the coordinate.
   // E.g. for 3-dim and axis=0
   //    output[indices[i][j][k]][j][k] = updates[i][j][k]
   // for axis 1
@@ -335,64 +328,100 @@ Status ScatterData(
     }
   }
 
-  const auto* update_data = static_cast<const Tdata*>(updates_input->DataRaw());
-  // For every update we compute the destination offset and copy it there
-  for (int64_t index = 0; index < num_indices;) {
-    const auto axis_idx = indices_data[narrow<size_t>(index)];
-
-    // Compute the offset
-    // See comments above for dim_block_size
-    size_t dst_offset = 0;
-    for (size_t i = 0; i < num_dims; ++i) {
-      if (i == size_t(axis)) {
-        // replace the counter with the update index for this dim
-        dst_offset += narrow<size_t>(axis_idx * dim_block_size[narrow<size_t>(i)]);
-      } else {
-        dst_offset += narrow<size_t>(dim_counters[narrow<size_t>(i)] * dim_block_size[narrow<size_t>(i)]);
-      }
-    }
-
-    func(dst_base + dst_offset, update_data + index);
-
-    if (++index == num_indices) {
-      break;
+  // View updates as [outer, axis_dim, inner]. Two updates can only write to the same output element if they
+  // differ in their axis coordinate alone, so each (outer, inner) column is applied in order by one thread.
+  // This keeps the result of a reduction deterministic and identical to applying the updates one by one.
+  const auto axis_idx = narrow<size_t>(axis);
+  const auto outer_size = narrow<size_t>(upd_shape.SizeToDimension(axis_idx));
+  const auto axis_dim = narrow<size_t>(upd_shape[axis_idx]);
+  const auto inner_size = narrow<size_t>(upd_shape.SizeFromDimension(axis_idx + 1));
+  const auto axis_block_size = dim_block_size[axis_idx];
+
+  // Returns the output offset of the coordinates of index in the dims [first_dim, last_dim) of updates.
+  auto get_offset = [&](size_t index, size_t first_dim, size_t last_dim) {
+    int64_t offset = 0;
+    for (size_t i = last_dim; i-- > first_dim;) {
+      const auto dim = narrow<size_t>(upd_shape[i]);
+      offset += narrow<int64_t>(index % dim) * dim_block_size[i];
+      index /= dim;
     }
-    // Increment counters
-    // See comments for dim_counters above
-    for (auto i = int64_t(num_dims - 1); i >= 0; --i) {
-      auto v = ++dim_counters[narrow<size_t>(i)];
-      assert(v <= upd_shape[narrow<size_t>(i)]);
-      if (v < upd_shape[narrow<size_t>(i)]) {
-        // No carry, done
-        break;
-      }
-      // No carry for the most significant dim
-      assert(i > 0);
-      dim_counters[narrow<size_t>(i)] = 0;
+    return offset;
+  };
+
+  // When the updates cover the full inner dimensions of the output their inner offsets are contiguous.
+  const bool contiguous_inner = input_data_shape.SizeFromDimension(axis_idx + 1) == static_cast<int64_t>(inner_size);
+  std::vector<int64_t> inner_offsets;
+  if (!contiguous_inner) {
+    inner_offsets.resize(inner_size);
+    for (size_t j = 0; j < inner_size; ++j) {
+      inner_offsets[j] = get_offset(j, axis_idx + 1, num_dims);
     }
   }
-  return Status::OK();
+
+  const auto* update_data = static_cast<const Tdata*>(updates_input->DataRaw());
+  const auto* indices = indices_data.data();
+
+  // the reduction functions throw for unsupported types, which must not escape a thread pool worker
+  std::mutex status_mutex;
+  Status status;
+  concurrency::ThreadPool::TryParallelFor(
+      tp, static_cast<std::ptrdiff_t>(outer_size * inner_size),
+      TensorOpCost{static_cast<double>(axis_dim * (sizeof(Tdata) * 2 + sizeof(int64_t))),
+                   static_cast<double>(axis_dim * sizeof(Tdata)),
+                   static_cast<double>(axis_dim) * 2.0},
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        ORT_TRY {
+          auto column = static_cast<size_t>(first);
+          const auto end = static_cast<size_t>(last);
+          while (column < end) {
+            // the columns of one outer index up to the end of the range
+            const size_t outer = column / inner_size;
+            const size_t inner_begin = column % inner_size;
+            const size_t inner_end = std::min(inner_size, inner_begin + (end - column));
+            Tdata* dst = dst_base + get_offset(outer, 0, axis_idx);
+
+            for (size_t a = 0; a < axis_dim; ++a) {
+              const size_t update_begin = (outer * axis_dim + a) * inner_size;
+              for (size_t j = inner_begin; j < inner_end; ++j) {
+                const size_t index = update_begin + j;
+                const int64_t inner_offset = contiguous_inner ? static_cast<int64_t>(j) : inner_offsets[j];
+                func(dst + indices[index] * axis_block_size + inner_offset, update_data + index);
+              }
+            }
+
+            column += inner_end - inner_begin;
+          }
+        }
+        ORT_CATCH(const std::exception& ex) {
+          ORT_HANDLE_EXCEPTION([&]() {
+            std::lock_guard<std::mutex> lock(status_mutex);
+            status = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, ex.what());
+          });
+        }
+      });
+
+  return status;
 }
 
 template <typename TData>
 struct ScatterDataDispatchTarget {
   Status operator()(const Tensor* data_input, const std::vector<int64_t>& indices_data, const Tensor* updates_input, int64_t axis,
-                    const std::string& reduction, Tensor* data_output) const {
+                    const std::string& reduction, Tensor* data_output, concurrency::ThreadPool* tp) const {
     if (reduction == "add")
       return ScatterData<TData>(
-          Func_Add<TData>(), data_input, indices_data, updates_input, axis, data_output);
+          Func_Add<TData>(), data_input, indices_data, updates_input, axis, data_output, tp);
     else if (reduction == "mul")
       return ScatterData<TData>(
-          Func_Mul<TData>(), data_input, indices_data, updates_input, axis, data_output);
+          Func_Mul<TData>(), data_input, indices_data, updates_input, axis, data_output, tp);
     else if (reduction == "min")
       return ScatterData<TData>(
-          Func_Min<TData>(), data_input, indices_data, updates_input, axis, data_output);
+          Func_Min<TData>(), data_input, indices_data, updates_input, axis, data_output, tp);
     else if (reduction == "max")
       return ScatterData<TData>(
-          Func_Max<TData>(), data_input, indices_data, updates_input, axis, data_output);
+          Func_Max<TData>(), data_input, indices_data, updates_input, axis, data_output, tp);
     else  // if (reduction == "none")
       return ScatterData<TData>(
-          Func_Assignment<TData>(), data_input, indices_data, updates_input, axis, data_output);
+          Func_Assignment<TData>(), data_input, indices_data, updates_input, axis, data_output, tp);
   }
 };
 
@@ -462,7 +491,7 @@ Status Scatter<EnabledDataTypes>::Compute(OpKernelContext* context) const {
 
   utils::MLTypeCallDispatcherFromTypeList<EnabledDataTypes> dispatcher{data_type};
   status = dispatcher.template InvokeRet<Status, ScatterDataDispatchTarget>(
-      data_input, indices_data, updates_input, axis, this->reduction_, data_output);
+      data_input, indices_data, updates_input, axis, this->reduction_, data_output, context->GetOperatorThreadPool());
 
   return status;
 }
@@ -483,7 +512,7 @@ Status GatherElementsGradImpl(const Tensor* indices_input, const Tensor* updates
                               const int64_t axis, Tensor* data_output) {
   std::vector<int64_t> indices_data{};
   ORT_RETURN_IF_ERROR(GetIndices<Tin>(*data_output, *indices_input, axis, indices_data));
-  return ScatterData<Tdata>(Func_Add<Tdata>(), data_output, indices_data, updates_input, axis, data_output);
+  return ScatterData<Tdata>(Func_Add<Tdata>(), data_output, indices_data, updates_input, axis, data_output, nullptr);
 }
 
 #define GATHER_ELEMENTS_GRAD_IMPL_SPECIALIZED(Tin, Tdata) \
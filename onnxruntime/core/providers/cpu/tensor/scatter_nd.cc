@@ -3,6 +3,9 @@
 
 #include "core/providers/cpu/tensor/scatter_nd.h"
 
+#include <algorithm>
+#include <numeric>
+
 #include "core/framework/element_type_lists.h"
 #include "core/framework/op_kernel_type_control_utils.h"
 #include "core/platform/threadpool.h"
@@ -396,13 +399,52 @@ struct ScatterNDDispatchTarget {
         } break;
       }
     };
-    concurrency::ThreadPool::TryParallelFor(
-        tp, prepare.element_offsets.size(), static_cast<double>(prepare.element_to_copy),
-        [&lambda](ptrdiff_t first, ptrdiff_t last) {
-          for (int i = static_cast<int>(first), end = static_cast<int>(last); i < end; ++i) {
-            lambda(i);
-          }
-        });
+
+    // Updates of the same slice must not run concurrently, and are applied in index order so that the result
+    // is deterministic. Sort the updates by destination and hand out whole groups of equal destinations.
+    const size_t num_updates = prepare.element_offsets.size();
+    std::vector<size_t> order;
+    std::vector<size_t> group_begin;
+    if (concurrency::ThreadPool::DegreeOfParallelism(tp) > 1 && num_updates > 1) {
+      order.resize(num_updates);
+      std::iota(order.begin(), order.end(), size_t{0});
+      std::stable_sort(order.begin(), order.end(), [&prepare](size_t a, size_t b) {
+        return prepare.element_offsets[a] < prepare.element_offsets[b];
+      });
+      for (size_t k = 0; k < num_updates; ++k) {
+        if (k == 0 || prepare.element_offsets[order[k]] != prepare.element_offsets[order[k - 1]]) {
+          group_begin.push_back(k);
+        }
+      }
+
+      if (group_begin.size() == num_updates) {
+        order.clear();  // all destinations are distinct
+      } else {
+        group_begin.push_back(num_updates);
+      }
+    }
+
+    if (order.empty()) {
+      concurrency::ThreadPool::TryParallelFor(
+          tp, num_updates, static_cast<double>(prepare.element_to_copy),
+          [&lambda](ptrdiff_t first, ptrdiff_t last) {
+            for (ptrdiff_t i = first; i < last; ++i) {
+              lambda(i);
+            }
+          });
+    } else {
+      const size_t num_groups = group_begin.size() - 1;
+      concurrency::ThreadPool::TryParallelFor(
+          tp, num_groups, static_cast<double>(prepare.element_to_copy) * num_updates / num_groups,
+          [&](ptrdiff_t first, ptrdiff_t last) {
+            for (ptrdiff_t g = first; g < last; ++g) {
+              for (size_t k = group_begin[g]; k < group_begin[g + 1]; ++k) {
+                lambda(static_cast<int64_t>(order[k]));
+              }
+            }
+          });
+    }
+
     return Status::OK();
   }
 };
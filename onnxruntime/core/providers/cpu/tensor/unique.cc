@@ -2,10 +2,17 @@
 // Licensed under the MIT License.
 
 #include "core/providers/cpu/tensor/unique.h"
+#include <algorithm>
+#include <cmath>
 #include <map>
+#include <numeric>
+#include <string_view>
+#include <type_traits>
 #include <core/common/safeint.h>
 #include <gsl/gsl>
+#include "core/common/inlined_containers.h"
 #include "core/framework/op_kernel_type_control_utils.h"
+#include "core/platform/threadpool.h"
 #include "core/providers/common.h"
 #include "core/providers/op_kernel_type_control.h"
 
@@ -144,62 +151,146 @@ class Subtensor {
   std::vector<T> items_;
 };
 
+// Elements of the flattened input handled by one task. Fixed, so the output doesn't depend on the number of threads.
+static constexpr int64_t kUniqueChunkSize = 16384;
+
+// Key of an element in the hash maps. Strings are looked up in place instead of being copied.
 template <typename T>
-static void CreateFlattenedOutput(OpKernelContext& context,
-                                  const std::map<const T, int64_t>& offsets,         // map sorted key to unsorted idx
-                                  const std::vector<std::vector<int64_t>>& indices,  // unsorted
-                                  const std::vector<int64_t>& inverse_index,         // unsorted
-                                  bool sorted) {
-  int64_t num_unique = static_cast<int64_t>(indices.size());
+using UniqueKey = std::conditional_t<std::is_same<T, std::string>::value, std::string_view, T>;
+
+// Ascending order for the sorted output. NaNs go last so that this is a strict weak ordering.
+template <typename T>
+static bool UniqueValueLess(const T& lhs, const T& rhs) {
+  if constexpr (std::is_floating_point<T>::value) {
+    return !std::isnan(lhs) && (std::isnan(rhs) || lhs < rhs);
+  } else {
+    return lhs < rhs;
+  }
+}
+
+// Unique of the flattened input. The chunks of the input are hashed in parallel, each into the unique values in the
+// order they first occur in it. Merging those in chunk order gives the unique values in the order they first occur
+// in the input, and the element to unique value mapping of every chunk is then remapped in parallel.
+template <typename T>
+static void ComputeFlattened(OpKernelContext& context, gsl::span<const T> data, bool sorted) {
+  using Key = UniqueKey<T>;
+  concurrency::ThreadPool* tp = context.GetOperatorThreadPool();
+  const int64_t num_elements = static_cast<int64_t>(data.size());
+  const int64_t num_chunks = (num_elements + kUniqueChunkSize - 1) / kUniqueChunkSize;
+  const double chunk_size = static_cast<double>(kUniqueChunkSize);
+
+  // index of the first occurrence and count of the unique values of each chunk.
+  // inverse_index holds the id of each element within its chunk.
+  std::vector<std::vector<int64_t>> chunk_indices(onnxruntime::narrow<size_t>(num_chunks));
+  std::vector<std::vector<int64_t>> chunk_counts(onnxruntime::narrow<size_t>(num_chunks));
+  std::vector<int64_t> inverse_index(data.size());
+
+  concurrency::ThreadPool::TryParallelFor(
+      tp, num_chunks, TensorOpCost{chunk_size * sizeof(T), chunk_size * sizeof(int64_t), chunk_size * 16},
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t chunk = first; chunk < last; ++chunk) {
+          const int64_t begin = chunk * kUniqueChunkSize;
+          const int64_t end = std::min(begin + kUniqueChunkSize, num_elements);
+          auto& indices = chunk_indices[chunk];
+          auto& counts = chunk_counts[chunk];
+          InlinedHashMap<Key, int64_t> ids;
+          for (int64_t i = begin; i < end; ++i) {
+            auto [entry, inserted] = ids.try_emplace(Key(data[onnxruntime::narrow<size_t>(i)]),
+                                                     static_cast<int64_t>(indices.size()));
+            if (inserted) {
+              indices.push_back(i);
+              counts.push_back(0);
+            }
+
+            ++counts[onnxruntime::narrow<size_t>(entry->second)];
+            inverse_index[onnxruntime::narrow<size_t>(i)] = entry->second;
+          }
+        }
+      });
+
+  // merge the chunks in order. indices and counts are in the order the unique values first occur in the input.
+  InlinedHashMap<Key, int64_t> ids;
+  std::vector<int64_t> indices;
+  std::vector<int64_t> counts;
+  std::vector<std::vector<int64_t>> chunk_to_unique(onnxruntime::narrow<size_t>(num_chunks));
+  for (size_t chunk = 0; chunk < chunk_indices.size(); ++chunk) {
+    auto& to_unique = chunk_to_unique[chunk];
+    to_unique.reserve(chunk_indices[chunk].size());
+    for (size_t id = 0; id < chunk_indices[chunk].size(); ++id) {
+      const int64_t first_index = chunk_indices[chunk][id];
+      auto [entry, inserted] = ids.try_emplace(Key(data[onnxruntime::narrow<size_t>(first_index)]),
+                                               static_cast<int64_t>(indices.size()));
+      if (inserted) {
+        indices.push_back(first_index);
+        counts.push_back(0);
+      }
+
+      counts[onnxruntime::narrow<size_t>(entry->second)] += chunk_counts[chunk][id];
+      to_unique.push_back(entry->second);
+    }
+  }
+
+  // position of each unique value in the output
+  const int64_t num_unique = static_cast<int64_t>(indices.size());
+  std::vector<int64_t> output_index(indices.size());
+  if (sorted) {
+    std::vector<int64_t> order(indices.size());
+    std::iota(order.begin(), order.end(), int64_t{0});
+    std::sort(order.begin(), order.end(), [&](int64_t lhs, int64_t rhs) {
+      const T& lhs_value = data[onnxruntime::narrow<size_t>(indices[onnxruntime::narrow<size_t>(lhs)])];
+      const T& rhs_value = data[onnxruntime::narrow<size_t>(indices[onnxruntime::narrow<size_t>(rhs)])];
+      if (UniqueValueLess(lhs_value, rhs_value)) return true;
+      if (UniqueValueLess(rhs_value, lhs_value)) return false;
+      return lhs < rhs;
+    });
+
+    for (size_t i = 0; i < order.size(); ++i) {
+      output_index[onnxruntime::narrow<size_t>(order[i])] = static_cast<int64_t>(i);
+    }
+  } else {
+    std::iota(output_index.begin(), output_index.end(), int64_t{0});
+  }
+
   Tensor& Y = *context.Output(0, {num_unique});
   Tensor* indices_out = context.Output(1, {num_unique});
-  Tensor* inverse_indices = context.Output(2, {static_cast<int64_t>(inverse_index.size())});
-  Tensor* counts = context.Output(3, {num_unique});
+  Tensor* inverse_indices = context.Output(2, {num_elements});
+  Tensor* counts_out = context.Output(3, {num_unique});
 
   auto Y_data = Y.MutableDataAsSpan<T>();
   gsl::span<int64_t> indices_data = indices_out != nullptr ? indices_out->MutableDataAsSpan<int64_t>()
                                                            : gsl::span<int64_t>();
   gsl::span<int64_t> inverse_indices_data = inverse_indices != nullptr ? inverse_indices->MutableDataAsSpan<int64_t>()
                                                                        : gsl::span<int64_t>();
-  gsl::span<int64_t> counts_data = counts != nullptr ? counts->MutableDataAsSpan<int64_t>()
-                                                     : gsl::span<int64_t>();
-
-  // iterate using 'offsets' which is sorted, but contains the offset of the unsorted entry
-  auto offsets_iter = offsets.begin();
-  for (int64_t i = 0, end = num_unique; i < end; ++i, ++offsets_iter) {
-    // write sequentially if we want sorted output, use the unsorted_idx if not
-    auto unsorted_idx = offsets_iter->second;
-    auto output_idx = sorted ? i : unsorted_idx;
+  gsl::span<int64_t> counts_data = counts_out != nullptr ? counts_out->MutableDataAsSpan<int64_t>()
+                                                         : gsl::span<int64_t>();
 
-    Y_data[onnxruntime::narrow<size_t>(output_idx)] = offsets_iter->first;
+  for (size_t i = 0; i < indices.size(); ++i) {
+    const auto output_idx = onnxruntime::narrow<size_t>(output_index[i]);
+    Y_data[output_idx] = data[onnxruntime::narrow<size_t>(indices[i])];
 
     if (indices_out) {
-      indices_data[onnxruntime::narrow<size_t>(output_idx)] = indices[onnxruntime::narrow<size_t>(unsorted_idx)].front();
+      indices_data[output_idx] = indices[i];
     }
 
-    if (counts) {
-      counts_data[onnxruntime::narrow<size_t>(output_idx)] = indices[onnxruntime::narrow<size_t>(unsorted_idx)].size();
+    if (counts_out) {
+      counts_data[output_idx] = counts[i];
     }
   }
 
   if (inverse_indices) {
-    if (sorted) {
-      // need to convert unsorted entries in the inverse index to their sorted values
-      std::vector<int64_t> unsorted_to_sorted;
-      unsorted_to_sorted.resize(onnxruntime::narrow<size_t>(num_unique));
-      int64_t sorted_idx = 0;
-      for (const auto& offset : offsets) {
-        unsorted_to_sorted[onnxruntime::narrow<size_t>(offset.second)] = sorted_idx++;
-      }
-
-      for (size_t i = 0, end = inverse_index.size(); i < end; ++i) {
-        inverse_indices_data[onnxruntime::narrow<size_t>(i)] = unsorted_to_sorted[onnxruntime::narrow<size_t>(inverse_index[i])];
-      }
-    } else {
-      for (size_t i = 0, end = inverse_index.size(); i < end; ++i) {
-        inverse_indices_data[i] = inverse_index[i];
-      }
-    }
+    concurrency::ThreadPool::TryParallelFor(
+        tp, num_chunks, TensorOpCost{chunk_size * sizeof(int64_t), chunk_size * sizeof(int64_t), chunk_size * 2},
+        [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+          for (std::ptrdiff_t chunk = first; chunk < last; ++chunk) {
+            const auto& to_unique = chunk_to_unique[chunk];
+            const int64_t begin = chunk * kUniqueChunkSize;
+            const int64_t end = std::min(begin + kUniqueChunkSize, num_elements);
+            for (int64_t i = begin; i < end; ++i) {
+              const auto unique_idx = to_unique[onnxruntime::narrow<size_t>(inverse_index[onnxruntime::narrow<size_t>(i)])];
+              inverse_indices_data[onnxruntime::narrow<size_t>(i)] = output_index[onnxruntime::narrow<size_t>(unique_idx)];
+            }
+          }
+        });
   }
 }
 
@@ -308,30 +399,7 @@ Status Unique::ComputeImpl(OpKernelContext& context) const {
   auto data = input.DataAsSpan<T>();
 
   if (flatten_) {
-    std::map<const T, int64_t> offsets;  // offset of entry in indices. provides map between sorted and unsorted values
-    std::vector<std::vector<int64_t>> indices;
-    std::vector<int64_t> inverse_index;
-
-    indices.reserve(data.size() / 2);  // arbitrary value. at worst 1 realloc but could be too large
-    inverse_index.reserve(data.size());
-
-    int64_t num_unique = 0;
-
-    for (int64_t i = 0, end = input.Shape().Size(); i < end; ++i) {
-      auto entry = offsets.find(data[onnxruntime::narrow<size_t>(i)]);
-      if (entry == offsets.end()) {
-        offsets[data[onnxruntime::narrow<size_t>(i)]] = num_unique;
-        inverse_index.push_back({num_unique});
-        indices.push_back({i});
-        ++num_unique;
-      } else {
-        size_t indices_idx = onnxruntime::narrow<size_t>(entry->second);
-        indices[indices_idx].push_back(i);
-        inverse_index.push_back(onnxruntime::narrow<int64_t>(indices_idx));
-      }
-    }
-
-    CreateFlattenedOutput(context, offsets, indices, inverse_index, sort_);
+    ComputeFlattened<T>(context, data, sort_);
   } else {
     const auto& input_shape = input.Shape();
     const int64_t input_dims = static_cast<int64_t>(input_shape.NumDimensions());
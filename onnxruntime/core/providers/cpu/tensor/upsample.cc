@@ -918,49 +918,85 @@ std::array<float, CubicModeGridLength> GetCubicCoeffs(float s, float cubic_coeff
   return coeffs;
 }
 
-// Get the tensor data at the requested coordinate
-template <typename T>
-T GetDataForCoordinate(const T* Xdata,
-                       int64_t x, int64_t y,
-                       int64_t input_height, int64_t input_width) {
-  x = std::max(static_cast<int64_t>(0), std::min(x, input_width - 1));
-  y = std::max(static_cast<int64_t>(0), std::min(y, input_height - 1));
-  return Xdata[y * input_width + x];
-}
+// Sampling table of bicubic interpolation along one axis. For every output index it holds the 4 input indices of
+// its grid, clamped to the input, and their weights. The taps are stored one after the other, [tap][output index],
+// so the loops over the output indices read them contiguously.
+struct CubicSamplingTable {
+  std::vector<int64_t> index;
+  std::vector<float> weight;
+  // sum of the weights when they are not normalized. 1 unless exclude_outside is set
+  std::vector<float> weight_sum;
+  // set if the output index takes the extrapolation value
+  std::vector<uint8_t> extrapolate;
+};
 
-// Computes cubic convolution interpolation in 1D
-template <typename T>
-float CubicInterpolation1D(const T* Xdata,
-                           int64_t x,
-                           int64_t y,
-                           int64_t input_height,
-                           int64_t input_width,
-                           std::array<float, CubicModeGridLength>& coeff_array,
-                           float coeff_sum,
-                           std::unordered_map<int64_t, float>& cache) {
-  // When calculating cubic interpolation we move the 4*4 grid across the original data and therefore there is
-  // opportunity to cache the results for previously seen combinations.
-  // Check if the result is already available in the cache
-  auto grid_start_pos = (y)*input_width + (x - 1);
-  if (cache.find(grid_start_pos) != cache.end()) {
-    return cache[grid_start_pos];
-  }
+static CubicSamplingTable SetupCubicSampling(int64_t input_size,
+                                             int64_t output_size,
+                                             float scale,
+                                             float roi_start,
+                                             float roi_end,
+                                             float cubic_coeff_a,
+                                             bool use_extrapolation,
+                                             bool exclude_outside,
+                                             bool normalize,
+                                             const GetOriginalCoordinateFunc& get_original_coordinate) {
+  const size_t size = narrow<size_t>(output_size);
+  CubicSamplingTable table;
+  table.index.resize(size * CubicModeGridLength, 0);
+  table.weight.resize(size * CubicModeGridLength, 0.0f);
+  table.weight_sum.resize(size, 1.0f);
+  table.extrapolate.resize(size, 0);
+
+  for (size_t o = 0; o < size; ++o) {
+    float in = scale == 1 ? static_cast<float>(o)
+                          : get_original_coordinate(static_cast<float>(o), scale,
+                                                    static_cast<float>(output_size),
+                                                    static_cast<float>(input_size),
+                                                    roi_start, roi_end);
+
+    // when use_extrapolation is set and original index is out of the dim range
+    // then use extrapolation_value as the output value.
+    if (use_extrapolation && (in < 0 || in > static_cast<float>(input_size - 1))) {
+      table.extrapolate[o] = 1;
+      continue;
+    }
+
+    const auto in_int = static_cast<int64_t>(std::floor(in));
+    const auto coeffs = GetCubicCoeffs(in - in_int, cubic_coeff_a);
+
+    // When exclude_outside is set, the weight of sampling locations outside the grid will be set to 0
+    // and the weight will be renormalized so that their sum is 1.0
+    float weight_sum = exclude_outside ? 0.0f : 1.0f;
+    for (size_t i = 0; i < CubicModeGridLength; ++i) {
+      const int64_t in_val = in_int - 1 + static_cast<int64_t>(i);
+      const bool outside = in_val < 0 || in_val >= input_size;
+      const float weight = exclude_outside && outside ? 0.0f : coeffs[i];
+      if (exclude_outside) {
+        weight_sum += weight;
+      }
+
+      table.index[i * size + o] = std::clamp(in_val, static_cast<int64_t>(0), input_size - 1);
+      table.weight[i * size + o] = weight;
+    }
 
-  // get the neighbors in 1D and find interpolation for this dimension
-  // for 1D cubic interpolation 4 samples are used. 2 on the left and 2 on the right of x
-  float result = 0;
-  for (int i = 0, j = -1; i < static_cast<int>(CubicModeGridLength); i++, j++) {
-    auto orig_data = GetDataForCoordinate(Xdata, x + j, y, input_height, input_width);
-    result += coeff_array[narrow<size_t>(i)] / coeff_sum * orig_data;
+    if (normalize) {
+      for (size_t i = 0; i < CubicModeGridLength; ++i) {
+        table.weight[i * size + o] /= weight_sum;
+      }
+    } else {
+      table.weight_sum[o] = weight_sum;
+    }
   }
-  cache[grid_start_pos] = result;
 
-  return result;
+  return table;
 }
-#if defined(_MSC_VER)
-#pragma warning(push)
-#pragma warning(disable : 6001)
-#endif
+
+// Separable bicubic resize of NCHW data: the input rows that are needed are interpolated along the width, and the
+// output rows are blended from 4 of those. Both passes run over precomputed sampling tables and are loops over the
+// output width the compiler vectorizes. The channels are processed in parallel.
+// The taps of an output row are within 4 consecutive input rows, so when the taps move monotonically down the input
+// a ring of 4 interpolated rows keyed by the input row is enough. Otherwise (e.g. a reversed roi) every input row
+// gets its own slot.
 template <typename T>
 void ResizeBiCubic(int64_t batch_size,
                    int64_t num_channels,
@@ -977,138 +1013,106 @@ void ResizeBiCubic(int64_t batch_size,
                    gsl::span<const float> roi,
                    const T* Xdata,
                    T* Ydata,
-                   const GetOriginalCoordinateFunc& get_original_coordinate) {
-  std::vector<float> y_original;
-  y_original.reserve(narrow<size_t>(output_height));
-
-  std::vector<float> x_original;
-  x_original.reserve(narrow<size_t>(output_width));
-
-  std::unordered_map<float, std::array<float, CubicModeGridLength>> cubic_coeffs;
-  std::unordered_map<float, std::unordered_map<int64_t, float>> coeff_to_1Dinterpolation_map;
-  auto roi_y_start = roi.size() / 2 - 2;
-  auto roi_y_end = roi.size() - 2;
-  auto roi_x_start = roi.size() / 2 - 1;
-  auto roi_x_end = roi.size() - 1;
-
-  // generate coefficients in y direction
-  for (int64_t y = 0; y < output_height; ++y) {
-    float in_y = height_scale == 1 ? static_cast<float>(y)
-                                   : get_original_coordinate(static_cast<float>(y), height_scale,
-                                                             static_cast<float>(output_height),
-                                                             static_cast<float>(input_height),
-                                                             roi[roi_y_start], roi[roi_y_end]);
-    y_original.emplace_back(in_y);
-    auto s = y_original[narrow<size_t>(y)] - std::floor(y_original[narrow<size_t>(y)]);
-    if (cubic_coeffs.find(s) == cubic_coeffs.end()) {
-      cubic_coeffs[s] = GetCubicCoeffs(s, cubic_coeff_a);
-      coeff_to_1Dinterpolation_map[s] = {};
-    }
-  }
-
-  // generate coefficients in x direction
-  for (int64_t x = 0; x < output_width; ++x) {
-    float in_x = width_scale == 1 ? static_cast<float>(x)
-                                  : get_original_coordinate(static_cast<float>(x),
-                                                            width_scale,
-                                                            static_cast<float>(output_width),
-                                                            static_cast<float>(input_width),
-                                                            roi[roi_x_start], roi[roi_x_end]);
-    x_original.emplace_back(in_x);
-    auto s = x_original[narrow<size_t>(x)] - std::floor(x_original[narrow<size_t>(x)]);
-    if (cubic_coeffs.find(s) == cubic_coeffs.end()) {
-      cubic_coeffs[s] = GetCubicCoeffs(s, cubic_coeff_a);
-      coeff_to_1Dinterpolation_map[s] = {};
+                   const GetOriginalCoordinateFunc& get_original_coordinate,
+                   concurrency::ThreadPool* tp) {
+  // the weights along the width are normalized up front. along the height the weight sum is applied to the
+  // interpolated values, the same order of operations as interpolating every output value on its own.
+  const CubicSamplingTable y_table = SetupCubicSampling(input_height, output_height, height_scale,
+                                                        roi[roi.size() / 2 - 2], roi[roi.size() - 2], cubic_coeff_a,
+                                                        use_extrapolation, exclude_outside, false,
+                                                        get_original_coordinate);
+  const CubicSamplingTable x_table = SetupCubicSampling(input_width, output_width, width_scale,
+                                                        roi[roi.size() / 2 - 1], roi[roi.size() - 1], cubic_coeff_a,
+                                                        use_extrapolation, exclude_outside, true,
+                                                        get_original_coordinate);
+
+  const size_t x_size = narrow<size_t>(output_width);
+  const size_t y_size = narrow<size_t>(output_height);
+
+  bool rows_monotonic = true;
+  int64_t previous_first_row = 0;
+  for (size_t y = 0; y < y_size; ++y) {
+    if (!y_table.extrapolate[y]) {
+      const int64_t first_row = y_table.index[y];
+      rows_monotonic = rows_monotonic && first_row >= previous_first_row;
+      previous_first_row = first_row;
     }
   }
 
-  // setup up temp arrays to hold coefficients when exclude_outside is set to true
-  std::array<float, CubicModeGridLength> y_coeff_holder;
-  std::array<float, CubicModeGridLength> x_coeff_holder;
-  float y_coeff_sum = 1;
-  float x_coeff_sum = 1;
-
-  for (int64_t n = 0; n < batch_size; n++) {
-    for (int64_t c = 0; c < num_channels; c++) {
-      for (int64_t y = 0; y < output_height; ++y) {
-        auto in_y = y_original[narrow<size_t>(y)];
-
-        // when use_extrapolation is set and original index is out of the dim range
-        // then use extrapolation_value as the output value.
-        if (use_extrapolation && (in_y < 0 || in_y > static_cast<float>(input_height - 1))) {
-          for (int64_t x = 0; x < output_width; ++x) {
-            Ydata[y * output_width + x] = extrapolation_value;
-          }
-          continue;
-        }
+  const size_t num_slots = rows_monotonic ? CubicModeGridLength : narrow<size_t>(input_height);
+
+  const int64_t input_plane_size = input_height * input_width;
+  const int64_t output_plane_size = output_height * output_width;
+  const double interpolations = static_cast<double>((std::min(input_height, output_height * 4) + output_height) *
+                                                    output_width);
+  const TensorOpCost cost{static_cast<double>(input_plane_size * sizeof(T)),
+                          static_cast<double>(output_plane_size * sizeof(T)),
+                          interpolations * CubicModeGridLength * 2};
+
+  concurrency::ThreadPool::TryParallelFor(
+      tp, narrow<std::ptrdiff_t>(batch_size * num_channels), cost,
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        // input rows interpolated along the width and the input row held by each slot
+        std::vector<float> horizontal(num_slots * x_size);
+        std::vector<int64_t> slot_row(num_slots);
+        std::vector<float> result(x_size);
+
+        for (std::ptrdiff_t plane = first; plane < last; ++plane) {
+          const T* X = Xdata + plane * input_plane_size;
+          T* Y = Ydata + plane * output_plane_size;
+          std::fill(slot_row.begin(), slot_row.end(), -1);
+
+          // rows are interpolated the first time they are used. the 4 taps of an output row use different slots.
+          const auto interpolated_row = [&](int64_t row) -> const float* {
+            const size_t slot = narrow<size_t>(row) % num_slots;
+            float* h = horizontal.data() + slot * x_size;
+            if (slot_row[slot] != row) {
+              const T* X_row = X + row * input_width;
+              std::fill_n(h, x_size, 0.0f);
+              for (size_t i = 0; i < CubicModeGridLength; ++i) {
+                const int64_t* x_index = x_table.index.data() + i * x_size;
+                const float* x_weight = x_table.weight.data() + i * x_size;
+                for (size_t x = 0; x < x_size; ++x) {
+                  h[x] += x_weight[x] * X_row[x_index[x]];
+                }
+              }
 
-        auto y_int = static_cast<int64_t>(std::floor(in_y));
-        auto& coeff_y = exclude_outside ? y_coeff_holder : cubic_coeffs[in_y - y_int];
-        y_coeff_sum = 1;
-
-        if (exclude_outside) {
-          // When true, the weight of sampling locations outside the grid will be set to 0
-          // and the weight will be renormalized so that their sum is 1.0
-          y_coeff_sum = 0;
-          auto& orig_y_coeffs = cubic_coeffs[in_y - y_int];
-          for (int64_t i = 0, y_val = y_int - 1; y_val <= y_int + 2; y_val++, i++) {
-            y_coeff_holder[narrow<size_t>(i)] = (y_val < 0 || y_val >= static_cast<float>(input_height)) ? 0.0f : orig_y_coeffs[narrow<size_t>(i)];
-            y_coeff_sum += y_coeff_holder[narrow<size_t>(i)];
-          }
-        }
+              slot_row[slot] = row;
+            }
 
-        for (int64_t x = 0; x < output_width; ++x) {
-          auto in_x = x_original[narrow<size_t>(x)];
+            return h;
+          };
 
-          // when use_extrapolation is set and original index is out of the dim range
-          // then use extrapolation_value as the output value.
-          if (use_extrapolation && (in_x < 0 || in_x > static_cast<float>(input_width - 1))) {
-            Ydata[y * output_width + x] = extrapolation_value;
-            continue;
-          }
+          for (size_t y = 0; y < y_size; ++y) {
+            T* Y_row = Y + y * x_size;
+            if (y_table.extrapolate[y]) {
+              std::fill_n(Y_row, x_size, static_cast<T>(extrapolation_value));
+              continue;
+            }
 
-          auto x_int = static_cast<int64_t>(std::floor(in_x));
-          auto s_x = static_cast<float>(in_x - x_int);
-          auto& coeff_x = exclude_outside ? x_coeff_holder : cubic_coeffs[s_x];
-          x_coeff_sum = 1;
-
-          if (exclude_outside) {
-            // When true, the weight of sampling locations outside the grid will be set to 0
-            // and the weight will be renormalized so that their sum is 1.0
-            x_coeff_sum = 0;
-            auto& orig_x_coeff = cubic_coeffs[s_x];
-            for (int64_t i = 0, x_val = x_int - 1; x_val <= x_int + 2; x_val++, i++) {
-              x_coeff_holder[narrow<size_t>(i)] = (x_val < 0 || x_val >= static_cast<float>(input_width)) ? 0.0f : orig_x_coeff[narrow<size_t>(i)];
-              x_coeff_sum += x_coeff_holder[narrow<size_t>(i)];
+            const float y_weight_sum = y_table.weight_sum[y];
+            std::fill(result.begin(), result.end(), 0.0f);
+            for (size_t i = 0; i < CubicModeGridLength; ++i) {
+              const float* h = interpolated_row(y_table.index[i * y_size + y]);
+              const float y_weight = y_table.weight[i * y_size + y];
+              if (y_weight_sum == 1.0f) {
+                for (size_t x = 0; x < x_size; ++x) {
+                  result[x] += h[x] * y_weight;
+                }
+              } else {
+                for (size_t x = 0; x < x_size; ++x) {
+                  result[x] += h[x] * y_weight / y_weight_sum;
+                }
+              }
             }
-          }
 
-          // Compute cubic interpolation in x dimension using the x coefficients.
-          // From the result of cubic interpolation in x dim, compute cubic interpolation in y dimension
-          auto& interpolation_result_cache = coeff_to_1Dinterpolation_map[s_x];
-          float result = 0;
-          for (int64_t y_val = y_int - 1, i = 0; y_val <= y_int + 2; y_val++, i++) {
-            auto x_interpolation_result = CubicInterpolation1D(Xdata, x_int, y_val,
-                                                               input_height, input_width, coeff_x, x_coeff_sum,
-                                                               interpolation_result_cache);
-            result += x_interpolation_result * coeff_y[narrow<size_t>(i)] / y_coeff_sum;
+            for (size_t x = 0; x < x_size; ++x) {
+              Y_row[x] = x_table.extrapolate[x] ? static_cast<T>(extrapolation_value) : static_cast<T>(result[x]);
+            }
           }
-
-          Ydata[y * output_width + x] = static_cast<T>(result);
         }
-      }
-
-      Xdata += input_height * input_width;
-      Ydata += output_height * output_width;
-
-      // clear the cache when moving to the next channel
-      coeff_to_1Dinterpolation_map.clear();
-    }
-  }
+      });
 }
-#if defined(_MSC_VER)
-#pragma warning(pop)
-#endif
 
 template <typename T>
 Status Upsample<T>::BaseCompute(OpKernelContext* context,
@@ -1361,7 +1365,8 @@ Status Upsample<T>::BaseCompute(OpKernelContext* context,
         ResizeBiCubic(batch_size, num_channels, input_height, input_width, output_height, output_width,
                       height_scale, width_scale, cubic_coeff_a_, use_extrapolation_,
                       extrapolation_value_, exclude_outside_, roi, X->Data<float>(),
-                      Y->MutableData<float>(), get_original_coordinate_);
+                      Y->MutableData<float>(), get_original_coordinate_,
+                      output_height * output_width * num_channels > 64 ? context->GetOperatorThreadPool() : nullptr);
       }
       return Status::OK();
     }
@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <algorithm>
+#include <type_traits>
 #include <vector>
 #ifndef SHARED_PROVIDER
 #include "core/framework/op_kernel.h"
@@ -81,6 +83,81 @@ BilinearParams SetupUpsampleBilinear(const int32_t input_height,
                                      const GetOriginalCoordinateFunc& get_original_coordinate,
                                      const bool is_nchw);
 
+// Bilinear interpolation of one float channel, first along the width and then along the height. The two input rows
+// of an output row are interpolated along the width into row buffers, which are reused by the following output rows
+// that read the same input rows, and then blended. Both loops are contiguous so the compiler vectorizes them.
+// Integer types keep the per pixel interpolation of UpsampleBilinear, as rounding them is sensitive to the order of
+// the operations.
+inline void UpsampleBilinearSeparable(const BilinearParams& p,
+                                      const int32_t input_height,
+                                      const int32_t input_width,
+                                      const int32_t output_height,
+                                      const int32_t output_width,
+                                      const bool use_extrapolation,
+                                      const float extrapolation_value,
+                                      const float* const Xdata,
+                                      float* const Ydata) {
+  std::vector<float> rows(static_cast<size_t>(output_width) * 2);
+  // offsets of the input rows held by the 2 row buffers
+  int32_t row_offsets[2] = {-1, -1};
+
+  const auto find_row = [&](int32_t input_row_offset) {
+    return row_offsets[0] == input_row_offset ? 0 : (row_offsets[1] == input_row_offset ? 1 : -1);
+  };
+
+  const auto interpolate_row = [&](int32_t input_row_offset, int slot) {
+    const float* const X_row = Xdata + input_row_offset;
+    float* const row = rows.data() + slot * output_width;
+    for (int32_t x = 0; x < output_width; ++x) {
+      row[x] = p.dx2[x] * X_row[p.in_x1[x]] + p.dx1[x] * X_row[p.in_x2[x]];
+    }
+    row_offsets[slot] = input_row_offset;
+  };
+
+  for (int32_t y = 0; y < output_height; ++y) {
+    float* const Y_row = Ydata + output_width * y;
+
+    // when use_extrapolation is set and original index of x or y is out of the dim range
+    // then use extrapolation_value as the output value.
+    if (use_extrapolation &&
+        (p.y_original[y] < 0 || p.y_original[y] > static_cast<float>(input_height - 1))) {
+      std::fill_n(Y_row, output_width, extrapolation_value);
+      continue;
+    }
+
+    const int32_t y1_offset = p.input_width_mul_y1[y];
+    const int32_t y2_offset = p.input_width_mul_y2[y];
+    int slot1 = find_row(y1_offset);
+    int slot2 = find_row(y2_offset);
+    if (slot1 < 0) {
+      slot1 = slot2 == 0 ? 1 : 0;
+      interpolate_row(y1_offset, slot1);
+      slot2 = find_row(y2_offset);
+    }
+
+    if (slot2 < 0) {
+      slot2 = slot1 == 0 ? 1 : 0;
+      interpolate_row(y2_offset, slot2);
+    }
+
+    const float* const row1 = rows.data() + slot1 * output_width;
+    const float* const row2 = rows.data() + slot2 * output_width;
+    const float dy1 = p.dy1[y];
+    const float dy2 = p.dy2[y];
+    for (int32_t x = 0; x < output_width; ++x) {
+      Y_row[x] = dy2 * row1[x] + dy1 * row2[x];
+    }
+
+    if (use_extrapolation) {
+      for (int32_t x = 0; x < output_width; ++x) {
+        if (p.x_original[x] < 0 || p.x_original[x] > static_cast<float>(input_width - 1)) {
+          Y_row[x] = extrapolation_value;
+        }
+      }
+    }
+  }
+}
+
 template <typename T>
 void UpsampleBilinear(const int32_t batch_size,
                       const int32_t num_channels,
@@ -108,27 +185,32 @@ void UpsampleBilinear(const int32_t batch_size,
           const T* const Xdata =
               XdataBase + (n * num_channels + static_cast<int32_t>(c)) * (input_height * input_width);
           T* const Ydata = YdataBase + (n * num_channels + static_cast<int32_t>(c)) * (output_height * output_width);
-          for (int32_t y = 0; y < output_height; ++y) {
-            for (int32_t x = 0; x < output_width; ++x) {
-              const int32_t output_offset = output_width * y + x;
-              // when use_extrapolation is set and original index of x or y is out of the dim range
-              // then use extrapolation_value as the output value.
-              if (use_extrapolation &&
-                  ((p.y_original[y] < 0 || p.y_original[y] > static_cast<float>(input_height - 1)) ||
-                   (p.x_original[x] < 0 || p.x_original[x] > static_cast<float>(input_width - 1)))) {
-                Ydata[output_offset] = static_cast<T>(extrapolation_value);
-                continue;
-              }
+          if constexpr (std::is_same<T, float>::value) {
+            UpsampleBilinearSeparable(p, input_height, input_width, output_height, output_width,
+                                      use_extrapolation, extrapolation_value, Xdata, Ydata);
+          } else {
+            for (int32_t y = 0; y < output_height; ++y) {
+              for (int32_t x = 0; x < output_width; ++x) {
+                const int32_t output_offset = output_width * y + x;
+                // when use_extrapolation is set and original index of x or y is out of the dim range
+                // then use extrapolation_value as the output value.
+                if (use_extrapolation &&
+                    ((p.y_original[y] < 0 || p.y_original[y] > static_cast<float>(input_height - 1)) ||
+                     (p.x_original[x] < 0 || p.x_original[x] > static_cast<float>(input_width - 1)))) {
+                  Ydata[output_offset] = static_cast<T>(extrapolation_value);
+                  continue;
+                }
 
-              T X11 = Xdata[p.input_width_mul_y1[y] + p.in_x1[x]];
-              T X21 = Xdata[p.input_width_mul_y1[y] + p.in_x2[x]];
-              T X12 = Xdata[p.input_width_mul_y2[y] + p.in_x1[x]];
-              T X22 = Xdata[p.input_width_mul_y2[y] + p.in_x2[x]];
+                T X11 = Xdata[p.input_width_mul_y1[y] + p.in_x1[x]];
+                T X21 = Xdata[p.input_width_mul_y1[y] + p.in_x2[x]];
+                T X12 = Xdata[p.input_width_mul_y2[y] + p.in_x1[x]];
+                T X22 = Xdata[p.input_width_mul_y2[y] + p.in_x2[x]];
 
-              Ydata[output_offset] = static_cast<T>(p.dx2[x] * p.dy2[y] * X11 +
-                                                    p.dx1[x] * p.dy2[y] * X21 +
-                                                    p.dx2[x] * p.dy1[y] * X12 +
-                                                    p.dx1[x] * p.dy1[y] * X22);
+                Ydata[output_offset] = static_cast<T>(p.dx2[x] * p.dy2[y] * X11 +
+                                                      p.dx1[x] * p.dy2[y] * X21 +
+                                                      p.dx2[x] * p.dy1[y] * X12 +
+                                                      p.dx1[x] * p.dy1[y] * X22);
+              }
             }
           }
         });
@@ -3,6 +3,7 @@
 
 #include "regex_full_match.h"
 #include "core/common/common.h"
+#include "core/platform/threadpool.h"
 
 namespace onnxruntime {
 ONNX_CPU_OPERATOR_KERNEL(
@@ -13,8 +14,23 @@ ONNX_CPU_OPERATOR_KERNEL(
         .TypeConstraint("T2", DataTypeImpl::GetTensorType<bool>()),
     RegexFullMatch);
 
+namespace {
+// Maximum length of the literal bounds extracted from the pattern.
+constexpr int kMatchRangeMaxLength = 16;
+}  // namespace
+
 RegexFullMatch::RegexFullMatch(const OpKernelInfo& info) : OpKernel(info), re_{info.GetAttr<std::string>("pattern")} {
   ORT_ENFORCE(re_.ok(), "Invalid regex pattern: ", re_.pattern());
+  has_match_range_ = re_.PossibleMatchRange(&min_match_, &max_match_, kMatchRangeMaxLength);
+}
+
+bool RegexFullMatch::IsMatch(const std::string& str) const {
+  // Patterns starting with a literal prefix produce a tight range, which lets most
+  // non-matching strings be rejected with a string comparison.
+  if (has_match_range_ && (str < min_match_ || str > max_match_)) {
+    return false;
+  }
+  return RE2::FullMatch(str, re_);
 }
 
 Status RegexFullMatch::Compute(OpKernelContext* context) const {
@@ -22,13 +38,30 @@ Status RegexFullMatch::Compute(OpKernelContext* context) const {
   const auto input_data = input_tensor->template DataAsSpan<std::string>();
   auto* output_tensor = context->Output(0, input_tensor->Shape());
   auto output_data = output_tensor->template MutableDataAsSpan<bool>();
-  auto output_iter = output_data.begin();
-  auto input_iter = input_data.begin();
-  while (input_iter != input_data.end()) {
-    *output_iter = RE2::FullMatch(*input_iter, re_);
-    input_iter++;
-    output_iter++;
+
+  const auto num_strings = static_cast<std::ptrdiff_t>(input_data.size());
+  if (num_strings == 0) {
+    return Status::OK();
   }
+
+  // RE2 matching is thread safe on a const RE2 object, so strings are sharded across the intra-op thread pool.
+  // The cost estimate scales with the average string length as matching is linear in the input length.
+  size_t total_length = 0;
+  for (const auto& str : input_data) {
+    total_length += str.size();
+  }
+  const double average_length = static_cast<double>(total_length) / static_cast<double>(num_strings);
+  const TensorOpCost cost{average_length + sizeof(std::string), static_cast<double>(sizeof(bool)),
+                          average_length * 8.0 + 16.0};
+
+  concurrency::ThreadPool::TryParallelFor(
+      context->GetOperatorThreadPool(), num_strings, cost,
+      [this, &input_data, &output_data](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t i = first; i < last; ++i) {
+          output_data[i] = IsMatch(input_data[i]);
+        }
+      });
+
   return Status::OK();
 }
 
@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <string>
+
 #include "core/framework/op_kernel.h"
 #include "re2/re2.h"
 
@@ -14,7 +16,14 @@ class RegexFullMatch final : public OpKernel {
   Status Compute(OpKernelContext* context) const override;
 
  private:
+  bool IsMatch(const std::string& str) const;
+
   RE2 re_;
+  // Lexicographic range [min_match_, max_match_] that contains every string fully matching re_.
+  // Used to reject inputs without running the regex engine. Only valid if has_match_range_ is true.
+  std::string min_match_;
+  std::string max_match_;
+  bool has_match_range_{false};
 };
 
 }  // namespace onnxruntime
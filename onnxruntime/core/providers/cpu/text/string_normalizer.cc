@@ -12,7 +12,9 @@
 #include <locale.h>
 #endif  // _MSC_VER
 
+#include <algorithm>
 #include <codecvt>
+#include <cstring>
 #include <locale>
 #include <functional>
 
@@ -436,6 +438,60 @@ const std::string default_locale("en_US.UTF-8");  // All non-MS and not Apple
 #endif
 
 #endif  // _MSC_VER
+
+// Returns true if every byte of the string is 7-bit ASCII.
+// Processes 8 bytes per iteration and tests the high bits once at the end.
+inline bool IsAscii(const std::string& str) {
+  const char* p = str.data();
+  const char* const end = p + str.size();
+  uint64_t acc = 0;
+  for (; end - p >= 8; p += 8) {
+    uint64_t word;
+    memcpy(&word, p, sizeof(word));
+    acc |= word;
+  }
+  for (; p < end; ++p) {
+    acc |= static_cast<unsigned char>(*p);
+  }
+  return (acc & 0x8080808080808080ULL) == 0;
+}
+
+// Changes the case of an ASCII only string. The loop is branch free
+// so that the compiler can vectorize it.
+inline void ChangeCaseAscii(StringNormalizer::CaseAction caseaction,
+                            const std::string& src, std::string& dest) {
+  assert(caseaction != StringNormalizer::NONE);
+  dest.resize(src.size());
+  const char first = (caseaction == StringNormalizer::LOWER) ? 'A' : 'a';
+  const int delta = (caseaction == StringNormalizer::LOWER) ? ('a' - 'A') : ('A' - 'a');
+  const auto* s = reinterpret_cast<const unsigned char*>(src.data());
+  auto* d = reinterpret_cast<unsigned char*>(dest.data());
+  for (size_t i = 0, lim = src.size(); i < lim; ++i) {
+    const unsigned char ch = s[i];
+    const bool in_range = static_cast<unsigned char>(ch - first) < 26;
+    d[i] = static_cast<unsigned char>(ch + (in_range ? delta : 0));
+  }
+}
+
+// Verifies that the locale case mapping of the ASCII range matches the "C" locale,
+// so ChangeCaseAscii() produces the same results as Locale::ChangeCase().
+// This is not the case for some locales, for example Turkish maps 'I' to a dotless i.
+bool LocaleHasAsciiCaseMapping(const Locale& locale) {
+  std::wstring lower;
+  std::wstring upper;
+  std::wstring expected_lower;
+  std::wstring expected_upper;
+  for (wchar_t ch = 1; ch < 0x80; ++ch) {
+    lower.push_back(ch);
+    upper.push_back(ch);
+    expected_lower.push_back((ch >= L'A' && ch <= L'Z') ? static_cast<wchar_t>(ch + (L'a' - L'A')) : ch);
+    expected_upper.push_back((ch >= L'a' && ch <= L'z') ? static_cast<wchar_t>(ch - (L'a' - L'A')) : ch);
+  }
+  locale.ChangeCase(StringNormalizer::LOWER, lower);
+  locale.ChangeCase(StringNormalizer::UPPER, upper);
+  return lower == expected_lower && upper == expected_upper;
+}
+
 }  // namespace string_normalizer
 
 using namespace string_normalizer;
@@ -461,6 +517,11 @@ StringNormalizer::StringNormalizer(const OpKernelInfo& info) : OpKernel(info) {
 
   locale_name_ = info.GetAttrOrDefault("locale", default_locale);
 
+  if (case_change_action_ != NONE || !is_case_sensitive_) {
+    Locale locale(locale_name_);
+    ascii_fast_path_ = LocaleHasAsciiCaseMapping(locale);
+  }
+
   std::vector<std::string> stop_words = info.GetAttrsOrDefault<std::string>("stopwords");
   if (is_case_sensitive_) {
     stopwords_.reserve(stop_words.size());
@@ -474,6 +535,11 @@ StringNormalizer::StringNormalizer(const OpKernelInfo& info) : OpKernel(info) {
     for (std::string& s : stop_words) {
       std::wstring wstr = converter.from_bytes(s);
       locale.ChangeCase(compare_caseaction_, wstr);
+      // A case-folded ASCII input can only ever match a case-folded stopword
+      // that is ASCII too, so keep a narrow copy of those for the fast path.
+      if (std::all_of(wstr.cbegin(), wstr.cend(), [](wchar_t ch) { return static_cast<uint32_t>(ch) < 0x80; })) {
+        ascii_wstopwords_.insert(std::string(wstr.cbegin(), wstr.cend()));
+      }
       wstopwords_.insert(std::move(wstr));
     }
   }
@@ -527,8 +593,12 @@ Status StringNormalizer::Compute(OpKernelContext* ctx) const {
   Utf8Converter converter;
 
   // Compute the largest widestring buffer needed.
+  // ASCII strings take the fast path and do not need the buffer.
   size_t max_wide_buffer_len = 0;
   for (const auto& s : input_span) {
+    if (ascii_fast_path_ && IsAscii(s)) {
+      continue;
+    }
     size_t wchars = 0;
     // Checks for invalid UTF-8 characters on Windows
     ORT_RETURN_IF_ERROR(converter.ComputeRequiredSizeToWideChar(s, wchars));
@@ -538,21 +608,29 @@ Status StringNormalizer::Compute(OpKernelContext* ctx) const {
   // Reuse reserved space
   std::wstring wchar_buffer;
   wchar_buffer.reserve(max_wide_buffer_len);
+  std::string ascii_buffer;
+
+  // Change case of a single string writing the result to dest
+  auto change_case = [&](const std::string& s, std::string& dest) {
+    if (ascii_fast_path_ && IsAscii(s)) {
+      ChangeCaseAscii(case_change_action_, s, dest);
+      return Status::OK();
+    }
+    wchar_buffer.resize(max_wide_buffer_len);
+    ORT_RETURN_IF_ERROR(converter.ConvertToWideChar(s, wchar_buffer));
+    locale.ChangeCase(case_change_action_, wchar_buffer);
+
+    size_t utf8_buffer_len = converter.ComputeRequiredSizeToUtf8(wchar_buffer);
+    dest.resize(utf8_buffer_len);
+    return converter.ConvertToUtf8(wchar_buffer, dest);
+  };
 
   // Output everything and change case as required
   auto output_no_filtering = [&](const TensorShape& output_shape) {
     auto output_tensor = ctx->Output(0, output_shape);
     auto const output_data = output_tensor->MutableData<std::string>();
     for (size_t i = 0, lim = input_span.size(); i < lim; ++i) {
-      const std::string& s = input_span[i];
-      wchar_buffer.resize(max_wide_buffer_len);
-      ORT_RETURN_IF_ERROR(converter.ConvertToWideChar(s, wchar_buffer));
-      locale.ChangeCase(case_change_action_, wchar_buffer);
-
-      auto& dest = output_data[i];
-      size_t utf8_buffer_len = converter.ComputeRequiredSizeToUtf8(wchar_buffer);
-      dest.resize(utf8_buffer_len);
-      ORT_RETURN_IF_ERROR(converter.ConvertToUtf8(wchar_buffer, dest));
+      ORT_RETURN_IF_ERROR(change_case(input_span[i], output_data[i]));
     }
     return Status::OK();
   };
@@ -563,14 +641,7 @@ Status StringNormalizer::Compute(OpKernelContext* ctx) const {
     for (size_t i : filtered_indices) {
       const std::string& s = input_span[i];
       if (case_change_action_ != NONE) {
-        wchar_buffer.resize(max_wide_buffer_len);
-        ORT_RETURN_IF_ERROR(converter.ConvertToWideChar(s, wchar_buffer));
-        locale.ChangeCase(case_change_action_, wchar_buffer);
-
-        auto& dest = *output_data++;
-        size_t utf8_buffer_len = converter.ComputeRequiredSizeToUtf8(wchar_buffer);
-        dest.resize(utf8_buffer_len);
-        ORT_RETURN_IF_ERROR(converter.ConvertToUtf8(wchar_buffer, dest));
+        ORT_RETURN_IF_ERROR(change_case(s, *output_data++));
       } else {
         *output_data++ = s;
       }
@@ -616,10 +687,17 @@ Status StringNormalizer::Compute(OpKernelContext* ctx) const {
       filtered_strings_indices.reserve(input_span.size());
       for (size_t i = 0, lim = input_span.size(); i < lim; ++i) {
         const std::string& s = input_span[i];
-        wchar_buffer.resize(max_wide_buffer_len);
-        ORT_RETURN_IF_ERROR(converter.ConvertToWideChar(s, wchar_buffer));
-        locale.ChangeCase(compare_caseaction_, wchar_buffer);
-        if (wstopwords_.count(wchar_buffer) == 0) {
+        bool is_stopword = false;
+        if (ascii_fast_path_ && IsAscii(s)) {
+          ChangeCaseAscii(compare_caseaction_, s, ascii_buffer);
+          is_stopword = ascii_wstopwords_.count(ascii_buffer) != 0;
+        } else {
+          wchar_buffer.resize(max_wide_buffer_len);
+          ORT_RETURN_IF_ERROR(converter.ConvertToWideChar(s, wchar_buffer));
+          locale.ChangeCase(compare_caseaction_, wchar_buffer);
+          is_stopword = wstopwords_.count(wchar_buffer) != 0;
+        }
+        if (!is_stopword) {
           filtered_strings_indices.push_back(i);
         }
       }
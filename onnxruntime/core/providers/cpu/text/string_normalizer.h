@@ -34,6 +34,12 @@ class StringNormalizer : public OpKernel {
   // Either if these are populated but not both
   InlinedHashSet<std::string> stopwords_;
   InlinedHashSet<std::wstring> wstopwords_;
+  // Case-folded stopwords that are pure ASCII, used to filter ASCII input
+  // without a round trip through wchar_t when is_case_sensitive_ is false.
+  InlinedHashSet<std::string> ascii_wstopwords_;
+  // True if the locale maps the ASCII range exactly as the "C" locale does.
+  // In that case ASCII-only strings bypass the UTF-8 <-> wchar_t conversion.
+  bool ascii_fast_path_{false};
 };
 
 }  // namespace onnxruntime
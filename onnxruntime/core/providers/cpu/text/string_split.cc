@@ -69,14 +69,17 @@ Status StringSplit::Compute(OpKernelContext* context) const {
   auto num_tokens_data = context->Output(1, input->Shape())->template MutableDataAsSpan<int64_t>();
   auto num_tokens_iter = num_tokens_data.begin();
 
-  InlinedVector<InlinedVector<std::string_view>> input_slices;
-  input_slices.reserve(input_data.size());
+  // Substrings of all inputs are kept in a single flat buffer of views into the input strings.
+  // The substrings of the i-th input occupy a contiguous range whose length is num_tokens_data[i].
+  // This avoids a separate allocation per input string.
+  InlinedVector<std::string_view> substrs;
+  substrs.reserve(input_data.size());
   size_t last_dim = 0;
 
   for (const auto& s : input_data) {
-    auto& substrs = input_slices.emplace_back();
+    const size_t first = substrs.size();
     ComputeSubstrings(s, delimiter_, maxsplit_, substrs);
-    auto substr_count = substrs.size();
+    auto substr_count = substrs.size() - first;
     last_dim = std::max(last_dim, substr_count);
     *num_tokens_iter = static_cast<int64_t>(substr_count);
     ++num_tokens_iter;
@@ -87,9 +90,13 @@ Status StringSplit::Compute(OpKernelContext* context) const {
   splits_shape.push_back(last_dim);
 
   auto splits_data = context->Output(0, splits_shape)->template MutableDataAsSpan<std::string>();
-  auto slices_iter = input_slices.begin();
-  for (auto output_splits_iter = splits_data.begin(); output_splits_iter != splits_data.end(); output_splits_iter += last_dim, ++slices_iter) {
-    std::copy(slices_iter->begin(), slices_iter->end(), output_splits_iter);
+  auto substrs_iter = substrs.cbegin();
+  auto num_tokens_count_iter = num_tokens_data.begin();
+  for (auto output_splits_iter = splits_data.begin(); output_splits_iter != splits_data.end();
+       output_splits_iter += last_dim, ++num_tokens_count_iter) {
+    const auto count = static_cast<ptrdiff_t>(*num_tokens_count_iter);
+    std::copy(substrs_iter, substrs_iter + count, output_splits_iter);
+    substrs_iter += count;
   }
 
   return Status::OK();
@@ -45,7 +45,8 @@ Status Transpose(const gsl::span<const size_t>& permutation, const Tensor& input
 template <typename T>
 Status MatMul(const T* input_1_data, const T* input_2_data, T* output_data,
               size_t left_stride, size_t right_stride, size_t output_stride,
-              size_t num_batches, size_t M, size_t K, size_t N, concurrency::ThreadPool* /*tp*/,
+              size_t num_batches, size_t M, size_t K, size_t N,
+              bool transpose_input_1, bool transpose_input_2, concurrency::ThreadPool* /*tp*/,
               void* einsum_rocm_assets) {
   typedef typename rocm::ToHipType<T>::MappedType HipT;
 
@@ -55,11 +56,12 @@ Status MatMul(const T* input_1_data, const T* input_2_data, T* output_data,
           static_cast<EinsumRocmAssets*>(einsum_rocm_assets)->rocm_ep_->GetTuningContext()),
       static_cast<EinsumRocmAssets*>(einsum_rocm_assets)->ort_stream_,
       static_cast<EinsumRocmAssets*>(einsum_rocm_assets)->hipblas_handle_,
-      blas::BlasOp::NonTrans, blas::BlasOp::NonTrans,
+      transpose_input_2 ? blas::BlasOp::Trans : blas::BlasOp::NonTrans,
+      transpose_input_1 ? blas::BlasOp::Trans : blas::BlasOp::NonTrans,
       N, M, K,
       /*alpha=*/1.0f,
-      reinterpret_cast<const HipT*>(input_2_data), N, right_stride,
-      reinterpret_cast<const HipT*>(input_1_data), K, left_stride,
+      reinterpret_cast<const HipT*>(input_2_data), transpose_input_2 ? K : N, right_stride,
+      reinterpret_cast<const HipT*>(input_1_data), transpose_input_1 ? M : K, left_stride,
       /*beta=*/0.0f,
       reinterpret_cast<HipT*>(output_data), N, output_stride,
       num_batches);
@@ -141,7 +143,8 @@ std::unique_ptr<Tensor> Diagonal(const Tensor& input, int64_t dim_1, int64_t dim
 template Status DeviceHelpers::RocmDeviceHelpers::MatMul<float>(
     const float* input_1_data, const float* input_2_data, float* output_data,
     size_t left_stride, size_t right_stride, size_t output_stride,
-    size_t num_batches, size_t M, size_t K, size_t N, concurrency::ThreadPool* tp,
+    size_t num_batches, size_t M, size_t K, size_t N,
+    bool transpose_input_1, bool transpose_input_2, concurrency::ThreadPool* tp,
     void* einsum_rocm_assets);
 
 template std::unique_ptr<Tensor> DeviceHelpers::RocmDeviceHelpers::ReduceSum<float>(
@@ -154,7 +157,8 @@ template std::unique_ptr<Tensor> DeviceHelpers::RocmDeviceHelpers::ReduceSum<flo
 template Status DeviceHelpers::RocmDeviceHelpers::MatMul<MLFloat16>(
     const MLFloat16* input_1_data, const MLFloat16* input_2_data, MLFloat16* output_data,
     size_t left_stride, size_t right_stride, size_t output_stride,
-    size_t num_batches, size_t M, size_t K, size_t N, concurrency::ThreadPool* tp,
+    size_t num_batches, size_t M, size_t K, size_t N,
+    bool transpose_input_1, bool transpose_input_2, concurrency::ThreadPool* tp,
     void* einsum_rocm_assets);
 
 template std::unique_ptr<Tensor> DeviceHelpers::RocmDeviceHelpers::ReduceSum<MLFloat16>(
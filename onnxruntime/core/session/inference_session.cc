@@ -4,6 +4,9 @@
 #include "core/graph/onnx_protobuf.h"
 #include "core/session/inference_session.h"
 
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
 #include <memory>
 #include <sstream>
 #include <list>
@@ -11,6 +14,7 @@
 #include <thread>
 #include <queue>
 
+#include "core/common/cpuid_info.h"
 #include "core/common/denormal.h"
 #include "core/common/logging/isink.h"
 #include "core/common/logging/logging.h"
@@ -28,6 +32,7 @@
 #include "core/framework/kernel_registry.h"
 #include "core/framework/kernel_type_str_resolver.h"
 #include "core/framework/kernel_type_str_resolver_utils.h"
+#include "core/framework/murmurhash3.h"
 #include "core/framework/mldata_type_utils.h"
 #include "core/framework/TensorSeq.h"
 #include "core/framework/tensorprotoutils.h"
@@ -246,6 +251,70 @@ Status GetMinimalBuildOptimizationHandling(
                          "Invalid value for ", kOrtSessionOptionsConfigMinimalBuildOptimizations, ": ", config_value);
 };
 
+// Computes the file name used for the optimized model snapshot of `model_uri`.
+// The key covers the model bytes, the session options that affect graph optimization and the CPU ISA, as the
+// optimized graph may contain hardware specific nodes (e.g. NCHWc). Execution providers are not part of the key.
+Status GetOptimizedModelCacheKey(const PathString& model_uri, const SessionOptions& session_options,
+                                 std::string& cache_key) {
+  std::ifstream model_file(std::filesystem::path(model_uri), std::ios::binary);
+  ORT_RETURN_IF_NOT(model_file, "Failed to open model file: ", ToUTF8String(model_uri));
+
+  // the model is hashed in fixed size chunks so that large models are not read into memory at once.
+  // the fingerprint holds the digests of the chunks followed by the options.
+  constexpr size_t kChunkSize = 1 << 20;
+  std::vector<char> chunk(kChunkSize);
+  std::string fingerprint;
+  uint64_t model_size = 0;
+  while (model_file) {
+    model_file.read(chunk.data(), static_cast<std::streamsize>(kChunkSize));
+    const auto bytes_read = static_cast<size_t>(model_file.gcount());
+    if (bytes_read == 0) {
+      break;
+    }
+
+    uint32_t chunk_hash[4] = {0, 0, 0, 0};
+    MurmurHash3::x86_128(chunk.data(), bytes_read, 0, chunk_hash);
+    fingerprint.append(reinterpret_cast<const char*>(chunk_hash), sizeof(chunk_hash));
+    model_size += bytes_read;
+  }
+  ORT_RETURN_IF(model_file.bad(), "Failed to read model file: ", ToUTF8String(model_uri));
+
+  std::ostringstream options;
+  options << "|size:" << model_size
+          << "|ort:" << ORT_VERSION
+          << "|level:" << static_cast<int>(session_options.graph_optimization_level);
+
+  std::vector<std::pair<std::string, std::string>> configurations(
+      session_options.config_options.configurations.begin(), session_options.config_options.configurations.end());
+  std::sort(configurations.begin(), configurations.end());
+  for (const auto& [config_key, config_value] : configurations) {
+    options << "|" << config_key << "=" << config_value;
+  }
+
+  for (const auto& free_dim : session_options.free_dimension_overrides) {
+    options << "|dim:" << free_dim.dim_identifier << ":" << static_cast<int>(free_dim.dim_identifier_type)
+            << "=" << free_dim.dim_value;
+  }
+
+  const auto& cpu_info = CPUIDInfo::GetCPUIDInfo();
+  options << "|isa:" << cpu_info.HasAVX() << cpu_info.HasAVX2() << cpu_info.HasAVX512f()
+          << cpu_info.HasAVX512Skylake() << cpu_info.HasAVX512_BF16() << cpu_info.HasAMX_BF16()
+          << cpu_info.HasF16C() << cpu_info.HasArmNeonDot() << cpu_info.HasArmNeon_I8MM()
+          << cpu_info.HasArmSVE_I8MM() << cpu_info.HasArmNeon_BF16();
+  fingerprint += options.str();
+
+  uint32_t hash[4] = {0, 0, 0, 0};
+  MurmurHash3::x86_128(fingerprint.data(), fingerprint.size(), 0, hash);
+
+  std::ostringstream key;
+  key << std::hex << std::setfill('0');
+  for (const auto h : hash) {
+    key << std::setw(8) << h;
+  }
+  cache_key = key.str();
+  return Status::OK();
+}
+
 #endif  // !defined(ORT_MINIMAL_BUILD)
 
 }  // namespace
@@ -673,6 +742,15 @@ InferenceSession::InferenceSession(const SessionOptions& session_options, const
 #endif  // !defined(ORT_MINIMAL_BUILD)
 
 InferenceSession::~InferenceSession() {
+#if !defined(ORT_MINIMAL_BUILD)
+  if (shape_specialization_ != nullptr) {
+    // the specialized session uses the thread pools and initializers of this session. cancel a build in progress
+    // and wait for it to stop.
+    *shape_specialization_->cancel_build = true;
+    shape_specialization_.reset();
+  }
+#endif
+
   if (session_options_.enable_profiling) {
     ORT_TRY {
       EndProfiling();
@@ -893,6 +971,278 @@ common::Status InferenceSession::SaveToOrtFormat(const std::filesystem::path& fi
   return Status::OK();
 }
 
+const char* InferenceSession::GetOptimizedModelCacheUnsupportedReason() const {
+  if (!session_options_.initializers_to_share_map.empty()) {
+    return "initializers were added to the session options";
+  }
+
+#if !defined(DISABLE_EXTERNAL_INITIALIZERS)
+  if (!session_options_.external_initializers.empty() || !session_options_.external_initializer_files_mmap.empty()) {
+    return "external initializers were added to the session options";
+  }
+#endif
+
+  if (session_options_.custom_op_libs != nullptr || !custom_registries_.empty() || HasLocalSchema()) {
+    return "custom ops are registered";
+  }
+
+  return nullptr;
+}
+
+common::Status InferenceSession::SaveOptimizedModelSnapshot() const {
+  ORT_RETURN_IF(session_state_->GetFuncMgr().NumFuncs() > 0,
+                "The model contains nodes compiled by an execution provider.");
+
+  // write to a process specific file and rename it so that concurrent sessions never observe a partial snapshot
+  std::filesystem::path cache_path(optimized_model_cache_path_);
+  std::filesystem::path temp_path(cache_path);
+  temp_path += ToPathString("." + std::to_string(Env::Default().GetSelfPid()) + ".tmp");
+
+  std::error_code ec;
+  std::filesystem::create_directories(cache_path.parent_path(), ec);
+  ORT_RETURN_IF_ERROR(SaveToOrtFormat(temp_path));
+
+  std::filesystem::rename(temp_path, cache_path, ec);
+  if (ec) {
+    std::filesystem::remove(temp_path, ec);
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Failed to rename ", ToUTF8String(temp_path.native()), " to ",
+                           ToUTF8String(cache_path.native()));
+  }
+
+  return Status::OK();
+}
+
+void InferenceSession::InitShapeSpecialization() {
+  const std::string runs_str =
+      session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigShapeSpecializationAfterRuns, "0");
+  int64_t runs_required = 0;
+  if (!TryParseStringWithClassicLocale<int64_t>(runs_str, runs_required)) {
+    LOGS(*session_logger_, WARNING) << "Ignoring invalid value for "
+                                    << kOrtSessionOptionsConfigShapeSpecializationAfterRuns << ": " << runs_str;
+    return;
+  }
+
+  if (runs_required <= 0) {
+    return;
+  }
+
+  // the specialized session re-creates the session from the model file, so everything else given to this session
+  // has to be reproducible from the session options
+  std::error_code ec;
+  if (model_location_.empty() || !std::filesystem::exists(model_location_, ec) ||
+      fbs::utils::IsOrtFormatModel(model_location_) || HasLocalSchema() ||
+      execution_providers_.NumProviders() != 1 || execution_providers_.Get(kCpuExecutionProvider) == nullptr) {
+    LOGS(*session_logger_, WARNING) << "Shape specialization requires an ONNX model file, the CPU EP only and "
+                                    << "no custom ops. It is disabled for this session.";
+    return;
+  }
+
+  const bool has_symbolic_dims = std::any_of(
+      model_->MainGraph().GetInputs().begin(), model_->MainGraph().GetInputs().end(), [](const NodeArg* input) {
+        const auto* shape = input->Shape();
+        return shape != nullptr && std::any_of(shape->dim().begin(), shape->dim().end(),
+                                               [](const auto& dim) { return !dim.has_dim_value(); });
+      });
+  if (!has_symbolic_dims) {
+    return;
+  }
+
+  shape_specialization_ = std::make_unique<ShapeSpecialization>();
+  shape_specialization_->runs_required = runs_required;
+}
+
+namespace {
+bool FeedShapesMatch(const InlinedHashMap<std::string, TensorShape>& feed_shapes,
+                     gsl::span<const std::string> feed_names, gsl::span<const OrtValue> feeds) {
+  if (feed_shapes.size() != feed_names.size()) {
+    return false;
+  }
+
+  for (size_t i = 0; i < feed_names.size(); ++i) {
+    auto entry = feed_shapes.find(feed_names[i]);
+    if (entry == feed_shapes.end() || !feeds[i].IsTensor() || feeds[i].Get<Tensor>().Shape() != entry->second) {
+      return false;
+    }
+  }
+
+  return true;
+}
+}  // namespace
+
+std::shared_ptr<InferenceSession> InferenceSession::GetShapeSpecializedSession(
+    gsl::span<const std::string> feed_names, gsl::span<const OrtValue> feeds) {
+  if (shape_specialization_ == nullptr) {
+    return nullptr;
+  }
+
+  std::shared_ptr<InferenceSession> session;
+  {
+    std::lock_guard<std::mutex> lock(shape_specialization_->mutex);
+    session = shape_specialization_->session;
+  }
+
+  // feed_shapes is immutable once the session is set
+  if (session == nullptr || !FeedShapesMatch(shape_specialization_->feed_shapes, feed_names, feeds)) {
+    return nullptr;
+  }
+
+  return session;
+}
+
+void InferenceSession::RecordFeedShapesForSpecialization(gsl::span<const std::string> feed_names,
+                                                         gsl::span<const OrtValue> feeds) {
+  if (shape_specialization_ == nullptr) {
+    return;
+  }
+
+  auto& state = *shape_specialization_;
+  {
+    std::lock_guard<std::mutex> lock(state.mutex);
+    if (state.runs_observed < 0) {
+      return;
+    }
+
+    if (FeedShapesMatch(state.feed_shapes, feed_names, feeds)) {
+      ++state.runs_observed;
+    } else {
+      state.feed_shapes.clear();
+      for (size_t i = 0; i < feed_names.size(); ++i) {
+        if (!feeds[i].IsTensor()) {
+          // non-tensor inputs have no shape to specialize for
+          state.runs_observed = -1;
+          return;
+        }
+
+        state.feed_shapes.insert_or_assign(feed_names[i], feeds[i].Get<Tensor>().Shape());
+      }
+
+      state.runs_observed = 1;
+    }
+
+    if (state.runs_observed < state.runs_required) {
+      return;
+    }
+
+    // this run starts the build. later runs neither record nor wait for it.
+    state.runs_observed = -1;
+    state.building = true;
+  }
+
+  // initializing the specialized session optimizes the whole model again, so it is not done on the thread of a run
+  OrtThreadPoolParams to;
+  to.thread_pool_size = 2;  // a single worker thread
+  to.allow_spinning = false;
+  to.name = ORT_TSTR("shape-specialization");
+  to.custom_create_thread_fn = session_options_.custom_create_thread_fn;
+  to.custom_thread_creation_options = session_options_.custom_thread_creation_options;
+  to.custom_join_thread_fn = session_options_.custom_join_thread_fn;
+  state.build_thread = concurrency::CreateThreadPool(&Env::Default(), to, concurrency::ThreadPoolType::INTER_OP);
+  concurrency::ThreadPool::Schedule(state.build_thread.get(), [this]() { BuildShapeSpecializedSession(); });
+}
+
+void InferenceSession::BuildShapeSpecializedSession() {
+  auto& state = *shape_specialization_;
+
+  // feed_shapes is no longer modified so it can be read without the lock
+  std::shared_ptr<InferenceSession> session;
+  auto status = CreateShapeSpecializedSession(state.feed_shapes, session);
+  if (!status.IsOK()) {
+    if (!*state.cancel_build) {
+      LOGS(*session_logger_, WARNING) << "Failed to create the shape specialized session: " << status.ErrorMessage();
+    }
+  } else {
+    LOGS(*session_logger_, INFO) << "Runs with the observed input shapes now use the shape specialized session.";
+  }
+
+  std::lock_guard<std::mutex> lock(state.mutex);
+  state.session = std::move(session);
+  state.building = false;
+  state.build_finished.notify_all();
+}
+
+Status InferenceSession::CreateShapeSpecializedSession(const InlinedHashMap<std::string, TensorShape>& feed_shapes,
+                                                       std::shared_ptr<InferenceSession>& session) const {
+  SessionOptions options = session_options_;
+  options.config_options.configurations.erase(kOrtSessionOptionsConfigShapeSpecializationAfterRuns);
+  options.config_options.configurations.erase(kOrtSessionOptionsConfigOptimizedModelCacheDir);
+  options.optimized_model_filepath.clear();
+  // the copied flag is shared with the options of this session. the build is cancelled with a flag of its own.
+  options.load_cancellation_flag = shape_specialization_->cancel_build;
+
+  InlinedHashMap<std::string, int64_t> dim_values;
+  for (const auto* input : model_->MainGraph().GetInputs()) {
+    auto entry = feed_shapes.find(input->Name());
+    const auto* shape = input->Shape();
+    if (entry == feed_shapes.end() || shape == nullptr) {
+      continue;
+    }
+
+    const TensorShape& feed_shape = entry->second;
+    ORT_RETURN_IF_NOT(static_cast<size_t>(shape->dim_size()) == feed_shape.NumDimensions(),
+                      "Unexpected rank of input ", input->Name());
+
+    for (int i = 0; i < shape->dim_size(); ++i) {
+      const auto& dim = shape->dim(i);
+      if (!dim.has_dim_param()) {
+        // unnamed dynamic dimensions cannot be overridden and stay dynamic
+        continue;
+      }
+
+      auto [it, inserted] = dim_values.insert({dim.dim_param(), feed_shape[i]});
+      ORT_RETURN_IF_NOT(it->second == feed_shape[i], "Inconsistent values observed for the dimension ",
+                        dim.dim_param());
+      if (inserted) {
+        options.free_dimension_overrides.push_back({dim.dim_param(), FreeDimensionOverrideType::Name,
+                                                    feed_shape[i]});
+      }
+    }
+  }
+
+  ORT_RETURN_IF(dim_values.empty(), "The model inputs have no named symbolic dimensions.");
+
+  // node level events of the forwarded runs go to a separate profile. Run() records them as runs of this session.
+  options.profile_file_prefix += ORT_TSTR("shape_specialized_");
+
+  // the specialized session runs on the thread pools of this session instead of creating its own
+  auto specialized_session = std::make_shared<InferenceSession>(options, environment_, GetIntraOpThreadPoolToUse(),
+                                                                GetInterOpThreadPoolToUse());
+  ORT_RETURN_IF_ERROR(specialized_session->Load(model_location_));
+
+  // initializers the optimizers of both sessions leave unchanged are not allocated again
+  specialized_session->initializers_source_session_ = this;
+  if (prepacked_weights_container_ != nullptr) {
+    ORT_RETURN_IF_ERROR(specialized_session->AddPrePackedWeightsContainer(prepacked_weights_container_));
+  }
+  ORT_RETURN_IF_ERROR(specialized_session->Initialize());
+
+  session = std::move(specialized_session);
+  return Status::OK();
+}
+
+void InferenceSession::ShareUnchangedInitializers(const InferenceSession& source_session) {
+  // both sessions loaded the same model file, so an initializer that neither session's transformers replaced holds
+  // the same data in both. the values are owned by the session state of source_session, which outlives this session.
+  const auto& ort_value_name_idx_map = source_session.session_state_->GetOrtValueNameIdxMap();
+  const auto& source_initializers = source_session.session_state_->GetInitializedTensors();
+  for (const auto& name : unchanged_initializers_) {
+    if (source_session.unchanged_initializers_.count(name) == 0) {
+      continue;
+    }
+
+    OrtValueIndex ort_value_idx;
+    if (!ort_value_name_idx_map.GetIdx(name, ort_value_idx).IsOK()) {
+      continue;
+    }
+
+    auto entry = source_initializers.find(ort_value_idx);
+    if (entry == source_initializers.end() || !entry->second.IsTensor()) {
+      continue;
+    }
+
+    session_options_.initializers_to_share_map.emplace(name, &entry->second);
+  }
+}
+
 common::Status InferenceSession::LoadWithLoader(std::function<common::Status(std::shared_ptr<Model>&)> loader,
                                                 const std::string& event_name) {
   Status status = Status::OK();
@@ -992,6 +1342,31 @@ common::Status InferenceSession::Load(const PathString& model_uri) {
                            "Invoke Load().");
   }
 
+  const std::string cache_dir =
+      session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigOptimizedModelCacheDir, "");
+  const char* cache_unsupported_reason =
+      cache_dir.empty() ? nullptr : GetOptimizedModelCacheUnsupportedReason();
+  if (cache_unsupported_reason != nullptr) {
+    LOGS(*session_logger_, INFO) << "Optimized model cache is not used as " << cache_unsupported_reason << ".";
+  } else if (!cache_dir.empty() && session_options_.optimized_model_filepath.empty()) {
+    std::string cache_key;
+    ORT_RETURN_IF_ERROR(GetOptimizedModelCacheKey(model_uri, session_options_, cache_key));
+    const std::filesystem::path cache_path =
+        std::filesystem::path(ToPathString(cache_dir)) / ToPathString(cache_key + ".ort");
+
+    std::error_code ec;
+    if (std::filesystem::is_regular_file(cache_path, ec)) {
+      LOGS(*session_logger_, INFO) << "Loading optimized model snapshot " << ToUTF8String(cache_path.native())
+                                   << " for " << ToUTF8String(model_uri);
+      ORT_RETURN_IF_ERROR(LoadOrtModel(cache_path.native()));
+      loaded_optimized_model_snapshot_ = true;
+      return Status::OK();
+    }
+
+    // the snapshot is written by Initialize once the session state has been finalized
+    optimized_model_cache_path_ = cache_path.native();
+  }
+
   return LoadOnnxModel(model_uri);
 #else
   return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "ONNX format model is not supported in this build.");
@@ -2027,11 +2402,33 @@ common::Status InferenceSession::Initialize() {
       }
 #endif
 
+      // a shape specialized session shares the initializers that the transformers of neither session replaced
+      const bool collect_unchanged_initializers =
+          initializers_source_session_ != nullptr ||
+          session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigShapeSpecializationAfterRuns,
+                                                             "0") != "0";
+      InlinedHashSet<std::string> loaded_initializers;
+      if (collect_unchanged_initializers) {
+        for (const auto& [name, initializer] : graph.GetAllInitializedTensors()) {
+          loaded_initializers.insert(name);
+        }
+      }
+
       // apply any transformations to the main graph and any subgraphs
       ORT_RETURN_IF_ERROR_SESSIONID_(TransformGraph(graph, saving_ort_format));
 
       // now that all the transforms are done, call Resolve on the main graph. this will recurse into the subgraphs.
       ORT_RETURN_IF_ERROR_SESSIONID_(graph.Resolve());
+
+      for (const auto& name : loaded_initializers) {
+        if (graph.IsInitializedTensor(name) && !graph.IsInitializerReplaced(name)) {
+          unchanged_initializers_.insert(name);
+        }
+      }
+
+      if (initializers_source_session_ != nullptr) {
+        ShareUnchangedInitializers(*initializers_source_session_);
+      }
       if (session_options_.IsLoadCancellationFlagSet()) {
         return ORT_MAKE_STATUS(ONNXRUNTIME, MODEL_LOAD_CANCELED,
                                "Session initialization canceled due to user request.");
@@ -2198,10 +2595,29 @@ common::Status InferenceSession::Initialize() {
 #endif  // !defined(ORT_MINIMAL_BUILD) || defined(ORT_EXTENDED_MINIMAL_BUILD)
     }
 
+#if !defined(ORT_MINIMAL_BUILD)
+    // custom ops may be registered between Load and Initialize
+    const char* cache_unsupported_reason = GetOptimizedModelCacheUnsupportedReason();
+    if (loaded_optimized_model_snapshot_ && cache_unsupported_reason != nullptr) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "The model was loaded from the optimized model cache but ",
+                             cache_unsupported_reason, " after loading it.");
+    }
+
+    // a pre-packed weights container is only added after Load. its entries are keyed by a hash of the packed data,
+    // so a loaded snapshot stays valid, but no snapshot is written by a session whose weights come from one.
+    if (cache_unsupported_reason != nullptr || prepacked_weights_container_ != nullptr) {
+      optimized_model_cache_path_.clear();
+    }
+
+    const bool caching_model = !optimized_model_cache_path_.empty();
+#else
+    constexpr bool caching_model = false;
+#endif
+
     ORT_RETURN_IF_ERROR_SESSIONID_(
         session_state_->FinalizeSessionState(model_location_, kernel_registry_manager_,
                                              // need to keep the initializers if saving the optimized model
-                                             !saving_model,
+                                             !(saving_model || caching_model),
                                              saving_ort_format));
 
 #if !defined(ORT_MINIMAL_BUILD)
@@ -2244,6 +2660,17 @@ common::Status InferenceSession::Initialize() {
       }
     }
 
+    if (caching_model) {
+      // a failure to write the snapshot only costs the next session its warm start, so it is not an error
+      auto status = SaveOptimizedModelSnapshot();
+      if (!status.IsOK()) {
+        LOGS(*session_logger_, WARNING) << "Optimized model snapshot was not saved: " << status.ErrorMessage();
+      }
+      optimized_model_cache_path_.clear();
+    }
+
+    InitShapeSpecialization();
+
     std::vector<TuningResults> tuning_results;
     bool found_tuning_results = false;
     ORT_RETURN_IF_ERROR_SESSIONID_(inference_session_utils::ParseTuningResultsFromModelMetadata(
@@ -2702,6 +3129,11 @@ Status InferenceSession::Run(const RunOptions& run_options,
   auto* inter_tp = (control_spinning) ? inter_op_thread_pool_.get() : nullptr;
   ThreadPoolSpinningSwitch runs_refcounter_and_tp_spin_control(intra_tp, inter_tp, current_num_runs_);
 
+  std::shared_ptr<InferenceSession> specialized_session;
+#if !defined(ORT_MINIMAL_BUILD)
+  specialized_session = GetShapeSpecializedSession(feed_names, feeds);
+#endif
+
   // Check if this Run() is simply going to be a CUDA Graph replay.
   if (cached_execution_provider_for_graph_replay_.IsGraphCaptured(graph_annotation_id)) {
     LOGS(*session_logger_, INFO) << "Replaying the captured "
@@ -2709,6 +3141,9 @@ Status InferenceSession::Run(const RunOptions& run_options,
                                  << " CUDA Graph for this model with tag: " << run_options.run_tag
                                  << " with graph annotation id: " << graph_annotation_id;
     ORT_RETURN_IF_ERROR_SESSIONID_(cached_execution_provider_for_graph_replay_.ReplayGraph(graph_annotation_id));
+  } else if (specialized_session != nullptr) {
+    // the specialized session uses the thread pools of this session, so the run is counted and profiled here
+    retval = specialized_session->Run(run_options, feed_names, feeds, output_names, p_fetches, p_fetches_device_info);
   } else {
     InlinedVector<IExecutionProvider*> exec_providers_to_stop;
     exec_providers_to_stop.reserve(execution_providers_.NumProviders());
@@ -2864,7 +3299,7 @@ Status InferenceSession::Run(const RunOptions& run_options,
 #endif
 
 #if !defined(ORT_MINIMAL_BUILD)
-  if (IsNodeStatsCollectionEnabled() && retval.IsOK()) {
+  if (IsNodeStatsCollectionEnabled() && retval.IsOK() && specialized_session == nullptr) {
     // Dump node stats if the run was successful
     node_stats_recorder_->DumpStats(session_state_->GetGraphViewer().ModelPath());
     node_stats_recorder_->ResetPerRunNameDeduper();
@@ -2873,6 +3308,12 @@ Status InferenceSession::Run(const RunOptions& run_options,
 
   reset_saturation_count();
 
+#if !defined(ORT_MINIMAL_BUILD)
+  if (retval.IsOK()) {
+    RecordFeedShapesForSpecialization(feed_names, feeds);
+  }
+#endif
+
   // As N+1 inference runs (N for memory allocation and 1 for graph capturing)
   // are needed before replaying the captured graph, here run N inference runs recursively until graph captured,
   // so that users just need one session run to capture the graph.
@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <atomic>
+#include <condition_variable>
 #include <map>
 #include <optional>
 #include <string>
@@ -672,6 +674,46 @@ class InferenceSession {
   // The file path of where the model was loaded. e.g. /tmp/test_squeezenet/model.onnx
   PathString model_location_;
 
+#if !defined(ORT_MINIMAL_BUILD)
+  // Where the optimized model snapshot is written when the cache configured via
+  // kOrtSessionOptionsConfigOptimizedModelCacheDir has no entry for the model. Empty if not caching.
+  PathString optimized_model_cache_path_;
+
+  // True if the model was loaded from a snapshot in the optimized model cache.
+  bool loaded_optimized_model_snapshot_ = false;
+
+  // State of the re-optimization for the input shapes observed at runtime.
+  // see kOrtSessionOptionsConfigShapeSpecializationAfterRuns.
+  struct ShapeSpecialization {
+    std::mutex mutex;
+    // Signalled when the build of the specialized session finishes, whether it succeeded or not.
+    std::condition_variable build_finished;
+    // Number of consecutive successful runs with the same input shapes required before specializing.
+    int64_t runs_required = 0;
+    // Number of consecutive runs with feed_shapes observed so far. -1 once specialized or given up.
+    int64_t runs_observed = 0;
+    InlinedHashMap<std::string, TensorShape> feed_shapes;
+    // True while the specialized session is being built. feed_shapes does not change once the build starts.
+    bool building = false;
+    // The load cancellation flag of the specialized session. Set to cancel the build when this session is destroyed.
+    std::shared_ptr<std::atomic_bool> cancel_build = std::make_shared<std::atomic_bool>(false);
+    // The session optimized for feed_shapes.
+    std::shared_ptr<InferenceSession> session;
+    // Builds the specialized session off the request path. Declared last so that its thread is joined before the
+    // other members are destroyed.
+    std::unique_ptr<concurrency::ThreadPool> build_thread;
+  };
+
+  std::unique_ptr<ShapeSpecialization> shape_specialization_;
+
+  // The session whose initializers this shape specialized session shares. nullptr for other sessions.
+  const InferenceSession* initializers_source_session_ = nullptr;
+
+  // Names of the main graph initializers that the graph transformers of this session left as loaded from the model.
+  // Only collected when shape specialization is configured or this is a shape specialized session.
+  InlinedHashSet<std::string> unchanged_initializers_;
+#endif
+
  private:
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(InferenceSession);
   void SetLoggingManager(const SessionOptions& session_options,
@@ -690,6 +732,38 @@ class InferenceSession {
   }
 
   common::Status SaveToOrtFormat(const std::filesystem::path& filepath) const;
+
+  // Saves the finalized model in ORT format to optimized_model_cache_path_ for kOrtSessionOptionsConfigOptimizedModelCacheDir.
+  common::Status SaveOptimizedModelSnapshot() const;
+
+  // Returns why the optimized model cache cannot be used by this session, or nullptr if it can. The cache key covers
+  // the model file and the session options only, so initializers supplied by the application and custom ops, which
+  // change the optimized graph or its kernels without changing the key, turn the cache off.
+  const char* GetOptimizedModelCacheUnsupportedReason() const;
+
+  // Enables shape specialization if configured and supported by this session.
+  void InitShapeSpecialization();
+
+  // Returns the session specialized for the shapes of the feeds or nullptr if there is none.
+  std::shared_ptr<InferenceSession> GetShapeSpecializedSession(gsl::span<const std::string> feed_names,
+                                                               gsl::span<const OrtValue> feeds);
+
+  // Records the feed shapes of a successful run and starts building the specialized session in the background once
+  // they have been stable for the configured number of runs.
+  void RecordFeedShapesForSpecialization(gsl::span<const std::string> feed_names, gsl::span<const OrtValue> feeds);
+
+  // Creates the specialized session for the recorded feed shapes and publishes it to later runs.
+  // Runs on ShapeSpecialization::build_thread.
+  void BuildShapeSpecializedSession();
+
+  // Creates and initializes a session for the model with the symbolic input dimensions fixed to the values in
+  // feed_shapes.
+  common::Status CreateShapeSpecializedSession(const InlinedHashMap<std::string, TensorShape>& feed_shapes,
+                                               std::shared_ptr<InferenceSession>& session) const;
+
+  // Uses the initializers of source_session for the initializers that the graph transformers of neither session
+  // replaced instead of allocating them again.
+  void ShareUnchangedInitializers(const InferenceSession& source_session);
 #endif
 
   /**
@@ -0,0 +1,102 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "gtest/gtest.h"
+#include "test/providers/provider_test_utils.h"
+
+namespace onnxruntime {
+namespace test {
+
+TEST(EmbeddingBagTest, Sum) {
+  OpTester test("EmbeddingBag", 1, kMSDomain);
+  test.AddInput<float>("table", {4, 3}, {0.f, 1.f, 2.f, 10.f, 11.f, 12.f, 20.f, 21.f, 22.f, 30.f, 31.f, 32.f});
+  test.AddInput<int64_t>("indices", {2, 2}, {0, 2, 3, -1});
+  test.AddOutput<float>("output", {2, 3}, {20.f, 22.f, 24.f, 60.f, 62.f, 64.f});
+  test.Run();
+}
+
+TEST(EmbeddingBagTest, MeanBatchedBags) {
+  OpTester test("EmbeddingBag", 1, kMSDomain);
+  test.AddAttribute<std::string>("mode", "mean");
+  test.AddInput<float>("table", {3, 2}, {1.f, 2.f, 3.f, 4.f, 5.f, 6.f});
+  test.AddInput<int32_t>("indices", {2, 1, 3}, {0, 1, 2, 2, 2, 0});
+  test.AddOutput<float>("output", {2, 1, 2}, {3.f, 4.f, 11.f / 3.f, 14.f / 3.f});
+  test.Run();
+}
+
+TEST(EmbeddingBagTest, PerSampleWeights) {
+  OpTester test("EmbeddingBag", 1, kMSDomain);
+  test.AddInput<float>("table", {3, 2}, {1.f, 2.f, 3.f, 4.f, 5.f, 6.f});
+  test.AddInput<int64_t>("indices", {2, 2}, {0, 1, 2, 2});
+  test.AddInput<float>("per_sample_weights", {2, 2, 1}, {2.f, -1.f, 0.5f, 0.25f});
+  test.AddOutput<float>("output", {2, 2}, {-1.f, 0.f, 3.75f, 4.5f});
+  test.Run();
+}
+
+TEST(EmbeddingBagTest, Int8TableWithScales) {
+  OpTester test("EmbeddingBag", 1, kMSDomain);
+  test.AddInput<int8_t>("table", {3, 2}, {1, -2, 100, 4, -128, 127});
+  test.AddInput<int64_t>("indices", {1, 3}, {0, 1, 2});
+  test.AddOptionalInputEdge<float>();
+  test.AddInput<float>("scales", {3}, {0.5f, 0.25f, 0.125f});
+  test.AddOutput<float>("output", {1, 2}, {0.5f + 25.f - 16.f, -1.f + 1.f + 15.875f});
+  test.Run();
+}
+
+TEST(EmbeddingBagTest, Float16Table) {
+  OpTester test("EmbeddingBag", 1, kMSDomain);
+  test.AddInput<MLFloat16>("table", {2, 3},
+                           {MLFloat16(1.f), MLFloat16(2.f), MLFloat16(3.f),
+                            MLFloat16(0.5f), MLFloat16(-1.f), MLFloat16(4.f)});
+  test.AddInput<int64_t>("indices", {2}, {0, 1});
+  test.AddOutput<float>("output", {3}, {1.5f, 1.f, 7.f});
+  test.Run();
+}
+
+TEST(EmbeddingBagTest, ManyBags) {
+  constexpr int64_t num_rows = 50;
+  constexpr int64_t dim = 40;
+  constexpr int64_t num_bags = 300;
+  constexpr int64_t bag_size = 5;
+  std::vector<float> table(num_rows * dim);
+  for (size_t i = 0; i < table.size(); ++i) {
+    table[i] = static_cast<float>(i % 13) * 0.25f - 1.f;
+  }
+
+  std::vector<int64_t> indices(num_bags * bag_size);
+  std::vector<float> output(num_bags * dim, 0.f);
+  for (int64_t bag = 0; bag < num_bags; ++bag) {
+    for (int64_t j = 0; j < bag_size; ++j) {
+      const int64_t row = (bag * 7 + j * 11) % num_rows;
+      indices[bag * bag_size + j] = row;
+      for (int64_t d = 0; d < dim; ++d) {
+        output[bag * dim + d] += table[row * dim + d];
+      }
+    }
+  }
+
+  OpTester test("EmbeddingBag", 1, kMSDomain);
+  test.AddInput<float>("table", {num_rows, dim}, table);
+  test.AddInput<int64_t>("indices", {num_bags, bag_size}, indices);
+  test.AddOutput<float>("output", {num_bags, dim}, output);
+  test.Run();
+}
+
+TEST(EmbeddingBagTest, IndexOutOfRange) {
+  OpTester test("EmbeddingBag", 1, kMSDomain);
+  test.AddInput<float>("table", {2, 2}, {1.f, 2.f, 3.f, 4.f});
+  test.AddInput<int64_t>("indices", {1, 2}, {0, 2});
+  test.AddOutput<float>("output", {1, 2}, {0.f, 0.f});
+  test.Run(OpTester::ExpectResult::kExpectFailure, "indices must be within [-2, 1]");
+}
+
+TEST(EmbeddingBagTest, Int8TableRequiresScales) {
+  OpTester test("EmbeddingBag", 1, kMSDomain);
+  test.AddInput<int8_t>("table", {2, 2}, {1, 2, 3, 4});
+  test.AddInput<int64_t>("indices", {1, 2}, {0, 1});
+  test.AddOutput<float>("output", {1, 2}, {0.f, 0.f});
+  test.Run(OpTester::ExpectResult::kExpectFailure, "an int8 table requires scales");
+}
+
+}  // namespace test
+}  // namespace onnxruntime
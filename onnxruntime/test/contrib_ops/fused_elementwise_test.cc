@@ -0,0 +1,71 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <cmath>
+
+#include "gtest/gtest.h"
+#include "test/providers/provider_test_utils.h"
+
+namespace onnxruntime {
+namespace test {
+
+TEST(FusedElementwiseTest, ImmediateAndTensorOperands) {
+  // Add(Relu(Mul(Sub(X, 1), W)), W)
+  OpTester test("FusedElementwise", 1, kMSDomain);
+  test.AddAttribute<std::vector<std::string>>("ops", {"Sub", "Mul", "Relu", "Add"});
+  test.AddAttribute<std::vector<int64_t>>("operands", {-1, 1, -1, 1});
+  test.AddAttribute<std::vector<float>>("immediates", {1.f, 0.f, 0.f, 0.f});
+  test.AddAttribute<std::vector<int64_t>>("chain_is_rhs", {0, 0, 0, 0});
+  test.AddInput<float>("X", {2, 3}, {0.f, 1.f, 2.f, 3.f, 4.f, 5.f});
+  test.AddInput<float>("W", {2, 3}, {1.f, 2.f, -1.f, 3.f, 0.5f, -2.f});
+  test.AddOutput<float>("Y", {2, 3}, {1.f, 2.f, -1.f, 9.f, 2.f, -2.f});
+  test.Run();
+}
+
+TEST(FusedElementwiseTest, ChainIsRhs) {
+  // Neg(Div(W, Sub(2, X)))
+  OpTester test("FusedElementwise", 1, kMSDomain);
+  test.AddAttribute<std::vector<std::string>>("ops", {"Sub", "Div", "Neg"});
+  test.AddAttribute<std::vector<int64_t>>("operands", {-1, 1, -1});
+  test.AddAttribute<std::vector<float>>("immediates", {2.f, 0.f, 0.f});
+  test.AddAttribute<std::vector<int64_t>>("chain_is_rhs", {1, 1, 0});
+  test.AddInput<float>("X", {4}, {0.f, 1.f, 3.f, 4.f});
+  test.AddInput<float>("W", {4}, {2.f, 3.f, 4.f, 6.f});
+  test.AddOutput<float>("Y", {4}, {-1.f, -3.f, 4.f, 3.f});
+  test.Run();
+}
+
+TEST(FusedElementwiseTest, MultipleTiles) {
+  // Mul(Sigmoid(X), X) over a tensor that spans several tiles
+  constexpr int64_t size = 10000;
+  std::vector<float> x(size);
+  std::vector<float> y(size);
+  for (int64_t i = 0; i < size; ++i) {
+    x[i] = static_cast<float>(i % 17) * 0.5f - 4.f;
+    y[i] = x[i] / (1.f + std::exp(-x[i]));
+  }
+
+  OpTester test("FusedElementwise", 1, kMSDomain);
+  test.AddAttribute<std::vector<std::string>>("ops", {"Sigmoid", "Mul"});
+  test.AddAttribute<std::vector<int64_t>>("operands", {-1, 0});
+  test.AddAttribute<std::vector<float>>("immediates", {0.f, 0.f});
+  test.AddAttribute<std::vector<int64_t>>("chain_is_rhs", {0, 0});
+  test.AddInput<float>("X", {size}, x);
+  test.AddOutput<float>("Y", {size}, y);
+  test.SetOutputAbsErr("Y", 1e-4f);
+  test.Run();
+}
+
+TEST(FusedElementwiseTest, UnsupportedOperator) {
+  OpTester test("FusedElementwise", 1, kMSDomain);
+  test.AddAttribute<std::vector<std::string>>("ops", {"Relu", "Cast"});
+  test.AddAttribute<std::vector<int64_t>>("operands", {-1, -1});
+  test.AddAttribute<std::vector<float>>("immediates", {0.f, 0.f});
+  test.AddAttribute<std::vector<int64_t>>("chain_is_rhs", {0, 0});
+  test.AddInput<float>("X", {2}, {1.f, -1.f});
+  test.AddOutput<float>("Y", {2}, {1.f, 0.f});
+  test.Run(OpTester::ExpectResult::kExpectFailure, "FusedElementwise does not support the operator Cast");
+}
+
+}  // namespace test
+}  // namespace onnxruntime
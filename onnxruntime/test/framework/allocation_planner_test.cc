@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 #include <string>
+#include <variant>
 #include <unordered_map>
 #include <unordered_set>
 #include <sstream>
@@ -517,6 +518,42 @@ TEST_F(PlannerTest, InPlaceTest) {
   CheckFreed(2, {X2});
 }
 
+// InPlaceBinaryElementwiseTest: Check that the output of the CPU Add kernel reuses whichever input has its size.
+
+TEST_F(PlannerTest, InPlaceBinaryElementwiseTest) {
+  const auto& logger = DefaultLoggingManager().DefaultLogger();
+  auto cpu_registry = CPUExecutionProvider(CPUExecutionProviderInfo()).GetKernelRegistry();
+  const KernelCreateInfo* add_kci = nullptr;
+  ASSERT_STATUS_OK(cpu_registry->TryFindKernel(kCpuExecutionProvider, "Add", kOnnxDomain, 7,
+                                               {{"T", DataTypeImpl::GetTensorType<float>()}}, logger, &add_kci));
+
+  // tensor variables:
+  std::string X1("X1"), X2("X2"), X3("X3"), X4("X4"), X5("X5");
+  std::string add_node_name("add");
+
+  // graph structure:
+  AddNormalNode(X1, X2);  // X2: temporary, broadcast by the Add
+  AddNormalNode(X1, X3);  // X3: temporary with the shape of the Add output
+  std::vector<onnxruntime::NodeArg*> add_inputs{Arg(X2), Arg(X3)};
+  std::vector<onnxruntime::NodeArg*> add_outputs{Arg(X4)};
+  AddNode(*add_kci->kernel_def, add_node_name, add_inputs, add_outputs);
+  AddNormalNode(X4, X5);  // X5: output
+
+  // simulate shape-inference results:
+  Shape shape1{"N"};
+  Shape shape2{"M", "N"};
+  SetShape({{X1, &shape1.value}, {X2, &shape1.value}, {X3, &shape2.value}, {X4, &shape2.value},
+            {X5, &shape2.value}});
+
+  CreatePlan();
+
+  // check allocation kind:
+  CheckAllocKind(X2, AllocKind::kAllocate);
+  CheckAllocKind(X3, AllocKind::kAllocate);
+  CheckAllocKind(X4, AllocKind::kReuse);
+  CheckAllocKind(X5, AllocKind::kAllocateOutput);
+}
+
 TEST_F(PlannerTest, ExternalOutputsTest) {
   // tensor variables:
   std::string X1("X1"), X2("X2"), X3("X3"), X4("X4");
@@ -716,6 +753,80 @@ TEST_F(PlannerTest, InPlaceSizeMismatchTest) {
   CheckFreed(3, {X2});
 }
 
+// InPlaceShapeMismatchTest: Check that Inplace reuse is not allowed when only the number of elements matches,
+// while a freed buffer with that number of elements can still be reused.
+TEST_F(PlannerTest, InPlaceShapeMismatchTest) {
+  // tensor variables:
+  std::string X1("X1"), X2("X2"), X3("X3"), X4("X4"), X5("X5");
+
+  // graph structure:
+  AddNormalNode(X1, X2);   // no in-place operator; X1: input; X2: temporary
+  AddInplaceNode(X2, X3);  // may-in-place operator; X3: temporary
+  AddNormalNode(X3, X4);   // no in-place operator; X4: temporary (reuse X2)
+  AddNormalNode(X4, X5);   // no in-place operator; X5: output
+
+  // simulate shape-inference results:
+  Shape shape1w{"M", "N"};
+  auto shape1 = &shape1w.value;
+  Shape shape2w{"N", "M"};
+  auto shape2 = &shape2w.value;
+  SetShape({{X1, shape1}, {X2, shape1}, {X3, shape2}, {X4, shape1}, {X5, shape1}});
+
+  CreatePlan();
+
+  // check allocation kind:
+  CheckAllocKind(X1, AllocKind::kPreExisting);
+  CheckAllocKind(X2, AllocKind::kAllocate);
+  CheckAllocKind(X3, AllocKind::kAllocate);
+  CheckAllocKind(X4, AllocKind::kReuse);
+  CheckAllocKind(X5, AllocKind::kAllocateOutput);
+}
+
+// Buffers of differently shaped tensors with the same symbolic number of elements can be reused.
+TEST_F(PlannerTest, SymbolicSizeReuseTest) {
+  // tensor variables:
+  std::string X("X"), B("B"), Y("Y"), Z("Z"), W("W");
+
+  // graph structure:
+  AddNormalNode(W, X);
+  AddNormalNode(X, B);
+  AddNormalNode(B, Y);
+  AddNormalNode(Y, Z);
+
+  // simulate shape-inference results:
+  auto make_shape = [](std::initializer_list<std::variant<int, std::string>> dims) {
+    TensorShapeProto shape;
+    for (const auto& d : dims) {
+      if (std::holds_alternative<int>(d)) {
+        shape.add_dim()->set_dim_value(std::get<int>(d));
+      } else {
+        shape.add_dim()->set_dim_param(std::get<std::string>(d));
+      }
+    }
+    return shape;
+  };
+
+  TensorShapeProto x_shape = make_shape({std::string("batch"), std::string("seq"), 768});
+  TensorShapeProto b_shape = make_shape({std::string("batch*seq"), 768});
+  TensorShapeProto y_shape = make_shape({std::string("batch"), 12, std::string("seq"), 64});
+  TensorShapeProto z_shape = make_shape({std::string("seq"), std::string("batch"), 768});
+  SetShape({{X, &x_shape}, {B, &b_shape}, {Y, &y_shape}, {Z, &z_shape}});
+
+  CreatePlan();
+
+  // Y has as many elements as X, which is no longer used once B is computed
+  CheckAllocKind(W, AllocKind::kPreExisting);
+  CheckAllocKind(X, AllocKind::kAllocate);
+  CheckAllocKind(B, AllocKind::kAllocate);
+  CheckAllocKind(Y, AllocKind::kReuse);
+  CheckAllocKind(Z, AllocKind::kAllocateOutput);
+
+  CheckFreed(0, {});
+  CheckFreed(1, {});
+  CheckFreed(2, {B});
+  CheckFreed(3, {X});
+}
+
 // Test operator<< to output details of an allocation & execution plan.
 TEST_F(PlannerTest, PlanOutputTest) {
   // tensor variables:
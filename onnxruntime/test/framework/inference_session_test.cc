@@ -10,6 +10,7 @@
 #include <future>
 #include <iterator>
 #include <thread>
+#include <filesystem>
 #include <fstream>
 #include <random>
 
@@ -21,6 +22,7 @@
 #include "core/framework/compute_capability.h"
 #include "core/framework/data_transfer_manager.h"
 #include "core/framework/execution_provider.h"
+#include "core/framework/customregistry.h"
 #include "core/framework/kernel_registry.h"
 #include "core/framework/op_kernel.h"
 #include "core/framework/session_state.h"
@@ -499,6 +501,105 @@ TEST(InferenceSessionTests, TestModelSerialization) {
   ASSERT_TRUE(session_object_emptyValidation.Initialize().IsOK());
 }
 
+#if !defined(ORT_MINIMAL_BUILD)
+TEST(InferenceSessionTests, OptimizedModelCache) {
+  const std::filesystem::path cache_dir("optimized_model_cache_test");
+  std::filesystem::remove_all(cache_dir);
+
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.OptimizedModelCache";
+  so.graph_optimization_level = TransformerLevel::Level1;
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigOptimizedModelCacheDir,
+                                                    cache_dir.string().c_str()));
+
+  auto count_snapshots = [&cache_dir]() {
+    return std::distance(std::filesystem::directory_iterator(cache_dir), std::filesystem::directory_iterator{});
+  };
+
+  // the first session optimizes the model and writes the snapshot
+  {
+    InferenceSessionWrapper session_object{so, GetEnvironment()};
+    ASSERT_STATUS_OK(session_object.Load(ORT_TSTR("testdata/transform/abs-id-max.onnx")));
+    ASSERT_STATUS_OK(session_object.Initialize());
+    ASSERT_EQ(count_snapshots(), 1);
+  }
+
+  // the second session loads the already optimized snapshot and does not add another entry
+  {
+    InferenceSessionWrapper session_object{so, GetEnvironment()};
+    ASSERT_STATUS_OK(session_object.Load(ORT_TSTR("testdata/transform/abs-id-max.onnx")));
+    ASSERT_STATUS_OK(session_object.Initialize());
+    ASSERT_EQ(count_snapshots(), 1);
+    ASSERT_EQ(CountOpsInGraph(session_object.GetGraph())["Identity"], 0);
+  }
+
+  // a different optimization level produces a different snapshot
+  so.graph_optimization_level = TransformerLevel::Default;
+  {
+    InferenceSessionWrapper session_object{so, GetEnvironment()};
+    ASSERT_STATUS_OK(session_object.Load(ORT_TSTR("testdata/transform/abs-id-max.onnx")));
+    ASSERT_STATUS_OK(session_object.Initialize());
+    ASSERT_EQ(count_snapshots(), 2);
+    ASSERT_GT(CountOpsInGraph(session_object.GetGraph())["Identity"], 0);
+  }
+
+  // the key does not cover custom ops, so a session that registers them neither loads nor writes a snapshot
+  so.graph_optimization_level = TransformerLevel::Level2;
+  {
+    InferenceSessionWrapper session_object{so, GetEnvironment()};
+    ASSERT_STATUS_OK(session_object.RegisterCustomRegistry(std::make_shared<CustomRegistry>()));
+    ASSERT_STATUS_OK(session_object.Load(ORT_TSTR("testdata/transform/abs-id-max.onnx")));
+    ASSERT_STATUS_OK(session_object.Initialize());
+    ASSERT_EQ(count_snapshots(), 2);
+  }
+
+  std::filesystem::remove_all(cache_dir);
+}
+
+TEST(InferenceSessionTests, ShapeSpecialization) {
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.ShapeSpecialization";
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigShapeSpecializationAfterRuns, "2"));
+
+  // the input x has the shape [Dim1, Dim2, 5]
+  InferenceSessionWrapper session_object{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object.Load(ORT_TSTR("testdata/abs_free_dimensions.onnx")));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  auto run = [&session_object](const std::vector<int64_t>& dims) {
+    std::vector<float> values(static_cast<size_t>(TensorShape(dims).Size()), -1.0f);
+    OrtValue x;
+    CreateMLValue<float>(TestCPUExecutionProvider()->CreatePreferredAllocators()[0], dims, values, &x);
+
+    NameMLValMap feeds{{"x", x}};
+    std::vector<std::string> output_names{"y"};
+    std::vector<OrtValue> fetches;
+    ASSERT_STATUS_OK(session_object.Run(RunOptions{}, feeds, output_names, &fetches));
+    VerifyOutputs(fetches, dims, std::vector<float>(values.size(), 1.0f));
+  };
+
+  // changing shapes restart the observation
+  run({1, 2, 5});
+  run({3, 2, 5});
+  ASSERT_EQ(session_object.GetSpecializedSession(), nullptr);
+
+  // the run that completes the observation does not wait for the specialized session
+  run({3, 2, 5});
+  auto specialized_session = session_object.WaitForSpecializedSession();
+  ASSERT_NE(specialized_session, nullptr);
+
+  const auto [status, inputs] = specialized_session->GetModelInputs();
+  ASSERT_STATUS_OK(status);
+  const auto* input_shape = (*inputs)[0]->Shape();
+  ASSERT_EQ(input_shape->dim(0).dim_value(), 3);
+  ASSERT_EQ(input_shape->dim(1).dim_value(), 2);
+
+  // matching runs use the specialized session and others still run on the original one
+  run({3, 2, 5});
+  run({4, 1, 5});
+}
+#endif  // !defined(ORT_MINIMAL_BUILD)
+
 TEST(InferenceSessionTests, RequestLoadCancellation) {
   {
     // Explicit cancel during load, small model is fine
@@ -1,6 +1,8 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <filesystem>
+#include <fstream>
 #include <iostream>
 #include <absl/base/config.h>
 
@@ -627,6 +629,21 @@ class PrePackingTestOpKernel : public OpKernel {
   IAllocatorUniquePtr<void> weight_packed_;
 };
 
+class FailingPrePackingTestOpKernel : public PrePackingTestOpKernel {
+ public:
+  FailingPrePackingTestOpKernel(const OpKernelInfo& info) : PrePackingTestOpKernel(info) {}
+
+  Status PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
+                 /*out*/ bool& is_packed, /*out*/ PrePackedWeights* prepacked_weights) override {
+    ORT_UNUSED_PARAMETER(tensor);
+    ORT_UNUSED_PARAMETER(input_idx);
+    ORT_UNUSED_PARAMETER(alloc);
+    ORT_UNUSED_PARAMETER(prepacked_weights);
+    is_packed = false;
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "PrePack failed");
+  }
+};
+
 static void CreateSimpleGraph(Graph& graph) {
   // node creation and placement
   TypeProto type;
@@ -759,6 +776,9 @@ static void PlaceAllNodesToCPUEP(Graph& graph) {
 struct PrepackingTestParam {
   bool test_subgraph;
   bool test_prepacking;
+  bool test_parallel_finalization = false;
+  bool test_lazy_prepacking = false;
+  bool test_failing_prepack = false;
 };
 
 class SessionStatePrepackingTest : public testing::TestWithParam<PrepackingTestParam> {};
@@ -801,6 +821,10 @@ TEST_P(SessionStatePrepackingTest, PrePackingTest) {
   sess_options.enable_mem_reuse = true;
   sess_options.config_options.configurations[kOrtSessionOptionsConfigDisablePrepacking] =
       test_param.test_prepacking ? "0" : "1";
+  sess_options.config_options.configurations[kOrtSessionOptionsConfigParallelFinalization] =
+      test_param.test_parallel_finalization ? "1" : "0";
+  sess_options.config_options.configurations[kOrtSessionOptionsConfigLazyPrepacking] =
+      test_param.test_lazy_prepacking ? "1" : "0";
 
   SessionState session_state(model.MainGraph(),
                              execution_providers,
@@ -819,8 +843,12 @@ TEST_P(SessionStatePrepackingTest, PrePackingTest) {
   auto kernel_def = KernelDefBuilder().SetName("PrePackingTest").Provider(kCpuExecutionProvider).SinceVersion(1).Build();
   ASSERT_STATUS_OK(kernel_registry->Register(
       KernelCreateInfo(std::move(kernel_def),
-                       [](FuncManager&, const OpKernelInfo& info, std::unique_ptr<OpKernel>& out) -> Status {
-                         out = std::make_unique<PrePackingTestOpKernel>(info);
+                       [test_param](FuncManager&, const OpKernelInfo& info, std::unique_ptr<OpKernel>& out) -> Status {
+                         if (test_param.test_failing_prepack) {
+                           out = std::make_unique<FailingPrePackingTestOpKernel>(info);
+                         } else {
+                           out = std::make_unique<PrePackingTestOpKernel>(info);
+                         }
                          return Status::OK();
                        })));
   kernel_registry_manager.RegisterKernelRegistry(kernel_registry);
@@ -831,7 +859,35 @@ TEST_P(SessionStatePrepackingTest, PrePackingTest) {
 
   const auto& const_initialized_tensors = session_state.GetConstantInitializedTensors();
   // check prepacking
-  ASSERT_EQ(const_initialized_tensors.size(), size_t(test_param.test_prepacking ? 0 : 1));
+  if (!test_param.test_lazy_prepacking) {
+    ASSERT_EQ(const_initialized_tensors.size(), size_t(test_param.test_prepacking ? 0 : 1));
+    return;
+  }
+
+  // nothing is pre-packed until the kernels run, and the original initializers are kept
+  ASSERT_EQ(const_initialized_tensors.size(), size_t(1));
+  ASSERT_EQ(session_state.GetNumberOfPrepacksCounter(), size_t(0));
+
+  if (test_param.test_failing_prepack) {
+    // every run of the node has to fail, not only the one that pre-packed it
+    for (const auto& node : model.MainGraph().Nodes()) {
+      for (int run = 0; run < 2; ++run) {
+        const auto prepack_status = session_state.PrepackKernelOnFirstUse(node.Index());
+        ASSERT_FALSE(prepack_status.IsOK());
+        ASSERT_NE(prepack_status.ErrorMessage().find("PrePack failed"), std::string::npos);
+      }
+    }
+    return;
+  }
+
+  for (const auto& node : model.MainGraph().Nodes()) {
+    ASSERT_STATUS_OK(session_state.PrepackKernelOnFirstUse(node.Index()));
+    ASSERT_STATUS_OK(session_state.PrepackKernelOnFirstUse(node.Index()));
+  }
+
+  if (!test_param.test_subgraph) {
+    ASSERT_EQ(session_state.GetNumberOfPrepacksCounter(), size_t(test_param.test_prepacking ? 1 : 0));
+  }
 }
 
 class SessionStateTestSharedInitalizersWithPrePacking : public ::testing::Test {
@@ -1104,6 +1160,102 @@ TEST_F(SessionStateTestSharedInitalizersWithPrePacking, test3) {
   ASSERT_EQ(session_state_2.GetUsedSharedPrePackedWeightCounter(), static_cast<size_t>(1));
 }
 
+// Pre-packing enabled + shared initializers + one pre-packed weights container per "process"
+// sharing a directory = a single file backs the pre-packed weights of both
+TEST_F(SessionStateTestSharedInitalizersWithPrePacking, SharedMemoryDirectory) {
+  const auto shared_memory_dir = std::filesystem::temp_directory_path() /
+                                 ("ort_prepacked_weights_test_" + std::to_string(Env::Default().GetSelfPid()));
+  std::filesystem::remove_all(shared_memory_dir);
+
+  SessionOptions sess_options;
+  sess_options.enable_mem_pattern = true;
+  sess_options.execution_mode = ExecutionMode::ORT_SEQUENTIAL;
+  sess_options.use_deterministic_compute = false;
+  sess_options.enable_mem_reuse = true;
+  // Enable pre-packing
+  sess_options.config_options.configurations[kOrtSessionOptionsConfigDisablePrepacking] = "0";
+  sess_options.config_options.configurations[kOrtSessionOptionsConfigPrepackedWeightsSharedMemoryDir] =
+      shared_memory_dir.string();
+
+  // Enable shared initializer
+  OrtMemoryInfo mem_info(CPU, OrtDeviceAllocator);
+  std::vector<float> float_data(1, 1);
+  auto value = std::make_unique<OrtValue>();
+  Tensor::InitOrtValue(DataTypeImpl::GetType<float>(), TensorShape(std::vector<int64_t>{1}),
+                       reinterpret_cast<void*>(float_data.data()), mem_info, *value);
+
+  ASSERT_STATUS_OK(sess_options.AddInitializer("node_0_input_1", value.get()));
+
+  {
+    // Separate containers stand in for replicas running in separate processes
+    PrepackedWeightsContainer prepacked_weights_container_1;
+    PrepackedWeightsContainer prepacked_weights_container_2;
+
+    Model model_1("graph_main", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+                  domain_to_version, std::vector<ONNX_NAMESPACE::FunctionProto>(),
+                  DefaultLoggingManager().DefaultLogger());
+    CreateSimpleGraph(model_1.MainGraph());
+    PlaceAllNodesToCPUEP(model_1.MainGraph());
+    SessionState session_state_1(model_1.MainGraph(), execution_providers, tp.get(), nullptr, dtm, edlm,
+                                 DefaultLoggingManager().DefaultLogger(), profiler, sess_options,
+                                 &prepacked_weights_container_1);
+    ASSERT_STATUS_OK(session_state_1.FinalizeSessionState(std::basic_string<PATH_CHAR_TYPE>(),
+                                                          kernel_registry_manager));
+
+    // Damage the data of the file without changing its name or header. The file is replaced by a new one
+    // so that the mapping of the first session is left as is.
+    for (const auto& entry : std::filesystem::directory_iterator(shared_memory_dir)) {
+      std::string contents;
+      {
+        std::ifstream in(entry.path(), std::ios::binary);
+        contents.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+      }
+      ASSERT_FALSE(contents.empty());
+      contents.back() ^= 0x1;
+
+      const auto damaged_path = shared_memory_dir / "damaged";
+      {
+        std::ofstream out(damaged_path, std::ios::binary);
+        out.write(contents.data(), static_cast<std::streamsize>(contents.size()));
+      }
+      std::filesystem::rename(damaged_path, entry.path());
+      break;
+    }
+
+    Model model_2("graph_main", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+                  domain_to_version, std::vector<ONNX_NAMESPACE::FunctionProto>(),
+                  DefaultLoggingManager().DefaultLogger());
+    CreateSimpleGraph(model_2.MainGraph());
+    PlaceAllNodesToCPUEP(model_2.MainGraph());
+    SessionState session_state_2(model_2.MainGraph(), execution_providers, tp.get(), nullptr, dtm, edlm,
+                                 DefaultLoggingManager().DefaultLogger(), profiler, sess_options,
+                                 &prepacked_weights_container_2);
+    ASSERT_STATUS_OK(session_state_2.FinalizeSessionState(std::basic_string<PATH_CHAR_TYPE>(),
+                                                          kernel_registry_manager));
+
+    ASSERT_TRUE(prepacked_weights_container_1.IsSharedMemoryEnabled());
+    ASSERT_EQ(session_state_2.GetUsedSharedPrePackedWeightCounter(), static_cast<size_t>(0));
+
+    // Both kernels read the correct pre-packed weight. The second session replaced the damaged file.
+    for (const auto* session_state : {&session_state_1, &session_state_2}) {
+      const auto* kernel = reinterpret_cast<const PrePackingTestOpKernel*>(session_state->GetKernel(0));
+      ASSERT_EQ(kernel->store_pre_packed_weight_calls_count, 1);
+      const float* weight = reinterpret_cast<const float*>(kernel->weight_packed_.get());
+      ASSERT_EQ(weight[0], 1.2345f);
+      ASSERT_EQ(weight[1], 1.2345f * 2.f);
+    }
+
+    size_t num_files = 0;
+    for (const auto& entry : std::filesystem::directory_iterator(shared_memory_dir)) {
+      ASSERT_NE(entry.path().extension(), ".tmp");
+      ++num_files;
+    }
+    ASSERT_EQ(num_files, static_cast<size_t>(1));
+  }
+
+  std::filesystem::remove_all(shared_memory_dir);
+}
+
 // Pre-packing enabled + shared initializers +
 // pre-packed weights container + subgraphs =
 // caching enabled in pre-packed weights used in subgraphs
@@ -1425,7 +1577,12 @@ INSTANTIATE_TEST_SUITE_P(SessionStateTests,
                          testing::Values(PrepackingTestParam{false, false},
                                          PrepackingTestParam{false, true},
                                          PrepackingTestParam{true, false},
-                                         PrepackingTestParam{true, true}));
+                                         PrepackingTestParam{true, true},
+                                         PrepackingTestParam{false, true, true},
+                                         PrepackingTestParam{true, true, true},
+                                         PrepackingTestParam{false, true, false, true},
+                                         PrepackingTestParam{true, true, false, true},
+                                         PrepackingTestParam{false, true, false, true, true}));
 #endif
 
 }  // namespace test
@@ -1154,6 +1154,68 @@ TEST_F(GraphTest, GraphConstruction_PriorityBasedTopologicalSort_MultiLayerRecom
   }
 }
 
+TEST_F(GraphTest, GraphConstruction_MemoryAwareTopologicalSort_IndependentBranches) {
+  Model model("graph_1", false, *logger_);
+  auto& graph = model.MainGraph();
+
+  /*
+                            |
+          expand_a (4096) --+-- expand_b (4096)
+                 |                   |
+          reduce_a (1)          reduce_b (1)
+                      \        /
+                    merge (Merge)
+                          |
+  */
+
+  TypeProto small_int32;
+  small_int32.mutable_tensor_type()->set_elem_type(TensorProto_DataType_INT32);
+  small_int32.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(1);
+  TypeProto large_int32;
+  large_int32.mutable_tensor_type()->set_elem_type(TensorProto_DataType_INT32);
+  large_int32.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(4096);
+
+  auto& input_arg = graph.GetOrCreateNodeArg("input", &small_int32);
+  auto& expand_a_out = graph.GetOrCreateNodeArg("expand_a_out", &large_int32);
+  auto& expand_b_out = graph.GetOrCreateNodeArg("expand_b_out", &large_int32);
+  auto& reduce_a_out = graph.GetOrCreateNodeArg("reduce_a_out", &small_int32);
+  auto& reduce_b_out = graph.GetOrCreateNodeArg("reduce_b_out", &small_int32);
+  auto& merge_out = graph.GetOrCreateNodeArg("merge_out", &small_int32);
+
+  // the node indices make the priority based order run both expansions before either reduction
+  graph.AddNode("expand_a", "Identity_Fake", "expand a", {&input_arg}, {&expand_a_out});
+  graph.AddNode("expand_b", "Identity_Fake", "expand b", {&input_arg}, {&expand_b_out});
+  graph.AddNode("reduce_a", "Identity_Fake", "reduce a", {&expand_a_out}, {&reduce_a_out});
+  graph.AddNode("reduce_b", "Identity_Fake", "reduce b", {&expand_b_out}, {&reduce_b_out});
+  graph.AddNode("merge", "Merge_Fake", "merge", {&reduce_a_out, &reduce_b_out}, {&merge_out});
+
+  auto status = graph.Resolve();
+  EXPECT_TRUE(status.IsOK()) << status.ErrorMessage();
+  GraphViewer graph_viewer(graph);
+
+  const auto& priority_based_order = graph_viewer.GetNodesInTopologicalOrder(ExecutionOrder::PRIORITY_BASED);
+#ifdef ENABLE_TRAINING
+  // training builds keep the default order for graphs without a YieldOp, so sort explicitly
+  std::vector<NodeIndex> memory_efficient_order;
+  graph.MemoryAwareTopologicalSort([](const Node* n1, const Node* n2) { return n1->Index() > n2->Index(); },
+                                   memory_efficient_order);
+#else
+  const auto& memory_efficient_order = graph_viewer.GetNodesInTopologicalOrder(ExecutionOrder::MEMORY_EFFICIENT);
+#endif
+
+  const std::vector<std::string> expected_memory_efficient_order =
+      {"expand_a", "reduce_a", "expand_b", "reduce_b", "merge"};
+  ASSERT_EQ(memory_efficient_order.size(), expected_memory_efficient_order.size());
+  for (size_t i = 0; i < memory_efficient_order.size(); ++i) {
+    auto node = graph.GetNode(memory_efficient_order[i]);
+    EXPECT_TRUE(node->Name() == expected_memory_efficient_order[i]) << "Memory efficient execution order is wrong.";
+  }
+
+  // only one of the large tensors is alive at a time
+  EXPECT_EQ(graph.EstimatePeakActivationBytes(memory_efficient_order), (4096 + 2) * sizeof(int32_t));
+  EXPECT_EQ(graph.EstimatePeakActivationBytes(priority_based_order), (2 * 4096 + 1) * sizeof(int32_t));
+}
+
 TEST_F(GraphTest, GraphConstruction_CheckGraphInputOutputOrderMaintained) {
   Model model("graph_1", false, *logger_);
   auto& graph = model.MainGraph();
@@ -1678,6 +1740,65 @@ TEST_F(GraphTest, DuplicateName) {
   EXPECT_TRUE(duplicate_error_found);
 }
 
+// Resolve skips type/shape inferencing of unchanged nodes. Check that a changed initializer value and changed
+// input types are still picked up by the affected nodes.
+TEST_F(GraphTest, IncrementalResolveReinfersChangedNodes) {
+  Model model{"IncrementalResolveTest", false, *logger_};
+  auto& graph = model.MainGraph();
+
+  ONNX_NAMESPACE::TensorProto shape{};
+  shape.set_data_type(TensorProto_DataType_INT64);
+  shape.add_dims(2);
+  shape.add_int64_data(2);
+  shape.add_int64_data(3);
+  shape.set_name("shape");
+  graph.AddInitializedTensor(shape);
+
+  TypeProto tensor_type;
+  tensor_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  tensor_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(6);
+  auto& x = graph.GetOrCreateNodeArg("X", &tensor_type);
+  auto& shape_arg = graph.GetOrCreateNodeArg("shape", nullptr);
+  auto& reshaped = graph.GetOrCreateNodeArg("reshaped", nullptr);
+  auto& y = graph.GetOrCreateNodeArg("Y", nullptr);
+  graph.AddNode("reshape", "Reshape", "reshape", {&x, &shape_arg}, {&reshaped});
+  graph.AddNode("relu", "Relu", "relu", {&reshaped}, {&y});
+
+  auto get_dims = [&graph](const std::string& name) {
+    std::vector<int64_t> dims;
+    const auto* shape_proto = graph.GetNodeArg(name)->Shape();
+    if (shape_proto != nullptr) {
+      for (const auto& dim : shape_proto->dim()) {
+        dims.push_back(dim.dim_value());
+      }
+    }
+    return dims;
+  };
+
+  ASSERT_STATUS_OK(graph.Resolve());
+  EXPECT_EQ(get_dims("Y"), std::vector<int64_t>({2, 3}));
+
+  // resolving an unchanged graph keeps the inferred shapes
+  graph.SetGraphResolveNeeded();
+  ASSERT_STATUS_OK(graph.Resolve());
+  EXPECT_EQ(get_dims("reshaped"), std::vector<int64_t>({2, 3}));
+  EXPECT_EQ(get_dims("Y"), std::vector<int64_t>({2, 3}));
+
+  // change the Reshape target in place and drop the stale shapes
+  ONNX_NAMESPACE::TensorProto new_shape = shape;
+  new_shape.clear_int64_data();
+  new_shape.add_int64_data(3);
+  new_shape.add_int64_data(2);
+  ASSERT_STATUS_OK(graph.ReplaceInitializedTensor(new_shape));
+  graph.GetNodeArg("reshaped")->ClearShape();
+  graph.GetNodeArg("Y")->ClearShape();
+  graph.SetGraphResolveNeeded();
+
+  ASSERT_STATUS_OK(graph.Resolve());
+  EXPECT_EQ(get_dims("reshaped"), std::vector<int64_t>({3, 2}));
+  EXPECT_EQ(get_dims("Y"), std::vector<int64_t>({3, 2}));
+}
+
 TEST_F(GraphTest, ReplaceInitializedTensor) {
   Model model{"GraphUpdateTest", false, *logger_};
   auto& graph = model.MainGraph();
@@ -0,0 +1,72 @@
+#include "common.h"
+#include "core/util/thread_utils.h"
+
+#include <benchmark/benchmark.h>
+#include <core/platform/threadpool.h>
+#include "core/providers/cpu/reduction/reduction_ops.h"
+
+using namespace onnxruntime;
+
+// Reduces a [outer, reduce, inner] tensor along its middle axis, covering KR (inner == 1),
+// RK (outer == 1) and KRK shapes.
+template <typename OP>
+static void BM_ReduceOuterReduceInner(benchmark::State& state, bool parallel) {
+  const int64_t n_outer = state.range(0);
+  const int64_t n_reduce = state.range(1);
+  const int64_t n_inner = state.range(2);
+
+  float* data = GenerateArrayWithRandomValue<float>(static_cast<size_t>(n_outer * n_reduce * n_inner), -1, 1);
+  std::vector<float> output(static_cast<size_t>(n_outer * n_inner));
+
+  OrtThreadPoolParams tpo;
+  tpo.auto_set_affinity = true;
+  std::unique_ptr<concurrency::ThreadPool> tp(
+      concurrency::CreateThreadPool(&onnxruntime::Env::Default(), tpo, concurrency::ThreadPoolType::INTRA_OP));
+
+  for (auto _ : state) {
+    ReduceOuterReduceInner<float, OP>(data, n_outer, n_reduce, n_inner, output.data(),
+                                      parallel ? tp.get() : nullptr);
+  }
+  aligned_free(data);
+}
+
+static void BM_ReduceSum_SingleThread(benchmark::State& state) {
+  BM_ReduceOuterReduceInner<ReduceOpSum<float>>(state, false);
+}
+
+static void BM_ReduceSum_Parallel(benchmark::State& state) {
+  BM_ReduceOuterReduceInner<ReduceOpSum<float>>(state, true);
+}
+
+static void BM_ReduceMax_Parallel(benchmark::State& state) {
+  BM_ReduceOuterReduceInner<ReduceOpMax<float>>(state, true);
+}
+
+static void ReduceShapes(benchmark::internal::Benchmark* b) {
+  // KR
+  b->Args({4, 1000000, 1});
+  b->Args({1024, 4096, 1});
+  b->Args({1, 4000000, 1});
+  // RK
+  b->Args({1, 100000, 8});
+  b->Args({1, 4096, 1024});
+  // KRK
+  b->Args({2, 2048, 2048});
+  b->Args({64, 128, 512});
+  b->Args({1, 8192, 64});
+}
+
+BENCHMARK(BM_ReduceSum_SingleThread)
+    ->UseRealTime()
+    ->Unit(benchmark::TimeUnit::kNanosecond)
+    ->Apply(ReduceShapes);
+
+BENCHMARK(BM_ReduceSum_Parallel)
+    ->UseRealTime()
+    ->Unit(benchmark::TimeUnit::kNanosecond)
+    ->Apply(ReduceShapes);
+
+BENCHMARK(BM_ReduceMax_Parallel)
+    ->UseRealTime()
+    ->Unit(benchmark::TimeUnit::kNanosecond)
+    ->Apply(ReduceShapes);
@@ -39,6 +39,8 @@
 #include "core/optimizer/double_qdq_pairs_remover.h"
 #include "core/optimizer/dropout_elimination.h"
 #include "core/optimizer/dynamic_quantize_matmul_fusion.h"
+#include "core/optimizer/elementwise_chain_fusion.h"
+#include "core/optimizer/embedding_bag_fusion.h"
 #include "core/optimizer/expand_elimination.h"
 #include "core/optimizer/fast_gelu_fusion.h"
 #include "core/optimizer/gather_fusion.h"
@@ -5673,6 +5675,278 @@ TEST_F(GraphTransformationTests, QuickGelu) {
   }
 }
 
+TEST_F(GraphTransformationTests, ElementwiseChainFusion) {
+  // 2 - Sigmoid((x + 1) * w)
+  auto build_test_case = [](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<float>({2, 3, 64}, -2.f, 2.f);
+    auto* weight_arg = builder.MakeInput<float>({2, 3, 64}, -2.f, 2.f);
+    auto* one_arg = builder.MakeInitializer<float>({}, {1.f});
+    auto* two_arg = builder.MakeInitializer<float>({}, {2.f});
+    auto* add_out = builder.MakeIntermediate();
+    auto* mul_out = builder.MakeIntermediate();
+    auto* sigmoid_out = builder.MakeIntermediate();
+    auto* sub_out = builder.MakeOutput();
+
+    builder.AddNode("Add", {input_arg, one_arg}, {add_out});
+    builder.AddNode("Mul", {weight_arg, add_out}, {mul_out});
+    builder.AddNode("Sigmoid", {mul_out}, {sigmoid_out});
+    builder.AddNode("Sub", {two_arg, sigmoid_out}, {sub_out});
+  };
+
+  auto pre_graph_checker = [](Graph& graph) {
+    TEST_RETURN_IF_NOT(CountOpsInGraph(graph).size() == 4);
+    return Status::OK();
+  };
+
+  auto post_graph_checker = [](Graph& graph) {
+    auto op_to_count = CountOpsInGraph(graph);
+    TEST_RETURN_IF_NOT(op_to_count.size() == 1);
+    TEST_RETURN_IF_NOT(op_to_count["com.microsoft.FusedElementwise"] == 1);
+    for (auto& node : graph.Nodes()) {
+      auto& attrs = node.GetAttributes();
+      const auto& ops = attrs.at("ops").strings();
+      TEST_RETURN_IF_NOT(std::vector<std::string>(ops.begin(), ops.end()) ==
+                         std::vector<std::string>({"Add", "Mul", "Sigmoid", "Sub"}));
+      const auto& operands = attrs.at("operands").ints();
+      TEST_RETURN_IF_NOT(std::vector<int64_t>(operands.begin(), operands.end()) ==
+                         std::vector<int64_t>({-1, 1, -1, -1}));
+      const auto& chain_is_rhs = attrs.at("chain_is_rhs").ints();
+      TEST_RETURN_IF_NOT(std::vector<int64_t>(chain_is_rhs.begin(), chain_is_rhs.end()) ==
+                         std::vector<int64_t>({0, 1, 0, 1}));
+      TEST_RETURN_IF_NOT(attrs.at("immediates").floats(0) == 1.f);
+      TEST_RETURN_IF_NOT(attrs.at("immediates").floats(3) == 2.f);
+      TEST_RETURN_IF_NOT(node.InputDefs().size() == 2);
+    }
+    return Status::OK();
+  };
+
+  ASSERT_STATUS_OK(TestGraphTransformer(build_test_case, 14, *logger_, std::make_unique<ElementwiseChainFusion>(),
+                                        TransformerLevel::Level1, 1, pre_graph_checker, post_graph_checker));
+
+  // the fused kernel must produce the same results as the unfused graph
+  auto check_transformed_graph = [](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["com.microsoft.FusedElementwise"], 1);
+  };
+
+  TransformerTester(build_test_case, check_transformed_graph, TransformerLevel::Default, TransformerLevel::Level1, 14,
+                    1e-5, 1e-5, std::make_unique<ElementwiseChainFusion>());
+}
+
+TEST_F(GraphTransformationTests, ElementwiseChainFusion_IntermediateGraphOutput) {
+  // Relu's output is a graph output so only Relu->Tanh->Neg can be fused
+  auto build_test_case = [](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<float>({{4, 16}});
+    auto* scale_arg = builder.MakeInitializer<float>({}, {0.5f});
+    auto* mul_out = builder.MakeOutput();
+    auto* relu_out = builder.MakeIntermediate();
+    auto* tanh_out = builder.MakeIntermediate();
+    auto* neg_out = builder.MakeOutput();
+
+    builder.AddNode("Mul", {input_arg, scale_arg}, {mul_out});
+    builder.AddNode("Relu", {mul_out}, {relu_out});
+    builder.AddNode("Tanh", {relu_out}, {tanh_out});
+    builder.AddNode("Neg", {tanh_out}, {neg_out});
+  };
+
+  auto pre_graph_checker = [](Graph& graph) {
+    TEST_RETURN_IF_NOT(CountOpsInGraph(graph).size() == 4);
+    return Status::OK();
+  };
+
+  auto post_graph_checker = [](Graph& graph) {
+    auto op_to_count = CountOpsInGraph(graph);
+    TEST_RETURN_IF_NOT(op_to_count["Mul"] == 1);
+    TEST_RETURN_IF_NOT(op_to_count["Relu"] == 0);
+    TEST_RETURN_IF_NOT(op_to_count["Tanh"] == 0);
+    TEST_RETURN_IF_NOT(op_to_count["Neg"] == 0);
+    TEST_RETURN_IF_NOT(op_to_count["com.microsoft.FusedElementwise"] == 1);
+    return Status::OK();
+  };
+
+  ASSERT_STATUS_OK(TestGraphTransformer(build_test_case, 14, *logger_, std::make_unique<ElementwiseChainFusion>(),
+                                        TransformerLevel::Level1, 1, pre_graph_checker, post_graph_checker));
+}
+
+TEST_F(GraphTransformationTests, EmbeddingBagFusion_ReduceSum) {
+  auto build_test_case = [](ModelTestBuilder& builder) {
+    auto* table_arg = builder.MakeInitializer<float>({10, 16}, -1.f, 1.f);
+    auto* indices_arg = builder.MakeInput<int64_t>({3, 4}, {0, 3, 3, 9, 1, 2, 5, -1, 7, 7, 7, 4});
+    auto* axes_arg = builder.MakeInitializer<int64_t>({1}, {1});
+    auto* gather_out = builder.MakeIntermediate();
+    auto* reduce_out = builder.MakeOutput();
+
+    builder.AddNode("Gather", {table_arg, indices_arg}, {gather_out});
+    builder.AddNode("ReduceSum", {gather_out, axes_arg}, {reduce_out}).AddAttribute("keepdims", int64_t(0));
+  };
+
+  auto pre_graph_checker = [](Graph& graph) {
+    TEST_RETURN_IF_NOT(CountOpsInGraph(graph).size() == 2);
+    return Status::OK();
+  };
+
+  auto post_graph_checker = [](Graph& graph) {
+    auto op_to_count = CountOpsInGraph(graph);
+    TEST_RETURN_IF_NOT(op_to_count.size() == 1);
+    TEST_RETURN_IF_NOT(op_to_count["com.microsoft.EmbeddingBag"] == 1);
+    for (auto& node : graph.Nodes()) {
+      TEST_RETURN_IF_NOT(node.GetAttributes().at("mode").s() == "sum");
+      TEST_RETURN_IF_NOT(!node.InputDefs()[2]->Exists());
+      TEST_RETURN_IF_NOT(!node.InputDefs()[3]->Exists());
+    }
+    return Status::OK();
+  };
+
+  ASSERT_STATUS_OK(TestGraphTransformer(build_test_case, 13, *logger_, std::make_unique<EmbeddingBagFusion>(),
+                                        TransformerLevel::Level1, 1, pre_graph_checker, post_graph_checker));
+
+  auto check_transformed_graph = [](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["com.microsoft.EmbeddingBag"], 1);
+  };
+
+  TransformerTester(build_test_case, check_transformed_graph, TransformerLevel::Default, TransformerLevel::Level1, 13,
+                    1e-5, 1e-5, std::make_unique<EmbeddingBagFusion>());
+}
+
+TEST_F(GraphTransformationTests, EmbeddingBagFusion_DequantizedTableWeighted) {
+  // ReduceSum(Gather(DequantizeLinear(table, scales, axis=0), indices) * weights, axes=[1])
+  auto build_test_case = [](ModelTestBuilder& builder) {
+    std::vector<int8_t> table(8 * 12);
+    for (size_t i = 0; i < table.size(); ++i) {
+      table[i] = static_cast<int8_t>(static_cast<int>(i * 37 % 255) - 127);
+    }
+
+    // the table is an input so that the DequantizeLinear is not constant folded
+    auto* table_arg = builder.MakeInput<int8_t>({8, 12}, table);
+    auto* scales_arg = builder.MakeInitializer<float>({8}, 0.01f, 0.1f);
+    auto* indices_arg = builder.MakeInput<int32_t>({2, 3}, {0, 7, 2, 5, 5, 1});
+    auto* weights_arg = builder.MakeInput<float>({2, 3, 1}, -1.f, 1.f);
+    auto* axes_arg = builder.MakeInitializer<int64_t>({1}, {-2});
+    auto* dq_out = builder.MakeIntermediate();
+    auto* gather_out = builder.MakeIntermediate();
+    auto* mul_out = builder.MakeIntermediate();
+    auto* reduce_out = builder.MakeOutput();
+
+    builder.AddNode("DequantizeLinear", {table_arg, scales_arg}, {dq_out}).AddAttribute("axis", int64_t(0));
+    builder.AddNode("Gather", {dq_out, indices_arg}, {gather_out});
+    builder.AddNode("Mul", {weights_arg, gather_out}, {mul_out});
+    builder.AddNode("ReduceSum", {mul_out, axes_arg}, {reduce_out}).AddAttribute("keepdims", int64_t(0));
+  };
+
+  auto pre_graph_checker = [](Graph& graph) {
+    TEST_RETURN_IF_NOT(CountOpsInGraph(graph).size() == 4);
+    return Status::OK();
+  };
+
+  auto post_graph_checker = [](Graph& graph) {
+    auto op_to_count = CountOpsInGraph(graph);
+    TEST_RETURN_IF_NOT(op_to_count.size() == 1);
+    TEST_RETURN_IF_NOT(op_to_count["com.microsoft.EmbeddingBag"] == 1);
+    for (auto& node : graph.Nodes()) {
+      TEST_RETURN_IF_NOT(node.InputDefs().size() == 4);
+      for (const auto* input : node.InputDefs()) {
+        TEST_RETURN_IF_NOT(input->Exists());
+      }
+    }
+    return Status::OK();
+  };
+
+  ASSERT_STATUS_OK(TestGraphTransformer(build_test_case, 13, *logger_, std::make_unique<EmbeddingBagFusion>(),
+                                        TransformerLevel::Level1, 1, pre_graph_checker, post_graph_checker));
+
+  auto check_transformed_graph = [](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["com.microsoft.EmbeddingBag"], 1);
+  };
+
+  TransformerTester(build_test_case, check_transformed_graph, TransformerLevel::Default, TransformerLevel::Level1, 13,
+                    1e-5, 1e-5, std::make_unique<EmbeddingBagFusion>());
+}
+
+TEST_F(GraphTransformationTests, EmbeddingBagFusion_Float16TableCast) {
+  // ReduceMean(Gather(Cast(table, to=float), indices), axes=[1]) reads the float16 table directly
+  auto build_test_case = [](ModelTestBuilder& builder) {
+    std::vector<MLFloat16> table(6 * 8);
+    for (size_t i = 0; i < table.size(); ++i) {
+      table[i] = MLFloat16(static_cast<float>(static_cast<int>(i * 7 % 19) - 9) * 0.125f);
+    }
+
+    // the table is an input so that the Cast is not constant folded
+    auto* table_arg = builder.MakeInput<MLFloat16>({6, 8}, table);
+    auto* indices_arg = builder.MakeInput<int64_t>({2, 3}, {0, 5, 2, 4, 4, 1});
+    auto* axes_arg = builder.MakeInitializer<int64_t>({1}, {1});
+    auto* cast_out = builder.MakeIntermediate();
+    auto* gather_out = builder.MakeIntermediate();
+    auto* reduce_out = builder.MakeOutput();
+
+    builder.AddNode("Cast", {table_arg}, {cast_out})
+        .AddAttribute("to", static_cast<int64_t>(ONNX_NAMESPACE::TensorProto_DataType_FLOAT));
+    builder.AddNode("Gather", {cast_out, indices_arg}, {gather_out});
+    builder.AddNode("ReduceMean", {gather_out}, {reduce_out})
+        .AddAttribute("axes", std::vector<int64_t>{1})
+        .AddAttribute("keepdims", int64_t(0));
+  };
+
+  auto pre_graph_checker = [](Graph& graph) {
+    TEST_RETURN_IF_NOT(CountOpsInGraph(graph).size() == 3);
+    return Status::OK();
+  };
+
+  auto post_graph_checker = [](Graph& graph) {
+    auto op_to_count = CountOpsInGraph(graph);
+    TEST_RETURN_IF_NOT(op_to_count.size() == 1);
+    TEST_RETURN_IF_NOT(op_to_count["com.microsoft.EmbeddingBag"] == 1);
+    for (auto& node : graph.Nodes()) {
+      TEST_RETURN_IF_NOT(node.GetAttributes().at("mode").s() == "mean");
+      TEST_RETURN_IF_NOT(node.InputDefs()[0]->TypeAsProto()->tensor_type().elem_type() ==
+                         ONNX_NAMESPACE::TensorProto_DataType_FLOAT16);
+      TEST_RETURN_IF_NOT(!node.InputDefs()[3]->Exists());
+    }
+    return Status::OK();
+  };
+
+  ASSERT_STATUS_OK(TestGraphTransformer(build_test_case, 13, *logger_, std::make_unique<EmbeddingBagFusion>(),
+                                        TransformerLevel::Level1, 1, pre_graph_checker, post_graph_checker));
+
+  auto check_transformed_graph = [](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["com.microsoft.EmbeddingBag"], 1);
+  };
+
+  TransformerTester(build_test_case, check_transformed_graph, TransformerLevel::Default, TransformerLevel::Level1, 13,
+                    1e-5, 1e-5, std::make_unique<EmbeddingBagFusion>());
+}
+
+TEST_F(GraphTransformationTests, EmbeddingBagFusion_KeepDims) {
+  // keepdims=1 keeps the bag axis, which EmbeddingBag does not produce
+  auto build_test_case = [](ModelTestBuilder& builder) {
+    auto* table_arg = builder.MakeInitializer<float>({10, 16}, -1.f, 1.f);
+    auto* indices_arg = builder.MakeInput<int64_t>({2, 3}, {0, 1, 2, 3, 4, 5});
+    auto* gather_out = builder.MakeIntermediate();
+    auto* reduce_out = builder.MakeOutput();
+
+    builder.AddNode("Gather", {table_arg, indices_arg}, {gather_out});
+    builder.AddNode("ReduceMean", {gather_out}, {reduce_out}).AddAttribute("axes", std::vector<int64_t>{1});
+  };
+
+  auto pre_graph_checker = [](Graph& graph) {
+    TEST_RETURN_IF_NOT(CountOpsInGraph(graph).size() == 2);
+    return Status::OK();
+  };
+
+  auto post_graph_checker = [](Graph& graph) {
+    auto op_to_count = CountOpsInGraph(graph);
+    TEST_RETURN_IF_NOT(op_to_count["Gather"] == 1);
+    TEST_RETURN_IF_NOT(op_to_count["ReduceMean"] == 1);
+    TEST_RETURN_IF_NOT(op_to_count["com.microsoft.EmbeddingBag"] == 0);
+    return Status::OK();
+  };
+
+  ASSERT_STATUS_OK(TestGraphTransformer(build_test_case, 13, *logger_, std::make_unique<EmbeddingBagFusion>(),
+                                        TransformerLevel::Level1, 1, pre_graph_checker, post_graph_checker));
+}
+
 struct BiasSoftmaxFusionTester {
   std::shared_ptr<Model> p_model_;
   Status model_load_;
@@ -12,6 +12,7 @@
 #include "TestCase.h"
 #include "utils.h"
 #include "ort_test_session.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
 using onnxruntime::Status;
 
 // TODO: Temporary, while we bring up the threadpool impl...
@@ -114,6 +115,14 @@ void PerformanceResult::DumpToFile(const std::basic_string<ORTCHAR_T>& path, boo
 void PerformanceRunner::LogSessionCreationTime() {
   std::chrono::duration<double> session_create_duration = session_create_end_ - session_create_start_;
   std::cout << "\nSession creation time cost: " << session_create_duration.count() << " s\n";
+  LogWarmSessionCreationTime();
+}
+
+void PerformanceRunner::LogWarmSessionCreationTime() {
+  if (session_create_warm_end_ != session_create_warm_start_) {
+    std::chrono::duration<double> warm_duration = session_create_warm_end_ - session_create_warm_start_;
+    std::cout << "Session creation time cost (warm, from optimized model cache): " << warm_duration.count() << " s\n";
+  }
 }
 
 Status PerformanceRunner::Run() {
@@ -164,6 +173,7 @@ Status PerformanceRunner::Run() {
             << "Avg CPU usage: " << performance_result_.average_CPU_usage << " %\n"
             << "Peak working set size: " << performance_result_.peak_workingset_size << " bytes"
             << std::endl;
+  LogWarmSessionCreationTime();
 
   return Status::OK();
 }
@@ -276,6 +286,16 @@ PerformanceRunner::PerformanceRunner(Ort::Env& env, const PerformanceTestConfig&
   session_create_start_ = std::chrono::high_resolution_clock::now();
   session_ = std::make_unique<OnnxRuntimeTestSession>(env, rd, performance_test_config_, *test_model_info_);
   session_create_end_ = std::chrono::high_resolution_clock::now();
+
+  // with an optimized model cache the first session is a cold start that populates the cache.
+  // create the session again to measure the warm start that loads the snapshot.
+  const auto& session_config_entries = performance_test_config_.run_config.session_config_entries;
+  if (session_config_entries.find(kOrtSessionOptionsConfigOptimizedModelCacheDir) != session_config_entries.end()) {
+    session_.reset();
+    session_create_warm_start_ = std::chrono::high_resolution_clock::now();
+    session_ = std::make_unique<OnnxRuntimeTestSession>(env, rd, performance_test_config_, *test_model_info_);
+    session_create_warm_end_ = std::chrono::high_resolution_clock::now();
+  }
 }
 
 PerformanceRunner::~PerformanceRunner() = default;
@@ -57,6 +57,8 @@ class PerformanceRunner {
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(PerformanceRunner);
 
  private:
+  void LogWarmSessionCreationTime();
+
   bool Initialize();
 
   template <bool isWarmup>
@@ -108,6 +110,9 @@ class PerformanceRunner {
  private:
   std::chrono::time_point<std::chrono::high_resolution_clock> session_create_start_;
   std::chrono::time_point<std::chrono::high_resolution_clock> session_create_end_;
+  // only set when an optimized model cache is configured. see kOrtSessionOptionsConfigOptimizedModelCacheDir.
+  std::chrono::time_point<std::chrono::high_resolution_clock> session_create_warm_start_;
+  std::chrono::time_point<std::chrono::high_resolution_clock> session_create_warm_end_;
   PerformanceResult initial_inference_result_;
   PerformanceResult performance_result_;
   PerformanceTestConfig performance_test_config_;
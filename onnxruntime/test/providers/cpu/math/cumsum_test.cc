@@ -257,5 +257,49 @@ TEST(CumSumTest, _1DTestLong) {
   test.AddOutput<int32_t>("y", {N}, output_value);
   test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});
 }
+TEST(CumSumTest, _2DTestLongAxisReverseExclusive) {
+  // a long axis with few columns is split into chunks that are scanned in parallel from carries
+  OpTester test("CumSum", 11, onnxruntime::kOnnxDomain);
+  test.AddAttribute("exclusive", int64_t(1));
+  test.AddAttribute("reverse", int64_t(1));
+  constexpr int64_t N = 10000, C = 3;
+  std::vector<int64_t> input(N * C);
+  std::vector<int64_t> output(N * C);
+  for (int64_t c = 0; c < C; ++c) {
+    int64_t sum = 0;
+    for (int64_t i = N - 1; i >= 0; --i) {
+      input[i * C + c] = (i * 7 + c) % 11 - 5;
+      output[i * C + c] = sum;
+      sum += input[i * C + c];
+    }
+  }
+
+  test.AddInput<int64_t>("x", {N, C}, input);
+  test.AddInput<int32_t>("axis", {}, {0});
+  test.AddOutput<int64_t>("y", {N, C}, output);
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});
+}
+TEST(CumSumTest, _3DTestManyColumns) {
+  OpTester test("CumSum", 11, onnxruntime::kOnnxDomain);
+  constexpr int64_t U = 2, N = 5, L = 600;
+  std::vector<int32_t> input(U * N * L);
+  std::vector<int32_t> output(U * N * L);
+  for (int64_t u = 0; u < U; ++u) {
+    for (int64_t l = 0; l < L; ++l) {
+      int32_t sum = 0;
+      for (int64_t i = 0; i < N; ++i) {
+        const int64_t idx = (u * N + i) * L + l;
+        input[idx] = static_cast<int32_t>((idx * 13) % 17);
+        sum += input[idx];
+        output[idx] = sum;
+      }
+    }
+  }
+
+  test.AddInput<int32_t>("x", {U, N, L}, input);
+  test.AddInput<int64_t>("axis", {}, {1});
+  test.AddOutput<int32_t>("y", {U, N, L}, output);
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});
+}
 }  // namespace test
 }  // namespace onnxruntime
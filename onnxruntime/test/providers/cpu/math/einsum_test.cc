@@ -592,6 +592,85 @@ TEST(Einsum, ImplicitEinsumAsTensorContraction) {
   test.Run();
 }
 
+// Theme: Contraction order and transposed MatMul
+
+// Contracting the last two inputs first is 5x cheaper than contracting left to right
+TEST(Einsum, ExplicitEinsumChainContractedInCheapestOrder) {
+  constexpr int64_t I = 10, J = 10, K = 10;
+  std::vector<float> a(I * J), b(J * K), c(K);
+  for (size_t i = 0; i < a.size(); ++i) a[i] = static_cast<float>(i % 7) - 3.f;
+  for (size_t i = 0; i < b.size(); ++i) b[i] = static_cast<float>(i % 5) - 2.f;
+  for (size_t i = 0; i < c.size(); ++i) c[i] = static_cast<float>(i % 3);
+
+  std::vector<float> expected(I, 0.f);
+  for (int64_t i = 0; i < I; ++i)
+    for (int64_t j = 0; j < J; ++j)
+      for (int64_t k = 0; k < K; ++k)
+        expected[i] += a[i * J + j] * b[j * K + k] * c[k];
+
+  OpTester test("Einsum", 12, onnxruntime::kOnnxDomain);
+  test.AddAttribute<std::string>("equation", "ij,jk,kl->il");
+  test.AddInput<float>("x", {I, J}, a);
+  test.AddInput<float>("y", {J, K}, b);
+  test.AddInput<float>("z", {K, 1}, c);
+  test.AddOutput<float>("o", {I, 1}, expected);
+  test.Run();
+}
+
+// The middle input shares no label with the first one, so the first pair contracted is not (x, y)
+TEST(Einsum, ExplicitEinsumMultiInputContractedOutOfOrder) {
+  constexpr int64_t I = 3, J = 4, K = 5;
+  std::vector<int64_t> a(I * J), b(K), c(J * K);
+  for (size_t i = 0; i < a.size(); ++i) a[i] = static_cast<int64_t>(i % 4) - 1;
+  for (size_t i = 0; i < b.size(); ++i) b[i] = static_cast<int64_t>(i) + 1;
+  for (size_t i = 0; i < c.size(); ++i) c[i] = static_cast<int64_t>(i % 3) - 1;
+
+  std::vector<int64_t> expected(I * K, 0);
+  for (int64_t i = 0; i < I; ++i)
+    for (int64_t j = 0; j < J; ++j)
+      for (int64_t k = 0; k < K; ++k)
+        expected[i * K + k] += a[i * J + j] * b[k] * c[j * K + k];
+
+  OpTester test("Einsum", 12, onnxruntime::kOnnxDomain);
+  test.AddAttribute<std::string>("equation", "ij,k,jk->ik");
+  test.AddInput<int64_t>("x", {I, J}, a);
+  test.AddInput<int64_t>("y", {K}, b);
+  test.AddInput<int64_t>("z", {J, K}, c);
+  test.AddOutput<int64_t>("o", {I, K}, expected);
+  test.Run();
+}
+
+template <typename T>
+static void RunBatchedMatmulTransposeATest() {
+  constexpr int64_t B = 2, K = 3, I = 4, J = 5;
+  std::vector<T> a(B * K * I), b(B * K * J);
+  for (size_t i = 0; i < a.size(); ++i) a[i] = static_cast<T>(static_cast<int>(i % 7) - 3);
+  for (size_t i = 0; i < b.size(); ++i) b[i] = static_cast<T>(static_cast<int>(i % 4) - 1);
+
+  std::vector<T> expected(B * I * J, static_cast<T>(0));
+  for (int64_t n = 0; n < B; ++n)
+    for (int64_t i = 0; i < I; ++i)
+      for (int64_t j = 0; j < J; ++j)
+        for (int64_t k = 0; k < K; ++k)
+          expected[(n * I + i) * J + j] += a[(n * K + k) * I + i] * b[(n * K + k) * J + j];
+
+  OpTester test("Einsum", 12, onnxruntime::kOnnxDomain);
+  test.AddAttribute<std::string>("equation", "bki,bkj->bij");
+  test.AddInput<T>("x", {B, K, I}, a);
+  test.AddInput<T>("y", {B, K, J}, b);
+  test.AddOutput<T>("o", {B, I, J}, expected);
+  test.Run();
+}
+
+// The first input is laid out as [batch, K, M] and is multiplied without being transposed first
+TEST(Einsum, ExplicitEinsumAsBatchedMatmulTransposeA) {
+  RunBatchedMatmulTransposeATest<float>();
+}
+
+TEST(Einsum, ExplicitEinsumAsBatchedMatmulTransposeA_int64) {
+  RunBatchedMatmulTransposeATest<int64_t>();
+}
+
 // Theme: Half support
 
 TEST(Einsum, ExplicitEinsumAsIdentity_1D_input_Half) {
@@ -861,5 +861,36 @@ TEST(TopKOperator, SelectTopKThreaded) {
   TestThreaded<double>(k, n, batch_size);
 }
 
+// create input of 2x20000 and select 64 so the rows are long enough to use radix selection
+TEST(TopKOperator, RadixSelectThreaded) {
+  constexpr int64_t k = 64;
+  constexpr int64_t n = 2;
+  constexpr int64_t batch_size = 20000;
+  TestThreaded<float>(k, n, batch_size);
+}
+
+// radix selection of a single long row with many equal values must select the lowest indices among them
+TEST(TopKOperator, RadixSelectSingleRowTies) {
+  constexpr int64_t k = 100;
+  constexpr int64_t size = 20000;
+  std::vector<float> input_vals(size);
+  for (int64_t i = 0; i < size; ++i) {
+    input_vals[i] = static_cast<float>(i % 100);
+  }
+  input_vals[100] = -0.0f;  // equal to the 0 values
+
+  std::vector<float> largest_vals(k, 99.0f);
+  std::vector<float> smallest_vals(k, 0.0f);
+  std::vector<int64_t> largest_indices(k);
+  std::vector<int64_t> smallest_indices(k);
+  for (int64_t i = 0; i < k; ++i) {
+    largest_indices[i] = 99 + i * 100;
+    smallest_indices[i] = i * 100;
+  }
+
+  RunTest(11, k, input_vals, {1, size}, largest_vals, largest_indices, {1, k}, false);
+  RunTest(11, k, input_vals, {1, size}, smallest_vals, smallest_indices, {1, k}, false, -1, 0);
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -81,6 +81,15 @@ TEST_F(ArrayFeatureExtractorTest, HigherDimensionalX) {
   test_.Run();
 }
 
+TEST_F(ArrayFeatureExtractorTest, ContiguousIndexRuns) {
+  // Y contains the runs [1, 4) and [6, 8), which are copied as blocks.
+  test_.AddInput<std::string>("X", {2, 8}, {"a0", "a1", "a2", "a3", "a4", "a5", "a6", "a7",
+                                            "b0", "b1", "b2", "b3", "b4", "b5", "b6", "b7"});
+  test_.AddInput<int64_t>("Y", {1, 5}, {1, 2, 3, 6, 7});
+  test_.AddOutput<std::string>("Z", {2, 5}, {"a1", "a2", "a3", "a6", "a7", "b1", "b2", "b3", "b6", "b7"});
+  test_.Run();
+}
+
 TEST_F(ArrayFeatureExtractorTest, OneDimensionalX) {
   test_.AddInput<int32_t>("X", {1}, {42});
   test_.AddInput<int64_t>("Y", {1, 3}, {0, 0, 0});
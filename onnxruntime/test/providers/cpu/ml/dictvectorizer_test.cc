@@ -42,5 +42,38 @@ TEST(MLOpTest, DictVectorizerInt64Input) {
   test.Run();
 }
 
+TEST(MLOpTest, DictVectorizerSparseInputUnknownKey) {
+  OpTester test("DictVectorizer", 1, onnxruntime::kMLDomain);
+
+  test.AddAttribute("int64_vocabulary", std::vector<int64_t>{10, 20, 30, 40, 50, 60});
+
+  // keys missing from the vocabulary are ignored
+  std::map<int64_t, float> map;
+  map[20] = 1.5f;
+  map[35] = 7.f;
+  map[60] = -2.f;
+
+  test.AddInput<int64_t, float>("X", map);
+
+  std::vector<int64_t> dims{1, 6};
+  test.AddOutput<float>("Y", dims, {0.f, 1.5f, 0.f, 0.f, 0.f, -2.f});
+  test.Run();
+}
+
+TEST(MLOpTest, DictVectorizerDuplicatedVocabulary) {
+  OpTester test("DictVectorizer", 1, onnxruntime::kMLDomain);
+
+  test.AddAttribute("string_vocabulary", std::vector<std::string>{"a", "b", "a", "c"});
+
+  std::map<std::string, int64_t> map;
+  map["a"] = 4;
+
+  test.AddInput<std::string, int64_t>("X", map);
+
+  std::vector<int64_t> dims{1, 4};
+  test.AddOutput<int64_t>("Y", dims, {4, 0, 4, 0});
+  test.Run();
+}
+
 }  // namespace test
 }  // namespace onnxruntime
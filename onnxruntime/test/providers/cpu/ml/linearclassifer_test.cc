@@ -155,6 +155,32 @@ void LinearClassifierMulticlass() {
   test.Run();
 }
 
+TEST(MLOpTest, LinearClassifierMulticlassSparseInput) {
+  OpTester test("LinearClassifier", 1, onnxruntime::kMLDomain);
+
+  constexpr int64_t num_features = 20;
+  std::vector<float> coefficients(2 * num_features, 1.f);
+  for (int64_t i = 0; i < num_features; ++i) {
+    coefficients[i] = static_cast<float>(i);
+  }
+  std::vector<float> intercepts = {0.5f, -1.f};
+
+  // One non-zero feature per row so the sparse scoring path is used.
+  std::vector<float> X(2 * num_features, 0.f);
+  X[3] = 2.f;
+  X[num_features + 17] = -1.f;
+
+  test.AddAttribute("coefficients", coefficients);
+  test.AddAttribute("intercepts", intercepts);
+  test.AddAttribute("classlabels_ints", std::vector<int64_t>{7, 9});
+
+  test.AddInput<float>("X", {2, num_features}, X);
+  test.AddOutput<int64_t>("Y", {2}, {7, 9});
+  test.AddOutput<float>("Z", {2, 2}, {6.5f, 1.f, -16.5f, -2.f});
+
+  test.Run();
+}
+
 TEST(MLOpTest, LinearClassifierMulticlassInt64Input) {
   LinearClassifierMulticlass<int64_t>();
 }
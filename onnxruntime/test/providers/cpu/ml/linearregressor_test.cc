@@ -72,6 +72,30 @@ TEST_P(LinearRegressorTest, LinearRegressorUniTarget) {
   test.Run();
 }
 
+TEST(MLOpTest, LinearRegressorSparseInput) {
+  OpTester test("LinearRegressor", 1, onnxruntime::kMLDomain);
+
+  constexpr int64_t num_features = 20;
+  std::vector<float> coefficients(2 * num_features, 1.f);
+  for (int64_t i = 0; i < num_features; ++i) {
+    coefficients[i] = static_cast<float>(i);
+  }
+  std::vector<float> intercepts = {0.5f, -1.f};
+
+  // One non-zero feature per row so the sparse scoring path is used.
+  std::vector<float> X(2 * num_features, 0.f);
+  X[3] = 2.f;
+  X[num_features + 17] = -1.f;
+
+  test.AddAttribute("coefficients", coefficients);
+  test.AddAttribute("intercepts", intercepts);
+  test.AddAttribute("targets", int64_t{2});
+
+  test.AddInput<float>("X", {2, num_features}, X);
+  test.AddOutput<float>("Y", {2, 2}, {6.5f, 1.f, -16.5f, -2.f});
+  test.Run();
+}
+
 // For PROBIT, all the output values are NaN.
 INSTANTIATE_TEST_SUITE_P(
     LinearRegressorTest, LinearRegressorTest,
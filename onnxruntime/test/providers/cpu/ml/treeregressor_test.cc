@@ -885,5 +885,45 @@ TEST(MLOpTest, TreeRegressorBranchEq) {
   test.Run();
 }
 
+TEST(MLOpTest, TreeRegressorUnbalancedBranchLtWithNaN) {
+  OpTester test("TreeEnsembleRegressor", 3, onnxruntime::kMLDomain);
+
+  // Tree 0 has leaves at depth 1 and 2, tree 1 is a single leaf.
+  int64_t n_targets = 1;
+  std::vector<int64_t> nodes_featureids = {0, 0, 1, 0, 0, 0};
+  std::vector<std::string> nodes_modes = {"BRANCH_LT", "LEAF", "BRANCH_LT", "LEAF", "LEAF", "LEAF"};
+  std::vector<float> nodes_values = {1.0, 0.0, 2.0, 0.0, 0.0, 0.0};
+  std::vector<int64_t> nodes_treeids = {0, 0, 0, 0, 0, 1};
+  std::vector<int64_t> nodes_nodeids = {0, 1, 2, 3, 4, 0};
+  std::vector<int64_t> nodes_falsenodeids = {2, 0, 4, 0, 0, 0};
+  std::vector<int64_t> nodes_truenodeids = {1, 0, 3, 0, 0, 0};
+
+  std::vector<int64_t> target_ids = {0, 0, 0, 0};
+  std::vector<int64_t> target_nodeids = {1, 3, 4, 0};
+  std::vector<int64_t> target_treeids = {0, 0, 0, 1};
+  std::vector<float> target_weights = {1.0, 10.0, 100.0, 1000.0};
+
+  // add attributes
+  test.AddAttribute("nodes_truenodeids", nodes_truenodeids);
+  test.AddAttribute("nodes_falsenodeids", nodes_falsenodeids);
+  test.AddAttribute("nodes_treeids", nodes_treeids);
+  test.AddAttribute("nodes_nodeids", nodes_nodeids);
+  test.AddAttribute("nodes_featureids", nodes_featureids);
+  test.AddAttribute("nodes_values", nodes_values);
+  test.AddAttribute("nodes_modes", nodes_modes);
+  test.AddAttribute("target_treeids", target_treeids);
+  test.AddAttribute("target_nodeids", target_nodeids);
+  test.AddAttribute("target_ids", target_ids);
+  test.AddAttribute("target_weights", target_weights);
+  test.AddAttribute("n_targets", n_targets);
+
+  // fill input data, NaN never satisfies the comparison and follows the false branch
+  std::vector<float> X = {0.5f, 5.0f, 3.0f, 1.0f, 3.0f, 3.0f, NAN, 1.0f, 1.0f, NAN};
+  std::vector<float> Y = {1001.0f, 1010.0f, 1100.0f, 1010.0f, 1100.0f};
+  test.AddInput<float>("X", {5, 2}, X);
+  test.AddOutput<float>("Y", {5, 1}, Y);
+  test.Run();
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -384,6 +384,46 @@ TEST(NonMaxSuppressionOpTest, BigIntMaxOutputBoxesPerClass) {
   test.Run();
 }
 
+TEST(NonMaxSuppressionOpTest, ManyBoxesMultipleBatchesAndClasses) {
+  // Each location holds a pair of heavily overlapping boxes so only the one with the higher score is selected.
+  // The number of selected boxes per class is larger than the block size used to check the boxes already selected.
+  constexpr int64_t num_batches = 2;
+  constexpr int64_t num_classes = 3;
+  constexpr int64_t num_locations = 20;
+  constexpr int64_t num_boxes = 2 * num_locations;
+
+  std::vector<float> boxes;
+  for (int64_t batch = 0; batch < num_batches; ++batch) {
+    for (int64_t location = 0; location < num_locations; ++location) {
+      const float x = 2.0f * static_cast<float>(location);
+      boxes.insert(boxes.end(), {0.0f, x, 1.0f, x + 1.0f, 0.0f, x + 0.1f, 1.0f, x + 1.1f});
+    }
+  }
+
+  std::vector<float> scores;
+  std::vector<int64_t> selected_indices;
+  for (int64_t batch = 0; batch < num_batches; ++batch) {
+    for (int64_t cls = 0; cls < num_classes; ++cls) {
+      for (int64_t location = 0; location < num_locations; ++location) {
+        const float score = 0.9f - 0.02f * static_cast<float>(location);
+        const bool second_wins = (location + cls + batch) % 2 == 0;
+        scores.push_back(second_wins ? score - 0.01f : score);
+        scores.push_back(second_wins ? score : score - 0.01f);
+        selected_indices.insert(selected_indices.end(), {batch, cls, 2 * location + (second_wins ? 1 : 0)});
+      }
+    }
+  }
+
+  OpTester test("NonMaxSuppression", 11, kOnnxDomain);
+  test.AddInput<float>("boxes", {num_batches, num_boxes, 4}, boxes);
+  test.AddInput<float>("scores", {num_batches, num_classes, num_boxes}, scores);
+  test.AddInput<int64_t>("max_output_boxes_per_class", {}, {30L});
+  test.AddInput<float>("iou_threshold", {}, {0.5f});
+  test.AddInput<float>("score_threshold", {}, {0.0f});
+  test.AddOutput<int64_t>("selected_indices", {num_batches * num_classes * num_locations, 3}, selected_indices);
+  test.Run();
+}
+
 TEST(NonMaxSuppressionOpTest, WithIOUThresholdOpset11) {
   OpTester test("NonMaxSuppression", 11, kOnnxDomain);
   test.AddInput<float>("boxes", {1, 6, 4},
@@ -6013,6 +6013,73 @@ TEST(ReductionOpTest, ReduceSum_RKRK_keepdims) {
   test.Run();
 }
 
+// A single outer dimension and a long reduced axis, the reduced axis is split across threads.
+TEST(ReductionOpTest, ReduceSum_KRK_long_reduced_axis) {
+  constexpr int64_t n_reduce = 1000, n_inner = 70;
+  std::vector<float> data(n_reduce * n_inner);
+  std::vector<float> expected(n_inner, 0.f);
+  for (int64_t i = 0; i < n_reduce; ++i) {
+    for (int64_t j = 0; j < n_inner; ++j) {
+      data[i * n_inner + j] = static_cast<float>((i + j) % 7) - 3.f;
+      expected[j] += data[i * n_inner + j];
+    }
+  }
+
+  OpTester test("ReduceSum");
+  test.AddAttribute("axes", std::vector<int64_t>{1});
+  test.AddAttribute("keepdims", (int64_t)0);
+  test.AddInput<float>("data", {1, n_reduce, n_inner}, data);
+  test.AddOutput<float>("reduced", {1, n_inner}, expected);
+  test.Run();
+}
+
+TEST(ReductionOpTest, ReduceMax_KR_long_rows) {
+  constexpr int64_t n_rows = 2, n_cols = 100000;
+  std::vector<float> data(n_rows * n_cols);
+  for (int64_t i = 0; i < n_rows * n_cols; ++i) {
+    data[i] = static_cast<float>(i % 1013) - 500.f;
+  }
+  data[3] = 1000.f;
+  data[n_cols + n_cols - 1] = 2000.f;
+
+  OpTester test("ReduceMax");
+  test.AddAttribute("axes", std::vector<int64_t>{1});
+  test.AddAttribute("keepdims", (int64_t)1);
+  test.AddInput<float>("data", {n_rows, n_cols}, data);
+  test.AddOutput<float>("reduced", {n_rows, 1}, {1000.f, 2000.f});
+  test.Run();
+}
+
+TEST(ReductionOpTest, ReduceMin_RK_few_columns) {
+  constexpr int64_t n_rows = 5000, n_cols = 3;
+  std::vector<int32_t> data(n_rows * n_cols);
+  for (int64_t i = 0; i < n_rows * n_cols; ++i) {
+    data[i] = static_cast<int32_t>(i % 101);
+  }
+  data[4000 * n_cols + 1] = -7;
+
+  OpTester test("ReduceMin");
+  test.AddAttribute("axes", std::vector<int64_t>{0});
+  test.AddAttribute("keepdims", (int64_t)0);
+  test.AddInput<int32_t>("data", {n_rows, n_cols}, data);
+  test.AddOutput<int32_t>("reduced", {n_cols}, {0, -7, 0});
+  test.Run();
+}
+
+TEST(ReductionOpTest, ReduceMean_all_large) {
+  constexpr int64_t size = 200000;
+  std::vector<double> data(size);
+  for (int64_t i = 0; i < size; ++i) {
+    data[i] = static_cast<double>(i % 10);
+  }
+
+  OpTester test("ReduceMean");
+  test.AddAttribute("keepdims", (int64_t)0);
+  test.AddInput<double>("data", {size}, data);
+  test.AddOutput<double>("reduced", {}, {4.5});
+  test.Run();
+}
+
 void test_empty_set(const std::string& op, int opset, bool axes_as_input, float empty_value) {
   OpTester test(op, opset);
   std::vector<int64_t> input_shape = {2, 0, 4};
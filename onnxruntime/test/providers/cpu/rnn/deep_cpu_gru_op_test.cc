@@ -7,6 +7,7 @@
 #include <vector>
 
 #include "core/providers/cpu/rnn/deep_cpu_gru.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
 #include "test/providers/provider_test_utils.h"
 #include "test/util/include/default_providers.h"
 using namespace std;
@@ -149,6 +150,60 @@ void DefaultActivationsSimpleWeightsNoBias(std::string direction,
                nullptr, nullptr, nullptr, direction, 9999.0, /* output_sequence*/ false, linear_before_reset);
 }
 
+// Runs the bidirectional case of DefaultActivationsSimpleWeightsNoBias with the weights quantized to int8,
+// so the expected output only holds within the quantization error.
+static void QuantizedWeightsSimpleWeightsNoBias(const std::vector<float>& Y_data,
+                                                const std::vector<float>& Y_h_data,
+                                                bool linear_before_reset,
+                                                bool is_initializer_weights) {
+  int64_t seq_length = 2;
+  int batch_size = linear_before_reset ? 3 : 2;
+  int64_t input_size = 1;
+  int64_t hidden_size = 3;
+  int num_directions = 2;
+
+  std::vector<float> X_data;
+  if (linear_before_reset) {
+    X_data = {1.f, 2.f, 3.f,
+              10.f, 11.f, 12.f};
+  } else {
+    X_data = {1.f, 2.f,
+              10.f, 11.f};
+  }
+
+  std::vector<float> W_data{0.1f, 0.2f, 0.3f,  // wz
+                            1.f, 2.f, 3.f,     // wr
+                            10.f, 11.f, 12.f,  // wh
+                            0.1f, 0.2f, 0.3f,
+                            1.f, 2.f, 3.f,
+                            10.f, 11.f, 12.f};
+
+  std::vector<float> R_data(num_directions * 3 * hidden_size * hidden_size, 0.1f);
+
+  OpTester test("GRU");
+
+  test.AddAttribute<std::vector<string>>("activations", {"Sigmoid", "Tanh", "Sigmoid", "Tanh"});
+  test.AddAttribute("direction", "bidirectional");
+  test.AddAttribute("hidden_size", hidden_size);
+  test.AddAttribute<int64_t>("linear_before_reset", linear_before_reset);
+
+  test.AddInput<float>("X", {seq_length, batch_size, input_size}, X_data);
+  test.AddInput<float>("W", {num_directions, 3 * hidden_size, input_size}, W_data, is_initializer_weights);
+  test.AddInput<float>("R", {num_directions, 3 * hidden_size, hidden_size}, R_data, is_initializer_weights);
+
+  test.AddOutput<float>("Y", {seq_length, num_directions, batch_size, hidden_size}, Y_data);
+  test.AddOutput<float>("Y_h", {num_directions, batch_size, hidden_size}, Y_h_data);
+
+  test.SetOutputTolerance(0.02f);
+
+  SessionOptions so;
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsQuantizeGruWeights, "1"));
+
+  test.Config(so)
+      .ConfigEp(DefaultCpuExecutionProvider())
+      .RunWithConfig();
+}
+
 TEST(GRUTest, ForwardDefaultActivationsSimpleWeightsNoBiasTwoRows) {
   std::vector<float> Y_data{
       0.4750208f, 0.450166f, 0.4255575f,
@@ -210,6 +265,10 @@ TEST(GRUTest, BidirectionalDefaultActivationsSimpleWeightsNoBias) {
       0.5803454f, 0.4527356f, 0.36886263f};
 
   DefaultActivationsSimpleWeightsNoBias("bidirectional", Y_data, Y_h_data);
+
+  // quantized weights, pre-packed and quantized per run
+  QuantizedWeightsSimpleWeightsNoBias(Y_data, Y_h_data, false, true);
+  QuantizedWeightsSimpleWeightsNoBias(Y_data, Y_h_data, false, false);
 }
 
 TEST(GRUTest, BidirectionalDefaultActivationsSimpleWeightsNoBiasLinearBeforeReset) {
@@ -246,6 +305,9 @@ TEST(GRUTest, BidirectionalDefaultActivationsSimpleWeightsNoBiasLinearBeforeRese
       0.5521325f, 0.40092295f, 0.30118297f};
 
   DefaultActivationsSimpleWeightsNoBias("bidirectional", Y_data, Y_h_data, true);
+
+  QuantizedWeightsSimpleWeightsNoBias(Y_data, Y_h_data, true, true);
+  QuantizedWeightsSimpleWeightsNoBias(Y_data, Y_h_data, true, false);
 }
 
 void DefaultActivationsSimpleWeightsWithBias(std::string direction,
@@ -277,6 +277,125 @@ TEST(LSTMTest, BidirectionalSimpleWeightsNoBiasTwoRows) {
   SimpleWeightsNoBiasTwoRows("bidirectional", Y_data, Y_h_data, Y_c_data);
 }
 
+// With a single row the recurrence can't be split by batch rows, so the two directions run concurrently
+TEST(LSTMTest, BidirectionalSimpleWeightsNoBiasOneRow) {
+  // TODO: Unskip when fixed #41968513
+  if (DefaultDmlExecutionProvider().get() != nullptr) {
+    GTEST_SKIP() << "Skipping because of the following error: MLOperatorAuthorImpl.cpp(1817): The parameter is incorrect.";
+  }
+
+  int64_t seq_length = 2;
+  int batch_size = 1;
+  int64_t input_size = 1;
+  int64_t hidden_size = 3;
+
+  std::vector<float> X_data{1.f, 10.f};
+
+  std::vector<float> W_data = DuplicateContainer(std::vector<float>{
+      0.1f, 0.2f, 0.3f, 0.4f,
+      1.f, 2.f, 3.f, 4.f,
+      10.f, 11.f, 12.f, 13.f});
+
+  std::vector<float> R_data(2 * 4 * hidden_size * hidden_size, 0.1f);
+
+  // the first row of the results of BidirectionalSimpleWeightsNoBiasTwoRows
+  std::vector<float> Y_data{
+      0.28828835f, 0.36581863f, 0.45679406f,
+      0.55391603f, 0.69201493f, 0.82696019f,
+
+      0.84196719f, 0.89402526f, 0.91073048f,
+      0.61249432f, 0.70678632f, 0.74094619f};
+
+  std::vector<float> Y_h_data{
+      0.84196719f, 0.89402526f, 0.91073048f,
+      0.55391603f, 0.69201493f, 0.82696019f};
+
+  std::vector<float> Y_c_data{
+      1.27731147f, 1.44181041f, 1.53179041f,
+      1.27850552f, 1.46799496f, 1.57641257f};
+
+  RunLstmTest(X_data, W_data, true, R_data, true, Y_data, Y_h_data, Y_c_data,
+              input_size, batch_size, hidden_size, seq_length,
+              nullptr, nullptr, nullptr, nullptr, nullptr, "bidirectional");
+}
+
+// kOrtSessionOptionsQuantizeLstmWeights runs the GEMMs with int8 weights and dynamically quantized inputs,
+// so the results only match the float results of BidirectionalSimpleWeightsNoBiasTwoRows approximately.
+static void RunQuantizedWeightsLstmTest(bool is_initializer_weights) {
+  int64_t seq_length = 2;
+  int batch_size = 2;
+  int64_t input_size = 1;
+  int64_t hidden_size = 3;
+  int num_directions = 2;
+
+  std::vector<float> X_data{1.f, 2.f, 10.f, 11.f};
+
+  std::vector<float> W_data = DuplicateContainer(std::vector<float>{
+      0.1f, 0.2f, 0.3f, 0.4f,
+      1.f, 2.f, 3.f, 4.f,
+      10.f, 11.f, 12.f, 13.f});
+
+  std::vector<float> R_data(num_directions * 4 * hidden_size * hidden_size, 0.1f);
+
+  std::vector<float> Y_data{
+      0.28828835f, 0.36581863f, 0.45679406f,
+      0.34526032f, 0.47220859f, 0.55850911f,
+
+      0.55391603f, 0.69201493f, 0.82696019f,
+      0.64046413f, 0.82303363f, 0.91610711f,
+
+      0.84196719f, 0.89402526f, 0.91073048f,
+      0.85882828f, 0.90703777f, 0.92382453f,
+
+      0.61249432f, 0.70678632f, 0.74094619f,
+      0.62759886f, 0.71640738f, 0.74624585f};
+
+  std::vector<float> Y_h_data{
+      0.84196719f, 0.89402526f, 0.91073048f,
+      0.85882828f, 0.90703777f, 0.92382453f,
+
+      0.55391603f, 0.69201493f, 0.82696019f,
+      0.64046413f, 0.82303363f, 0.91610711f};
+
+  std::vector<float> Y_c_data{
+      1.27731147f, 1.44181041f, 1.53179041f,
+      1.3249796f, 1.51063104f, 1.61451544f,
+
+      1.27850552f, 1.46799496f, 1.57641257f,
+      1.34960834f, 1.54772296f, 1.65633056f};
+
+  OpTester test("LSTM");
+
+  test.AddAttribute<std::vector<string>>("activations", {"sigmoid", "tanh", "tanh", "sigmoid", "tanh", "tanh"});
+  test.AddAttribute("direction", "bidirectional");
+  test.AddAttribute("hidden_size", hidden_size);
+
+  test.AddInput<float>("X", {seq_length, batch_size, input_size}, X_data);
+  test.AddInput<float>("W", {num_directions, 4 * hidden_size, input_size}, W_data, is_initializer_weights);
+  test.AddInput<float>("R", {num_directions, 4 * hidden_size, hidden_size}, R_data, is_initializer_weights);
+
+  test.AddOutput<float>("Y", {seq_length, num_directions, batch_size, hidden_size}, Y_data);
+  test.AddOutput<float>("Y_h", {num_directions, batch_size, hidden_size}, Y_h_data);
+  test.AddOutput<float>("Y_c", {num_directions, batch_size, hidden_size}, Y_c_data);
+
+  test.SetOutputTolerance(0.02f);
+
+  SessionOptions so;
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsQuantizeLstmWeights, "1"));
+
+  test.Config(so)
+      .ConfigEp(DefaultCpuExecutionProvider())
+      .RunWithConfig();
+}
+
+TEST(LSTMTest, QuantizedWeights) {
+  RunQuantizedWeightsLstmTest(true);
+}
+
+TEST(LSTMTest, QuantizedNonConstantWeights) {
+  RunQuantizedWeightsLstmTest(false);
+}
+
 TEST(LSTMTest, MixedSequenceLengths) {
   // TODO: Unskip when fixed #41968513
   if (DefaultDmlExecutionProvider().get() != nullptr) {
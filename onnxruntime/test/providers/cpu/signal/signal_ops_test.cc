@@ -1,6 +1,8 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <cmath>
+#include <complex>
 #include <functional>
 #include <vector>
 
@@ -206,6 +208,68 @@ TEST(SignalOpsTest, DFT20_invertible_complex) {
   TestDFTInvertible(true, kOpsetVersion20);
 }
 
+// Reference DFT of the num_samples values of x which are stride elements apart, computed in double.
+static vector<std::complex<double>> NaiveDFT(const float* x, size_t stride, bool complex, size_t num_samples,
+                                             const float* window, bool inverse) {
+  vector<std::complex<double>> y(num_samples);
+  const double direction = inverse ? 1.0 : -1.0;
+  for (size_t k = 0; k < num_samples; k++) {
+    for (size_t n = 0; n < num_samples; n++) {
+      const double angle = direction * 2.0 * M_PI * static_cast<double>((k * n) % num_samples) / num_samples;
+      std::complex<double> value(x[n * stride], complex ? x[n * stride + 1] : 0.0);
+      if (window) value *= window[n];
+      y[k] += value * std::complex<double>(std::cos(angle), std::sin(angle));
+    }
+    if (inverse) y[k] /= static_cast<double>(num_samples);
+  }
+  return y;
+}
+
+// Lengths with factors of 2, 3 and 5 use the mixed-radix FFT, even ones with a half-length FFT for real input,
+// and other lengths use the Bluestein algorithm.
+static void TestDFTMatchesNaive(int64_t length, bool complex, bool onesided, bool inverse) {
+  OpTester test("DFT", kMinOpsetVersion);
+  constexpr int64_t num_batches = 3;
+  const int64_t components = complex ? 2 : 1;
+  const int64_t output_length = onesided ? (length >> 1) + 1 : length;
+
+  RandomValueGenerator random(GetTestRandomSeed());
+  vector<int64_t> input_shape{num_batches, length, components};
+  vector<float> input = random.Uniform<float>(input_shape, -1.f, 1.f);
+  vector<float> expected_output;
+  for (int64_t b = 0; b < num_batches; b++) {
+    auto y = NaiveDFT(input.data() + b * length * components, components, complex, length, nullptr, inverse);
+    for (int64_t k = 0; k < output_length; k++) {
+      expected_output.push_back(static_cast<float>(y[k].real()));
+      expected_output.push_back(static_cast<float>(y[k].imag()));
+    }
+  }
+
+  test.AddInput<float>("input", input_shape, input);
+  test.AddAttribute<int64_t>("onesided", static_cast<int64_t>(onesided));
+  test.AddAttribute<int64_t>("inverse", static_cast<int64_t>(inverse));
+  test.AddOutput<float>("output", {num_batches, output_length, 2}, expected_output);
+  test.SetOutputAbsErr("output", 0.001f);
+  test.Run();
+}
+
+TEST(SignalOpsTest, DFT17_Float_mixed_radix) {
+  for (int64_t length : {6, 12, 45, 400}) {
+    TestDFTMatchesNaive(length, false, false, false);
+    TestDFTMatchesNaive(length, false, true, false);
+    TestDFTMatchesNaive(length, true, false, false);
+    TestDFTMatchesNaive(length, false, false, true);
+    TestDFTMatchesNaive(length, true, false, true);
+  }
+}
+
+TEST(SignalOpsTest, DFT17_Float_bluestein) {
+  for (int64_t length : {7, 14}) {
+    TestDFTMatchesNaive(length, false, false, false);
+    TestDFTMatchesNaive(length, true, false, true);
+  }
+}
+
 TEST(SignalOpsTest, STFTFloat) {
   OpTester test("STFT", kMinOpsetVersion);
 
@@ -233,6 +297,82 @@ TEST(SignalOpsTest, STFTFloat) {
   test.Run();
 }
 
+// Speech front-end sized frames, transformed in parallel with the real-input FFT.
+TEST(SignalOpsTest, STFTFloat_MixedRadixFrames) {
+  constexpr int64_t num_batches = 2;
+  constexpr int64_t signal_length = 1600;
+  constexpr int64_t frame_length = 400;
+  constexpr int64_t frame_step = 160;
+  constexpr int64_t num_frames = (signal_length - frame_length) / frame_step + 1;
+  constexpr int64_t output_length = frame_length / 2 + 1;
+
+  RandomValueGenerator random(GetTestRandomSeed());
+  vector<float> signal = random.Uniform<float>({num_batches, signal_length, 1}, -1.f, 1.f);
+  vector<float> window(frame_length);
+  for (int64_t n = 0; n < frame_length; n++) {
+    window[n] = static_cast<float>(0.5 - 0.5 * std::cos(2.0 * M_PI * n / frame_length));
+  }
+
+  vector<float> expected_output;
+  for (int64_t b = 0; b < num_batches; b++) {
+    for (int64_t f = 0; f < num_frames; f++) {
+      auto y = NaiveDFT(signal.data() + b * signal_length + f * frame_step, 1, false, frame_length, window.data(),
+                        false);
+      for (int64_t k = 0; k < output_length; k++) {
+        expected_output.push_back(static_cast<float>(y[k].real()));
+        expected_output.push_back(static_cast<float>(y[k].imag()));
+      }
+    }
+  }
+
+  OpTester test("STFT", kMinOpsetVersion);
+  test.AddInput<float>("signal", {num_batches, signal_length, 1}, signal);
+  test.AddInput<int64_t>("frame_step", {}, {frame_step});
+  test.AddInput<float>("window", {frame_length}, window);
+  test.AddInput<int64_t>("frame_length", {}, {frame_length});
+  test.AddOutput<float>("output", {num_batches, num_frames, output_length, 2}, expected_output);
+  test.SetOutputAbsErr("output", 0.001f);
+  test.Run();
+}
+
+// Complex signals with several batches check that the frame offsets count whole complex samples.
+TEST(SignalOpsTest, STFTFloat_ComplexMultipleBatches) {
+  constexpr int64_t num_batches = 3;
+  constexpr int64_t signal_length = 64;
+  constexpr int64_t frame_length = 16;
+  constexpr int64_t frame_step = 8;
+  constexpr int64_t num_frames = (signal_length - frame_length) / frame_step + 1;
+
+  RandomValueGenerator random(GetTestRandomSeed());
+  vector<float> signal = random.Uniform<float>({num_batches, signal_length, 2}, -1.f, 1.f);
+  vector<float> window(frame_length);
+  for (int64_t n = 0; n < frame_length; n++) {
+    window[n] = static_cast<float>(0.54 - 0.46 * std::cos(2.0 * M_PI * n / frame_length));
+  }
+
+  vector<float> expected_output;
+  for (int64_t b = 0; b < num_batches; b++) {
+    for (int64_t f = 0; f < num_frames; f++) {
+      auto y = NaiveDFT(signal.data() + (b * signal_length + f * frame_step) * 2, 2, true, frame_length,
+                        window.data(), false);
+      for (int64_t k = 0; k < frame_length; k++) {
+        expected_output.push_back(static_cast<float>(y[k].real()));
+        expected_output.push_back(static_cast<float>(y[k].imag()));
+      }
+    }
+  }
+
+  OpTester test("STFT", kMinOpsetVersion);
+  test.AddAttribute<int64_t>("onesided", 0);
+  test.AddInput<float>("signal", {num_batches, signal_length, 2}, signal);
+  test.AddInput<int64_t>("frame_step", {}, {frame_step});
+  test.AddInput<float>("window", {frame_length}, window);
+  test.AddInput<int64_t>("frame_length", {}, {frame_length});
+  test.AddOutput<float>("output", {num_batches, num_frames, frame_length, 2}, expected_output);
+  test.SetOutputAbsErr("output", 0.001f);
+  test.Run();
+}
+
 TEST(SignalOpsTest, HannWindowFloat) {
   OpTester test("HannWindow", kMinOpsetVersion);
 
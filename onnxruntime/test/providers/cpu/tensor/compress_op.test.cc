@@ -1,6 +1,8 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <memory>
+
 #include "gtest/gtest.h"
 #include "test/providers/provider_test_utils.h"
 
@@ -148,5 +150,55 @@ TEST(CompressTest, Compress_3dims_neg_axis) {
   test.Run();
 }
 
+TEST(CompressTest, Compress_large_default_axis) {
+  // spans several chunks that are counted and copied in parallel
+  constexpr int64_t size = 50000;
+  std::vector<int64_t> input(size);
+  // std::vector<bool> has no raw data to add as an input
+  auto condition = std::make_unique<bool[]>(size);
+  std::vector<int64_t> output;
+  for (int64_t i = 0; i < size; ++i) {
+    input[i] = i * 3;
+    condition[i] = (i % 5 == 1) || (i > 20000 && i < 20100);
+    if (condition[i]) {
+      output.push_back(input[i]);
+    }
+  }
+
+  OpTester test("Compress", 11);
+  test.AddInput<int64_t>("input", {size}, input);
+  test.AddInput<bool>("condition", {size}, condition.get(), size);
+  test.AddOutput<int64_t>("output", {static_cast<int64_t>(output.size())}, output);
+  test.Run();
+}
+
+TEST(CompressTest, Compress_large_axis_string) {
+  constexpr int64_t outer = 3, dim = 100, inner = 4;
+  std::vector<std::string> input(outer * dim * inner);
+  auto condition = std::make_unique<bool[]>(dim);
+  std::vector<std::string> output;
+  for (int64_t j = 0; j < dim; ++j) {
+    condition[j] = j % 3 == 0;
+  }
+
+  for (int64_t i = 0; i < outer; ++i) {
+    for (int64_t j = 0; j < dim; ++j) {
+      for (int64_t k = 0; k < inner; ++k) {
+        input[(i * dim + j) * inner + k] = std::to_string((i * dim + j) * inner + k);
+        if (condition[j]) {
+          output.push_back(input[(i * dim + j) * inner + k]);
+        }
+      }
+    }
+  }
+
+  OpTester test("Compress", 11);
+  test.AddAttribute("axis", int64_t(1));
+  test.AddInput<std::string>("input", {outer, dim, inner}, input);
+  test.AddInput<bool>("condition", {dim}, condition.get(), dim);
+  test.AddOutput<std::string>("output", {outer, 34, inner}, output);
+  test.Run();
+}
+
 }  // namespace test
 }  // namespace onnxruntime
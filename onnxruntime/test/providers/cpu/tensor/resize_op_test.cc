@@ -1,6 +1,7 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
 #include <exception>
 #include "gtest/gtest.h"
 #include "test/providers/provider_test_utils.h"
@@ -526,6 +527,50 @@ TEST(ResizeOpTest, ResizeOpLinearDownSampleTest_4DBilinear_align_corners_sizes)
 #endif
 }
 
+TEST(ResizeOpTest, ResizeOpLinearUpSampleTest_4DBilinear_align_corners_MultiChannel) {
+  // bilinear interpolation reproduces a plane exactly, whichever order the two axes are interpolated in
+  OpTester test("Resize", 13);
+  std::vector<float> roi{};
+  std::vector<float> scales{};
+  std::vector<int64_t> sizes{2, 3, 11, 9};
+
+  test.AddAttribute("mode", "linear");
+  test.AddAttribute("coordinate_transformation_mode", "align_corners");
+
+  constexpr int64_t N = 2, C = 3, H = 6, W = 5;
+  constexpr int64_t H_out = 11, W_out = 9;
+  const auto plane = [](int64_t n, int64_t c, float y, float x) {
+    return static_cast<float>(n * 100 + c * 10) + 3.0f * y - 2.0f * x;
+  };
+
+  std::vector<float> X;
+  std::vector<float> Y;
+  for (int64_t n = 0; n < N; ++n) {
+    for (int64_t c = 0; c < C; ++c) {
+      for (int64_t y = 0; y < H; ++y) {
+        for (int64_t x = 0; x < W; ++x) {
+          X.push_back(plane(n, c, static_cast<float>(y), static_cast<float>(x)));
+        }
+      }
+
+      // align_corners maps output y to input y * (H - 1) / (H_out - 1), which is y / 2 here, and the same for x
+      for (int64_t y = 0; y < H_out; ++y) {
+        for (int64_t x = 0; x < W_out; ++x) {
+          Y.push_back(plane(n, c, static_cast<float>(y) / 2, static_cast<float>(x) / 2));
+        }
+      }
+    }
+  }
+
+  test.AddInput<float>("X", {N, C, H, W}, X);
+  test.AddInput<float>("roi", {0}, roi);
+  test.AddInput<float>("", {0}, scales);
+  test.AddInput<int64_t>("sizes", {4}, sizes);
+
+  test.AddOutput<float>("Y", {N, C, H_out, W_out}, Y);
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", ExcludeTrtOnA100());
+}
+
 TEST(ResizeOpTest, NhwcResizeOpLinearDownSampleTest_4DBilinear_align_corners_uint8) {
   // To test NNAPI EP, we need the scales/sizes to be in initializers
   auto run_test = [](bool scales_in_initializer) {
@@ -1565,6 +1610,32 @@ TEST(ResizeOpTest, ResizeOpCubicUpSampleTest_MultiChannel) {
   test.AddOutput<float>("Y", {N, C, sizes[2], sizes[3]}, Y);
   test.Run();
 }
+TEST(ResizeOpTest, ResizeOpCubicDownSampleTest_MultiChannelConstantPlanes) {
+  // every plane is resized on its own, so a constant plane stays constant
+  OpTester test("Resize", 13);
+  std::vector<float> roi{};
+  std::vector<float> scales{1.0f, 1.0f, 0.6f, 0.5f};
+
+  test.AddAttribute("mode", "cubic");
+  test.AddAttribute("exclude_outside", static_cast<int64_t>(1));
+
+  constexpr int64_t N = 2, C = 3, H = 10, W = 10;
+  constexpr int64_t H_out = 6, W_out = 5;
+  std::vector<float> X(N * C * H * W);
+  std::vector<float> Y(N * C * H_out * W_out);
+  for (int64_t plane = 0; plane < N * C; ++plane) {
+    std::fill_n(X.begin() + plane * H * W, H * W, static_cast<float>(plane) - 2.5f);
+    std::fill_n(Y.begin() + plane * H_out * W_out, H_out * W_out, static_cast<float>(plane) - 2.5f);
+  }
+
+  test.AddInput<float>("X", {N, C, H, W}, X);
+  test.AddInput<float>("roi", {0}, roi);
+  test.AddInput<float>("scales", {4}, scales);
+
+  test.AddOutput<float>("Y", {N, C, H_out, W_out}, Y);
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", ExcludeTrtOnA100());
+}
+
 TEST(ResizeOpTest, ResizeOpCubicUpSampleTest_tf_half_pixel_for_nn) {
   // tf_half_pixel_for_nn has been deprecated since opset 13
   OpTester test("Resize", 12);
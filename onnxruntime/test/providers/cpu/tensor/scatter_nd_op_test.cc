@@ -235,5 +235,29 @@ TEST(ScatterNDOpTest, ScatterND_18_max) {
   test1.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider, kOpenVINOExecutionProvider});
 }
 
+TEST(ScatterNDOpTest, ScatterND_18_add_many_duplicates) {
+  // many updates of each slice, which must not be applied concurrently
+  constexpr int64_t rows = 16, cols = 32, num_updates = 200;
+  std::vector<float> data(rows * cols, 0.5f);
+  std::vector<int64_t> indices(num_updates);
+  std::vector<float> updates(num_updates * cols);
+  std::vector<float> expected(data);
+  for (int64_t i = 0; i < num_updates; ++i) {
+    indices[i] = (i * 5) % rows;
+    for (int64_t j = 0; j < cols; ++j) {
+      updates[i * cols + j] = static_cast<float>((i + j) % 4);
+      expected[indices[i] * cols + j] += updates[i * cols + j];
+    }
+  }
+
+  OpTester test1("ScatterND", 18);
+  test1.AddAttribute("reduction", "add");
+  test1.AddInput<float>("data", {rows, cols}, data);
+  test1.AddInput<int64_t>("indices", {num_updates, 1}, indices);
+  test1.AddInput<float>("updates", {num_updates, cols}, updates);
+  test1.AddOutput<float>("output", {rows, cols}, expected);
+  test1.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider, kOpenVINOExecutionProvider});
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -452,5 +452,60 @@ TEST(ScatterElements, MinReduction_Double) {
   test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider, kOpenVINOExecutionProvider});
 }
 
+TEST(ScatterElements, AddReductionManyDuplicates) {
+  // large enough to be split between threads, with every output row updated many times
+  constexpr int64_t rows = 64, cols = 300, update_rows = 128, update_cols = 200;
+  std::vector<float> data(rows * cols, 1.f);
+  std::vector<int64_t> indices(update_rows * update_cols);
+  std::vector<float> updates(update_rows * update_cols);
+  std::vector<float> expected(data);
+  for (int64_t i = 0; i < update_rows; ++i) {
+    for (int64_t j = 0; j < update_cols; ++j) {
+      const int64_t k = i * update_cols + j;
+      indices[k] = (i * 7 + j * 3) % rows;
+      updates[k] = static_cast<float>(k % 5);
+      expected[indices[k] * cols + j] += updates[k];
+    }
+  }
+
+  OpTester test("ScatterElements", 18);
+  test.AddAttribute<int64_t>("axis", 0);
+  test.AddAttribute<std::string>("reduction", "add");
+  test.AddInput<float>("data", {rows, cols}, data);
+  test.AddInput<int64_t>("indices", {update_rows, update_cols}, indices);
+  test.AddInput<float>("updates", {update_rows, update_cols}, updates);
+  test.AddOutput<float>("y", {rows, cols}, expected);
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider, kOpenVINOExecutionProvider});
+}
+
+TEST(ScatterElements, MiddleAxisPartialInnerDims) {
+  // updates cover only part of the dims after the axis, so their output offsets are not contiguous
+  constexpr int64_t d0 = 3, d1 = 5, d2 = 6;
+  constexpr int64_t u0 = 2, u1 = 5, u2 = 4;
+  std::vector<float> data(d0 * d1 * d2);
+  for (size_t i = 0; i < data.size(); ++i) data[i] = static_cast<float>(i);
+  std::vector<int64_t> indices(u0 * u1 * u2);
+  std::vector<float> updates(indices.size());
+  std::vector<float> expected(data);
+  for (int64_t i = 0; i < u0; ++i) {
+    for (int64_t j = 0; j < u1; ++j) {
+      for (int64_t k = 0; k < u2; ++k) {
+        const int64_t n = (i * u1 + j) * u2 + k;
+        indices[n] = (j + i + k) % d1;  // a permutation of the axis for each (i, k)
+        updates[n] = -static_cast<float>(n) - 1.f;
+        expected[(i * d1 + indices[n]) * d2 + k] = updates[n];
+      }
+    }
+  }
+
+  OpTester test("ScatterElements", 18);
+  test.AddAttribute<int64_t>("axis", 1);
+  test.AddInput<float>("data", {d0, d1, d2}, data);
+  test.AddInput<int64_t>("indices", {u0, u1, u2}, indices);
+  test.AddInput<float>("updates", {u0, u1, u2}, updates);
+  test.AddOutput<float>("y", {d0, d1, d2}, expected);
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider, kOpenVINOExecutionProvider});
+}
+
 }  // namespace test
 }  // namespace onnxruntime
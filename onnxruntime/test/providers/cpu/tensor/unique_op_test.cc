@@ -1,6 +1,8 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <map>
+
 #include "gtest/gtest.h"
 #include "test/providers/provider_test_utils.h"
 
@@ -394,5 +396,53 @@ TEST(Unique, EmptyInput) {
   test.Run();
 }
 
+TEST(Unique, Flatten_LargeInput) {
+  // spans several chunks that are hashed in parallel and merged
+  constexpr int64_t size = 40000;
+  std::vector<int64_t> X(size);
+  for (int64_t i = 0; i < size; ++i) {
+    X[i] = (i * 7919) % 1000 - (i > 30000 ? 2000 : 0);
+  }
+
+  for (bool sorted : {false, true}) {
+    std::vector<int64_t> Y, indices, counts, inverse_indices(size);
+    std::map<int64_t, int64_t> position;
+    for (int64_t i = 0; i < size; ++i) {
+      auto entry = position.find(X[i]);
+      if (entry == position.end()) {
+        entry = position.emplace(X[i], static_cast<int64_t>(Y.size())).first;
+        Y.push_back(X[i]);
+        indices.push_back(i);
+        counts.push_back(0);
+      }
+
+      ++counts[entry->second];
+      inverse_indices[i] = entry->second;
+    }
+
+    if (sorted) {
+      std::vector<int64_t> sorted_Y, sorted_indices, sorted_counts, old_to_new(Y.size());
+      for (const auto& [value, old_idx] : position) {
+        old_to_new[old_idx] = static_cast<int64_t>(sorted_Y.size());
+        sorted_Y.push_back(value);
+        sorted_indices.push_back(indices[old_idx]);
+        sorted_counts.push_back(counts[old_idx]);
+      }
+
+      for (auto& idx : inverse_indices) {
+        idx = old_to_new[idx];
+      }
+
+      Y = std::move(sorted_Y);
+      indices = std::move(sorted_indices);
+      counts = std::move(sorted_counts);
+    }
+
+    const std::vector<int64_t> Y_dims{static_cast<int64_t>(Y.size())};
+    RunUniqueTest<int64_t>({size}, X, nullptr, sorted, Y_dims, Y, Y_dims, indices,
+                           {size}, inverse_indices, Y_dims, counts);
+  }
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -97,6 +97,40 @@ TEST(RegexFullMatch, InvalidPattern) {
   test.Run(BaseTester::ExpectResult::kExpectFailure, "Invalid regex pattern: [a-z");
 }
 
+TEST(RegexFullMatch, LiteralPrefixManyInputs) {
+  // Enough strings to be split across threads. Most of them are rejected by the literal prefix check.
+  constexpr int64_t kNumStrings = 4096;
+  std::vector<std::string> input;
+  std::unique_ptr<bool[]> expected = std::make_unique<bool[]>(kNumStrings);
+  input.reserve(kNumStrings);
+  for (int64_t i = 0; i < kNumStrings; ++i) {
+    switch (i % 4) {
+      case 0:
+        input.push_back("error: code " + std::to_string(i));
+        expected[i] = true;
+        break;
+      case 1:
+        input.push_back("warning: code " + std::to_string(i));
+        expected[i] = false;
+        break;
+      case 2:
+        input.push_back("error: code x" + std::to_string(i));
+        expected[i] = false;
+        break;
+      default:
+        input.push_back("");
+        expected[i] = false;
+        break;
+    }
+  }
+
+  OpTester test("RegexFullMatch", 20, kOnnxDomain);
+  test.AddAttribute("pattern", std::string(R"(error: code \d+)"));
+  test.AddInput<std::string>("Input", {kNumStrings}, input);
+  test.AddOutput<bool>("Output", {kNumStrings}, expected.get(), kNumStrings);
+  test.Run();
+}
+
 TEST(RegexFullMatch, NonUtf8Pattern) {
   uint8_t invalid_bytes[] = {0xC0, 0xC1, 0x41, 0x42, 0xC3, 0x80, 0xC2, 0x80, 0xC2, 0xC3, 0xC4, 0x00};
   OpTester test("RegexFullMatch", 20, kOnnxDomain);
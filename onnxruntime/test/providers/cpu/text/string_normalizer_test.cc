@@ -194,6 +194,31 @@ TEST(ContribOpTest, StringNormalizerInsensitiveFilterOutUpperWithLocale) {
   test.Run(OpTester::ExpectResult::kExpectSuccess);
 }
 
+TEST(ContribOpTest, StringNormalizerInsensitiveFilterOutLowerMixedAscii) {
+  // - case-INSENSITIVE approach en_US locale
+  // - a mix of ASCII only and non-ASCII strings so both the ASCII fast path
+  //   and the wide char path are exercised in the same run
+  // - filter out MONDAY and École which are given in a different case than the input
+
+  OpTester test("StringNormalizer", opset_ver, domain);
+  InitTestAttr(test, "LOWER", false, {"MONDAY", "École"}, test_locale);
+  std::vector<int64_t> dims{6};
+  std::vector<std::string> input = {"Monday",
+                                    "TUESDAY",
+                                    "ÉCOLE",
+                                    "Besançon",
+                                    "Hello, World! 123",
+                                    "a long ascii string that spans more than eight bytes"};
+  test.AddInput<std::string>("T", dims, input);
+
+  std::vector<std::string> output = {"tuesday",
+                                     "besançon",
+                                     "hello, world! 123",
+                                     "a long ascii string that spans more than eight bytes"};
+  test.AddOutput<std::string>("Y", {4}, output);
+  test.Run(OpTester::ExpectResult::kExpectSuccess);
+}
+
 TEST(ContribOpTest, StringNormalizerSensitiveFilterOutUpperEmptyCase) {
   // Empty output case
   // - casesensitive approach
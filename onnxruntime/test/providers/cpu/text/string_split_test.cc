@@ -78,6 +78,14 @@ TEST(StringSplit, EdgeWhitespaceTest) {
   test.Run();
 }
 
+TEST(StringSplit, RaggedTokenCountTest) {
+  OpTester test("StringSplit", 20);
+  test.AddInput<std::string>("X", {4}, {"a b c d", "", "e", "f g"});
+  test.AddOutput<std::string>("Y", {4, 4}, {"a", "b", "c", "d", "", "", "", "", "e", "", "", "", "f", "g", "", ""});
+  test.AddOutput<int64_t>("Z", {4}, {4, 0, 1, 2});
+  test.Run();
+}
+
 TEST(StringSplit, EmptyInputTest) {
   OpTester test("StringSplit", 20);
   test.AddInput<std::string>("X", {1, 3, 1}, {"", "+", "*"});
@@ -30,6 +30,30 @@ class InferenceSessionWrapper : public InferenceSession {
   const Model& GetModel() const {
     return *model_;
   }
+
+#if !defined(ORT_MINIMAL_BUILD)
+  // Returns the session re-optimized for the observed input shapes or nullptr if there is none yet.
+  std::shared_ptr<InferenceSession> GetSpecializedSession() const {
+    if (shape_specialization_ == nullptr) {
+      return nullptr;
+    }
+
+    std::lock_guard<std::mutex> lock(shape_specialization_->mutex);
+    return shape_specialization_->session;
+  }
+
+  // Waits for the background build of the session re-optimized for the observed input shapes to finish.
+  // Returns the session or nullptr if no build was started or it failed.
+  std::shared_ptr<InferenceSession> WaitForSpecializedSession() const {
+    if (shape_specialization_ == nullptr) {
+      return nullptr;
+    }
+
+    std::unique_lock<std::mutex> lock(shape_specialization_->mutex);
+    shape_specialization_->build_finished.wait(lock, [this]() { return !shape_specialization_->building; });
+    return shape_specialization_->session;
+  }
+#endif
 };
 
 }  // namespace test